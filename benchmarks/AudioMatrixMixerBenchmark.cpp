@@ -0,0 +1,119 @@
+//
+// AudioMatrixMixer 混音内核基准
+// - 以 ns/样本/通道对 衡量 mixBlock()：总耗时 ÷ (块数 × blockSize × 参与运算的输入-输出对)
+// - 覆盖稠密（全部非零）与稀疏（对角）增益、增益恒定与每块变化（平滑斜坡）四种情况
+// - 同时给出逐样本标量三重循环（改写前的运算方式）作为对照
+// 用法：AudioMatrixMixerBenchmark [块数=20000] [blockSize=512]
+//
+#include "Nodes/AudioMatrixNode/AudioMatrixMixer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Nodes::AudioMatrixMixer;
+
+constexpr int ChannelCounts[] = {2, 8, 16, 32, 64};
+
+struct Buffers {
+    std::vector<std::vector<float>> inputData;
+    std::vector<std::vector<float>> outputData;
+    std::vector<const float*> inputs;
+    std::vector<float*> outputs;
+    std::vector<int> counts;
+
+    Buffers(int channels, int blockSize)
+        : inputData(channels, std::vector<float>(blockSize)),
+          outputData(channels, std::vector<float>(blockSize)),
+          counts(channels, blockSize) {
+        for (int c = 0; c < channels; ++c) {
+            for (int i = 0; i < blockSize; ++i) {
+                inputData[c][i] = float((i * 7 + c * 13) % 100) / 200.0f - 0.25f;
+            }
+            inputs.push_back(inputData[c].data());
+            outputs.push_back(outputData[c].data());
+        }
+    }
+};
+
+Eigen::MatrixXd gainMatrix(int channels, bool dense, double scale) {
+    if (dense) {
+        return Eigen::MatrixXd::Constant(channels, channels, scale / channels);
+    }
+    return Eigen::MatrixXd::Identity(channels, channels) * scale;
+}
+
+/**
+ * 函数级注释：运行 mixBlock()，ramping 为 true 时每块在两组增益之间切换
+ */
+double benchMixer(int channels, int blockSize, int blocks, bool dense, bool ramping) {
+    Buffers buffers(channels, blockSize);
+    AudioMatrixMixer mixer;
+    mixer.configure(channels, channels, blockSize);
+    const Eigen::MatrixXd gainsA = gainMatrix(channels, dense, 0.8);
+    const Eigen::MatrixXd gainsB = gainMatrix(channels, dense, 0.6);
+    mixer.setGains(gainsA);
+    mixer.mixBlock(buffers.inputs.data(), buffers.counts.data(), buffers.outputs.data());
+    const int pairs = mixer.activeRouteCount();
+
+    const auto start = Clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        if (ramping) {
+            mixer.setGains((b & 1) ? gainsA : gainsB);
+        }
+        mixer.mixBlock(buffers.inputs.data(), buffers.counts.data(), buffers.outputs.data());
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (double(blocks) * blockSize * std::max(1, pairs));
+}
+
+/**
+ * 函数级注释：对照组——每块把 double 增益逐元素读出，按样本做标量乘加与削波
+ */
+double benchScalar(int channels, int blockSize, int blocks, bool dense) {
+    Buffers buffers(channels, blockSize);
+    const Eigen::MatrixXd gains = gainMatrix(channels, dense, 0.8);
+    const auto start = Clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        for (int out = 0; out < channels; ++out) {
+            float* dst = buffers.outputs[out];
+            for (int i = 0; i < blockSize; ++i) {
+                double sum = 0.0;
+                for (int in = 0; in < channels; ++in) {
+                    sum += gains(in, out) * buffers.inputs[in][i];
+                }
+                dst[i] = float(std::clamp(sum, -1.0, 1.0));
+            }
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    // 对照组不跳过零增益，按全部通道对计
+    return ns / (double(blocks) * blockSize * channels * channels);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const int blocks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    const int blockSize = argc > 2 ? std::max(1, std::atoi(argv[2])) : 512;
+    std::printf("blocks=%d blockSize=%d (ns per sample per active channel pair)\n", blocks, blockSize);
+    std::printf("%8s %12s %12s %12s %12s %12s\n",
+                "in x out", "dense", "dense ramp", "diagonal", "diag ramp", "scalar ref");
+    for (int channels : ChannelCounts) {
+        // 对照组按通道数缩减块数，避免大矩阵时耗时过长
+        const int scalarBlocks = std::max(1, blocks / channels);
+        std::printf("%3d x %-3d %12.4f %12.4f %12.4f %12.4f %12.4f\n",
+                    channels, channels,
+                    benchMixer(channels, blockSize, blocks, true, false),
+                    benchMixer(channels, blockSize, blocks, true, true),
+                    benchMixer(channels, blockSize, blocks, false, false),
+                    benchMixer(channels, blockSize, blocks, false, true),
+                    benchScalar(channels, blockSize, scalarBlocks, true));
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+//
+// AudioTimestampRingQueue 多读者扇出基准
+// - 1 个生产者按固定间隔写入帧，1/2/4/8/16 个读者各持一个游标读取最新帧并校验
+// - 分别统计 Locked 与 LockFreeSpsc 模式下单次读取（acquire + verify）与单次写入的耗时分位数
+// 用法：AudioQueueFanoutBenchmark [帧数=2000] [帧间隔微秒=1000]
+//
+#include "AudioTimestampRingQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SampleRate = 48000;
+constexpr int Channels = 2;
+constexpr int FrameSamples = 256;   // 每通道采样数
+constexpr int QueueSlots = 64;
+constexpr int ReaderCounts[] = {1, 2, 4, 8, 16};
+
+struct Percentiles {
+    qint64 p50 = 0;
+    qint64 p99 = 0;
+    qint64 max = 0;
+};
+
+Percentiles percentiles(std::vector<qint64>& values) {
+    Percentiles result;
+    if (values.empty()) {
+        return result;
+    }
+    std::sort(values.begin(), values.end());
+    result.p50 = values[values.size() / 2];
+    result.p99 = values[std::min(values.size() - 1, values.size() * 99 / 100)];
+    result.max = values.back();
+    return result;
+}
+
+qint64 elapsedNs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/**
+ * 函数级注释：运行一组配置
+ * - 读者自旋等待生产者发布新的时间戳，读到后立即以游标读取该帧，模拟多个输出节点追同一个 AudioData
+ * - 生产者在主线程按 periodUs 间隔写入
+ */
+void runCase(AudioQueueMode mode, int readerCount, int frames, int periodUs) {
+    AudioTimestampRingQueue queue(QueueSlots, mode);
+    std::atomic<qint64> published {0};
+    std::atomic<bool> done {false};
+    std::atomic<int> ready {0};
+
+    std::vector<std::shared_ptr<AudioQueueCursor>> cursors;
+    std::vector<std::vector<qint64>> readNs(readerCount);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; ++r) {
+        cursors.push_back(AudioTimestampRingQueue::createCursor());
+        readNs[r].reserve(frames);
+    }
+    for (int r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            AudioQueueCursor& cursor = *cursors[r];
+            std::vector<qint64>& samples = readNs[r];
+            volatile float sink = 0.0f;
+            qint64 last = 0;
+            ready.fetch_add(1);
+            while (!done.load(std::memory_order_acquire)) {
+                const qint64 target = published.load(std::memory_order_acquire);
+                if (target == last) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                last = target;
+                const auto start = Clock::now();
+                AudioFrameView view;
+                if (queue.acquireFrameView(cursor, target, view)) {
+                    if (view.sampleCount > 0) {
+                        sink = sink + view.data[view.sampleCount - 1];
+                    }
+                    queue.verifyFrameView(cursor, view);
+                }
+                samples.push_back(elapsedNs(start));
+            }
+        });
+    }
+    while (ready.load() < readerCount) {
+        std::this_thread::yield();
+    }
+
+    AudioFrame frame;
+    frame.data = QByteArray(int(FrameSamples * Channels * sizeof(float)), 0);
+    frame.sampleRate = SampleRate;
+    frame.channels = Channels;
+    frame.bitsPerSample = 32;
+
+    std::vector<qint64> pushNs;
+    pushNs.reserve(frames);
+    const auto period = std::chrono::microseconds(periodUs);
+    auto next = Clock::now();
+    for (qint64 ts = 1; ts <= frames; ++ts) {
+        frame.timestamp = ts;
+        const auto start = Clock::now();
+        queue.pushFrame(frame);
+        pushNs.push_back(elapsedNs(start));
+        published.store(ts, std::memory_order_release);
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    std::vector<qint64> allReads;
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 late = 0;
+    for (int r = 0; r < readerCount; ++r) {
+        allReads.insert(allReads.end(), readNs[r].begin(), readNs[r].end());
+        const AudioQueueStats stats = cursors[r]->stats();
+        hits += stats.hitFrames;
+        misses += stats.missedFrames;
+        late += stats.lateFrames;
+    }
+    const Percentiles read = percentiles(allReads);
+    const Percentiles push = percentiles(pushNs);
+    std::printf("%-12s %7d %9lld %9lld %9lld %9lld %9lld %9lld %9llu %7llu %7llu\n",
+                mode == AudioQueueMode::Locked ? "Locked" : "LockFreeSpsc",
+                readerCount,
+                static_cast<long long>(read.p50), static_cast<long long>(read.p99), static_cast<long long>(read.max),
+                static_cast<long long>(push.p50), static_cast<long long>(push.p99), static_cast<long long>(push.max),
+                static_cast<unsigned long long>(hits),
+                static_cast<unsigned long long>(misses),
+                static_cast<unsigned long long>(late));
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const int periodUs = argc > 2 ? std::max(0, std::atoi(argv[2])) : 1000;
+    std::printf("frames=%d period=%dus frame=%d samples x %d ch, slots=%d (latency in ns)\n",
+                frames, periodUs, FrameSamples, Channels, QueueSlots);
+    std::printf("%-12s %7s %9s %9s %9s %9s %9s %9s %9s %7s %7s\n",
+                "mode", "readers", "read p50", "read p99", "read max",
+                "push p50", "push p99", "push max", "hits", "misses", "late");
+    for (AudioQueueMode mode : {AudioQueueMode::Locked, AudioQueueMode::LockFreeSpsc}) {
+        for (int readerCount : ReaderCounts) {
+            runCase(mode, readerCount, frames, periodUs);
+        }
+    }
+    return 0;
+}
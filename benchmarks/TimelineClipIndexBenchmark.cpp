@@ -0,0 +1,126 @@
+//
+// TimelineClipIndex 区间索引基准
+// - 1 小时（25fps）时间轴上随机分布 10k 个剪辑（默认），统计：
+//   重建耗时、连续播放逐帧查询、随机跳转查询、ClipId 查找，以及逐剪辑线性判断的对照
+// 用法：TimelineClipIndexBenchmark [剪辑数=10000] [随机查询次数=100000]
+//
+#include "Common/BaseClass/TimelineClipIndex.h"
+
+#include <QCoreApplication>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int FrameRate = 25;
+constexpr qint64 TimelineFrames = qint64(FrameRate) * 3600;
+constexpr int MinClipFrames = FrameRate;
+constexpr int MaxClipFrames = FrameRate * 60;
+
+/**
+ * @brief 只有起止帧的剪辑，不加载媒体
+ */
+class BenchClip : public AbstractClipModel {
+public:
+    BenchClip(int start, int end, ClipId id)
+        : AbstractClipModel(start, "Bench") {
+        AbstractClipModel::setEnd(end);
+        AbstractClipModel::setId(id);
+    }
+
+    QVariantMap currentData(int) const override { return {}; }
+};
+
+double nsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const int clipCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10000;
+    const int queries = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100000;
+
+    std::mt19937 rng(20250902);
+    std::uniform_int_distribution<int> startDist(0, int(TimelineFrames - MinClipFrames));
+    std::uniform_int_distribution<int> lengthDist(MinClipFrames, MaxClipFrames);
+    std::vector<std::unique_ptr<BenchClip>> owned;
+    QList<AbstractClipModel*> clips;
+    owned.reserve(clipCount);
+    clips.reserve(clipCount);
+    for (int i = 0; i < clipCount; ++i) {
+        const int start = startDist(rng);
+        owned.push_back(std::make_unique<BenchClip>(start, start + lengthDist(rng), ClipId(i + 1)));
+        clips.append(owned.back().get());
+    }
+
+    TimelineClipIndex index;
+    auto start = Clock::now();
+    index.rebuild(clips);
+    const double rebuildNs = nsSince(start);
+
+    // 连续播放：每帧 +1，走增量路径
+    qint64 activeTotal = 0;
+    start = Clock::now();
+    for (qint64 frame = 0; frame < TimelineFrames; ++frame) {
+        activeTotal += index.activeClips(frame).size();
+    }
+    const double playNs = nsSince(start) / double(TimelineFrames);
+
+    // 随机跳转：每次都走区间索引定位
+    std::uniform_int_distribution<qint64> frameDist(0, TimelineFrames - 1);
+    std::vector<qint64> seekFrames(queries);
+    for (qint64& frame : seekFrames) {
+        frame = frameDist(rng);
+    }
+    qint64 seekTotal = 0;
+    start = Clock::now();
+    for (qint64 frame : seekFrames) {
+        seekTotal += index.activeClips(frame).size();
+    }
+    const double seekNs = nsSince(start) / double(queries);
+
+    // ClipId 查找
+    std::uniform_int_distribution<int> idDist(1, clipCount);
+    std::vector<ClipId> ids(queries);
+    for (ClipId& id : ids) {
+        id = ClipId(idDist(rng));
+    }
+    int found = 0;
+    start = Clock::now();
+    for (ClipId id : ids) {
+        found += index.clip(id) != nullptr;
+    }
+    const double lookupNs = nsSince(start) / double(queries);
+
+    // 对照：逐剪辑判断 start <= frame <= end（改写前每帧的做法）
+    const int linearQueries = std::max(1, queries / 100);
+    qint64 linearTotal = 0;
+    start = Clock::now();
+    for (int q = 0; q < linearQueries; ++q) {
+        const qint64 frame = seekFrames[q];
+        for (AbstractClipModel* clip : clips) {
+            linearTotal += clip->start() <= frame && frame <= clip->end();
+        }
+    }
+    const double linearNs = nsSince(start) / double(linearQueries);
+
+    std::printf("clips=%d timeline=%lld frames (%d fps)\n", clipCount, static_cast<long long>(TimelineFrames), FrameRate);
+    std::printf("rebuild                 %12.1f us\n", rebuildNs / 1000.0);
+    std::printf("sequential activeClips  %12.1f ns/frame  (avg %.1f active)\n",
+                playNs, double(activeTotal) / double(TimelineFrames));
+    std::printf("random seek activeClips %12.1f ns/query  (avg %.1f active)\n",
+                seekNs, double(seekTotal) / double(queries));
+    std::printf("clip(ClipId)            %12.1f ns/query  (%d found)\n", lookupNs, found);
+    std::printf("linear scan reference   %12.1f ns/query  (avg %.1f active)\n",
+                linearNs, double(linearTotal) / double(linearQueries));
+    return 0;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+}
+
+namespace Clips
+{
+    /**
+     * 函数级注释：Art-Net 剪辑的后台 DMX 解码器
+     * - 打开文件时在解码线程中建立 PTS/关键帧索引，帧号查找为二分查找，跳转只需定位到最近关键帧
+     * - 解码线程在播放头之后预解码 RingSize 帧到环形缓冲，timeline 时钟线程只做内存拷贝，不再解码
+     * - 预解码空闲时顺序解码整个文件，写入磁盘缓存（头 + PTS 表 + 每帧 universeCount×512 字节原始数据），
+     *   之后再次打开同一文件（路径/大小/修改时间一致）直接内存映射缓存，无需任何视频解码
+     * - 所有接口线程安全；readFrame 不阻塞，数据未就绪时返回 false
+     */
+    class ArtnetClipDecoder : public QThread {
+        Q_OBJECT
+    public:
+        static constexpr int DmxSize = 512;
+        static constexpr int RingSize = 64;          // 预解码帧数
+        static constexpr int CacheBuildChunk = 8;    // 每次空闲时写入缓存的帧数
+        static constexpr quint32 CacheMagic = 0x584D4446; // "FDMX"
+        static constexpr quint32 CacheVersion = 1;
+
+        explicit ArtnetClipDecoder(QObject* parent = nullptr);
+        ~ArtnetClipDecoder() override;
+
+        /**
+         * 函数级注释：异步打开文件（路径不变时忽略）；空路径表示关闭
+         */
+        void open(const QString& path);
+
+        /**
+         * 函数级注释：停止解码线程并释放资源
+         */
+        void stop();
+
+        /**
+         * 函数级注释：索引是否就绪（可调用 frameAt/readFrame）
+         */
+        bool isReady() const;
+
+        /**
+         * 函数级注释：是否已使用磁盘缓存（不再解码视频）
+         */
+        bool isCached() const;
+
+        int universeCount() const;
+        int frameCount() const;
+
+        /**
+         * 函数级注释：时间（秒）对应的帧号：PTS 不大于该时间的最后一帧
+         * @return 未就绪返回 -1
+         */
+        int frameAt(double seconds) const;
+
+        /**
+         * 函数级注释：读取一帧 DMX 数据（universeCount×512 字节）并将播放头移至该帧
+         * - 数据来自磁盘缓存或预解码环形缓冲；未就绪时唤醒解码线程并返回 false，不阻塞调用方
+         */
+        bool readFrame(int frameIndex, char* dest);
+
+    protected:
+        void run() override;
+
+    private:
+        struct DecodeContext {
+            AVFormatContext* format = nullptr;
+            AVCodecContext* codec = nullptr;
+            AVFrame* frame = nullptr;
+            AVPacket* packet = nullptr;
+            int streamIndex = -1;
+            int nextFrame = 0;        // 顺序解码时下一帧帧号
+            bool draining = false;    // 已到文件末尾，正在取出解码器剩余帧
+        };
+
+        struct RingSlot {
+            int frame = -1;
+            QByteArray data;
+        };
+
+        // 以下函数仅在解码线程中调用
+        void openMedia(const QString& path);
+        void closeMedia();
+        bool openContext(DecodeContext& ctx, const QString& path);
+        void closeContext(DecodeContext& ctx);
+        bool buildIndex(DecodeContext& ctx, const QString& path, std::vector<int64_t>& pts);
+        bool seekContext(DecodeContext& ctx, int frameIndex);
+        int decodeNext(DecodeContext& ctx, char* dest);
+        int frameForPts(int64_t pts) const;
+        bool fillRing(int playhead);
+        bool buildCacheStep();
+        void finishCache(bool success);
+        bool loadCache(const QString& cachePath);
+        static QString cacheFilePath(const QString& path);
+
+        bool pathChanged(const QString& path) const;
+
+        mutable QMutex m_mutex;
+        QWaitCondition m_condition;
+        QString m_path;                  // 请求打开的路径
+        int m_playhead = 0;              // 最近一次 readFrame 的帧号
+        bool m_idle = false;             // 解码线程无事可做，等待唤醒
+        bool m_stopping = false;
+
+        // 受 m_mutex 保护的已发布状态
+        bool m_ready = false;
+        int m_universeCount = 0;
+        int m_frameCount = 0;
+        double m_timeBase = 0.0;
+        std::vector<int64_t> m_pts;      // 按显示顺序的每帧 PTS
+        std::vector<RingSlot> m_ring;
+        const uchar* m_cacheFrames = nullptr; // 内存映射缓存中的帧数据起始
+
+        // 仅解码线程访问
+        DecodeContext m_play;            // 预解码
+        DecodeContext m_build;           // 写缓存的顺序解码
+        std::vector<int64_t> m_keyframes; // 关键帧 PTS（升序）
+        QByteArray m_decodeBuffer;
+        QFile m_cacheFile;               // 已映射的缓存文件
+        uchar* m_cacheMap = nullptr;     // 缓存文件映射起始
+        AVRational m_streamTimeBase {0, 1};
+        QFile m_buildFile;               // 正在写入的缓存临时文件
+        QString m_buildPath;             // 缓存目标路径，为空表示无需/无法写缓存
+        int m_builtFrames = 0;
+        QString m_mediaPath;             // 解码线程当前打开的路径
+    };
+}
@@ -16,6 +16,7 @@ Clips::ArtnetClipModel::ArtnetClipModel(int start,const QString& filePath, QObje
         SHOWBORDER = true;
         ClipColor=QColor("#66cccc");
         AbstractClipModel::initPropertyWidget();
+        m_decoder = new ArtnetClipDecoder(this);
         if (!filePath.isEmpty()) {
             loadArtnetInfo(filePath);
         }
@@ -28,7 +29,9 @@ Clips::ArtnetClipModel::ArtnetClipModel(int start,const QString& filePath, QObje
         QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
     }
 
-Clips::ArtnetClipModel::~ArtnetClipModel() {}
+Clips::ArtnetClipModel::~ArtnetClipModel() {
+    m_decoder->stop();
+}
 
 // 设置文件路径并加载视频信息
 void Clips::ArtnetClipModel::setMedia(const QVariant& path) {
@@ -37,11 +40,11 @@ void Clips::ArtnetClipModel::setMedia(const QVariant& path) {
 }
 
 void Clips::ArtnetClipModel::setStart(int start)  {
-    AbstractClipModel::setStart(start);
+    AbstractClipDelegateModel::setStart(start);
     QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
 }
 void Clips::ArtnetClipModel::setEnd(int end)   {
-    AbstractClipModel::setEnd(end);
+    AbstractClipDelegateModel::setEnd(end);
     QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
 }
 
@@ -133,8 +136,9 @@ QWidget* Clips::ArtnetClipModel::clipPropertyWidget() {
          * 函数级注释：在 timeline 上按帧回放 DMX 数据
          * - 当 currentFrame 处于剪辑区间内时：
          *   1) 打开并定位到对应视频帧（基于 timeline 帧率与 FFmpeg time_base）
-         *   2) 提取每一行（universe）的 512 字节 DMX 数据到 m_dmxDataList
-         *   3) 构建与 UniversePlaybackDataModel 对齐的 artnetPacket 列表返回
+         *   2) 提取每一行（universe）的 512 字节 DMX 数据到连续数据块 m_dmxBlock（原地写入）
+         *   3) 返回 "dmxBlock"（N×512 字节，隐式共享不复制）、"startUniverse" 与 "universeCount"，
+         *      需要单宇宙数据时以 DmxUniverseData(universe, block, index * 512) 视图引用
          *   4) 同步通过 m_artnetTransmitter 将每个 Universe 的帧入队广播
          * - 在剪辑开始帧返回 "/file"，结束前一帧返回 "/stop" 以保持与其他 Clip 一致的习惯
          */
@@ -160,47 +164,26 @@ QVariantMap Clips::ArtnetClipModel::currentData(int currentFrame) const {
         return data;
     }
 
-    // 懒加载打开视频
+    // 懒加载打开视频（异步：索引在解码线程中建立）
     const_cast<ArtnetClipModel*>(this)->ensureVideoOpened(AppConstants::MEDIA_LIBRARY_STORAGE_DIR + "/" + m_filePath);
-    if (!m_formatContext || !m_codecContext || m_videoStreamIndex < 0) {
+    if (!m_decoder->isReady()) {
         return data;
     }
 
-    // 解码并提取当前帧 DMX
-    if (const_cast<ArtnetClipModel*>(this)->readFrameAt(currentFrame)) {
-        const_cast<ArtnetClipModel*>(this)->extractDMXFromCurrentFrame();
+    // timeline 帧号 -> 秒 -> 视频帧号（PTS 索引）
+    const double timelineFps = timecode_frames_per_sec(getTimeCodeType());
+    const int relFrame = qMax(0, currentFrame - start());
+    const int frameIndex = m_decoder->frameAt(relFrame / timelineFps);
 
-        // 构建 artnetPacket 列表
-        QVariantList packets;
+    // 从缓存或预解码缓冲读取当前帧 DMX；尚未解码到时本帧不输出，不阻塞时钟
+    if (const_cast<ArtnetClipModel*>(this)->readDmxFrame(frameIndex)) {
         int baseUniverse = (m_startUniverse ? m_startUniverse->value() : 0);
         int subnet = 0; // Timeline 版本简化：默认 subnet=0
         int net = 0;    // Timeline 版本简化：默认 net=0
 
-        for (int universeIndex = 0; universeIndex < m_universeCount; ++universeIndex) {
-            QVariantMap artnetPacket;
-            artnetPacket["protocol"] = "Art-Net";
-            artnetPacket["version"] = 14;
-            artnetPacket["opcode"] = 0x5000;
-
-            int currentUniverse = (baseUniverse + universeIndex) % 16;
-            artnetPacket["universe"] = currentUniverse;
-            artnetPacket["subnet"] = subnet;
-            artnetPacket["net"] = net;
-            int fullUniverse = (net << 8) | (subnet << 4) | currentUniverse;
-            artnetPacket["fullUniverse"] = fullUniverse;
-
-            const QByteArray& dmx = m_dmxDataList[universeIndex];
-            QVariantList dmxList;
-            dmxList.reserve(512);
-            for (int i = 0; i < 512; ++i) {
-                dmxList.append(int(static_cast<unsigned char>(dmx[i])));
-            }
-            artnetPacket["dmxData"] = dmxList;
-            artnetPacket["dataLength"] = 512;
-
-            packets.push_back(artnetPacket);
-        }
-        data["artnetPackets"] = packets;
+        data["dmxBlock"] = m_dmxBlock;
+        data["startUniverse"] = (net << 8) | (subnet << 4) | (baseUniverse % 16);
+        data["universeCount"] = m_universeCount;
 
         // 同步发送：避免重复发送同一帧
         const_cast<ArtnetClipModel*>(this)->sendArtnetFrames(baseUniverse, subnet, net, currentFrame);
@@ -281,188 +264,35 @@ void Clips::ArtnetClipModel::loadArtnetInfo(const QString& path) {
 
     avformat_close_input(&formatContext);
 
+    // 在解码线程中建立帧索引并开始预解码/写缓存
+    ensureVideoOpened(path);
 }
 
 /**
- * 函数级注释：确保视频已打开并初始化 FFmpeg 解码器（FFmpeg 7.1）
- * - 校验尺寸：宽度=512，height>=1
- * - 设定 m_universeCount = m_videoHeight
- * - 仅当尚未打开或路径改变时执行
+ * 函数级注释：确保解码器打开该文件（异步，仅路径改变时执行）
  */
 void Clips::ArtnetClipModel::ensureVideoOpened(const QString& path) {
-    if (m_openedPath == path && m_formatContext) {
-        return;
-    }
-
-    // 清理旧资源
-    if (m_frame) { av_frame_free(&m_frame); m_frame = nullptr; }
-    if (m_packet) { av_packet_free(&m_packet); m_packet = nullptr; }
-    if (m_codecContext) { avcodec_free_context(&m_codecContext); m_codecContext = nullptr; }
-    if (m_formatContext) { avformat_close_input(&m_formatContext); m_formatContext = nullptr; }
-
-    // 打开输入
-    if (avformat_open_input(&m_formatContext, path.toUtf8().constData(), nullptr, nullptr) < 0) {
-        return;
-    }
-    if (avformat_find_stream_info(m_formatContext, nullptr) < 0) {
-        avformat_close_input(&m_formatContext);
-        m_formatContext = nullptr;
-        return;
-    }
-
-    // 查找视频流
-    m_videoStreamIndex = -1;
-    for (unsigned int i = 0; i < m_formatContext->nb_streams; i++) {
-        if (m_formatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-            m_videoStreamIndex = static_cast<int>(i);
-            break;
-        }
-    }
-    if (m_videoStreamIndex == -1) {
-        return;
-    }
-
-    // 编解码器参数
-    AVCodecParameters* codecpar = m_formatContext->streams[m_videoStreamIndex]->codecpar;
-    m_videoWidth = codecpar->width;
-    m_videoHeight = codecpar->height;
-
-    if (m_videoWidth != 512 || m_videoHeight < 1) {
-        // 尺寸不合法
-        return;
-    }
-
-    // 查找并打开解码器（FFV1）
-    m_codec = avcodec_find_decoder(codecpar->codec_id);
-    if (!m_codec || m_codec->id != AV_CODEC_ID_FFV1) {
-        return;
-    }
-
-    m_codecContext = avcodec_alloc_context3(m_codec);
-    if (!m_codecContext) {
-        return;
-    }
-    if (avcodec_parameters_to_context(m_codecContext, codecpar) < 0) {
-        avcodec_free_context(&m_codecContext);
-        m_codecContext = nullptr;
+    if (m_openedPath == path) {
         return;
     }
-    if (avcodec_open2(m_codecContext, m_codec, nullptr) < 0) {
-        avcodec_free_context(&m_codecContext);
-        m_codecContext = nullptr;
-        return;
-    }
-
-    // 分配帧与包
-    m_frame = av_frame_alloc();
-    m_packet = av_packet_alloc();
-    if (!m_frame || !m_packet) {
-        if (m_frame) av_frame_free(&m_frame);
-        if (m_packet) av_packet_free(&m_packet);
-        avcodec_free_context(&m_codecContext);
-        m_codecContext = nullptr;
-        avformat_close_input(&m_formatContext);
-        m_formatContext = nullptr;
-        return;
-    }
-
-    // 基本信息
-    AVStream* videoStream = m_formatContext->streams[m_videoStreamIndex];
-    m_timeBase = av_q2d(videoStream->time_base);
-    m_fps = av_q2d(videoStream->r_frame_rate);
-    m_duration = m_formatContext->duration / (double)AV_TIME_BASE;
-
-    // Universe 数量与缓冲初始化
-    m_universeCount = m_videoHeight;
-    m_dmxDataList.clear();
-    for (int i = 0; i < m_universeCount; ++i) {
-        QByteArray universeData;
-        universeData.resize(512);
-        universeData.fill(char(0x00));
-        m_dmxDataList.append(universeData);
-    }
-
-    m_lastFrameIndex = -1;
     m_openedPath = path;
+    m_decoder->open(path);
 }
 
 /**
- * 函数级注释：按 timeline 的 currentFrame 定位并解码一帧
- * - timeline 帧号 -> 秒 = (frame - start) / timelineFps
- * - 秒 -> 流时间戳单位 = 秒 / time_base
- * - av_seek_frame + avcodec_flush_buffers 再读取解码
+ * 函数级注释：读取一帧 DMX 到 m_dmxBlock
+ * - Universe 数量变化时重新分配数据块，否则原地写入
  */
-bool Clips::ArtnetClipModel::readFrameAt(int currentFrame) {
-    if (!m_formatContext || !m_codecContext) {
+bool Clips::ArtnetClipModel::readDmxFrame(int frameIndex) {
+    if (frameIndex < 0) {
         return false;
     }
-
-    double timelineFps = timecode_frames_per_sec(getTimeCodeType());
-    int relFrame = currentFrame - start();
-    if (relFrame < 0) relFrame = 0;
-    double seconds = relFrame / timelineFps;
-    int64_t targetTs = static_cast<int64_t>(seconds / m_timeBase);
-
-    // 定位到目标时间戳
-    if (av_seek_frame(m_formatContext, m_videoStreamIndex, targetTs, AVSEEK_FLAG_BACKWARD) < 0) {
-        return false;
-    }
-    avcodec_flush_buffers(m_codecContext);
-
-    // 解码第一帧
-    while (av_read_frame(m_formatContext, m_packet) >= 0) {
-        if (m_packet->stream_index == m_videoStreamIndex) {
-            if (avcodec_send_packet(m_codecContext, m_packet) < 0) {
-                av_packet_unref(m_packet);
-                continue;
-            }
-            int ret = avcodec_receive_frame(m_codecContext, m_frame);
-            av_packet_unref(m_packet);
-            if (ret == 0) {
-                m_lastFrameIndex = currentFrame;
-                return true;
-            } else if (ret == AVERROR(EAGAIN)) {
-                continue;
-            } else {
-                return false;
-            }
-        }
-        av_packet_unref(m_packet);
-    }
-    return false;
-}
-
-/**
- * 函数级注释：从当前解码帧提取每个 Universe 的 512 字节 DMX 数据
- * - 灰度：直接读取每列像素值
- * - 非灰度（兼容旧 RGBA）：取 R 通道
- */
-void Clips::ArtnetClipModel::extractDMXFromCurrentFrame() {
-    if (!m_frame || !m_frame->data[0]) {
-        return;
-    }
-    int channelsPerUniverse = 512;
-    int usableWidth = qMin(m_videoWidth, channelsPerUniverse);
-
-    for (int universe = 0; universe < m_universeCount; ++universe) {
-        QByteArray dmxData;
-        dmxData.resize(channelsPerUniverse);
-        dmxData.fill(char(0x00));
-
-        const uint8_t* rowData = m_frame->data[0] + universe * m_frame->linesize[0];
-
-        if (m_frame->format == AV_PIX_FMT_GRAY8) {
-            for (int col = 0; col < usableWidth; ++col) {
-                dmxData[col] = char(rowData[col]);
-            }
-        } else {
-            for (int col = 0; col < usableWidth; ++col) {
-                const uint8_t* pixelData = rowData + col * 4; // RGBA 步长 4
-                dmxData[col] = char(pixelData[0]);            // 取 R 通道
-            }
-        }
-        m_dmxDataList[universe] = dmxData;
+    const int universeCount = m_decoder->universeCount();
+    if (universeCount != m_universeCount || m_dmxBlock.size() != universeCount * 512) {
+        m_universeCount = universeCount;
+        m_dmxBlock = QByteArray(universeCount * 512, char(0x00));
     }
+    return m_decoder->readFrame(frameIndex, m_dmxBlock.data());
 }
 
 
@@ -489,7 +319,8 @@ void Clips::ArtnetClipModel::sendArtnetFrames(int baseUniverse, int subnet, int
         frame.sequence = 0;
         frame.timestamp = QDateTime::currentMSecsSinceEpoch();
         frame.universe = static_cast<quint16>(fullUniverse);
-        frame.setDmxData(m_dmxDataList[universeIndex]);
+        // 引用数据块中的本宇宙数据，不复制（enqueueFrame 内同步拷入发送槽位）
+        frame.setDmxData(QByteArray::fromRawData(m_dmxBlock.constData() + universeIndex * 512, 512));
 
         m_artnetTransmitter->enqueueFrame(frame);
     }
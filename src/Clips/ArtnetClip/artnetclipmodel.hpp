@@ -16,6 +16,7 @@
 #include "../../Common/Devices/ClientController/SocketTransmitter.h"
 #include "ArtnetSender/ArtnetTransmitter.h"
 #include "Elements/SelectorComboBox/SelectorComboBox.hpp"
+#include "artnetclipdecoder.hpp"
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -50,9 +51,10 @@ namespace Clips
         /**
          * 函数级注释：在 timeline 上按帧回放 DMX 数据
          * - 当 currentFrame 处于剪辑区间内时：
-         *   1) 打开并定位到对应视频帧（基于 timeline 帧率与 FFmpeg time_base）
-         *   2) 提取每一行（universe）的 512 字节 DMX 数据到 m_dmxDataList
-         *   3) 构建与 UniversePlaybackDataModel 对齐的 artnetPacket 列表返回
+         *   1) 由 timeline 帧率与 PTS 索引换算视频帧号
+         *   2) 从磁盘缓存或预解码环形缓冲拷贝该帧 DMX 到连续数据块 m_dmxBlock（不在时钟线程解码；未就绪时本帧不输出）
+         *   3) 返回 "dmxBlock"（N×512 字节，隐式共享不复制）、"startUniverse" 与 "universeCount"，
+         *      需要单宇宙数据时以 DmxUniverseData(universe, block, index * 512) 视图引用
          *   4) 同步通过 m_artnetTransmitter 将每个 Universe 的帧入队广播
          * - 在剪辑开始帧返回 "/file"，结束前一帧返回 "/stop" 以保持与其他 Clip 一致的习惯
          */
@@ -81,32 +83,21 @@ namespace Clips
 
         /**
          * 函数级注释：读取媒体文件基本信息并据此设置剪辑长度
-         * 仅用于设定剪辑时长，不进行数据解码；真正的解码在 currentData 内完成
+         * 仅用于设定剪辑时长，不进行数据解码；随后交由 m_decoder 在后台建立索引并预解码
          */
         void loadArtnetInfo(const QString& path) ;
 
         /**
-         * 函数级注释：确保视频已打开并初始化 FFmpeg 解码器（FFmpeg 7.1）
-         * - 校验尺寸：宽度=512，height>=1
-         * - 设定 m_universeCount = m_videoHeight
-         * - 仅当尚未打开或路径改变时执行
+         * 函数级注释：确保解码器打开该文件（异步，仅路径改变时执行）
+         * - 解码线程建立 PTS/关键帧索引，命中磁盘缓存时直接映射缓存
          */
         void ensureVideoOpened(const QString& path) ;
 
         /**
-         * 函数级注释：按 timeline 的 currentFrame 定位并解码一帧
-         * - timeline 帧号 -> 秒 = (frame - start) / timelineFps
-         * - 秒 -> 流时间戳单位 = 秒 / time_base
-         * - av_seek_frame + avcodec_flush_buffers 再读取解码
+         * 函数级注释：读取一帧 DMX 到 m_dmxBlock（Universe 数量变化时重新分配）
+         * @return 帧尚未解码或缓存就绪时返回 false
          */
-        bool readFrameAt(int currentFrame) ;
-
-        /**
-         * 函数级注释：从当前解码帧提取每个 Universe 的 512 字节 DMX 数据
-         * - 灰度：直接读取每列像素值
-         * - 非灰度（兼容旧 RGBA）：取 R 通道
-         */
-        void extractDMXFromCurrentFrame() ;
+        bool readDmxFrame(int frameIndex) ;
         /**
          * 函数级注释：将当前帧的每个 Universe 的 512 字节 DMX 数据封装为 ArtnetFrame 并入队发送
          * - 参考 ArtnetOutDataModel 的发送逻辑
@@ -132,17 +123,7 @@ namespace Clips
         void afterModelReady() override;
 
     private:
-        AVFormatContext* m_formatContext {nullptr};
-        AVCodecContext* m_codecContext {nullptr};
-        const AVCodec* m_codec {nullptr};
-        AVFrame* m_frame {nullptr};
-        AVPacket* m_packet {nullptr};
-        int m_videoStreamIndex {-1};
-        int m_videoWidth {0};
-        int m_videoHeight {0};
-        double m_timeBase {0.0};
-        double m_fps {25.0};
-        double m_duration {0.0};
+        ArtnetClipDecoder* m_decoder {nullptr}; // 后台解码（索引/预解码/磁盘缓存）
 
         QString m_filePath;
         QString m_openedPath;              // 已打开的真实路径（避免重复打开）
@@ -150,10 +131,9 @@ namespace Clips
         SelectorComboBox* mediaSelector;
         QSpinBox* m_startUniverse {nullptr};
         QLineEdit* targetHostEdit = new QLineEdit();   
-        int m_lastFrameIndex {-1};
         int m_universeCount {0};
         QLabel* videoInfoLabel;
-        QList<QByteArray> m_dmxDataList;
+        QByteArray m_dmxBlock;             // 当前帧全部 Universe 的 DMX 数据（m_universeCount × 512 字节连续）
 
         bool m_canNotify = false;
         ArtnetTransmitter* m_artnetTransmitter;  // ArtnetTransmitter单例
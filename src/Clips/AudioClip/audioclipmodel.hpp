@@ -65,11 +65,11 @@ namespace Clips
         }
 
         void setStart(int start) override  {
-            AbstractClipModel::setStart(start);
+            AbstractClipDelegateModel::setStart(start);
             QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
         }
         void setEnd(int end) override  {
-            AbstractClipModel::setEnd(end);
+            AbstractClipDelegateModel::setEnd(end);
             QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
         }
         // 其他 getter/setter 保持不变
@@ -72,13 +72,13 @@ namespace Clips
         }
 
         void setStart(int start) override  {
-            AbstractClipModel::setStart(start);
+            AbstractClipDelegateModel::setStart(start);
             if (m_canNotify) {
                 QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
             }
         }
         void setEnd(int end) override  {
-            AbstractClipModel::setEnd(end);
+            AbstractClipDelegateModel::setEnd(end);
             if (m_canNotify) {
                 QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
             }
@@ -90,7 +90,7 @@ namespace Clips
          * - 若允许通知，则异步排队 onPropertyChanged，避免构造阶段阻塞或崩溃
          */
         void setStart(int start) override  {
-            AbstractClipModel::setStart(start);
+            AbstractClipDelegateModel::setStart(start);
             if (m_canNotify) {
                 QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
             }
@@ -102,7 +102,7 @@ namespace Clips
          * - 若允许通知，则异步排队 onPropertyChanged，避免构造阶段阻塞或崩溃
          */
         void setEnd(int end) override  {
-            AbstractClipModel::setEnd(end);
+            AbstractClipDelegateModel::setEnd(end);
             if (m_canNotify) {
                 QMetaObject::invokeMethod(this, "onPropertyChanged", Qt::QueuedConnection);
             }
@@ -65,6 +65,12 @@ ConfigManager::ConfigManager()
     , m_mqttControlTopic(AppConfigs::MQTT_CONTROL_TOPIC)
     , m_mqttFeedbackTopic(AppConfigs::MQTT_FEEDBACK_TOPIC)
     , m_webAccessPassword(AppConfigs::WEB_ACCESS_PASSWORD)
+    , m_audioSampleRate(AppConfigs::AUDIO_SAMPLE_RATE)
+    , m_audioBlockSize(AppConfigs::AUDIO_BLOCK_SIZE)
+    , m_audioDeviceDrivenClock(AppConfigs::AUDIO_DEVICE_DRIVEN_CLOCK)
+    , m_artnetRefreshRate(AppConfigs::ARTNET_REFRESH_RATE)
+    , m_dataflowSchedulerEnabled(AppConfigs::DATAFLOW_SCHEDULER_ENABLED)
+    , m_dataflowTickRate(AppConfigs::DATAFLOW_TICK_RATE)
     , m_defaultDarkTheme(AppConfigs::DEFAULT_DARK_THEME)
     , m_MaxLogEntries(AppConfigs::MAX_LOG_ENTRIES)
 {
@@ -94,6 +100,12 @@ QString ConfigManager::getMqttPassword() const { return m_mqttPassword; }
 QString ConfigManager::getMqttControlTopic() const { return m_mqttControlTopic; }
 QString ConfigManager::getMqttFeedbackTopic() const { return m_mqttFeedbackTopic; }
 QString ConfigManager::getWebAccessPassword() const { return m_webAccessPassword; }
+int ConfigManager::getAudioSampleRate() const { return m_audioSampleRate; }
+int ConfigManager::getAudioBlockSize() const { return m_audioBlockSize; }
+bool ConfigManager::isAudioDeviceDrivenClock() const { return m_audioDeviceDrivenClock; }
+double ConfigManager::getArtnetRefreshRate() const { return m_artnetRefreshRate; }
+bool ConfigManager::isDataflowSchedulerEnabled() const { return m_dataflowSchedulerEnabled; }
+double ConfigManager::getDataflowTickRate() const { return m_dataflowTickRate; }
 
 void ConfigManager::addRecentFile(const QString& path)
 {
@@ -136,6 +148,16 @@ void ConfigManager::loadConfig()
     m_mqttControlTopic = settings.value("Network/MqttControlTopic", AppConfigs::MQTT_CONTROL_TOPIC).toString();
     m_mqttFeedbackTopic = settings.value("Network/MqttFeedbackTopic", AppConfigs::MQTT_FEEDBACK_TOPIC).toString();
     m_webAccessPassword = settings.value("Network/WebAccessPassword", AppConfigs::WEB_ACCESS_PASSWORD).toString();
+    // Audio
+    m_audioSampleRate = settings.value("Audio/SampleRate", AppConfigs::AUDIO_SAMPLE_RATE).toInt();
+    m_audioBlockSize = settings.value("Audio/BlockSize", AppConfigs::AUDIO_BLOCK_SIZE).toInt();
+    m_audioDeviceDrivenClock = settings.value("Audio/DeviceDrivenClock", AppConfigs::AUDIO_DEVICE_DRIVEN_CLOCK).toBool();
+
+    // Art-Net
+    m_artnetRefreshRate = settings.value("Artnet/RefreshRate", AppConfigs::ARTNET_REFRESH_RATE).toDouble();
+    // Dataflow
+    m_dataflowSchedulerEnabled = settings.value("Dataflow/SchedulerEnabled", AppConfigs::DATAFLOW_SCHEDULER_ENABLED).toBool();
+    m_dataflowTickRate = settings.value("Dataflow/TickRate", AppConfigs::DATAFLOW_TICK_RATE).toDouble();
     // Log
     m_MaxLogEntries = settings.value("Log/MaxLogEntries", AppConfigs::MAX_LOG_ENTRIES).toInt();
 }
@@ -170,6 +192,16 @@ void ConfigManager::saveConfig()
     settings.setValue("Network/MqttControlTopic", m_mqttControlTopic);
     settings.setValue("Network/MqttFeedbackTopic", m_mqttFeedbackTopic);
     settings.setValue("Network/WebAccessPassword", m_webAccessPassword);
+    // Audio
+    settings.setValue("Audio/SampleRate", m_audioSampleRate);
+    settings.setValue("Audio/BlockSize", m_audioBlockSize);
+    settings.setValue("Audio/DeviceDrivenClock", m_audioDeviceDrivenClock);
+
+    // Art-Net
+    settings.setValue("Artnet/RefreshRate", m_artnetRefreshRate);
+    // Dataflow
+    settings.setValue("Dataflow/SchedulerEnabled", m_dataflowSchedulerEnabled);
+    settings.setValue("Dataflow/TickRate", m_dataflowTickRate);
     // Log
     settings.setValue("Log/MaxLogEntries", m_MaxLogEntries);
 
@@ -195,6 +227,12 @@ void ConfigManager::updateConfig(const QJsonObject& newConfig)
     if (newConfig.contains("MqttControlTopic")) m_mqttControlTopic = newConfig["MqttControlTopic"].toString();
     if (newConfig.contains("MqttFeedbackTopic")) m_mqttFeedbackTopic = newConfig["MqttFeedbackTopic"].toString();
     if (newConfig.contains("WebAccessPassword")) m_webAccessPassword = newConfig["WebAccessPassword"].toString();
+    if (newConfig.contains("AudioSampleRate")) m_audioSampleRate = newConfig["AudioSampleRate"].toInt();
+    if (newConfig.contains("AudioBlockSize")) m_audioBlockSize = newConfig["AudioBlockSize"].toInt();
+    if (newConfig.contains("AudioDeviceDrivenClock")) m_audioDeviceDrivenClock = newConfig["AudioDeviceDrivenClock"].toBool();
+    if (newConfig.contains("ArtnetRefreshRate")) m_artnetRefreshRate = newConfig["ArtnetRefreshRate"].toDouble();
+    if (newConfig.contains("DataflowSchedulerEnabled")) m_dataflowSchedulerEnabled = newConfig["DataflowSchedulerEnabled"].toBool();
+    if (newConfig.contains("DataflowTickRate")) m_dataflowTickRate = newConfig["DataflowTickRate"].toDouble();
 
     saveConfig();
 }
@@ -41,6 +41,12 @@ public:
     QString getMqttControlTopic() const;
     QString getMqttFeedbackTopic() const;
     QString getWebAccessPassword() const;
+    int getAudioSampleRate() const;
+    int getAudioBlockSize() const;
+    bool isAudioDeviceDrivenClock() const;
+    double getArtnetRefreshRate() const;
+    bool isDataflowSchedulerEnabled() const;
+    double getDataflowTickRate() const;
     /**
      * 函数级注释：将新路径加入最近文件列表
      * - 规则：去重后插入到首位；保留最多 MaxRecentFiles 个
@@ -83,6 +89,12 @@ private:
     QString m_mqttControlTopic;
     QString m_mqttFeedbackTopic;
     QString m_webAccessPassword;
+    int m_audioSampleRate;
+    int m_audioBlockSize;
+    bool m_audioDeviceDrivenClock;
+    double m_artnetRefreshRate;
+    bool m_dataflowSchedulerEnabled;
+    double m_dataflowTickRate;
     bool m_defaultDarkTheme;
     int m_MaxLogEntries;
     QStringList m_recentFiles;
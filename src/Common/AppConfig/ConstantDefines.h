@@ -20,6 +20,10 @@ namespace AppConstants {
     const QString LOGS_STORAGE_DIR = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)+"/Flow/Logs";
     // 媒体库存储目录
     const QString MEDIA_LIBRARY_STORAGE_DIR = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)+"/Flow/Medias";
+    // DMX 视频解码缓存目录（ArtnetClip 预解码的原始 DMX 帧）
+    const QString DMX_CACHE_STORAGE_DIR = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)+"/Flow/Cache/Dmx";
+    // 媒体库元数据索引与缩略图缓存目录
+    const QString MEDIA_INDEX_CACHE_DIR = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)+"/Flow/Cache/Media";
     // FLOW文件存储目录
     const QString MEDIA_LIBRARY_FLOW_DIR = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)+"/Flow/Flows";
     // 最近打开文件存储路径
@@ -45,6 +49,8 @@ namespace AppConfigs {
     constexpr const char* OSC_INTERNAL_CONTROL_HOST = "127.0.0.1";
     // OSC外部反馈端口号,即使用这个端口向外发送数据
     constexpr int EXTRA_FEEDBACK_PORT = 8990;
+    // OSC外部反馈发送间隔（毫秒），同一地址的状态在间隔内只发送最新值
+    constexpr int EXTRA_FEEDBACK_INTERVAL_MS = 33;
     // OSC外部控制端口号,即使用这个端口向内接收数据
     constexpr int EXTRA_CONTROL_PORT = 8991;
     // HTTP&WebSocket 服务器端口号
@@ -65,5 +71,17 @@ namespace AppConfigs {
     constexpr const char* MQTT_CONTROL_TOPIC = "flow/control";
     // MQTT 反馈主题（发布，向外推送状态）
     constexpr const char* MQTT_FEEDBACK_TOPIC = "flow/feedback";
+    // 全局音频时钟采样率
+    constexpr int AUDIO_SAMPLE_RATE = 48000;
+    // 全局音频时钟块大小（每个时间戳对应的采样数）
+    constexpr int AUDIO_BLOCK_SIZE = 2048;
+    // 全局音频时钟是否由音频设备回调驱动（否则由内部高精度计时线程驱动）
+    constexpr bool AUDIO_DEVICE_DRIVEN_CLOCK = false;
+    // Art-Net 每个宇宙的刷新率（Hz），上限为 DMX512 的 44Hz
+    constexpr double ARTNET_REFRESH_RATE = 44.0;
+    // 数据流图是否启用批量调度（按拓扑序合并传播），否则每次输出立即同步下发
+    constexpr bool DATAFLOW_SCHEDULER_ENABLED = false;
+    // 数据流批量调度的最大刷新率（Hz）
+    constexpr double DATAFLOW_TICK_RATE = 60.0;
 
 }
\ No newline at end of file
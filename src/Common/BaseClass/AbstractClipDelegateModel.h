@@ -23,6 +23,20 @@ public:
 
     ~AbstractClipDelegateModel() override;
 
+    /**
+     * 函数级注释：设置起止帧后发出 timingChanged，供时间轴剪辑索引失效重建
+     * - 派生类重写时应调用本类实现而非 AbstractClipModel 的实现
+     */
+    void setStart(int start) override {
+        AbstractClipModel::setStart(start);
+        Q_EMIT timingChanged();
+    }
+
+    void setEnd(int end) override {
+        AbstractClipModel::setEnd(end);
+        Q_EMIT timingChanged();
+    }
+
     void setId(ClipId id) override {
         // 函数级注释：设置剪辑 ID 后触发一次统一的控件注册与状态推送
         AbstractClipModel::setId(id);
@@ -99,6 +113,12 @@ public:
         afterModelReady();
     }
 
+Q_SIGNALS:
+    /**
+     * 函数级注释：起止帧变化
+     */
+    void timingChanged();
+
 protected:
     /**
      * 函数级注释：剪辑模型初始化完成后的扩展点（ClipId 与别名已就绪）
@@ -28,6 +28,19 @@ using QtNodes::ConnectionPolicy;
 class AbstractDelegateModel : public QtNodes::NodeDelegateModel {
     Q_OBJECT
 public:
+    /**
+     * 函数级注释：节点执行特性（数据流调度器据此决定 setInData 的执行线程）
+     * - MainThreadOnly：默认，访问界面或非线程安全状态，固定在主线程执行
+     * - ThreadSafe：setInData/outData 可在工作线程执行（不直接操作控件）
+     * - ComputeHeavy：计算量大，即使没有可并行的兄弟节点也值得投递到线程池（需同时声明 ThreadSafe）
+     */
+    enum ExecutionFlag {
+        MainThreadOnly = 0x0,
+        ThreadSafe = 0x1,
+        ComputeHeavy = 0x2
+    };
+    Q_DECLARE_FLAGS(ExecutionFlags, ExecutionFlag)
+
     /**
      * 函数级注释：构造函数，保持与 NodeDelegateModel 一致的初始化行为
      */
@@ -50,6 +63,10 @@ public:
      * 函数级注释：状态反馈，默认写入到 StatusContainer（地址为完整 /dataflow/...）
      */
     virtual void stateFeedBack(const QString& oscAddress, QVariant value);
+    /**
+     * 函数级注释：节点执行特性，派生类按需重写
+     */
+    virtual ExecutionFlags executionFlags() const { return MainThreadOnly; }
 
 protected:
     /**
@@ -95,3 +112,5 @@ private:
     bool _ready = false;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(AbstractDelegateModel::ExecutionFlags)
+
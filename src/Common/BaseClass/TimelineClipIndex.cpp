@@ -0,0 +1,155 @@
+//
+// Created by WuBin on 2025/9/2.
+//
+
+#include "TimelineClipIndex.h"
+#include <algorithm>
+
+TimelineClipIndex::TimelineClipIndex(QObject* parent)
+    : QObject(parent) {}
+
+TimelineClipIndex::~TimelineClipIndex() = default;
+
+void TimelineClipIndex::invalidate() {
+    m_valid = false;
+}
+
+/**
+ * 函数级注释：重建索引
+ * - 起止帧无效（end < start）的剪辑只进入 ClipId 哈希，不参与帧查询
+ * - 监听剪辑销毁与起止帧变化（AbstractClipDelegateModel::timingChanged），变化后索引失效
+ */
+void TimelineClipIndex::rebuild(const QList<AbstractClipModel*>& clips) {
+    for (const QMetaObject::Connection& connection : m_connections) {
+        disconnect(connection);
+    }
+    m_connections.clear();
+
+    m_entries.clear();
+    m_entries.reserve(clips.size());
+    m_byId.clear();
+    m_byId.reserve(clips.size());
+
+    for (int i = 0; i < clips.size(); ++i) {
+        AbstractClipModel* clip = clips[i];
+        if (!clip) {
+            continue;
+        }
+        m_byId.insert(clip->id(), clip);
+        if (clip->end() >= clip->start()) {
+            m_entries.push_back({clip->start(), clip->end(), i, clip});
+        }
+
+        m_connections.append(connect(clip, &QObject::destroyed, this, &TimelineClipIndex::invalidate));
+        if (clip->metaObject()->indexOfSignal("timingChanged()") >= 0) {
+            m_connections.append(connect(clip, SIGNAL(timingChanged()), this, SLOT(invalidate())));
+        }
+    }
+
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.start < b.start; });
+
+    m_maxEnd.assign(m_entries.empty() ? 0 : m_entries.size() * 4, 0);
+    if (!m_entries.empty()) {
+        buildTree(1, 0, int(m_entries.size()));
+    }
+
+    m_active.clear();
+    m_result.clear();
+    m_nextStart = 0;
+    m_frame = -1;
+    m_clipCount = clips.size();
+    m_valid = true;
+}
+
+void TimelineClipIndex::buildTree(int node, int lo, int hi) {
+    if (hi - lo == 1) {
+        m_maxEnd[node] = m_entries[lo].end;
+        return;
+    }
+    const int mid = (lo + hi) / 2;
+    buildTree(node * 2, lo, mid);
+    buildTree(node * 2 + 1, mid, hi);
+    m_maxEnd[node] = std::max(m_maxEnd[node * 2], m_maxEnd[node * 2 + 1]);
+}
+
+/**
+ * 函数级注释：在 [lo, hi) ∩ [0, limit) 中收集 end >= frame 的条目
+ * - 子树最大 end 小于 frame 时整棵剪枝，只访问活动剪辑所在路径
+ */
+void TimelineClipIndex::collect(int node, int lo, int hi, int limit, qint64 frame) {
+    if (lo >= limit || m_maxEnd[node] < frame) {
+        return;
+    }
+    if (hi - lo == 1) {
+        m_active.push_back(lo);
+        return;
+    }
+    const int mid = (lo + hi) / 2;
+    collect(node * 2, lo, mid, limit, frame);
+    collect(node * 2 + 1, mid, hi, limit, frame);
+}
+
+/**
+ * 函数级注释：跳转定位（非连续帧）
+ */
+void TimelineClipIndex::seek(qint64 frame) {
+    m_active.clear();
+    m_nextStart = std::upper_bound(m_entries.begin(), m_entries.end(), frame,
+                                   [](qint64 value, const Entry& entry) { return value < entry.start; })
+                  - m_entries.begin();
+    if (m_nextStart > 0) {
+        collect(1, 0, int(m_entries.size()), int(m_nextStart), frame);
+    }
+    std::sort(m_active.begin(), m_active.end(),
+              [this](int a, int b) { return m_entries[a].order < m_entries[b].order; });
+}
+
+void TimelineClipIndex::updateResult() {
+    m_result.clear();
+    m_result.reserve(int(m_active.size()));
+    for (int index : m_active) {
+        m_result.append(m_entries[index].clip);
+    }
+}
+
+/**
+ * 函数级注释：获取活动剪辑
+ * - 同帧：直接返回缓存
+ * - 下一帧：移除 end 已过的剪辑，追加 start 恰为该帧的剪辑
+ * - 其他（跳转、倒退、丢帧）：按区间索引重新定位
+ */
+const QList<AbstractClipModel*>& TimelineClipIndex::activeClips(qint64 frame) {
+    if (frame == m_frame) {
+        return m_result;
+    }
+
+    if (m_frame >= 0 && frame == m_frame + 1) {
+        const auto expired = std::remove_if(m_active.begin(), m_active.end(),
+                                            [this, frame](int index) { return m_entries[index].end < frame; });
+        bool changed = expired != m_active.end();
+        m_active.erase(expired, m_active.end());
+
+        bool entered = false;
+        while (m_nextStart < m_entries.size() && m_entries[m_nextStart].start <= frame) {
+            if (m_entries[m_nextStart].end >= frame) {
+                m_active.push_back(int(m_nextStart));
+                entered = true;
+            }
+            ++m_nextStart;
+        }
+        if (entered) {
+            std::sort(m_active.begin(), m_active.end(),
+                      [this](int a, int b) { return m_entries[a].order < m_entries[b].order; });
+        }
+        if (changed || entered) {
+            updateResult();
+        }
+    } else {
+        seek(frame);
+        updateResult();
+    }
+
+    m_frame = frame;
+    return m_result;
+}
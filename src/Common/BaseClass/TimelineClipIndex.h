@@ -0,0 +1,81 @@
+//
+// Created by WuBin on 2025/9/2.
+//
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <vector>
+#include "AbstractClipModel.hpp"
+#include "TimeLineDefines.h"
+
+/**
+ * @brief 时间轴剪辑索引（区间索引 + ClipId 哈希）
+ * - 剪辑按起始帧排序，并以“最大结束帧”线段树索引，定位任意帧的活动剪辑为 O(log n + k)
+ * - 连续播放（帧号 +1）时增量维护活动集：只处理进入与离开的剪辑，不再遍历全部轨道
+ * - ClipId → 剪辑指针哈希，clipData/setClipData 查找为 O(1)
+ * - 索引惰性重建：时间轴结构变化、剪辑起止帧变化或剪辑销毁时失效，下次查询时重建
+ * - 区间为闭区间 [start, end]，与原逐剪辑判断一致；结果按轨道顺序、轨道内剪辑顺序排列
+ */
+class TimelineClipIndex : public QObject {
+    Q_OBJECT
+public:
+    explicit TimelineClipIndex(QObject* parent = nullptr);
+    ~TimelineClipIndex() override;
+
+    /**
+     * @brief 索引是否可用
+     * @param clipCount 当前全部轨道的剪辑总数（结构变化的兜底校验）
+     */
+    bool isValid(int clipCount) const { return m_valid && clipCount == m_clipCount; }
+
+    /**
+     * @brief 由全部剪辑重建索引
+     * @param clips 按轨道顺序、轨道内剪辑顺序排列的剪辑
+     */
+    void rebuild(const QList<AbstractClipModel*>& clips);
+
+    /**
+     * @brief 获取在该帧处于活动区间的剪辑
+     * - 与上次查询同帧或相邻下一帧时增量更新，否则按区间索引重新定位
+     * @return 引用内部缓存，下次查询或重建前有效
+     */
+    const QList<AbstractClipModel*>& activeClips(qint64 frame);
+
+    /**
+     * @brief 按 ClipId 查找剪辑，不存在返回 nullptr
+     */
+    AbstractClipModel* clip(ClipId clipId) const { return m_byId.value(clipId, nullptr); }
+
+public slots:
+    /**
+     * @brief 标记索引失效（下次查询时重建）
+     */
+    void invalidate();
+
+private:
+    struct Entry {
+        qint64 start;
+        qint64 end;
+        int order;                  // 在 rebuild 输入中的序号，用于保持轨道顺序
+        AbstractClipModel* clip;
+    };
+
+    void buildTree(int node, int lo, int hi);
+    void collect(int node, int lo, int hi, int limit, qint64 frame);
+    void seek(qint64 frame);
+    void updateResult();
+
+    std::vector<Entry> m_entries;               // 按 start 排序
+    std::vector<qint64> m_maxEnd;               // 线段树：区间内最大 end
+    QHash<ClipId, AbstractClipModel*> m_byId;
+    std::vector<int> m_active;                  // 活动剪辑在 m_entries 中的下标（按 order 排序）
+    QList<AbstractClipModel*> m_result;
+    size_t m_nextStart = 0;                     // 首个 start 大于当前帧的条目
+    qint64 m_frame = -1;                        // 活动集对应的帧
+    int m_clipCount = 0;
+    bool m_valid = false;
+    QList<QMetaObject::Connection> m_connections; // 剪辑销毁/起止帧变化 → 失效
+};
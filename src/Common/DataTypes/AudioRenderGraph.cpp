@@ -0,0 +1,155 @@
+//
+// Created by WuBin on 2025/8/29.
+//
+
+#include "AudioRenderGraph.h"
+#include <QDebug>
+#include <algorithm>
+
+AudioRenderGraph& AudioRenderGraph::instance() {
+    static AudioRenderGraph graph;
+    return graph;
+}
+
+/**
+ * 函数级注释：登记或更新处理器
+ * - 已登记的处理器只替换输入/输出队列，保持原登记顺序
+ * - 任一变化都会重新计算拓扑序
+ */
+void AudioRenderGraph::updateProcessor(AudioRenderProcessor* processor,
+                                       const std::vector<const AudioTimestampRingQueue*>& inputs,
+                                       const std::vector<const AudioTimestampRingQueue*>& outputs) {
+    if (!processor) {
+        return;
+    }
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto it = std::find_if(nodes_.begin(), nodes_.end(),
+                           [processor](const Node& node) { return node.processor == processor; });
+    if (it == nodes_.end()) {
+        nodes_.push_back(Node{processor, inputs, outputs});
+    } else {
+        it->inputs = inputs;
+        it->outputs = outputs;
+    }
+    rebuildOrderLocked();
+}
+
+void AudioRenderGraph::removeProcessor(AudioRenderProcessor* processor) {
+    std::lock_guard<std::mutex> locker(mutex_);
+    nodes_.erase(std::remove_if(nodes_.begin(), nodes_.end(),
+                                [processor](const Node& node) { return node.processor == processor; }),
+                 nodes_.end());
+    rebuildOrderLocked();
+}
+
+bool AudioRenderGraph::attachDriver(const void* owner) {
+    const void* expected = nullptr;
+    if (driver_.compare_exchange_strong(expected, owner, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> locker(mutex_);
+        lastRenderedTimestamp_ = -1;
+        lastClockTimestamp_ = -1;
+        return true;
+    }
+    return expected == owner;
+}
+
+void AudioRenderGraph::detachDriver(const void* owner) {
+    const void* expected = owner;
+    driver_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+/**
+ * 函数级注释：按输入/输出队列推导依赖并做 Kahn 拓扑排序
+ * - 处理器 A 的某个输出队列出现在处理器 B 的输入中，则 A 先于 B
+ * - 同层按登记顺序排列；存在环时剩余处理器按登记顺序追加并告警
+ */
+void AudioRenderGraph::rebuildOrderLocked() {
+    const size_t count = nodes_.size();
+    std::vector<std::vector<size_t>> downstream(count);
+    std::vector<int> indegree(count, 0);
+
+    for (size_t from = 0; from < count; ++from) {
+        for (size_t to = 0; to < count; ++to) {
+            if (from == to) {
+                continue;
+            }
+            const auto& outputs = nodes_[from].outputs;
+            const auto& inputs = nodes_[to].inputs;
+            const bool linked = std::any_of(outputs.begin(), outputs.end(), [&inputs](const AudioTimestampRingQueue* queue) {
+                return queue && std::find(inputs.begin(), inputs.end(), queue) != inputs.end();
+            });
+            if (linked) {
+                downstream[from].push_back(to);
+                ++indegree[to];
+            }
+        }
+    }
+
+    order_.clear();
+    std::vector<bool> emitted(count, false);
+    bool progressed = true;
+    while (progressed) {
+        progressed = false;
+        for (size_t i = 0; i < count; ++i) {
+            if (emitted[i] || indegree[i] != 0) {
+                continue;
+            }
+            emitted[i] = true;
+            progressed = true;
+            order_.push_back(nodes_[i].processor);
+            for (size_t next : downstream[i]) {
+                --indegree[next];
+            }
+        }
+    }
+
+    if (order_.size() != count) {
+        qWarning() << "AudioRenderGraph: cycle detected, falling back to registration order for"
+                   << (count - order_.size()) << "processors";
+        for (size_t i = 0; i < count; ++i) {
+            if (!emitted[i]) {
+                order_.push_back(nodes_[i].processor);
+            }
+        }
+    }
+}
+
+/**
+ * 函数级注释：渲染一个块（设备回调线程）
+ * - 仅 try_lock：登记/注销进行中时跳过本次遍历，处理器输出缺失的块由设备按静音处理
+ * - 遍历期间不分配内存、不发信号
+ */
+qint64 AudioRenderGraph::render(const void* owner, qint64 timestamp) {
+    if (driver_.load(std::memory_order_acquire) != owner) {
+        return -1;
+    }
+    std::unique_lock<std::mutex> locker(mutex_, std::try_to_lock);
+    if (!locker.owns_lock()) {
+        skippedPasses_.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    if (order_.empty()) {
+        return -1;
+    }
+
+    // 全局时钟自身回退（重置/重启）时以当前时钟重新对齐
+    if (timestamp < lastClockTimestamp_) {
+        lastRenderedTimestamp_ = -1;
+    }
+    lastClockTimestamp_ = timestamp;
+
+    // 回调快于时钟时沿上次时间戳顺延，保证输出时间戳严格递增；
+    // 领先已达 MaxLeadBlocks 时挂起本次遍历等待时钟追上，从不回退到时钟时间戳
+    qint64 renderTimestamp = timestamp;
+    if (lastRenderedTimestamp_ >= 0 && timestamp <= lastRenderedTimestamp_) {
+        renderTimestamp = lastRenderedTimestamp_ + 1;
+        if (renderTimestamp - timestamp > MaxLeadBlocks) {
+            return HeldPass;
+        }
+    }
+    for (AudioRenderProcessor* processor : order_) {
+        processor->renderBlock(renderTimestamp);
+    }
+    lastRenderedTimestamp_ = renderTimestamp;
+    return renderTimestamp;
+}
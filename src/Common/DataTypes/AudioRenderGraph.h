@@ -0,0 +1,111 @@
+//
+// Created by WuBin on 2025/8/29.
+//
+#pragma once
+#include <QtGlobal>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "DataTypesExport.h"
+
+class AudioTimestampRingQueue;
+
+/**
+ * @brief 可被音频渲染图拉取的处理器
+ * - renderBlock() 在音频设备回调线程中调用，实现必须不阻塞：
+ *   与参数设置等其它线程共享状态时使用 tryLock，取不到锁则跳过本块
+ * - 在拉取模式下，处理器读取输入 timestamp 帧并将输出直接标记为 timestamp，
+ *   下游处理器与设备在同一次回调中即可读到，不再额外叠加时间戳补偿
+ */
+class DATATYPES_EXPORT AudioRenderProcessor {
+public:
+    virtual ~AudioRenderProcessor() = default;
+
+    /**
+     * @brief 渲染一个音频块
+     * @param timestamp 本块全局时间戳
+     */
+    virtual void renderBlock(qint64 timestamp) = 0;
+};
+
+/**
+ * @brief 音频渲染图（拉取模式）
+ * - 处理器登记自身的输入/输出队列，图据此推导 上游→下游 依赖并拓扑排序
+ *   （如 解码器 → 矩阵 → 闪避 → 交叉淡化 → 设备输出）
+ * - 驱动设备（第一个启动的 AudioDeviceOut）在 PortAudio 回调中调用 render()，
+ *   一次实时遍历内按拓扑序渲染全部处理器，端到端延迟固定为一个设备缓冲
+ * - 非实时源（解码器、采集等）不参与遍历，通过 LockFreeSpsc 队列向图提供数据
+ * - 没有驱动设备时各处理器继续按 TimestampGenerator 帧信号自行推进
+ * - 线程：登记/注销在各处理器线程中加锁进行；render() 仅 try_lock，取不到锁时跳过本次遍历，从不阻塞回调线程
+ */
+class DATATYPES_EXPORT AudioRenderGraph {
+public:
+    static constexpr qint64 MaxLeadBlocks = 4;  // 渲染时间戳相对全局时钟的最大领先块数
+    static constexpr qint64 HeldPass = -2;      // render() 返回值：领先已达上限，本次遍历被挂起，设备应输出静音
+
+    static AudioRenderGraph& instance();
+
+    /**
+     * @brief 登记或更新处理器及其输入/输出队列，随后重新拓扑排序
+     */
+    void updateProcessor(AudioRenderProcessor* processor,
+                         const std::vector<const AudioTimestampRingQueue*>& inputs,
+                         const std::vector<const AudioTimestampRingQueue*>& outputs);
+
+    /**
+     * @brief 注销处理器；若回调线程正在遍历则等待本次遍历结束，返回后处理器可安全析构
+     */
+    void removeProcessor(AudioRenderProcessor* processor);
+
+    /**
+     * @brief 声明驱动设备（仅第一个声明者生效）
+     * @return true 表示成为驱动设备
+     */
+    bool attachDriver(const void* owner);
+
+    /**
+     * @brief 释放驱动设备
+     */
+    void detachDriver(const void* owner);
+
+    /**
+     * @brief 是否有驱动设备在拉取（处理器据此停止自行推进）
+     */
+    bool isDriven() const { return driver_.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief 由驱动设备回调调用，按拓扑序渲染一个块
+     * - 时钟尚未推进时顺延为上次渲染时间戳 + 1（最多领先 MaxLeadBlocks 块），与设备读取策略一致
+     * - 领先已达上限时挂起本次遍历，渲染时间戳不回退；仅在全局时钟自身回退（重置/重启）时重新对齐
+     * @param owner 驱动设备标识，非驱动设备调用直接返回
+     * @param timestamp 当前全局时间戳
+     * @return 实际渲染的时间戳；挂起返回 HeldPass；未渲染（非驱动设备/无处理器/图正在更新）返回 -1
+     */
+    qint64 render(const void* owner, qint64 timestamp);
+
+    /**
+     * @brief 因图正在更新而跳过的遍历次数
+     */
+    quint64 skippedPasses() const { return skippedPasses_.load(std::memory_order_relaxed); }
+
+private:
+    AudioRenderGraph() = default;
+    AudioRenderGraph(const AudioRenderGraph&) = delete;
+    AudioRenderGraph& operator=(const AudioRenderGraph&) = delete;
+
+    struct Node {
+        AudioRenderProcessor* processor = nullptr;
+        std::vector<const AudioTimestampRingQueue*> inputs;
+        std::vector<const AudioTimestampRingQueue*> outputs;
+    };
+
+    void rebuildOrderLocked();
+
+    std::mutex mutex_;                               // 保护 nodes_/order_，回调线程仅 try_lock
+    std::vector<Node> nodes_;                        // 登记顺序
+    std::vector<AudioRenderProcessor*> order_;       // 拓扑序
+    std::atomic<const void*> driver_{nullptr};       // 驱动设备
+    qint64 lastRenderedTimestamp_ = -1;              // 上次渲染时间戳（仅回调线程持锁访问）
+    qint64 lastClockTimestamp_ = -1;                 // 上次遍历时的全局时钟，用于识别时钟重置
+    std::atomic<quint64> skippedPasses_{0};
+};
@@ -3,6 +3,8 @@
 //
 
 #include "AudioTimestampRingQueue.h"
+#include <algorithm>
+#include <cstring>
 
 using QtNodes::NodeData;
 using QtNodes::NodeDataType;
@@ -12,6 +14,23 @@ AudioTimestampRingQueue::AudioTimestampRingQueue(int maxSize, QObject* parent)
     frames_.resize(maxSize_);  // 预分配固定大小的缓冲区
 }
 
+/**
+ * 函数级注释：按指定模式构造队列
+ * - LockFreeSpsc：一次性预分配 maxSize 个 float 槽位，运行期写入与读取均不再分配内存
+ * - Locked：与默认构造一致
+ */
+AudioTimestampRingQueue::AudioTimestampRingQueue(int maxSize, AudioQueueMode mode, int slotCapacity, QObject* parent)
+    : QObject(parent), maxSize_(maxSize), mode_(mode), slotCapacity_(slotCapacity), isActive_(true), writeIndex_(0) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        slots_ = std::make_unique<LockFreeSlot[]>(static_cast<size_t>(maxSize_));
+        for (int i = 0; i < maxSize_; ++i) {
+            slots_[i].samples.assign(static_cast<size_t>(slotCapacity_), 0.0f);
+        }
+    } else {
+        frames_.resize(maxSize_);
+    }
+}
+
 
 AudioTimestampRingQueue::~AudioTimestampRingQueue() {
     clear();
@@ -25,11 +44,14 @@ AudioTimestampRingQueue::~AudioTimestampRingQueue() {
  * - 信号发射：在锁外 emit，避免信号槽执行耗时导致写入线程长时间持锁
  */
 bool AudioTimestampRingQueue::pushFrame(const AudioFrame& frame) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        return pushFrameLockFree(frame);
+    }
     int emittedWriteIndex = -1;
     AudioFrame emittedFrame;
     {
-        QMutexLocker locker(&mutex_);
-        if (!isActive_) {
+        QWriteLocker locker(&lock_);
+        if (!isActive_.load(std::memory_order_relaxed)) {
             return false;
         }
 
@@ -53,8 +75,8 @@ bool AudioTimestampRingQueue::pushFrame(const AudioFrame& frame) {
         // 更新读侧定位锚点：记录“最近一次写入的有效帧”所在槽位
         // 读侧会通过 delta = latestTimestamp_ - target 反推 idx = latestIndex_ - delta（取模）来定位目标帧
         if (nowValid) {
-            latestTimestamp_ = frame.timestamp;
-            latestIndex_ = writeIndex_;
+            latestTimestamp_.store(frame.timestamp, std::memory_order_relaxed);
+            latestIndex_.store(writeIndex_, std::memory_order_relaxed);
         }
 
         // 记录要发射的参数（写入索引与帧内容），确保锁外 emit 时不再访问共享数据结构
@@ -64,6 +86,7 @@ bool AudioTimestampRingQueue::pushFrame(const AudioFrame& frame) {
         // 更新写索引（环形递增）：下一次写入将覆盖下一个槽位
         writeIndex_ = (writeIndex_ + 1) % maxSize_;
     }
+    pushedFrames_.fetch_add(1, std::memory_order_relaxed);
 
     // 锁外发射：避免信号槽执行耗时导致长时间持锁，影响音频实时性
     if (emittedWriteIndex >= 0) {
@@ -74,17 +97,111 @@ bool AudioTimestampRingQueue::pushFrame(const AudioFrame& frame) {
     return true;
 }
 
+/**
+ * 函数级注释：无锁模式写入（单生产者，wait-free）
+ * - seqlock 协议：写入前将槽位 sequence 置为奇数，写完后置为偶数，读侧据此判断数据是否完整
+ * - 数据拷贝到预分配的 float 槽位，不分配内存；超出 slotCapacity_ 的部分截断
+ * - 若被覆盖的槽位仍未被消费，计入 overwrittenFrames
+ * - 最后以 release 语义发布 latestIndex_/latestTimestamp_，读侧据此 O(1) 定位
+ */
+bool AudioTimestampRingQueue::pushFrameLockFree(const AudioFrame& frame) {
+    int sampleCount = static_cast<int>(frame.data.size() / static_cast<int>(sizeof(float)));
+    float* dst = beginWriteFrame(sampleCount);
+    if (!dst) {
+        return false;
+    }
+    if (sampleCount > 0) {
+        memcpy(dst, frame.data.constData(), static_cast<size_t>(sampleCount) * sizeof(float));
+    }
+    if (!commitWriteFrame(frame.timestamp, frame.sampleRate, frame.channels)) {
+        return false;
+    }
+    emit newFrameWritten(frame);
+    return true;
+}
+
+/**
+ * 函数级注释：生产者直写——打开当前写槽位
+ * - 将槽位 sequence 置为奇数（写入中），读侧在提交前不会把该槽位视为完整帧
+ * - 返回槽位内预分配的 float 缓冲，生产者可直接在其中计算输出（如矩阵混音），省去中间帧与拷贝
+ * - 若被覆盖的槽位仍未被消费，计入 overwrittenFrames
+ */
+float* AudioTimestampRingQueue::beginWriteFrame(int& sampleCount) {
+    if (mode_ != AudioQueueMode::LockFreeSpsc || maxSize_ <= 0) {
+        return nullptr;
+    }
+    applyPendingClearLockFree();
+    if (!isActive_.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    LockFreeSlot& slot = slots_[writeIndex_];
+
+    pendingWasValid_ = slot.timestamp.load(std::memory_order_relaxed) > 0;
+    if (pendingWasValid_ && !slot.consumed.load(std::memory_order_relaxed)) {
+        overwrittenFrames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const quint64 seq = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    sampleCount = std::max(0, std::min(sampleCount, slotCapacity_));
+    pendingSampleCount_ = sampleCount;
+    writeOpen_ = true;
+    return slot.samples.data();
+}
+
+/**
+ * 函数级注释：生产者直写——提交当前写槽位
+ * - 写入元数据后以 release 语义将 sequence 置为偶数，随后发布 latestIndex_/latestTimestamp_
+ * - 仅发出 frameWritten(index)；不构造 AudioFrame，因此不发出 newFrameWritten
+ */
+bool AudioTimestampRingQueue::commitWriteFrame(qint64 timestamp, int sampleRate, int channels) {
+    if (!writeOpen_) {
+        return false;
+    }
+    writeOpen_ = false;
+
+    const int idx = writeIndex_;
+    LockFreeSlot& slot = slots_[idx];
+    slot.sampleCount = pendingSampleCount_;
+    slot.sampleRate = sampleRate;
+    slot.channels = channels;
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.consumed.store(false, std::memory_order_relaxed);
+
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    const bool nowValid = timestamp > 0;
+    if (!pendingWasValid_ && nowValid) {
+        if (validFrames_.load(std::memory_order_relaxed) < maxSize_) validFrames_.fetch_add(1, std::memory_order_relaxed);
+    } else if (pendingWasValid_ && !nowValid) {
+        if (validFrames_.load(std::memory_order_relaxed) > 0) validFrames_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (nowValid) {
+        latestIndex_.store(idx, std::memory_order_release);
+        latestTimestamp_.store(timestamp, std::memory_order_release);
+    }
+
+    writeIndex_ = (writeIndex_ + 1) % maxSize_;
+    pushedFrames_.fetch_add(1, std::memory_order_relaxed);
+
+    emit frameWritten(idx);
+    return true;
+}
+
 double AudioTimestampRingQueue::getUsedRatio() const {
-    QMutexLocker locker(&mutex_);
-    if (maxSize_ <= 0) return 0.0;
-    return static_cast<double>(validFrames_) / static_cast<double>(maxSize_);
+    if (maxSize_ <= 0 || clearRequested_.load(std::memory_order_acquire)) return 0.0;
+    return static_cast<double>(validFrames_.load(std::memory_order_relaxed)) / static_cast<double>(maxSize_);
 }
 
 /**
  * 函数级注释：根据目标时间戳获取对应音频帧（环形缓冲区，读侧优化）
- * - 线程安全：内部使用 QMutexLocker 保证并发读写安全，锁外不持有资源
+ * - 线程安全：Locked 模式内部使用写锁（共享默认读者缓存）；LockFreeSpsc 模式无锁读取后拷出
  * - 访问策略（由快到慢）：
- *   1) 小缓存命中：优先检查上次命中的槽位（lastHitIndex_），若 timestamp 相等直接返回
+ *   1) 小缓存命中：优先检查上次命中的槽位（lastHitIndex），若 timestamp 相等直接返回
  *   2) 相邻槽命中：若上次命中时间戳 + 1 等于目标时间戳，尝试读取相邻槽位（顺序访问高概率命中）
  *   3) 基于最新写入锚点的 O(1) 反推定位：
  *      - latestTimestamp_ / latestIndex_ 在写入有效帧时更新
@@ -94,104 +211,389 @@ double AudioTimestampRingQueue::getUsedRatio() const {
  * - 返回值：
  *   - true：找到匹配的帧并写入到参数 frame
  *   - false：队列未激活、队列为空、目标已被覆盖或无法命中
- * - 适用场景：单生产者/单消费者、写入时间戳单调递增、读侧以顺序访问为主（偶发跳转可由扫描容错）
+ * - 适用场景：单消费者；多消费者请使用带 AudioQueueCursor 的重载
  * - 复杂度与稳定性：避免哈希查找与大范围线性扫描，绝大多数情况下为 O(1) 命中；在非连续情况下退化为常数半径扫描
  */
 bool AudioTimestampRingQueue::getFrameByTimestamp(qint64 targetFrameCount, AudioFrame& frame) {
-    QMutexLocker locker(&mutex_);
-    if (!isActive_) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        return copyFrameOutLockFree(defaultCursor_, targetFrameCount, true, frame);
+    }
+
+    QWriteLocker locker(&lock_);
+    const int idx = findFrameIndexLocked(defaultCursor_, targetFrameCount);
+    if (idx < 0) {
+        return false;
+    }
+    frame = frames_[idx];
+    return true;
+}
+
+/**
+ * 函数级注释：以读者游标获取目标帧
+ * - Locked：共享读锁，多读者可并发；frame.data 与槽位共享 QByteArray 引用计数，不深拷贝
+ * - LockFreeSpsc：无锁读取后拷出
+ * - 游标私有缓存避免多个消费者互相冲掉彼此的顺序访问命中
+ */
+bool AudioTimestampRingQueue::getFrameByTimestamp(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrame& frame) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        return copyFrameOutLockFree(cursor, targetFrameCount, false, frame);
+    }
+
+    QReadLocker locker(&lock_);
+    const int idx = findFrameIndexLocked(cursor, targetFrameCount);
+    if (idx < 0) {
+        return false;
+    }
+    frame = frames_[idx];
+    return true;
+}
+
+/**
+ * 函数级注释：零拷贝读取目标时间戳帧
+ * - LockFreeSpsc：按 seqlock 协议直接返回槽位内 float 指针，不加锁、不分配
+ * - Locked：加锁定位后以 QByteArray 引用计数持有数据（不做深拷贝）
+ * - 使用完 view 后应调用 verifyFrameView() 确认读取期间未被覆盖
+ */
+bool AudioTimestampRingQueue::acquireFrameView(qint64 targetFrameCount, AudioFrameView& view) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        return acquireFrameViewLockFree(defaultCursor_, targetFrameCount, true, view);
+    }
+    QWriteLocker locker(&lock_);
+    return fillFrameViewLocked(defaultCursor_, targetFrameCount, view);
+}
+
+/**
+ * 函数级注释：以读者游标零拷贝读取目标帧
+ * - 游标读者不回写槽位 consumed 标记，多个读者之间不产生共享写
+ */
+bool AudioTimestampRingQueue::acquireFrameView(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrameView& view) {
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        return acquireFrameViewLockFree(cursor, targetFrameCount, false, view);
+    }
+    QReadLocker locker(&lock_);
+    return fillFrameViewLocked(cursor, targetFrameCount, view);
+}
+
+bool AudioTimestampRingQueue::verifyFrameView(const AudioFrameView& view) const {
+    return verifyFrameView(defaultCursor_, view);
+}
+
+/**
+ * 函数级注释：校验视图有效性
+ * - LockFreeSpsc：比较槽位当前 sequence 与读取时记录的 sequence，不一致说明生产者已追上并改写
+ * - Locked：视图持有数据引用，始终有效
+ */
+bool AudioTimestampRingQueue::verifyFrameView(AudioQueueCursor& cursor, const AudioFrameView& view) const {
+    if (mode_ != AudioQueueMode::LockFreeSpsc) {
+        return view.isValid();
+    }
+    if (view.slotIndex < 0 || view.slotIndex >= maxSize_) {
         return false;
     }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slots_[view.slotIndex].sequence.load(std::memory_order_relaxed) != view.sequence) {
+        cursor.lateFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<AudioQueueCursor> AudioTimestampRingQueue::createCursor() {
+    return std::make_shared<AudioQueueCursor>();
+}
+
+/**
+ * 函数级注释：读取单个无锁槽位
+ * - sequence 为奇数说明生产者正在写入，直接放弃
+ * - 读取元数据后再次校验 sequence，保证 view 内容来自同一次写入
+ * - markConsumed 仅用于单读者旧接口，以统计未消费即被覆盖的帧
+ */
+bool AudioTimestampRingQueue::readSlotLockFree(int idx, qint64 targetFrameCount, bool markConsumed, AudioFrameView& view) const {
+    const LockFreeSlot& slot = slots_[idx];
+    const quint64 seqBefore = slot.sequence.load(std::memory_order_acquire);
+    if (seqBefore & 1ULL) {
+        return false;
+    }
+    if (slot.timestamp.load(std::memory_order_relaxed) != targetFrameCount) {
+        return false;
+    }
+    view.data = slot.samples.data();
+    view.sampleCount = slot.sampleCount;
+    view.sampleRate = slot.sampleRate;
+    view.channels = slot.channels;
+    view.timestamp = targetFrameCount;
+    view.slotIndex = idx;
+    view.sequence = seqBefore;
+    view.holder.clear();
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != seqBefore) {
+        view.data = nullptr;
+        return false;
+    }
+    if (markConsumed) {
+        slots_[idx].consumed.store(true, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * 函数级注释：无锁定位目标帧
+ * - 先查游标的顺序访问缓存（上次命中槽位的下一个），再以 latestTimestamp_/latestIndex_ 为锚点 O(1) 反推，
+ *   未命中时做常数半径扫描
+ * - 目标帧尚未写入或丢失计入 missedFrames；目标已滑出窗口计入 lateFrames（均记在游标上）
+ */
+bool AudioTimestampRingQueue::acquireFrameViewLockFree(AudioQueueCursor& cursor, qint64 targetFrameCount, bool markConsumed, AudioFrameView& view) {
+    // 清空请求尚未被生产者执行时视为空队列
+    if (!isActive_.load(std::memory_order_relaxed) || maxSize_ <= 0 || clearRequested_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    auto hit = [&](int idx) {
+        cursor.lastHitIndex = idx;
+        cursor.lastHitTimestamp = targetFrameCount;
+        cursor.hitFrames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    if (cursor.lastHitIndex >= 0 && cursor.lastHitIndex < maxSize_ && cursor.lastHitTimestamp + 1 == targetFrameCount) {
+        const int nextIdx = (cursor.lastHitIndex + 1) % maxSize_;
+        if (readSlotLockFree(nextIdx, targetFrameCount, markConsumed, view)) {
+            return hit(nextIdx);
+        }
+    }
+
+    const qint64 latestTs = latestTimestamp_.load(std::memory_order_acquire);
+    const int latestIdx = latestIndex_.load(std::memory_order_acquire);
+    if (latestTs <= 0 || latestIdx < 0) {
+        cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const qint64 delta = latestTs - targetFrameCount;
+    if (delta < 0) {
+        cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (delta >= maxSize_) {
+        cursor.lateFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    int idx = (latestIdx - static_cast<int>(delta)) % maxSize_;
+    if (idx < 0) idx += maxSize_;
+
+    if (readSlotLockFree(idx, targetFrameCount, markConsumed, view)) {
+        return hit(idx);
+    }
+
+    constexpr int scanRadius = 4;
+    for (int offset = 1; offset <= scanRadius; ++offset) {
+        const int idxR = (idx + offset) % maxSize_;
+        if (readSlotLockFree(idxR, targetFrameCount, markConsumed, view)) {
+            return hit(idxR);
+        }
+        int idxL = (idx - offset) % maxSize_;
+        if (idxL < 0) idxL += maxSize_;
+        if (readSlotLockFree(idxL, targetFrameCount, markConsumed, view)) {
+            return hit(idxL);
+        }
+    }
+
+    cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+/**
+ * 函数级注释：无锁读取并拷出为 AudioFrame（兼容需要 QByteArray 的旧消费者）
+ */
+bool AudioTimestampRingQueue::copyFrameOutLockFree(AudioQueueCursor& cursor, qint64 targetFrameCount, bool markConsumed, AudioFrame& frame) {
+    AudioFrameView view;
+    if (!acquireFrameViewLockFree(cursor, targetFrameCount, markConsumed, view)) {
+        return false;
+    }
+    frame.data = QByteArray(reinterpret_cast<const char*>(view.data),
+                            view.sampleCount * static_cast<int>(sizeof(float)));
+    frame.sampleRate = view.sampleRate;
+    frame.channels = view.channels;
+    frame.bitsPerSample = 32;
+    frame.timestamp = view.timestamp;
+    return verifyFrameView(cursor, view);
+}
+
+/**
+ * 函数级注释：Locked 模式下填充视图（调用方需持有 lock_）
+ * - 以引用计数持有 QByteArray，锁外读取不受生产者覆盖影响
+ */
+bool AudioTimestampRingQueue::fillFrameViewLocked(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrameView& view) const {
+    const int idx = findFrameIndexLocked(cursor, targetFrameCount);
+    if (idx < 0) {
+        return false;
+    }
+    const AudioFrame& hit = frames_[idx];
+    view.holder = hit.data;
+    view.data = reinterpret_cast<const float*>(view.holder.constData());
+    view.sampleCount = static_cast<int>(view.holder.size() / static_cast<int>(sizeof(float)));
+    view.sampleRate = hit.sampleRate;
+    view.channels = hit.channels;
+    view.timestamp = hit.timestamp;
+    view.slotIndex = idx;
+    view.sequence = 0;
+    return true;
+}
+
+/**
+ * 函数级注释：Locked 模式定位目标帧所在槽位（调用方需持有 lock_）
+ * - 访问策略见 getFrameByTimestamp 注释；顺序访问缓存与统计均记在传入的游标上
+ * @return 槽位索引，未命中返回 -1
+ */
+int AudioTimestampRingQueue::findFrameIndexLocked(AudioQueueCursor& cursor, qint64 targetFrameCount) const {
+    if (!isActive_.load(std::memory_order_relaxed)) {
+        return -1;
+    }
+
+    auto hit = [&](int idx) {
+        cursor.lastHitIndex = idx;
+        cursor.lastHitTimestamp = targetFrameCount;
+        cursor.hitFrames.fetch_add(1, std::memory_order_relaxed);
+        return idx;
+    };
 
     // 先用小缓存（连续访问很常见）
-    if (lastHitIndex_ >= 0 && lastHitIndex_ < maxSize_) {
-        const AudioFrame& cached = frames_[lastHitIndex_];
+    if (cursor.lastHitIndex >= 0 && cursor.lastHitIndex < maxSize_) {
+        const AudioFrame& cached = frames_[cursor.lastHitIndex];
         if (cached.timestamp == targetFrameCount) {
-            frame = cached;
-            return true;
+            return hit(cursor.lastHitIndex);
         }
-        
+
         // 真正实现"直接使用相邻槽"，不查哈希表，大幅降低锁竞争
         if (cached.timestamp + 1 == targetFrameCount) {
-            int nextIdx = (lastHitIndex_ + 1) % maxSize_;
-            const AudioFrame& nextFrame = frames_[nextIdx];
-            if (nextFrame.timestamp == targetFrameCount) {
-                frame = nextFrame;
-                lastHitIndex_ = nextIdx;
-                lastHitTimestamp_ = nextFrame.timestamp;
-                return true;
+            int nextIdx = (cursor.lastHitIndex + 1) % maxSize_;
+            if (frames_[nextIdx].timestamp == targetFrameCount) {
+                return hit(nextIdx);
             }
         }
-        
+
         // 容错：如果缓存的时间戳已经不匹配（比如被覆盖），走下面的基于最新写入的定位
     }
 
-    if (latestTimestamp_ <= 0 || latestIndex_ < 0 || maxSize_ <= 0) {
-        return false;
+    const qint64 latestTs = latestTimestamp_.load(std::memory_order_relaxed);
+    const int latestIdx = latestIndex_.load(std::memory_order_relaxed);
+    if (latestTs <= 0 || latestIdx < 0 || maxSize_ <= 0) {
+        cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+        return -1;
     }
 
-    const qint64 delta = latestTimestamp_ - targetFrameCount;
-    if (delta < 0 || delta >= maxSize_) {
-        return false;
+    const qint64 delta = latestTs - targetFrameCount;
+    if (delta < 0) {
+        cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    if (delta >= maxSize_) {
+        cursor.lateFrames.fetch_add(1, std::memory_order_relaxed);
+        return -1;
     }
 
-    int idx = latestIndex_ - static_cast<int>(delta);
+    int idx = latestIdx - static_cast<int>(delta);
     idx %= maxSize_;
     if (idx < 0) idx += maxSize_;
 
-    const AudioFrame& hit = frames_[idx];
-    if (hit.timestamp == targetFrameCount) {
-        frame = hit;
-        lastHitTimestamp_ = hit.timestamp;
-        lastHitIndex_ = idx;
-        return true;
+    if (frames_[idx].timestamp == targetFrameCount) {
+        return hit(idx);
     }
 
     constexpr int scanRadius = 4;
     for (int offset = 1; offset <= scanRadius; ++offset) {
         int idxR = (idx + offset) % maxSize_;
-        const AudioFrame& r = frames_[idxR];
-        if (r.timestamp == targetFrameCount) {
-            frame = r;
-            lastHitTimestamp_ = r.timestamp;
-            lastHitIndex_ = idxR;
-            return true;
+        if (frames_[idxR].timestamp == targetFrameCount) {
+            return hit(idxR);
         }
 
         int idxL = (idx - offset) % maxSize_;
         if (idxL < 0) idxL += maxSize_;
-        const AudioFrame& l = frames_[idxL];
-        if (l.timestamp == targetFrameCount) {
-            frame = l;
-            lastHitTimestamp_ = l.timestamp;
-            lastHitIndex_ = idxL;
-            return true;
+        if (frames_[idxL].timestamp == targetFrameCount) {
+            return hit(idxL);
         }
     }
 
-    return false;
+    cursor.missedFrames.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+/**
+ * 函数级注释：获取队列健康度统计快照
+ * - pushed/overwritten 为写侧指标；hit/missed/late 为未使用游标的旧接口读者指标，
+ *   游标读者的统计见 AudioQueueCursor::stats()
+ */
+AudioQueueStats AudioTimestampRingQueue::getStats() const {
+    AudioQueueStats stats = defaultCursor_.stats();
+    stats.pushedFrames = pushedFrames_.load(std::memory_order_relaxed);
+    stats.overwrittenFrames = overwrittenFrames_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AudioTimestampRingQueue::resetStats() {
+    pushedFrames_.store(0, std::memory_order_relaxed);
+    overwrittenFrames_.store(0, std::memory_order_relaxed);
+    defaultCursor_.hitFrames.store(0, std::memory_order_relaxed);
+    defaultCursor_.missedFrames.store(0, std::memory_order_relaxed);
+    defaultCursor_.lateFrames.store(0, std::memory_order_relaxed);
 }
 
+/**
+ * 函数级注释：清空队列
+ * - Locked 模式：写锁下立即清空
+ * - LockFreeSpsc 模式：槽位与写索引只由生产者改写，这里只登记清空请求（任意线程可调用），
+ *   由生产者在下一次 beginWriteFrame() 前执行；执行前读者按空队列处理
+ * - 游标读者的缓存无需重置：命中前总会校验槽位时间戳
+ */
 void AudioTimestampRingQueue::clear() {
-    QMutexLocker locker(&mutex_);
+    if (mode_ == AudioQueueMode::LockFreeSpsc) {
+        clearRequested_.store(true, std::memory_order_release);
+        return;
+    }
+    QWriteLocker locker(&lock_);
+    latestTimestamp_.store(0, std::memory_order_release);
+    latestIndex_.store(-1, std::memory_order_release);
     writeIndex_ = 0;
-    validFrames_ = 0;
-    lastHitTimestamp_ = 0;
-    lastHitIndex_ = -1;
-    latestTimestamp_ = 0;
-    latestIndex_ = -1;
+    validFrames_.store(0, std::memory_order_relaxed);
+    defaultCursor_.lastHitTimestamp = 0;
+    defaultCursor_.lastHitIndex = -1;
     for (int i = 0; i < frames_.size(); ++i) {
         frames_[i] = AudioFrame();
     }
 }
 
+/**
+ * 函数级注释：执行挂起的清空请求（仅生产者线程，且没有打开的写槽位）
+ * - 先取走请求再清空：清空期间再次到达的请求留给下一次写入
+ * - 每个槽位按 seqlock 协议改写，并发读者要么读到完整旧帧，要么判定为改写
+ */
+void AudioTimestampRingQueue::applyPendingClearLockFree() {
+    if (writeOpen_ || !clearRequested_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    latestTimestamp_.store(0, std::memory_order_release);
+    latestIndex_.store(-1, std::memory_order_release);
+    writeIndex_ = 0;
+    validFrames_.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < maxSize_; ++i) {
+        LockFreeSlot& slot = slots_[i];
+        const quint64 seq = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp.store(0, std::memory_order_relaxed);
+        slot.sampleCount = 0;
+        slot.consumed.store(true, std::memory_order_relaxed);
+        slot.sequence.store(seq + 2, std::memory_order_release);
+    }
+}
+
 void AudioTimestampRingQueue::setActive(bool active) {
-    QMutexLocker locker(&mutex_);
-    isActive_ = active;
+    isActive_.store(active, std::memory_order_relaxed);
 }
 
 bool AudioTimestampRingQueue::isActive() const {
-    QMutexLocker locker(&mutex_);
-    return isActive_;
+    return isActive_.load(std::memory_order_relaxed);
 }
 
@@ -6,8 +6,11 @@
 #include <QMetaType>
 #include <QQueue>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QAtomicInt>
 #include <memory>
+#include <atomic>
+#include <vector>
 #include <QDateTime>
 #include <QMap>
 #include <QObject>  // 添加QObject头文件
@@ -27,24 +30,164 @@ struct AudioFrame {
     AudioFrame() : sampleRate(0), channels(0), bitsPerSample(0), timestamp(0) {}
 };
 
+/**
+ * @brief 队列工作模式
+ * - Locked：互斥锁保护，槽位存放 QByteArray（默认，兼容旧行为）
+ * - LockFreeSpsc：单生产者无锁模式，槽位为预分配 float 缓冲，读侧零拷贝；
+ *   多个消费者并发读取时须各自持有 AudioQueueCursor
+ */
+enum class AudioQueueMode {
+    Locked,
+    LockFreeSpsc
+};
+
+/**
+ * @brief 只读音频帧视图（零拷贝）
+ * - data 指向队列内部槽位，仅在 verifyFrameView() 返回 true 前的读取有效
+ * - Locked 模式下 holder 持有 QByteArray 引用，保证数据在视图生命周期内不被释放
+ */
+struct AudioFrameView {
+    const float* data = nullptr;  // 只读采样数据
+    int sampleCount = 0;          // 采样数
+    int sampleRate = 0;           // 采样率
+    int channels = 0;             // 通道数
+    qint64 timestamp = 0;         // 时间戳
+    int slotIndex = -1;           // 所在槽位
+    quint64 sequence = 0;         // 读取时槽位序列号（用于校验是否被覆盖）
+    QByteArray holder;            // Locked 模式下的数据持有者
+
+    bool isValid() const { return data != nullptr; }
+};
+
+/**
+ * @brief 队列健康度统计
+ */
+struct AudioQueueStats {
+    quint64 pushedFrames = 0;       // 写入帧数
+    quint64 hitFrames = 0;          // 读取命中帧数
+    quint64 missedFrames = 0;       // 无锁读取未命中（目标帧尚未写入或已丢失）
+    quint64 lateFrames = 0;         // 读取过迟（目标帧已滑出窗口或读取期间被改写）
+    quint64 overwrittenFrames = 0;  // 未被消费即被覆盖的帧
+};
+
+/**
+ * @brief 读者游标：每个消费者独立持有的读取状态
+ * - 顺序访问缓存与命中统计均为读者私有，多个消费者并发读取同一队列时不写任何共享状态
+ * - 一个 AudioData 输出扇出给多个节点时，每个节点各自持有一个游标
+ */
+struct alignas(64) AudioQueueCursor {
+    int lastHitIndex = -1;                  // 上次命中的槽位
+    qint64 lastHitTimestamp = 0;            // 上次命中的时间戳
+    std::atomic<quint64> hitFrames{0};      // 命中帧数
+    std::atomic<quint64> missedFrames{0};   // 未命中帧数
+    std::atomic<quint64> lateFrames{0};     // 过迟帧数
+
+    /**
+     * @brief 获取该读者的统计快照（pushed/overwritten 为队列级指标，此处为 0）
+     */
+    AudioQueueStats stats() const {
+        AudioQueueStats s;
+        s.hitFrames = hitFrames.load(std::memory_order_relaxed);
+        s.missedFrames = missedFrames.load(std::memory_order_relaxed);
+        s.lateFrames = lateFrames.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() {
+        lastHitIndex = -1;
+        lastHitTimestamp = 0;
+        hitFrames.store(0, std::memory_order_relaxed);
+        missedFrames.store(0, std::memory_order_relaxed);
+        lateFrames.store(0, std::memory_order_relaxed);
+    }
+};
+
 /**
  * @brief 基于时间戳的环形音频队列
  * AudioDecoder始终写入队首，AudioDeviceOut根据时间戳提取帧
+ * 多消费者扇出：各消费者通过 createCursor() 获取独立游标后并发读取，
+ * Locked 模式下读者共享读锁，LockFreeSpsc 模式下读者完全无锁
  */
 class DATATYPES_EXPORT AudioTimestampRingQueue : public QObject {
     Q_OBJECT
 public:
+    static constexpr int DefaultSlotCapacity = 8192;  // 无锁模式下每槽位预分配采样数
+
     explicit AudioTimestampRingQueue(int maxSize = 64,QObject* parent = nullptr);
+    /**
+     * @brief 指定工作模式构造
+     * @param maxSize 槽位数量
+     * @param mode 工作模式
+     * @param slotCapacity 无锁模式下每槽位预分配的 float 采样数，超出部分截断
+     */
+    AudioTimestampRingQueue(int maxSize, AudioQueueMode mode, int slotCapacity = DefaultSlotCapacity, QObject* parent = nullptr);
     ~AudioTimestampRingQueue() ;
 
     bool pushFrame(const AudioFrame& frame);
 
+    /**
+     * @brief 生产者直写：打开下一个写槽位（仅 LockFreeSpsc 模式，单生产者）
+     * - 返回槽位内预分配缓冲，生产者直接写入后调用 commitWriteFrame() 发布
+     * - 打开期间读者不会读到该槽位的半帧数据
+     * @param sampleCount 期望写入的采样数，返回时截断为槽位容量
+     * @return 可写缓冲；Locked 模式或队列未激活时返回 nullptr
+     */
+    float* beginWriteFrame(int& sampleCount);
+
+    /**
+     * @brief 生产者直写：提交 beginWriteFrame() 打开的槽位
+     * @return false 表示没有已打开的槽位
+     */
+    bool commitWriteFrame(qint64 timestamp, int sampleRate, int channels);
+
     // 使用当前有效帧数估算使用率（0.0-1.0）
     double getUsedRatio() const ;
 
     // 无消费者版本：先匹配 target，再匹配 target+1
     bool getFrameByTimestamp(qint64 targetFrameCount, AudioFrame& frame) ;
 
+    /**
+     * @brief 零拷贝读取：获取目标时间戳帧的只读视图
+     * - LockFreeSpsc 模式下不加锁、不分配
+     * @return true 表示命中并填充 view
+     */
+    bool acquireFrameView(qint64 targetFrameCount, AudioFrameView& view) ;
+
+    /**
+     * @brief 校验视图在使用期间未被生产者改写
+     * @return false 表示读取期间槽位被覆盖，数据可能不完整（计入 lateFrames）
+     */
+    bool verifyFrameView(const AudioFrameView& view) const ;
+
+    /**
+     * @brief 创建读者游标（每个消费者一个）
+     */
+    static std::shared_ptr<AudioQueueCursor> createCursor() ;
+
+    /**
+     * @brief 以游标方式读取帧：读者状态私有，多消费者之间无争用
+     * - 返回的 AudioFrame.data 与队列共享引用计数数据，不做深拷贝（LockFreeSpsc 模式除外）
+     */
+    bool getFrameByTimestamp(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrame& frame) ;
+
+    /**
+     * @brief 以游标方式零拷贝读取帧视图
+     */
+    bool acquireFrameView(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrameView& view) ;
+
+    /**
+     * @brief 以游标方式校验视图，改写计入该游标的 lateFrames
+     */
+    bool verifyFrameView(AudioQueueCursor& cursor, const AudioFrameView& view) const ;
+
+    AudioQueueMode mode() const { return mode_; }
+
+    AudioQueueStats getStats() const ;
+    void resetStats() ;
+
+    /**
+     * @brief 清空队列；LockFreeSpsc 模式下为生产者侧请求，在下一次写入前执行，执行前读者视为空队列
+     */
     void clear() ;
 
     void setActive(bool active) ;
@@ -55,16 +198,47 @@ signals:
     void newFrameWritten(AudioFrame);
 
 private:
+    /**
+     * @brief 无锁模式槽位（seqlock：sequence 为奇数表示写入中）
+     */
+    struct LockFreeSlot {
+        std::atomic<quint64> sequence{0};
+        std::atomic<qint64> timestamp{0};
+        std::atomic<bool> consumed{true};
+        int sampleRate = 0;
+        int channels = 0;
+        int sampleCount = 0;
+        std::vector<float> samples;
+    };
+
+    bool pushFrameLockFree(const AudioFrame& frame);
+    void applyPendingClearLockFree();
+    bool readSlotLockFree(int idx, qint64 targetFrameCount, bool markConsumed, AudioFrameView& view) const;
+    bool acquireFrameViewLockFree(AudioQueueCursor& cursor, qint64 targetFrameCount, bool markConsumed, AudioFrameView& view) ;
+    bool copyFrameOutLockFree(AudioQueueCursor& cursor, qint64 targetFrameCount, bool markConsumed, AudioFrame& frame) ;
+    bool fillFrameViewLocked(AudioQueueCursor& cursor, qint64 targetFrameCount, AudioFrameView& view) const ;
+    int findFrameIndexLocked(AudioQueueCursor& cursor, qint64 targetFrameCount) const ;
+
     QVector<AudioFrame> frames_;                  // 固定大小的环形缓冲区
     int maxSize_;                                 // 队列最大长度
-    bool isActive_;                               // 队列激活状态
+    AudioQueueMode mode_ = AudioQueueMode::Locked; // 工作模式
+    int slotCapacity_ = 0;                        // 无锁槽位容量（采样数）
+    std::unique_ptr<LockFreeSlot[]> slots_;       // 无锁模式槽位
+    std::atomic<bool> isActive_;                  // 队列激活状态
     int writeIndex_;                              // 写索引（0到maxSize-1循环）
-    mutable QMutex mutex_;                        // 线程安全互斥锁
-    int validFrames_ = 0;                         // 有效帧数量（timestamp>0）
-
-    // 读取侧小缓存：加速顺序访问，减少哈希查找次数
-    qint64 lastHitTimestamp_ = 0;
-    int lastHitIndex_ = -1;
-    qint64 latestTimestamp_=0;
-    int latestIndex_=-1;
+    bool writeOpen_ = false;                      // 直写槽位是否已打开（仅生产者线程访问）
+    bool pendingWasValid_ = false;                // 打开的槽位在覆盖前是否有效
+    int pendingSampleCount_ = 0;                  // 打开的槽位待提交采样数
+    mutable QReadWriteLock lock_;                 // Locked 模式读写锁：写者独占，游标读者共享
+    std::atomic<int> validFrames_{0};             // 有效帧数量（timestamp>0）
+    std::atomic<bool> clearRequested_{false};     // LockFreeSpsc 模式待生产者执行的清空请求
+
+    // 未使用游标的旧接口共用的默认读者状态（含读取侧小缓存与命中统计）
+    mutable AudioQueueCursor defaultCursor_;
+    std::atomic<qint64> latestTimestamp_{0};
+    std::atomic<int> latestIndex_{-1};
+
+    // 健康度统计（读写两侧均以 relaxed 原子计数，不影响实时线程）
+    std::atomic<quint64> pushedFrames_{0};
+    std::atomic<quint64> overwrittenFrames_{0};
 };
@@ -0,0 +1,128 @@
+//
+// Created by WuBin on 2025/8/29.
+//
+#include "DmxUniverseData.h"
+#include "VariableData.h"
+#include <QVariantList>
+#include <cstring>
+
+using namespace NodeDataTypes;
+
+DmxUniverseData::DmxUniverseData()
+    : m_block(ChannelCount, '\0') {}
+
+DmxUniverseData::DmxUniverseData(int universe, const QByteArray& block, int offset)
+    : m_universe(universe & 0x7FFF) {
+    setBlock(block, offset);
+}
+
+QtNodes::NodeDataType DmxUniverseData::type() const {
+    return QtNodes::NodeDataType{"dmx", "DMX"};
+}
+
+QByteArray DmxUniverseData::toByteArray() const {
+    if (m_offset == 0 && m_block.size() == ChannelCount) {
+        return m_block;
+    }
+    return QByteArray(m_block.constData() + m_offset, ChannelCount);
+}
+
+/**
+ * 函数级注释：写入通道数据
+ * - 视图（offset != 0 或块大小不是 512）先切换为独占存储
+ * - data() 仅在数据被共享时分离复制，独占时原地写入
+ */
+void DmxUniverseData::setChannels(const char* source, int length) {
+    if (m_offset != 0 || m_block.size() != ChannelCount) {
+        m_block = QByteArray(ChannelCount, '\0');
+        m_offset = 0;
+    }
+    const int count = qBound(0, length, ChannelCount);
+    char* target = m_block.data();
+    if (count > 0) {
+        std::memcpy(target, source, count);
+    }
+    std::memset(target + count, 0, ChannelCount - count);
+}
+
+void DmxUniverseData::setBlock(const QByteArray& block, int offset) {
+    if (offset >= 0 && offset + ChannelCount <= block.size()) {
+        m_block = block;
+        m_offset = offset;
+        return;
+    }
+    // 数据块不足一个宇宙：复制可用部分并补零
+    m_block = QByteArray(ChannelCount, '\0');
+    m_offset = 0;
+    if (offset >= 0 && offset < block.size()) {
+        std::memcpy(m_block.data(), block.constData() + offset, block.size() - offset);
+    }
+}
+
+/**
+ * 函数级注释：转为旧格式 Art-Net 数据包
+ * - 与 UniversePlayback/DMXUniverse 节点原有输出字段一致，dmxData 为 512 个整数
+ */
+QVariantMap DmxUniverseData::toArtnetPacket() const {
+    QVariantMap artnetPacket;
+    artnetPacket["protocol"] = "Art-Net";
+    artnetPacket["version"] = 14;
+    artnetPacket["opcode"] = 0x5000;
+    artnetPacket["universe"] = universeInSubnet();
+    artnetPacket["subnet"] = subnet();
+    artnetPacket["net"] = net();
+    artnetPacket["fullUniverse"] = m_universe;
+
+    QVariantList dmxList;
+    dmxList.reserve(ChannelCount);
+    const uchar* channels = data();
+    for (int i = 0; i < ChannelCount; ++i) {
+        dmxList.append(int(channels[i]));
+    }
+    artnetPacket["dmxData"] = dmxList;
+    artnetPacket["dataLength"] = ChannelCount;
+    artnetPacket["activeChannels"] = 0;
+    artnetPacket["timestamp"] = m_timestamp;
+    return artnetPacket;
+}
+
+std::shared_ptr<VariableData> DmxUniverseData::toVariableData() const {
+    auto variableData = std::make_shared<VariableData>();
+    variableData->insert("default", toArtnetPacket());
+    return variableData;
+}
+
+/**
+ * 函数级注释：从旧格式 Art-Net 数据包构造
+ * - 优先读取 fullUniverse，缺失时由 net/subnet/universe 组合
+ */
+std::shared_ptr<DmxUniverseData> DmxUniverseData::fromVariableData(const VariableData& data) {
+    const QVariantMap artnetPacket = data.value("default").toMap();
+    if (artnetPacket.value("protocol").toString() != "Art-Net") {
+        return nullptr;
+    }
+
+    auto dmx = std::make_shared<DmxUniverseData>();
+    if (artnetPacket.contains("fullUniverse")) {
+        dmx->setUniverse(artnetPacket.value("fullUniverse").toInt());
+    } else {
+        dmx->setUniverse((artnetPacket.value("net").toInt() << 8) |
+                         (artnetPacket.value("subnet").toInt() << 4) |
+                         artnetPacket.value("universe").toInt());
+    }
+    dmx->setTimestamp(artnetPacket.value("timestamp").toLongLong());
+
+    const QVariant dmxValue = artnetPacket.value("dmxData");
+    if (dmxValue.typeId() == QMetaType::QByteArray) {
+        dmx->setChannels(dmxValue.toByteArray());
+    } else {
+        const QVariantList dmxList = dmxValue.toList();
+        char channels[ChannelCount] = {};
+        const int count = qMin(dmxList.size(), ChannelCount);
+        for (int i = 0; i < count; ++i) {
+            channels[i] = static_cast<char>(qBound(0, dmxList[i].toInt(), 255));
+        }
+        dmx->setChannels(channels, ChannelCount);
+    }
+    return dmx;
+}
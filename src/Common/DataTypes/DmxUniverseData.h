@@ -0,0 +1,106 @@
+//
+// Created by WuBin on 2025/8/29.
+//
+#pragma once
+
+#include <QtNodes/NodeData>
+#include <QByteArray>
+#include <QVariantMap>
+#include <memory>
+#include "DataTypesExport.h"
+
+namespace NodeDataTypes
+{
+    class VariableData;
+
+    /**
+     * @brief 单个 DMX 宇宙（512 通道）的节点数据
+     * - 数据保存在 QByteArray 中：既可独占 512 字节，也可作为多宇宙连续数据块上的引用计数视图（offset 指向本宇宙起始）
+     * - 拷贝/传递只增加引用计数，不复制通道数据
+     * - universe 为 15 位端口地址：Net(7) | SubNet(4) | Universe(4)
+     * - 仍需 VariableData 的节点通过 toVariableData()/fromVariableData() 与旧的 Art-Net 数据包格式互转
+     */
+    class DATATYPES_EXPORT DmxUniverseData final : public QtNodes::NodeData {
+    public:
+        static constexpr int ChannelCount = 512;
+
+        /**
+         * @brief 构造全零宇宙（独占存储）
+         */
+        DmxUniverseData();
+
+        /**
+         * @brief 构造多宇宙数据块上的视图
+         * @param universe 15 位端口地址
+         * @param block 连续数据块，不足 offset + 512 字节时复制并补零
+         * @param offset 本宇宙在数据块中的起始字节
+         */
+        DmxUniverseData(int universe, const QByteArray& block, int offset = 0);
+
+        QtNodes::NodeDataType type() const override;
+
+        int universe() const { return m_universe; }
+        int net() const { return (m_universe >> 8) & 0x7F; }
+        int subnet() const { return (m_universe >> 4) & 0x0F; }
+        int universeInSubnet() const { return m_universe & 0x0F; }
+        void setUniverse(int universe) { m_universe = universe & 0x7FFF; }
+
+        qint64 timestamp() const { return m_timestamp; }
+        void setTimestamp(qint64 timestamp) { m_timestamp = timestamp; }
+
+        /**
+         * @brief 只读通道数据（512 字节）
+         */
+        const uchar* data() const {
+            return reinterpret_cast<const uchar*>(m_block.constData()) + m_offset;
+        }
+
+        int size() const { return ChannelCount; }
+
+        /**
+         * @brief 读取单个通道（0 起始），越界返回 0
+         */
+        uchar channel(int index) const {
+            return (index >= 0 && index < ChannelCount) ? data()[index] : 0;
+        }
+
+        /**
+         * @brief 以 QByteArray 返回 512 字节通道数据；独占存储时共享数据不复制
+         */
+        QByteArray toByteArray() const;
+
+        /**
+         * @brief 写入通道数据，不足 512 字节的部分补零
+         * - 独占存储且未被共享时原地写入，不分配内存；视图或共享时先复制为独占存储
+         */
+        void setChannels(const char* source, int length);
+        void setChannels(const QByteArray& source) { setChannels(source.constData(), source.size()); }
+
+        /**
+         * @brief 改为引用另一个数据块（不复制）
+         */
+        void setBlock(const QByteArray& block, int offset = 0);
+
+        /**
+         * @brief 转为旧格式 Art-Net 数据包（protocol/universe/subnet/net/fullUniverse/dmxData...）
+         */
+        QVariantMap toArtnetPacket() const;
+
+        /**
+         * @brief 转为 VariableData（"default" 为 toArtnetPacket()），供只接受 VariableData 的节点使用
+         */
+        std::shared_ptr<VariableData> toVariableData() const;
+
+        /**
+         * @brief 从旧格式 Art-Net 数据包构造；"dmxData" 可为整数列表或 QByteArray
+         * @return 不是 Art-Net 数据包时返回 nullptr
+         */
+        static std::shared_ptr<DmxUniverseData> fromVariableData(const VariableData& data);
+
+    private:
+        QByteArray m_block;     // 独占的 512 字节或多宇宙数据块
+        int m_offset = 0;       // 本宇宙在数据块中的起始字节
+        int m_universe = 0;     // 15 位端口地址
+        qint64 m_timestamp = 0; // 数据时间戳（毫秒）
+    };
+}
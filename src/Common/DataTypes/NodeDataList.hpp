@@ -1,4 +1,5 @@
 #include "AudioData.h"
+#include "DmxUniverseData.h"
 #include  "ImageData.h"
 #include "RectsData.h"
 #include "RectData.h"
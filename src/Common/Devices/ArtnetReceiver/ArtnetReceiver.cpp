@@ -3,17 +3,43 @@
 //
 
 #include "ArtnetReceiver.h"
-#include <QJsonObject>
 #include <QByteArray>
 #include <QHostAddress>
-#include "tinyosc.h"
+#include <QNetworkInterface>
+#include <QDateTime>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <QThread>
 #include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr quint16 ARTNET_PORT = 6454;
+    constexpr quint16 OP_POLL = 0x2000;
+    constexpr quint16 OP_DMX = 0x5000;
+    constexpr quint16 OP_SYNC = 0x5200;
+    constexpr quint16 OP_POLL_REPLY = 0x2100;
+    constexpr int ARTDMX_HEADER_SIZE = 18;
+    constexpr int POLL_REPLY_SIZE = 239;
+    const char ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00};
+}
+
+ArtnetReceiver* ArtnetReceiver::getInstance() {
+    static ArtnetReceiver* instance = new ArtnetReceiver();
+    return instance;
+}
+
 ArtnetReceiver::ArtnetReceiver(QObject *parent)
-        : QObject(parent), mUniverse(-1), mSocket(nullptr) ,result(QVariantMap()){
-    // 启动线程
-    qRegisterMetaType<QVariantMap >("QVariantMap&");
+        : QObject(parent), mSocket(nullptr),
+          mReceiveBuffer(MaxDatagramSize),
+          mUniverses(MaxUniverses) {
     //注册信号传递数值类型
+    qRegisterMetaType<ArtnetUniverseFrame>("ArtnetUniverseFrame");
+    mPendingSync.reserve(256);
+    mClock.start();
+
+    // 启动线程
     mThread = new QThread(this);
     this->moveToThread(mThread);
     connect(mThread, &QThread::started, this, &ArtnetReceiver::initializeSocket);
@@ -30,7 +56,8 @@ ArtnetReceiver::~ArtnetReceiver() {
 void ArtnetReceiver::initializeSocket() {
     mSocket = new QUdpSocket(this);
 
-    if (mSocket->bind(QHostAddress::AnyIPv4, 6454,QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+    if (mSocket->bind(QHostAddress::AnyIPv4, ARTNET_PORT,QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+        buildPollReply();
         connect(mSocket, &QUdpSocket::readyRead, this, &ArtnetReceiver::processPendingDatagrams);
     }
 }
@@ -43,57 +70,295 @@ void ArtnetReceiver::cleanup() {
     }
 }
 
+/**
+ * 函数级注释：订阅宇宙数据变化
+ * - 处理由 SLOT() 宏传入的方法签名，只保留函数名
+ * - 同一对象对同一宇宙、同一槽函数的重复订阅将被忽略
+ */
+void ArtnetReceiver::subscribe(int universe, QObject* receiver, const char* method) {
+    if (!receiver || !method || universe < -1 || universe >= MaxUniverses) {
+        return;
+    }
+    QByteArray sig(method);
+    if (!sig.isEmpty() && sig[0] >= '0' && sig[0] <= '2') {
+        sig = sig.mid(1);
+    }
+    const int parenIndex = sig.indexOf('(');
+    if (parenIndex > 0) {
+        sig = sig.left(parenIndex);
+    }
+
+    QWriteLocker locker(&mSubscriberLock);
+    QVector<Endpoint>& list = mSubscribers[universe];
+    for (const Endpoint& ep : list) {
+        if (ep.target == receiver && ep.method == sig) {
+            return;
+        }
+    }
+    list.push_back(Endpoint{receiver, sig});
+}
+
+void ArtnetReceiver::unsubscribe(QObject* receiver) {
+    if (!receiver) {
+        return;
+    }
+    QWriteLocker locker(&mSubscriberLock);
+    for (auto it = mSubscribers.begin(); it != mSubscribers.end();) {
+        QVector<Endpoint>& list = it.value();
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [receiver](const Endpoint& ep) {
+                                      return ep.target == receiver || ep.target.isNull();
+                                  }),
+                   list.end());
+        if (list.isEmpty()) {
+            it = mSubscribers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ArtnetReceiver::universeData(int universe, ArtnetUniverseFrame& frame) const {
+    if (universe < 0 || universe >= MaxUniverses) {
+        return false;
+    }
+    QReadLocker locker(&mTableLock);
+    const UniverseState* state = mUniverses[universe].get();
+    if (!state) {
+        return false;
+    }
+    frame.universe = static_cast<quint16>(universe);
+    frame.sequence = state->sequence;
+    frame.physical = state->physical;
+    frame.timestamp = state->timestamp;
+    frame.host = QHostAddress(state->sourceIp).toString();
+    frame.dmxData = QByteArray(state->dmx.data(), DmxSize);
+    return true;
+}
+
+ArtnetReceiveStats ArtnetReceiver::getStats() const {
+    ArtnetReceiveStats stats;
+    stats.receivedPackets = mReceivedPackets.load(std::memory_order_relaxed);
+    stats.dmxPackets = mDmxPackets.load(std::memory_order_relaxed);
+    stats.unchangedFrames = mUnchangedFrames.load(std::memory_order_relaxed);
+    stats.outOfOrderFrames = mOutOfOrderFrames.load(std::memory_order_relaxed);
+    stats.notifiedFrames = mNotifiedFrames.load(std::memory_order_relaxed);
+    stats.pollReplies = mPollReplies.load(std::memory_order_relaxed);
+    stats.universeCount = mUniverseCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * 函数级注释：读取并原地解析所有待处理数据报
+ * - 数据报直接读入预分配缓冲，不为每个数据报分配 QByteArray
+ * - 按操作码分发：OpDmx 写入宇宙表，OpSync 释放同步缓存，OpPoll 回复 OpPollReply
+ */
 void ArtnetReceiver::processPendingDatagrams() {
+    const qint64 nowMs = mClock.elapsed();
+    const qint64 epochMs = QDateTime::currentMSecsSinceEpoch();
+    QHostAddress sender;
+    quint16 senderPort = 0;
+
     while (mSocket && mSocket->hasPendingDatagrams()) {
-        QByteArray datagram;
-        datagram.resize(mSocket->pendingDatagramSize());
-        QHostAddress sender;
-        quint16 senderPort;
-        mSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-        // 解析 Art-Net 数据包
-        if (datagram.size() < 18) {
-//            qWarning() << "Invalid Art-Net packet";
+        const qint64 size = mSocket->readDatagram(mReceiveBuffer.data(), static_cast<qint64>(mReceiveBuffer.size()),
+                                                  &sender, &senderPort);
+        // 检查标识符 "Art-Net\0" 与操作码
+        if (size < 10 || std::memcmp(mReceiveBuffer.data(), ARTNET_ID, sizeof(ARTNET_ID)) != 0) {
             continue;
         }
+        mReceivedPackets.fetch_add(1, std::memory_order_relaxed);
 
-        // 检查标识符 "Art-Net"
-        const char *header = datagram.constData();
-        if (strncmp(header, "Art-Net", 7) != 0) {
-//            qWarning() << "Not an Art-Net packet";
-            continue;
+        const char* packet = mReceiveBuffer.data();
+        const quint16 opCode = qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(packet + 8));
+        switch (opCode) {
+            case OP_DMX:
+                handleDmx(packet, static_cast<int>(size), sender.toIPv4Address(), nowMs, epochMs);
+                break;
+            case OP_SYNC:
+                handleSync(nowMs);
+                break;
+            case OP_POLL:
+                handlePoll(sender);
+                break;
+            default:
+                break;
         }
-        // 提取操作码
-        quint16 opCode = qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(header + 8));
-        result.clear();
-
-        if (opCode == 0x5000) { // OpDmx
-            result["universe"] = qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(header + 14));
-            result["sequence"] = static_cast<quint8>(header[12]);
-            result["physical"] = static_cast<quint8>(header[13]);
-            result["host"]=sender.toString();
-
-            // 获取数据包中的DMX数据长度
-            quint16 dmxDataLength = qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(header + 16));
-            // 检查数据包大小
-            if (datagram.size() < 18) {
-                qWarning() << "无效的Art-Net数据包大小";
-                continue;
-            }
+    }
 
-            // 提取DMX数据并填充到512字节
-            QByteArray dmxData;
-            if (datagram.size() >= 18) {
-                // 提取实际数据并填充到512字节
-                dmxData = datagram.mid(18).leftJustified(512, 0x00);
-            }
-            result["hex"]= dmxData.toHex();
-            result["default"] = dmxData;
-            if(mUniverse==-1||mUniverse==result["universe"].toInt())
-                emit receiveArtnet(result);
+    // 发送端停止发送 OpSync 后退出同步模式，释放仍在等待的变化
+    if (!mPendingSync.empty() && (mLastSyncMs < 0 || nowMs - mLastSyncMs > SyncTimeoutMs)) {
+        flushPendingSync();
+    }
+}
+
+/**
+ * 函数级注释：处理 OpDmx
+ * - 端口地址取低 15 位；数据长度为大端序，按实际数据报长度与 512 截断，其余通道视为 0
+ * - 序列号非 0 且距上次接收未超时时，丢弃不比上次新的包（乱序/重复）
+ * - 内容未变化时只更新序列号与时间戳，不通知
+ */
+void ArtnetReceiver::handleDmx(const char* packet, int size, quint32 sourceIp, qint64 nowMs, qint64 epochMs) {
+    if (size < ARTDMX_HEADER_SIZE) {
+        return;
+    }
+    mDmxPackets.fetch_add(1, std::memory_order_relaxed);
+
+    const quint8 sequence = static_cast<quint8>(packet[12]);
+    const quint8 physical = static_cast<quint8>(packet[13]);
+    const quint16 universe = qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(packet + 14)) & 0x7FFF;
+    const int declaredLength = qFromBigEndian<quint16>(reinterpret_cast<const uchar*>(packet + 16));
+    const int length = std::min({declaredLength, size - ARTDMX_HEADER_SIZE, DmxSize});
+    const char* dmx = packet + ARTDMX_HEADER_SIZE;
+
+    QWriteLocker locker(&mTableLock);
+    std::unique_ptr<UniverseState>& slot = mUniverses[universe];
+    const bool isNew = !slot;
+    if (isNew) {
+        slot = std::make_unique<UniverseState>();
+        mUniverseCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    UniverseState& state = *slot;
+
+    const bool sequenceValid = !isNew && sequence != 0 && state.sequence != 0 &&
+                               nowMs - state.lastReceivedMs <= SequenceTimeoutMs;
+    if (sequenceValid && static_cast<qint8>(sequence - state.sequence) <= 0) {
+        mOutOfOrderFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    state.sequence = sequence;
+    state.physical = physical;
+    state.timestamp = epochMs;
+    state.lastReceivedMs = nowMs;
+    state.sourceIp = sourceIp;
+
+    const bool changed = std::memcmp(state.dmx.data(), dmx, length) != 0 ||
+                         std::any_of(state.dmx.begin() + length, state.dmx.end(), [](char c) { return c != 0; });
+    if (!changed && !isNew) {
+        mUnchangedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::memcpy(state.dmx.data(), dmx, length);
+    std::memset(state.dmx.data() + length, 0, DmxSize - length);
+    locker.unlock();
+
+    // 同步模式：等待 OpSync 统一通知
+    if (mLastSyncMs >= 0 && nowMs - mLastSyncMs <= SyncTimeoutMs) {
+        if (!state.pendingSync) {
+            state.pendingSync = true;
+            mPendingSync.push_back(universe);
         }
+        return;
     }
+    notifyUniverse(universe, state);
+}
+
+void ArtnetReceiver::handleSync(qint64 nowMs) {
+    mLastSyncMs = nowMs;
+    flushPendingSync();
 }
 
-void ArtnetReceiver::universeFilter(const int &uni) {
-    mUniverse = uni;
+void ArtnetReceiver::flushPendingSync() {
+    for (quint16 universe : mPendingSync) {
+        UniverseState* state = mUniverses[universe].get();
+        if (state) {
+            state->pendingSync = false;
+            notifyUniverse(universe, *state);
+        }
+    }
+    mPendingSync.clear();
+}
+
+/**
+ * 函数级注释：回复 OpPoll（单播回发送端 6454 端口）
+ */
+void ArtnetReceiver::handlePoll(const QHostAddress& sender) {
+    if (mPollReply.isEmpty() || sender.isNull()) {
+        return;
+    }
+    if (mSocket->writeDatagram(mPollReply, sender, ARTNET_PORT) > 0) {
+        mPollReplies.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * 函数级注释：预构建 OpPollReply
+ * - 本机地址取第一个非回环 IPv4 地址
+ * - 声明一个可从 Art-Net 输出 DMX512 的端口，支持 15 位端口地址
+ */
+void ArtnetReceiver::buildPollReply() {
+    QHostAddress localAddress;
+    for (const QHostAddress& address : QNetworkInterface::allAddresses()) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol && !address.isLoopback()) {
+            localAddress = address;
+            break;
+        }
+    }
+    const quint32 ip = localAddress.toIPv4Address();
+
+    mPollReply.fill(0x00, POLL_REPLY_SIZE);
+    uchar* reply = reinterpret_cast<uchar*>(mPollReply.data());
+    std::memcpy(reply, ARTNET_ID, sizeof(ARTNET_ID));
+    qToLittleEndian<quint16>(OP_POLL_REPLY, reply + 8);
+    qToBigEndian<quint32>(ip, reply + 10);            // IP 地址
+    qToLittleEndian<quint16>(ARTNET_PORT, reply + 14); // 端口
+    reply[17] = 0x01;                                 // 固件版本
+    reply[23] = 0xD0;                                 // Status1：指示灯正常，端口地址由面板设置
+
+    const QByteArray shortName("Flow");
+    const QByteArray longName("Flow Art-Net Receiver");
+    const QByteArray nodeReport("#0001 [0000] Flow Art-Net receiver ready");
+    std::memcpy(reply + 26, shortName.constData(), std::min<int>(shortName.size(), 17));
+    std::memcpy(reply + 44, longName.constData(), std::min<int>(longName.size(), 63));
+    std::memcpy(reply + 108, nodeReport.constData(), std::min<int>(nodeReport.size(), 63));
+
+    qToBigEndian<quint16>(1, reply + 172);            // 端口数量
+    reply[174] = 0x80;                                // PortTypes：可从 Art-Net 输出 DMX512
+    reply[182] = 0x80;                                // GoodOutput：正在输出数据
+    reply[200] = 0x00;                                // Style：StNode
+    qToBigEndian<quint32>(ip, reply + 207);           // BindIp
+    reply[211] = 0x01;                                // BindIndex
+    reply[212] = 0x08;                                // Status2：支持 15 位端口地址
+}
+
+/**
+ * 函数级注释：通知订阅了该宇宙的对象
+ * - 没有订阅者时直接返回，不构造任何数据
+ * - 构造一次 ArtnetUniverseFrame，由所有订阅者共享（QByteArray 隐式共享）
+ * - 使用 Qt::QueuedConnection 投递到订阅者所在线程
+ */
+void ArtnetReceiver::notifyUniverse(quint16 universe, const UniverseState& state) {
+    QReadLocker locker(&mSubscriberLock);
+    const auto specific = mSubscribers.constFind(universe);
+    const auto all = mSubscribers.constFind(-1);
+    if (specific == mSubscribers.constEnd() && all == mSubscribers.constEnd()) {
+        return;
+    }
+
+    ArtnetUniverseFrame frame;
+    frame.universe = universe;
+    frame.sequence = state.sequence;
+    frame.physical = state.physical;
+    frame.timestamp = state.timestamp;
+    frame.host = QHostAddress(state.sourceIp).toString();
+    frame.dmxData = QByteArray(state.dmx.data(), DmxSize);
+
+    auto deliver = [&frame](const QVector<Endpoint>& endpoints) {
+        for (const Endpoint& ep : endpoints) {
+            if (!ep.target) {
+                continue;
+            }
+            QMetaObject::invokeMethod(ep.target,
+                                      ep.method.constData(),
+                                      Qt::QueuedConnection,
+                                      Q_ARG(ArtnetUniverseFrame, frame));
+        }
+    };
+    if (specific != mSubscribers.constEnd()) {
+        deliver(specific.value());
+    }
+    if (all != mSubscribers.constEnd()) {
+        deliver(all.value());
+    }
+    mNotifiedFrames.fetch_add(1, std::memory_order_relaxed);
 }
@@ -7,27 +7,145 @@
 #include <QObject>
 #include "QThread"
 #include <QtNetwork/QUdpSocket>
+#include <QtNetwork/QHostAddress>
 #include <QVariant>
+#include <QHash>
+#include <QPointer>
+#include <QReadWriteLock>
+#include <QElapsedTimer>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 单个宇宙的DMX数据（发送给订阅者）
+ * dmxData 固定 512 字节，同一次变化的所有订阅者共享同一份数据
+ */
+struct ArtnetUniverseFrame {
+    quint16 universe = 0;   // 15 位端口地址（Net/SubNet/Universe）
+    quint8 sequence = 0;    // ArtDmx 序列号
+    quint8 physical = 0;    // 发送端物理端口
+    qint64 timestamp = 0;   // 接收时间（毫秒，Epoch）
+    QString host;           // 发送端地址
+    QByteArray dmxData;     // DMX 数据（512 字节）
+};
+Q_DECLARE_METATYPE(ArtnetUniverseFrame)
+
+/**
+ * @brief Art-Net接收统计
+ */
+struct ArtnetReceiveStats {
+    quint64 receivedPackets = 0;   // 收到的 Art-Net 数据包
+    quint64 dmxPackets = 0;        // 其中 OpDmx 数据包
+    quint64 unchangedFrames = 0;   // 内容未变化、未通知的 OpDmx
+    quint64 outOfOrderFrames = 0;  // 按序列号判定为乱序/重复而丢弃的 OpDmx
+    quint64 notifiedFrames = 0;    // 触发订阅通知的宇宙变化次数
+    quint64 pollReplies = 0;       // 回复的 OpPollReply
+    int universeCount = 0;         // 已收到过数据的宇宙数
+};
+
+/**
+ * @brief Art-Net接收器（进程内单例，所有 Art-Net 输入节点共享一个套接字）
+ * - 数据报读入预分配缓冲并原地解析，DMX 数据写入稀疏宇宙表（宇宙首次出现时分配一次，之后不再分配）
+ * - 每个宇宙记录序列号与接收时间，按 Art-Net 规范丢弃乱序/重复包（序列号为 0 时不校验）
+ * - 内容变化时才通知，且只通知订阅了该宇宙的对象（universe = -1 表示订阅全部）
+ * - 支持 OpPoll（回复 OpPollReply）与 OpSync（同步模式下 DMX 变化缓存到 OpSync 到达后统一通知）
+ */
 class ArtnetReceiver:public QObject {
     Q_OBJECT
 public:
-    explicit ArtnetReceiver(QObject *parent = nullptr);
-    ~ArtnetReceiver();
+    static constexpr int MaxUniverses = 32768;      // 15 位端口地址
+    static constexpr int DmxSize = 512;
+    static constexpr int MaxDatagramSize = 1500;    // 接收缓冲（以太网 MTU）
+    static constexpr qint64 SequenceTimeoutMs = 1000; // 超过该时间未收到则不做序列号校验（发送端重启）
+    static constexpr qint64 SyncTimeoutMs = 4000;   // 超过该时间未收到 OpSync 则退出同步模式
+
+    /**
+     * @brief 获取单例实例
+     */
+    static ArtnetReceiver* getInstance();
+
+    /**
+     * @brief 订阅宇宙数据变化
+     * @param universe 宇宙编号，-1 表示全部
+     * @param receiver 槽函数所在对象
+     * @param method 槽函数签名，形式如 SLOT(onArtnetUniverse(ArtnetUniverseFrame))
+     */
+    void subscribe(int universe, QObject* receiver, const char* method);
+
+    /**
+     * @brief 取消某对象的全部订阅
+     */
+    void unsubscribe(QObject* receiver);
+
+    /**
+     * @brief 读取宇宙当前数据快照
+     * @return false 表示该宇宙尚未收到数据
+     */
+    bool universeData(int universe, ArtnetUniverseFrame& frame) const;
 
-signals:
-    void receiveArtnet(QVariantMap &data);
+    ArtnetReceiveStats getStats() const;
 
 public slots:
     void processPendingDatagrams();  // 处理接收到的UDP数据
-    void universeFilter(const int &uni);
     void initializeSocket();
     void cleanup();
+
 private:
-    int mUniverse;
-    QString mHost;
+    explicit ArtnetReceiver(QObject *parent = nullptr);
+    ~ArtnetReceiver();
+    ArtnetReceiver(const ArtnetReceiver&) = delete;
+    ArtnetReceiver& operator=(const ArtnetReceiver&) = delete;
+
+    /**
+     * @brief 宇宙表项（仅接收线程写入，读取快照时持表锁）
+     */
+    struct UniverseState {
+        std::array<char, DmxSize> dmx{};
+        quint8 sequence = 0;
+        quint8 physical = 0;
+        qint64 timestamp = 0;        // 接收时间（毫秒，Epoch）
+        qint64 lastReceivedMs = -1;  // 单调时钟，用于序列号超时
+        quint32 sourceIp = 0;
+        bool pendingSync = false;    // 同步模式下等待 OpSync 的变化
+    };
+
+    struct Endpoint {
+        QPointer<QObject> target;
+        QByteArray method;
+    };
+
+    void handleDmx(const char* packet, int size, quint32 sourceIp, qint64 nowMs, qint64 epochMs);
+    void handleSync(qint64 nowMs);
+    void flushPendingSync();
+    void handlePoll(const QHostAddress& sender);
+    void buildPollReply();
+
+    /**
+     * @brief 通知订阅了该宇宙的对象（在接收线程中构造一次 ArtnetUniverseFrame，队列投递）
+     */
+    void notifyUniverse(quint16 universe, const UniverseState& state);
+
     QThread *mThread;
     QUdpSocket *mSocket;
-    QVariantMap result;
-};
 
+    std::vector<char> mReceiveBuffer;                      // 预分配接收缓冲
+    std::vector<std::unique_ptr<UniverseState>> mUniverses; // 稀疏宇宙表，按宇宙编号索引
+    mutable QReadWriteLock mTableLock;
+    std::vector<quint16> mPendingSync;                     // 同步模式下待通知的宇宙
+    qint64 mLastSyncMs = -1;                               // 最近一次 OpSync（单调时钟）
+    QElapsedTimer mClock;
+    QByteArray mPollReply;                                 // 预构建的 OpPollReply
 
+    mutable QReadWriteLock mSubscriberLock;
+    QHash<int, QVector<Endpoint>> mSubscribers;            // 宇宙 → 订阅者（-1 为全部）
+
+    std::atomic<quint64> mReceivedPackets{0};
+    std::atomic<quint64> mDmxPackets{0};
+    std::atomic<quint64> mUnchangedFrames{0};
+    std::atomic<quint64> mOutOfOrderFrames{0};
+    std::atomic<quint64> mNotifiedFrames{0};
+    std::atomic<quint64> mPollReplies{0};
+    std::atomic<int> mUniverseCount{0};
+};
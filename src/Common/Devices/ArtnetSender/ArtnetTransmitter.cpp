@@ -5,8 +5,28 @@
 #include "ArtnetTransmitter.h"
 #include <QHostAddress>
 #include <QtEndian>
-#include <QMutexLocker>
+#include <QMetaMethod>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <QDebug>
+#include <algorithm>
+#include <cstring>
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <arpa/inet.h>
+#endif
+
+namespace {
+    // 单次 sendmmsg 最多提交的数据包数（不超过内核 UIO_MAXIOV）
+    constexpr size_t MaxPacketsPerSyscall = 1024;
+    // 发送缓冲区大小：数千个宇宙一次刷新约数 MB
+    constexpr int SendBufferSize = 4 * 1024 * 1024;
+
+    int refreshIntervalMs(double hz)
+    {
+        return qMax(1, qRound(1000.0 / hz));
+    }
+}
 
 // 声明全局静态实例
 ArtnetTransmitter* ArtnetTransmitter::artnetInstance = nullptr;
@@ -21,37 +41,36 @@ ARTNETTRANSMITTER_EXPORT ArtnetTransmitter* getArtnetTransmitterInstance()
 
 /**
  * @brief 私有构造函数，自动启动UDP套接字服务
+ * 按配置的刷新率设置定时器，并在独立线程中初始化定时器与套接字
  */
 ArtnetTransmitter::ArtnetTransmitter(QObject* parent)
     : QObject(parent), mQueueTimer (new QTimer(this))
 {
-    /**
-     * @brief 构造函数中设置发送间隔为25ms，并在独立线程中初始化定时器与套接字
-     */
     // 注册信号传递数值类型
     qRegisterMetaType<ArtnetFrame>("ArtnetFrame");
     qRegisterMetaType<ArtnetFrame>("ArtnetFrame&");
     qRegisterMetaType<QList<ArtnetFrame>>("QList<ArtnetFrame>");
 
+    const double configuredRate = ConfigManager::instance().getArtnetRefreshRate();
+    mRefreshRate.store(configuredRate > 0.0 ? qMin(configuredRate, MaxRefreshRate) : MaxRefreshRate,
+                       std::memory_order_relaxed);
+    mClock.start();
+
     // 创建工作线程
     mThread = new QThread(this);
     this->moveToThread(mThread);
 
-    mQueueTimer ->setInterval(mSendInterval);
+    mQueueTimer->setTimerType(Qt::PreciseTimer);
+    mQueueTimer->setInterval(refreshIntervalMs(refreshRate()));
     mQueueTimer ->moveToThread(mThread);
     connect(mThread , &QThread::started, this, &ArtnetTransmitter::initializeSocket);
     connect(mThread , &QThread::finished, this, &ArtnetTransmitter::cleanup);
     connect(mQueueTimer , &QTimer::timeout, this, &ArtnetTransmitter::processQueue);
-    
-    // 自动启动传输器
-    mThread->start();
-    // 在主线程中启动定时器
-    QMetaObject::invokeMethod(mQueueTimer, "start", Qt::QueuedConnection);
-    // 连接线程信号
-  
 
     // 启动线程，自动初始化套接字
     mThread->start();
+    // 在工作线程中启动定时器
+    QMetaObject::invokeMethod(mQueueTimer, "start", Qt::QueuedConnection);
 }
 
 /**
@@ -64,12 +83,14 @@ ArtnetTransmitter::~ArtnetTransmitter()
         mThread->wait();
     }
 }
+
 void ArtnetTransmitter::initializeSocket() {
     mSocket = new QUdpSocket(this);
     if (mSocket->bind(QHostAddress::AnyIPv4, 0,QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint)) {
-        // connect(mQueueTimer, &QTimer::timeout, this, &ArtnetTransmitter::onQueueTimer);
+        mSocket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, SendBufferSize);
     }
 }
+
 /**
  * @brief 获取单例实例
  */
@@ -81,8 +102,6 @@ ArtnetTransmitter* ArtnetTransmitter::getInstance()
     return artnetInstance;
 }
 
-
-
 /**
  * @brief 清理资源
  */
@@ -93,187 +112,402 @@ void ArtnetTransmitter::cleanup()
         mQueueTimer->deleteLater();
         mQueueTimer = nullptr;
     }
-    
+
     if (mSocket) {
         mSocket->deleteLater();
         mSocket = nullptr;
     }
-    
+
     qDebug() << "Art-Net transmitter cleaned up";
 }
 
 /**
- * @brief 批量添加Art-Net数据帧到发送队列
+ * @brief 设置每个宇宙的刷新率，定时器间隔在工作线程中更新
  */
-void ArtnetTransmitter::enqueueFrames(const QList<ArtnetFrame>& frames)
+void ArtnetTransmitter::setRefreshRate(double hz)
 {
-    QMutexLocker locker(&mMutex);
+    if (hz <= 0.0) {
+        return;
+    }
+    const double rate = qMin(hz, MaxRefreshRate);
+    mRefreshRate.store(rate, std::memory_order_relaxed);
+    QMetaObject::invokeMethod(this, [this, rate]() {
+        if (mQueueTimer) {
+            mQueueTimer->setInterval(refreshIntervalMs(rate));
+        }
+    }, Qt::QueuedConnection);
+}
 
+/**
+ * @brief 批量写入Art-Net数据帧
+ */
+void ArtnetTransmitter::enqueueFrames(const QList<ArtnetFrame>& frames)
+{
     for (const ArtnetFrame& frame : frames) {
-        if (frame.isValid()) {
-            mSendQueue.enqueue(frame);
-        } else {
-            qWarning() << "Skipping invalid frame in batch";
-        }
+        enqueueFrame(frame);
     }
-    
-    int queueSize = mSendQueue.size();
-    locker.unlock();
-    
-    emit queueSizeChanged(queueSize);
-    //
-    // qDebug() << "Enqueued" << frames.size() << "frames, queue size:" << queueSize;
 }
+
 /**
- * @brief 单独添加Art-Net数据帧到发送队列
+ * @brief 写入单个Art-Net数据帧
+ *
+ * 在读锁下查找槽位并覆盖数据；槽位不存在时才取写锁创建（只解析一次主机地址）。
  */
 void ArtnetTransmitter::enqueueFrame(const ArtnetFrame& frame)
 {
-    QMutexLocker locker(&mMutex);
+    const SlotKey key{frame.host, frame.port, frame.universe};
+
+    QReadLocker locker(&mSlotLock);
+    UniverseSlot* slot = mSlotIndex.value(key, nullptr);
+    if (!slot) {
+        locker.unlock();
+        if (frame.dmxData.size() > DmxSize || !createSlot(key)) {
+            mDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+            qWarning() << "Skipping invalid Art-Net frame" << frame.host << frame.universe;
+            return;
+        }
+        locker.relock();
+        slot = mSlotIndex.value(key, nullptr);
+        if (!slot) {
+            // 创建后立即被 clearQueue() 清空
+            mDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    writeSlot(slot, frame);
+}
+
+/**
+ * @brief 创建槽位
+ *
+ * 套接字绑定在 IPv4 上，因此只接受 IPv4 目标地址。
+ */
+bool ArtnetTransmitter::createSlot(const SlotKey& key)
+{
+    if (key.universe > 32767 || key.port == 0) {
+        return false;
+    }
+    QHostAddress address(key.host);
+    if (address.isNull() || address.protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
 
+    auto slot = std::make_unique<UniverseSlot>();
+    slot->host = key.host;
+    slot->port = key.port;
+    slot->universe = key.universe;
+    slot->address = address;
+#ifdef Q_OS_LINUX
+    slot->sockAddr.sin_family = AF_INET;
+    slot->sockAddr.sin_port = htons(key.port);
+    slot->sockAddr.sin_addr.s_addr = htonl(address.toIPv4Address());
+#endif
+    buildPacketHeader(slot.get());
 
-    if (frame.isValid()) {
-        mSendQueue.enqueue(frame);
-    } else {
-        qWarning() << "Skipping invalid frame in batch";
+    QWriteLocker locker(&mSlotLock);
+    if (mSlotIndex.contains(key)) {
+        return true;
     }
+    mSlotIndex.insert(key, slot.get());
+    mSlots.push_back(std::move(slot));
+    return true;
+}
 
+/**
+ * @brief 将帧数据写入槽位
+ *
+ * - 内容与槽位相同的帧直接忽略，不触发发送
+ * - 槽位上一次写入尚未发送即被覆盖时计为合并
+ */
+void ArtnetTransmitter::writeSlot(UniverseSlot* slot, const ArtnetFrame& frame)
+{
+    const int length = qMin<int>(frame.dmxData.size(), DmxSize);
+    const char* data = frame.dmxData.constData();
 
-    int queueSize = mSendQueue.size();
-    locker.unlock();
+    while (slot->writeLock.test_and_set(std::memory_order_acquire)) {
+        QThread::yieldCurrentThread();
+    }
 
-    emit queueSizeChanged(queueSize);
+    const bool unchanged = std::memcmp(slot->dmx.data(), data, length) == 0 &&
+                           std::all_of(slot->dmx.begin() + length, slot->dmx.end(), [](char c) { return c == 0; });
+    if (unchanged) {
+        slot->writeLock.clear(std::memory_order_release);
+        mUnchangedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const quint32 version = slot->version.load(std::memory_order_relaxed);
+    if (version != slot->sentVersion.load(std::memory_order_relaxed)) {
+        mCoalescedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot->version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot->dmx.data(), data, length);
+    std::memset(slot->dmx.data() + length, 0, DmxSize - length);
+    slot->version.store(version + 2, std::memory_order_release);
+
+    slot->writeLock.clear(std::memory_order_release);
 }
+
 /**
- * @brief 清空发送队列
+ * @brief 清空槽位表
  */
 void ArtnetTransmitter::clearQueue()
 {
-    QMutexLocker locker(&mMutex);
-    mSendQueue.clear();
+    QWriteLocker locker(&mSlotLock);
+    mSlotIndex.clear();
+    mSlots.clear();
     locker.unlock();
-    
+
     emit queueSizeChanged(0);
-    qDebug() << "Send queue cleared";
+    qDebug() << "Art-Net universe slots cleared";
 }
 
 /**
- * @brief 获取队列中待发送的帧数量
+ * @brief 获取待发送（有变化）的宇宙数量
  */
 int ArtnetTransmitter::getQueueSize() const
 {
-    QMutexLocker locker(&mMutex);
-    return mSendQueue.size();
+    QReadLocker locker(&mSlotLock);
+    int pending = 0;
+    for (const auto& slot : mSlots) {
+        if (slot->version.load(std::memory_order_acquire) != slot->sentVersion.load(std::memory_order_relaxed)) {
+            ++pending;
+        }
+    }
+    return pending;
 }
 
-    /**
-     * @brief 批量发送队列中的所有帧
-     *
-     * 为减少锁持有时间，先将当前队列中的帧拷贝到本地列表，再释放锁后逐一发送。
-     */
-void ArtnetTransmitter::processQueue()
+ArtnetSendStats ArtnetTransmitter::getStats() const
 {
+    ArtnetSendStats stats;
+    stats.sentPackets = mSentPackets.load(std::memory_order_relaxed);
+    stats.coalescedFrames = mCoalescedFrames.load(std::memory_order_relaxed);
+    stats.unchangedFrames = mUnchangedFrames.load(std::memory_order_relaxed);
+    stats.droppedFrames = mDroppedFrames.load(std::memory_order_relaxed);
+    QReadLocker locker(&mSlotLock);
+    stats.universeCount = static_cast<int>(mSlots.size());
+    return stats;
+}
 
-    QMutexLocker locker(&mMutex);
+void ArtnetTransmitter::resetStats()
+{
+    mSentPackets.store(0, std::memory_order_relaxed);
+    mCoalescedFrames.store(0, std::memory_order_relaxed);
+    mUnchangedFrames.store(0, std::memory_order_relaxed);
+    mDroppedFrames.store(0, std::memory_order_relaxed);
+}
 
-    if (mSendQueue.isEmpty()) {
+/**
+ * @brief 刷新槽位表
+ *
+ * - 只 tryLock：槽位正在创建/清空时跳过本次刷新，发送线程从不等待
+ * - 槽位正在被生产者写入（或拷贝期间被改写）时留到下一次刷新
+ * - 新建槽位与未变化槽位按保活间隔重发
+ */
+void ArtnetTransmitter::processQueue()
+{
+    if (!mSocket) {
         return;
     }
-
-    // 将当前队列全部取出到本地列表
-    QList<ArtnetFrame> framesToSend;
-    framesToSend.reserve(mSendQueue.size());
-    while (!mSendQueue.isEmpty()) {
-        framesToSend.append(mSendQueue.dequeue());
+    if (!mSlotLock.tryLockForRead()) {
+        return;
     }
-    int queueSize = mSendQueue.size(); // 此处应为0
-    locker.unlock();
 
-    // 逐一发送
-    for (const ArtnetFrame& f : framesToSend) {
-        bool success = sendFrameInternal(f);
-        if (!success) {
-            qWarning() << "Failed to send frame, dropping";
-            // 可选：失败重试或重新入队，这里选择丢弃
+    const qint64 now = mClock.elapsed();
+    int deferred = 0;
+    mPending.clear();
+    for (const auto& owned : mSlots) {
+        UniverseSlot* slot = owned.get();
+        const quint32 version = slot->version.load(std::memory_order_acquire);
+        if (version & 1u) {
+            ++deferred;
+            continue;
+        }
+        const bool changed = version != slot->sentVersion.load(std::memory_order_relaxed);
+        if (!changed && slot->lastSentMs >= 0 && now - slot->lastSentMs < KeepAliveIntervalMs) {
+            continue;
+        }
+
+        std::memcpy(slot->packet.data() + HeaderSize, slot->dmx.data(), DmxSize);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->version.load(std::memory_order_relaxed) != version) {
+            ++deferred;
+            continue;
         }
+
+        // 序列号 1-255 循环，0 表示不启用序列
+        slot->sequence = slot->sequence == 255 ? 1 : static_cast<quint8>(slot->sequence + 1);
+        slot->packet[12] = static_cast<char>(slot->sequence);
+        slot->sentVersion.store(version, std::memory_order_relaxed);
+        slot->lastSentMs = now;
+        mPending.push_back(PendingSend{slot, changed});
     }
 
-    // 队列被清空后广播队列大小
-    emit queueSizeChanged(queueSize);
+    const bool sentAny = !mPending.empty();
+    sendBatch();
+    mSlotLock.unlock();
+
+    if (sentAny) {
+        emit queueSizeChanged(deferred);
+    }
 }
 
- /**
-     * @brief 定时器回调：每25ms检查队列并批量发送
-     */
+/**
+ * @brief 定时器回调：刷新槽位表
+ */
 void ArtnetTransmitter::onQueueTimer()
 {
-   
     processQueue();
 }
 
 /**
- * @brief 实际发送数据包的内部函数
+ * @brief 批量发送本次刷新的数据包
+ *
+ * Linux 下用 sendmmsg 将整批数据包在一次（每 1024 包一次）系统调用中提交；
+ * 发送缓冲区满时剩余数据包丢弃并计数，其余错误回退到逐包发送以获得错误信息。
  */
-bool ArtnetTransmitter::sendFrameInternal(const ArtnetFrame& frame)
+void ArtnetTransmitter::sendBatch()
 {
-    if (!mSocket) {
-        emit frameSendFailed(frame, "Socket not initialized");
-        return false;
+    if (mPending.empty()) {
+        return;
     }
-    
-    // 创建Art-Net数据包
-    QByteArray packet = createArtnetPacket(frame);
-    
-    // 发送数据包
-    QHostAddress targetAddress(frame.host);
-    qint64 bytesWritten = mSocket->writeDatagram(packet, targetAddress, frame.port);
-    
-    if (bytesWritten == -1) {
-        QString errorString = mSocket->errorString();
-        qWarning() << "Failed to send Art-Net packet:" << errorString;
-        emit frameSendFailed(frame, errorString);
-        return false;
-    } else {
-        emit frameSent(frame, bytesWritten);
-        return true;
+#ifdef Q_OS_LINUX
+    const qintptr fd = mSocket->socketDescriptor();
+    if (fd < 0) {
+        sendBatchFallback(0);
+        return;
+    }
+
+    const size_t count = mPending.size();
+    if (mMsgHeaders.size() < count) {
+        mMsgHeaders.resize(count);
+        mIoVectors.resize(count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        UniverseSlot* slot = mPending[i].slot;
+        iovec& iov = mIoVectors[i];
+        iov.iov_base = slot->packet.data();
+        iov.iov_len = static_cast<size_t>(slot->packet.size());
+
+        mmsghdr& msg = mMsgHeaders[i];
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_hdr.msg_name = &slot->sockAddr;
+        msg.msg_hdr.msg_namelen = sizeof(slot->sockAddr);
+        msg.msg_hdr.msg_iov = &iov;
+        msg.msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t offset = 0;
+    while (offset < count) {
+        const unsigned int chunk = static_cast<unsigned int>(std::min(count - offset, MaxPacketsPerSyscall));
+        const int sent = ::sendmmsg(static_cast<int>(fd), mMsgHeaders.data() + offset, chunk, 0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+                break;
+            }
+            sendBatchFallback(offset);
+            return;
+        }
+        for (int i = 0; i < sent; ++i) {
+            notifySent(mPending[offset + i], mMsgHeaders[offset + i].msg_len);
+        }
+        offset += static_cast<size_t>(sent);
+    }
+
+    if (offset < count) {
+        const QString errorString = QStringLiteral("Send buffer full");
+        for (size_t i = offset; i < count; ++i) {
+            notifyFailed(mPending[i], errorString);
+        }
+        qWarning() << "Art-Net send buffer full, dropped" << (count - offset) << "packets";
     }
+#else
+    sendBatchFallback(0);
+#endif
 }
 
 /**
- * @brief 创建Art-Net数据包
+ * @brief 逐包发送，使用槽位缓存的目标地址
  */
-QByteArray ArtnetTransmitter::createArtnetPacket(const ArtnetFrame& frame)
+void ArtnetTransmitter::sendBatchFallback(size_t begin)
 {
-    QByteArray packet;
-    packet.resize(18 + 512); // Art-Net头部18字节 + DMX数据512字节
-    
+    for (size_t i = begin; i < mPending.size(); ++i) {
+        UniverseSlot* slot = mPending[i].slot;
+        const qint64 bytesWritten = mSocket->writeDatagram(slot->packet, slot->address, slot->port);
+        if (bytesWritten == -1) {
+            const QString errorString = mSocket->errorString();
+            qWarning() << "Failed to send Art-Net packet:" << errorString;
+            notifyFailed(mPending[i], errorString);
+        } else {
+            notifySent(mPending[i], bytesWritten);
+        }
+    }
+}
+
+/**
+ * @brief 发送成功通知：仅内容变化的宇宙且有连接时才构造 ArtnetFrame 发信号
+ */
+void ArtnetTransmitter::notifySent(const PendingSend& pending, qint64 bytesWritten)
+{
+    mSentPackets.fetch_add(1, std::memory_order_relaxed);
+
+    static const QMetaMethod sentSignal = QMetaMethod::fromSignal(&ArtnetTransmitter::frameSent);
+    if (!pending.changed || !isSignalConnected(sentSignal)) {
+        return;
+    }
+    const UniverseSlot* slot = pending.slot;
+    ArtnetFrame frame(slot->host, slot->universe,
+                      QByteArray(slot->packet.constData() + HeaderSize, DmxSize), slot->sequence);
+    frame.port = slot->port;
+    emit frameSent(frame, bytesWritten);
+}
+
+void ArtnetTransmitter::notifyFailed(const PendingSend& pending, const QString& errorString)
+{
+    mDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+
+    static const QMetaMethod failedSignal = QMetaMethod::fromSignal(&ArtnetTransmitter::frameSendFailed);
+    if (!isSignalConnected(failedSignal)) {
+        return;
+    }
+    const UniverseSlot* slot = pending.slot;
+    ArtnetFrame frame(slot->host, slot->universe,
+                      QByteArray(slot->packet.constData() + HeaderSize, DmxSize), slot->sequence);
+    frame.port = slot->port;
+    emit frameSendFailed(frame, errorString);
+}
+
+/**
+ * @brief 构建槽位数据包：包头一次写好，发送时只修改序列号与DMX数据
+ */
+void ArtnetTransmitter::buildPacketHeader(UniverseSlot* slot)
+{
+    QByteArray& packet = slot->packet;
+    packet.fill(0x00, HeaderSize + DmxSize); // Art-Net头部18字节 + DMX数据512字节
+
     // Art-Net标识符 "Art-Net\0"
     packet[0] = 'A'; packet[1] = 'r'; packet[2] = 't'; packet[3] = '-';
     packet[4] = 'N'; packet[5] = 'e'; packet[6] = 't'; packet[7] = 0x00;
-    
+
     // 操作码 OpDmx (0x5000) - 小端序
     qToLittleEndian<quint16>(0x5000, reinterpret_cast<uchar*>(packet.data() + 8));
-    
+
     // 协议版本 (0x000E) - 大端序
     qToBigEndian<quint16>(0x000E, reinterpret_cast<uchar*>(packet.data() + 10));
-    
-    // 序列号
-    packet[12] = frame.sequence;
-    
+
+    // 序列号（发送时填写）
+    packet[12] = 0x00;
+
     // 物理端口
     packet[13] = 0x00;
-    
+
     // 宇宙编号 - 小端序
-    qToLittleEndian<quint16>(frame.universe, reinterpret_cast<uchar*>(packet.data() + 14));
-    
+    qToLittleEndian<quint16>(slot->universe, reinterpret_cast<uchar*>(packet.data() + 14));
+
     // 数据长度 (512) - 大端序
-    qToBigEndian<quint16>(512, reinterpret_cast<uchar*>(packet.data() + 16));
-    
-    // DMX数据
-    QByteArray dmxData = frame.getFormattedDmxData();
-    packet.replace(18, 512, dmxData);
-    
-    return packet;
+    qToBigEndian<quint16>(DmxSize, reinterpret_cast<uchar*>(packet.data() + 16));
 }
-
-
@@ -6,11 +6,21 @@
 
 #include <QObject>
 #include <QThread>
-#include <QMutex>
-#include <QQueue>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QElapsedTimer>
 #include <QtNetwork/QUdpSocket>
+#include <QtNetwork/QHostAddress>
 #include <QTimer>
 #include <QtCore/qglobal.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
 #include "ArtnetFrame.h"
 #include "Common/AppConfig/ConfigManager.h"
 #if defined(ARTNETTRANSMITTER_LIBRARY)
@@ -19,21 +29,56 @@
 #define ARTNETTRANSMITTER_EXPORT Q_DECL_IMPORT
 #endif
 
+/**
+ * @brief Art-Net发送统计
+ */
+struct ArtnetSendStats {
+    quint64 sentPackets = 0;      // 已发送数据包数（含保活重发）
+    quint64 coalescedFrames = 0;  // 未发送即被同一宇宙新数据覆盖的帧
+    quint64 unchangedFrames = 0;  // 与当前槽位内容相同而忽略的帧
+    quint64 droppedFrames = 0;    // 无效帧及发送失败的数据包
+    int universeCount = 0;        // 当前槽位（主机+端口+宇宙）数量
+};
+
 /**
  * @brief Art-Net传输器单例类
  * 
- * 专注于Art-Net数据包的发送功能，通过队列机制依次发送ArtnetFrame数据
+ * 专注于Art-Net数据包的发送功能，按 (主机, 端口, 宇宙) 维护最新值槽位表：
+ * - 生产者在调用线程中直接覆盖槽位内的DMX数据（seqlock），不排队，发送线程从不等待生产者
+ * - 发送线程按刷新率（默认44Hz）定时扫描，只发送有变化的宇宙，未变化的宇宙每秒保活重发一次
+ * - 数据包头在槽位创建时预先构建，每次发送只修改序列号和DMX数据
+ * - Linux 下使用 sendmmsg 一次系统调用批量发送，其它平台逐包 writeDatagram
  */
 class ARTNETTRANSMITTER_EXPORT ArtnetTransmitter : public QObject {
     Q_OBJECT
 
 public:
+    static constexpr double MaxRefreshRate = 44.0;    // DMX512 最大刷新率
+    static constexpr qint64 KeepAliveIntervalMs = 1000; // 未变化宇宙的保活重发间隔
+    static constexpr int HeaderSize = 18;             // ArtDmx 包头长度
+    static constexpr int DmxSize = 512;               // DMX 数据长度
+
     /**
      * @brief 获取单例实例
      * @return ArtnetTransmitter* 单例实例指针
      */
     static ArtnetTransmitter* getInstance();
 
+    /**
+     * @brief 获取发送统计（任意线程可调用）
+     */
+    ArtnetSendStats getStats() const;
+
+    /**
+     * @brief 清零发送统计
+     */
+    void resetStats();
+
+    /**
+     * @brief 当前刷新率（Hz）
+     */
+    double refreshRate() const { return mRefreshRate.load(std::memory_order_relaxed); }
+
 private:
     /**
      * @brief 私有构造函数，确保单例模式
@@ -56,28 +101,35 @@ private:
 
 public slots:
     /**
-     * @brief 添加Art-Net数据帧到发送队列
+     * @brief 写入Art-Net数据帧到对应宇宙槽位
+     * 在调用线程中直接覆盖槽位数据，下一次刷新时发送；同一宇宙在两次刷新之间的多次写入只发送最后一次
      * @param frame Art-Net数据帧
      */
     void enqueueFrame(const ArtnetFrame& frame);
 
     /**
-     * @brief 批量添加Art-Net数据帧到发送队列
+     * @brief 批量写入Art-Net数据帧
      * @param frames Art-Net数据帧列表
      */
     void enqueueFrames(const QList<ArtnetFrame>& frames);
 
     /**
-     * @brief 清空发送队列
+     * @brief 清空槽位表（停止发送全部宇宙）
      */
     void clearQueue();
 
     /**
-     * @brief 获取队列中待发送的帧数量
-     * @return int 队列长度
+     * @brief 获取待发送（有变化）的宇宙数量
+     * @return int 待发送宇宙数
      */
     int getQueueSize() const;
 
+    /**
+     * @brief 设置每个宇宙的刷新率
+     * @param hz 刷新率，限制在 (0, 44] Hz
+     */
+    void setRefreshRate(double hz);
+
 signals:
     /**
      * @brief 数据帧发送成功信号
@@ -94,7 +146,7 @@ signals:
     void frameSendFailed(const ArtnetFrame& frame, const QString& errorString);
 
     /**
-     * @brief 队列状态变化信号
+     * @brief 队列状态变化信号（每次刷新后发出仍待发送的宇宙数）
      * @param queueSize 当前队列大小
      */
     void queueSizeChanged(int queueSize);
@@ -111,10 +163,9 @@ private slots:
     void cleanup();
 
     /**
-     * @brief 处理发送队列
+     * @brief 刷新槽位表
      *
-     * 每25ms触发一次，若队列不为空，则一次性取出现有队列中的所有帧并逐一发送。
-     * 发送完成后更新队列大小信号。
+     * 按刷新率触发，收集有变化或需要保活的宇宙，修补序列号与DMX数据后批量发送。
      */
     Q_INVOKABLE void processQueue();
 
@@ -124,37 +175,117 @@ private slots:
     void onQueueTimer();
 
 private:
+    /**
+     * @brief 槽位键：目标主机 + 端口 + 宇宙
+     */
+    struct SlotKey {
+        QString host;
+        quint16 port = 0;
+        quint16 universe = 0;
+
+        bool operator==(const SlotKey& other) const {
+            return universe == other.universe && port == other.port && host == other.host;
+        }
+    };
+    friend size_t qHash(const SlotKey& key, size_t seed) noexcept {
+        return qHashMulti(seed, key.host, key.port, key.universe);
+    }
+
+    /**
+     * @brief 宇宙槽位
+     * - 生产者之间以 writeLock 自旋互斥，生产者与发送线程之间以 version 做 seqlock（奇数表示写入中）
+     * - version != sentVersion 表示有未发送的新数据
+     * - 地址与数据包在创建后只由发送线程读写
+     */
+    struct UniverseSlot {
+        std::atomic_flag writeLock = ATOMIC_FLAG_INIT;
+        std::atomic<quint32> version{0};
+        std::atomic<quint32> sentVersion{0};
+        std::array<char, DmxSize> dmx{};
+
+        QString host;
+        quint16 port = 0;
+        quint16 universe = 0;
+        QHostAddress address;          // 创建时解析一次
+        QByteArray packet;             // 预构建的完整数据包（包头 + DMX）
+        quint8 sequence = 0;           // ArtDmx 序列号（1-255 循环）
+        qint64 lastSentMs = -1;        // 上次发送时间
+#ifdef Q_OS_LINUX
+        sockaddr_in sockAddr{};        // 预填的 sendmmsg 目标地址
+#endif
+    };
+
+    /**
+     * @brief 本次刷新待发送的槽位
+     */
+    struct PendingSend {
+        UniverseSlot* slot;
+        bool changed;
+    };
+
+    /**
+     * @brief 创建槽位：解析主机地址并预构建数据包
+     * @return false 表示主机地址、端口或宇宙编号无效
+     */
+    bool createSlot(const SlotKey& key);
+
+    /**
+     * @brief 将帧数据写入槽位
+     */
+    void writeSlot(UniverseSlot* slot, const ArtnetFrame& frame);
+
+    /**
+     * @brief 构建槽位数据包头
+     */
+    static void buildPacketHeader(UniverseSlot* slot);
+
+    /**
+     * @brief 发送本次刷新收集到的数据包
+     */
+    void sendBatch();
+
+    /**
+     * @brief 逐包发送（非 Linux 平台或 sendmmsg 不可用时）
+     * @param begin 起始下标
+     */
+    void sendBatchFallback(size_t begin);
+
+    /**
+     * @brief 发送完成后的信号通知
+     */
+    void notifySent(const PendingSend& pending, qint64 bytesWritten);
+    void notifyFailed(const PendingSend& pending, const QString& errorString);
+
     // 工作线程
     QThread* mThread;
     
     // UDP套接字
-    QUdpSocket* mSocket;
-    
-    // 发送队列
-    QQueue<ArtnetFrame> mSendQueue;
-    
-    // 互斥锁
-    mutable QMutex mMutex;
-    
+    QUdpSocket* mSocket = nullptr;
+
+    // 槽位表：读锁查找/发送，写锁仅用于创建与清空
+    mutable QReadWriteLock mSlotLock;
+    QHash<SlotKey, UniverseSlot*> mSlotIndex;
+    std::vector<std::unique_ptr<UniverseSlot>> mSlots;
+
+    // 发送线程复用的缓冲
+    std::vector<PendingSend> mPending;
+#ifdef Q_OS_LINUX
+    std::vector<mmsghdr> mMsgHeaders;
+    std::vector<iovec> mIoVectors;
+#endif
+    QElapsedTimer mClock;
+
     // 队列处理定时器
     QTimer* mQueueTimer;
     
-    // 发送间隔（毫秒）
-    int mSendInterval=1000/AppConstants::ARTNET_OUTPUT_FPS; // 发送间隔（毫秒），默认20fps
+    // 刷新率（Hz）
+    std::atomic<double> mRefreshRate{AppConfigs::ARTNET_REFRESH_RATE};
 
-    /**
-     * @brief 创建Art-Net数据包
-     * @param frame Art-Net数据帧
-     * @return QByteArray 构建的Art-Net数据包
-     */
-    QByteArray createArtnetPacket(const ArtnetFrame& frame);
-
-    /**
-     * @brief 实际发送数据包的内部函数
-     * @param frame Art-Net数据帧
-     * @return bool 发送是否成功
-     */
-    bool sendFrameInternal(const ArtnetFrame& frame);
+    // 统计
+    std::atomic<quint64> mSentPackets{0};
+    std::atomic<quint64> mCoalescedFrames{0};
+    std::atomic<quint64> mUnchangedFrames{0};
+    std::atomic<quint64> mDroppedFrames{0};
 };
 
 /**
@@ -48,7 +48,9 @@ qint64 LtcDecoder::writeData(const char *data, qint64 len)
   // 以 float32 作为输入格式
   size_t sampleCount = static_cast<size_t>(len) / sizeof(float);
   if (sampleCount > 0) {
-    ltc_decoder_write_float(ltc, (float *)data, sampleCount, 0);
+    // posinfo 传入首个样本的序号，解码结果的 off_start 即为帧起点的绝对样本位置
+    ltc_decoder_write_float(ltc, (float *)data, sampleCount, _samplePosition);
+    _samplePosition += static_cast<qint64>(sampleCount);
   }
 
   while(ltc_decoder_read(ltc, &ltc_frame))
@@ -115,6 +117,7 @@ qint64 LtcDecoder::writeData(const char *data, qint64 len)
     }
 
     emit newFrame(frame);
+    emit frameDecoded(frame, static_cast<qint64>(ltc_frame.off_start), _samplePosition);
   }
 
   return len;
@@ -16,11 +16,24 @@ public:
   virtual inline qint64 readData(char *, qint64) override { return 0; }
   virtual qint64 writeData(const char *data, qint64 len) override;
 
+  /**
+   * @brief 已写入解码器的样本总数（音频采样时钟）
+   */
+  qint64 samplePosition() const { return _samplePosition; }
+
 signals:
   void newFrame(TimeCodeFrame frame);
+  /**
+   * @brief 解码到新帧，附带该帧起点与当前写入位置的样本序号，供 LTC 追踪按采样时钟对齐
+   * @param frame 时间码帧
+   * @param frameStartSample 帧起点的样本序号
+   * @param currentSample 本次写入后的样本总数
+   */
+  void frameDecoded(TimeCodeFrame frame, qint64 frameStartSample, qint64 currentSample);
 
 private:
   void *_private {nullptr};
+  qint64 _samplePosition {0};
 };
 
 #endif // LTCDECODER_H
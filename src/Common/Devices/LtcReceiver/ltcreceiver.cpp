@@ -13,6 +13,7 @@ LTCReceiver::LTCReceiver(QObject *parent)
 
   _decoder = new LtcDecoder;
   connect(_decoder, &LtcDecoder::newFrame, this, &LTCReceiver::newFrame);
+  connect(_decoder, &LtcDecoder::frameDecoded, this, &LTCReceiver::framePosition, Qt::DirectConnection);
 }
 
 bool LTCReceiver::isASIODevice(int deviceIndex) const
@@ -55,11 +56,13 @@ void LTCReceiver::start(QString deviceName)
   }
 
   _isASIO = isASIODevice(_currentDeviceIndex);
+  _channelBuffer.resize(FRAMES_PER_BUFFER);
 
   // 配置音频流参数
   PaStreamParameters inputParameters;
   inputParameters.device = _currentDeviceIndex;
-  inputParameters.sampleFormat = paUInt8;
+  // 解码器按 float32 样本解码
+  inputParameters.sampleFormat = paFloat32;
   inputParameters.suggestedLatency = Pa_GetDeviceInfo(_currentDeviceIndex)->defaultLowInputLatency;
   inputParameters.hostApiSpecificStreamInfo = nullptr;
 
@@ -122,20 +125,22 @@ int LTCReceiver::paCallback(const void* inputBuffer, void* outputBuffer,
                           void* userData)
 {
   auto* self = static_cast<LTCReceiver*>(userData);
-  const char* buffer = static_cast<const char*>(inputBuffer);
+  const float* buffer = static_cast<const float*>(inputBuffer);
 
   if (buffer) {
     if (self->_isASIO) {
       // ASIO 模式下直接处理数据（已经是选定的通道）
-      self->processAudioData(buffer, framesPerBuffer);
+      self->processAudioData(reinterpret_cast<const char*>(buffer), framesPerBuffer * sizeof(float));
     } else {
-      // 非 ASIO 模式下需要提取指定通道
-      char* selectedChannelData = new char[framesPerBuffer];
+      // 非 ASIO 模式下需要提取指定通道（复用缓冲区，回调中不分配内存）
+      if (self->_channelBuffer.size() < framesPerBuffer) {
+        self->_channelBuffer.resize(framesPerBuffer);
+      }
+      float* selectedChannelData = self->_channelBuffer.data();
       for (unsigned long i = 0; i < framesPerBuffer; i++) {
         selectedChannelData[i] = buffer[i * self->NUM_CHANNELS + self->_selectedChannel];
       }
-      self->processAudioData(selectedChannelData, framesPerBuffer);
-      delete[] selectedChannelData;
+      self->processAudioData(reinterpret_cast<const char*>(selectedChannelData), framesPerBuffer * sizeof(float));
     }
   }
 
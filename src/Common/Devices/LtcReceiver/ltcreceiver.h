@@ -2,6 +2,7 @@
 #define LTCRECEIVER_H
 
 #include <QObject>
+#include <vector>
 
 #include "TimeCodeDefines.h"
 #include "../../Common/Devices/LtcDecoder/ltcdecoder.h"
@@ -33,8 +34,13 @@ public slots:
   int getDeviceIndex() const { return _currentDeviceIndex; }
   QString getDeviceName() const { return _currentDeviceName; }
   int getChannel() const { return _selectedChannel; }
+  int sampleRate() const { return SAMPLE_RATE; }
 signals:
   void newFrame(TimeCodeFrame frame);
+  /**
+   * @brief 新帧及其在音频采样时钟上的位置（在音频回调线程中发出）
+   */
+  void framePosition(TimeCodeFrame frame, qint64 frameStartSample, qint64 currentSample);
   void statusChanged(bool error, QString message);
 
 private:
@@ -58,6 +64,7 @@ private:
   bool _isASIO {false};
   int _currentDeviceIndex {0};
   QString _currentDeviceName;
+  std::vector<float> _channelBuffer;   // 选定通道的样本，回调中复用
   // 音频参数
   static constexpr int SAMPLE_RATE = 44100;
   static constexpr int FRAMES_PER_BUFFER = 512;
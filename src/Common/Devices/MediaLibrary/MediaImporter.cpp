@@ -0,0 +1,119 @@
+#include "MediaImporter.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+namespace {
+    const QString PartialPrefix = QStringLiteral(".");
+    const QString PartialSuffix = QStringLiteral(".part");
+}
+
+MediaImporter::MediaImporter(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void MediaImporter::cancel()
+{
+    m_cancel.store(true);
+}
+
+bool MediaImporter::isPartialFile(const QString& fileName)
+{
+    return fileName.startsWith(PartialPrefix) && fileName.endsWith(PartialSuffix);
+}
+
+/**
+ * @brief 将一批文件复制到存储目录；进度按字节汇总，信号发送频率限制在 ProgressIntervalMs 以内
+ */
+void MediaImporter::importFiles(const QStringList& sources, const QString& storageDir)
+{
+    m_cancel.store(false);
+    QDir storage(storageDir);
+    if (!storage.exists()) {
+        QDir().mkpath(storageDir);
+    }
+
+    qint64 bytesTotal = 0;
+    for (const QString& source : sources) {
+        bytesTotal += QFileInfo(source).size();
+    }
+
+    qint64 bytesDone = 0;
+    for (const QString& source : sources) {
+        if (m_cancel.load()) break;
+        const QFileInfo fi(source);
+        const QString target = storage.absoluteFilePath(fi.fileName());
+        QString error;
+        const qint64 before = bytesDone;
+        if (copyFile(fi.absoluteFilePath(), target, bytesDone, bytesTotal, error)) {
+            emit fileImported(target);
+        } else {
+            // 失败文件的剩余字节计入进度，保证进度条可以走完
+            bytesDone = before + fi.size();
+            if (!m_cancel.load()) {
+                emit fileFailed(fi.absoluteFilePath(), error);
+            }
+        }
+    }
+    emit progress(bytesTotal, bytesTotal, QString());
+    emit finished(m_cancel.load());
+}
+
+bool MediaImporter::copyFile(const QString& source, const QString& target, qint64& bytesDone, qint64 bytesTotal, QString& error)
+{
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly)) {
+        error = in.errorString();
+        return false;
+    }
+    const QFileInfo targetInfo(target);
+    const QString partialPath = targetInfo.dir().absoluteFilePath(PartialPrefix + targetInfo.fileName() + PartialSuffix);
+    QFile out(partialPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = out.errorString();
+        return false;
+    }
+
+    if (m_buffer.size() != ChunkSize) {
+        m_buffer.resize(ChunkSize);
+    }
+    QElapsedTimer progressTimer;
+    progressTimer.start();
+    emit progress(bytesDone, bytesTotal, source);
+    while (!in.atEnd()) {
+        if (m_cancel.load()) {
+            error = QStringLiteral("canceled");
+            out.close();
+            out.remove();
+            return false;
+        }
+        const qint64 read = in.read(m_buffer.data(), ChunkSize);
+        if (read < 0 || out.write(m_buffer.constData(), read) != read) {
+            error = read < 0 ? in.errorString() : out.errorString();
+            out.close();
+            out.remove();
+            return false;
+        }
+        bytesDone += read;
+        if (progressTimer.elapsed() >= ProgressIntervalMs) {
+            progressTimer.restart();
+            emit progress(bytesDone, bytesTotal, source);
+        }
+    }
+    out.close();
+
+    // 强制覆盖同名目标：先删除旧文件再改名
+    if (QFile::exists(target) && !QFile::remove(target)) {
+        error = QStringLiteral("cannot overwrite %1").arg(target);
+        QFile::remove(partialPath);
+        return false;
+    }
+    if (!QFile::rename(partialPath, target)) {
+        error = QStringLiteral("cannot rename %1").arg(partialPath);
+        QFile::remove(partialPath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <QObject>
+#include <QStringList>
+#include <atomic>
+
+/**
+ * @class MediaImporter
+ * @brief 媒体导入工作者：运行在独立线程，分块复制文件到存储目录并汇报进度。
+ *        先写入隐藏的 .part 临时文件，完成后再替换目标，复制中断不会留下半截媒体。
+ */
+class MediaImporter : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr qint64 ChunkSize = 4 * 1024 * 1024;   // 单次读写块大小
+    static constexpr int ProgressIntervalMs = 100;         // 进度信号最小间隔
+
+    explicit MediaImporter(QObject* parent = nullptr);
+
+    /**
+     * @brief 取消当前批次（可在任意线程调用）
+     */
+    void cancel();
+
+    /**
+     * @brief 判断文件名是否为导入过程中的临时文件
+     */
+    static bool isPartialFile(const QString& fileName);
+
+public slots:
+    /**
+     * @brief 将一批文件复制到存储目录，同名目标被覆盖
+     */
+    void importFiles(const QStringList& sources, const QString& storageDir);
+
+signals:
+    /**
+     * @brief 导入进度（字节）；currentFile 为正在复制的源文件
+     */
+    void progress(qint64 bytesDone, qint64 bytesTotal, const QString& currentFile);
+
+    /**
+     * @brief 单个文件复制完成
+     */
+    void fileImported(const QString& targetPath);
+
+    /**
+     * @brief 单个文件复制失败
+     */
+    void fileFailed(const QString& sourcePath, const QString& reason);
+
+    /**
+     * @brief 一批文件处理结束（包括被取消）
+     */
+    void finished(bool canceled);
+
+private:
+    bool copyFile(const QString& source, const QString& target, qint64& bytesDone, qint64 bytesTotal, QString& error);
+
+private:
+    std::atomic_bool m_cancel{false};
+    QByteArray m_buffer;   ///< 复用的复制缓冲区
+};
@@ -0,0 +1,403 @@
+#include "MediaIndexer.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QTime>
+#include <QDebug>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+namespace {
+    // 生成缩略图时最多读取的视频包数量，避免损坏文件导致长时间解码
+    constexpr int MaxThumbnailPackets = 256;
+    constexpr int IndexVersion = 1;
+
+    /**
+     * 函数级注释：将解码帧缩放为 RGB24 缩略图
+     */
+    QImage scaleFrame(const AVFrame* frame)
+    {
+        if (frame->width <= 0 || frame->height <= 0) return {};
+        const int width = qMin(frame->width, MediaIndexer::ThumbnailWidth);
+        const int height = qMax(1, frame->height * width / frame->width);
+        SwsContext* sws = sws_getContext(frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+                                         width, height, AV_PIX_FMT_RGB24, SWS_BILINEAR,
+                                         nullptr, nullptr, nullptr);
+        if (!sws) return {};
+        QImage image(width, height, QImage::Format_RGB888);
+        uint8_t* dst[4] = { image.bits(), nullptr, nullptr, nullptr };
+        int dstStride[4] = { static_cast<int>(image.bytesPerLine()), 0, 0, 0 };
+        sws_scale(sws, frame->data, frame->linesize, 0, frame->height, dst, dstStride);
+        sws_freeContext(sws);
+        return image;
+    }
+
+    /**
+     * 函数级注释：解码视频流的一帧作为缩略图；非封面流先定位到 10%（最多 10 秒）处以跳过片头黑场
+     */
+    QImage decodeThumbnail(AVFormatContext* fmt, AVStream* stream)
+    {
+        const AVCodec* codec = avcodec_find_decoder(stream->codecpar->codec_id);
+        if (!codec) return {};
+        AVCodecContext* ctx = avcodec_alloc_context3(codec);
+        QImage image;
+        if (ctx && avcodec_parameters_to_context(ctx, stream->codecpar) >= 0) {
+            // 并行度由线程池提供，单个解码器只用一个线程
+            ctx->thread_count = 1;
+            if (avcodec_open2(ctx, codec, nullptr) >= 0) {
+                if (!(stream->disposition & AV_DISPOSITION_ATTACHED_PIC) && fmt->duration > 0) {
+                    const int64_t target = qMin<int64_t>(fmt->duration / 10, 10LL * AV_TIME_BASE);
+                    av_seek_frame(fmt, -1, target, AVSEEK_FLAG_BACKWARD);
+                }
+                AVPacket* packet = av_packet_alloc();
+                AVFrame* frame = av_frame_alloc();
+                int packets = 0;
+                while (image.isNull() && packets < MaxThumbnailPackets && av_read_frame(fmt, packet) >= 0) {
+                    if (packet->stream_index == stream->index) {
+                        ++packets;
+                        if (avcodec_send_packet(ctx, packet) >= 0 && avcodec_receive_frame(ctx, frame) >= 0) {
+                            image = scaleFrame(frame);
+                        }
+                    }
+                    av_packet_unref(packet);
+                }
+                if (image.isNull() && avcodec_send_packet(ctx, nullptr) >= 0
+                    && avcodec_receive_frame(ctx, frame) >= 0) {
+                    image = scaleFrame(frame);
+                }
+                av_frame_free(&frame);
+                av_packet_free(&packet);
+            }
+        }
+        avcodec_free_context(&ctx);
+        return image;
+    }
+
+    /**
+     * 函数级注释：用 FFmpeg 读取容器与流信息，并为视频流生成缩略图
+     */
+    void probeWithFFmpeg(const QString& absPath, MediaInfo& info, QImage& thumbnail)
+    {
+        AVFormatContext* fmt = nullptr;
+        const QByteArray path = absPath.toUtf8();
+        if (avformat_open_input(&fmt, path.constData(), nullptr, nullptr) < 0) return;
+        if (avformat_find_stream_info(fmt, nullptr) < 0) {
+            avformat_close_input(&fmt);
+            return;
+        }
+        if (fmt->duration != AV_NOPTS_VALUE && fmt->duration > 0) {
+            info.durationMs = fmt->duration / (AV_TIME_BASE / 1000);
+        }
+        const int audioIndex = av_find_best_stream(fmt, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+        if (audioIndex >= 0) {
+            const AVCodecParameters* par = fmt->streams[audioIndex]->codecpar;
+            info.audioCodec = QString::fromUtf8(avcodec_get_name(par->codec_id));
+            info.sampleRate = par->sample_rate;
+            info.channels = par->ch_layout.nb_channels;
+        }
+        const int videoIndex = av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+        if (videoIndex >= 0) {
+            AVStream* stream = fmt->streams[videoIndex];
+            info.videoCodec = QString::fromUtf8(avcodec_get_name(stream->codecpar->codec_id));
+            info.width = stream->codecpar->width;
+            info.height = stream->codecpar->height;
+            const AVRational rate = av_guess_frame_rate(fmt, stream, nullptr);
+            if (rate.num > 0 && rate.den > 0) {
+                info.frameRate = av_q2d(rate);
+            }
+            thumbnail = decodeThumbnail(fmt, stream);
+        }
+        avformat_close_input(&fmt);
+    }
+
+    QJsonObject toJson(const MediaInfo& info)
+    {
+        QJsonObject obj;
+        obj["path"] = info.path;
+        obj["size"] = QString::number(info.size);
+        obj["modified"] = QString::number(info.modified);
+        obj["durationMs"] = QString::number(info.durationMs);
+        obj["videoCodec"] = info.videoCodec;
+        obj["audioCodec"] = info.audioCodec;
+        obj["width"] = info.width;
+        obj["height"] = info.height;
+        obj["frameRate"] = info.frameRate;
+        obj["sampleRate"] = info.sampleRate;
+        obj["channels"] = info.channels;
+        obj["thumbnail"] = info.thumbnail;
+        return obj;
+    }
+
+    MediaInfo fromJson(const QJsonObject& obj)
+    {
+        MediaInfo info;
+        info.path = obj.value("path").toString();
+        info.size = obj.value("size").toString().toLongLong();
+        info.modified = obj.value("modified").toString().toLongLong();
+        info.durationMs = obj.value("durationMs").toString().toLongLong();
+        info.videoCodec = obj.value("videoCodec").toString();
+        info.audioCodec = obj.value("audioCodec").toString();
+        info.width = obj.value("width").toInt();
+        info.height = obj.value("height").toInt();
+        info.frameRate = obj.value("frameRate").toDouble();
+        info.sampleRate = obj.value("sampleRate").toInt();
+        info.channels = obj.value("channels").toInt();
+        info.thumbnail = obj.value("thumbnail").toString();
+        return info;
+    }
+}
+
+/**
+ * @brief 生成用于提示框的简要描述，例如 “1920x1080 | h264 25.00 fps | 00:01:23 | aac 48000 Hz 2ch”
+ */
+QString MediaInfo::summary() const
+{
+    QStringList parts;
+    if (width > 0 && height > 0) {
+        parts << QStringLiteral("%1x%2").arg(width).arg(height);
+    }
+    if (!videoCodec.isEmpty()) {
+        parts << (frameRate > 0.0 ? QStringLiteral("%1 %2 fps").arg(videoCodec).arg(frameRate, 0, 'f', 2)
+                                  : videoCodec);
+    }
+    if (durationMs > 0) {
+        parts << QTime(0, 0).addMSecs(static_cast<int>(durationMs)).toString(QStringLiteral("hh:mm:ss"));
+    }
+    if (!audioCodec.isEmpty()) {
+        parts << QStringLiteral("%1 %2 Hz %3ch").arg(audioCodec).arg(sampleRate).arg(channels);
+    }
+    return parts.join(QStringLiteral(" | "));
+}
+
+MediaIndexer::MediaIndexer(const QString& cacheDir, QObject* parent)
+    : QObject(parent),
+      m_cacheDir(cacheDir),
+      m_thumbnailDir(QDir(cacheDir).filePath(QStringLiteral("thumbnails")))
+{
+    qRegisterMetaType<MediaInfo>("MediaInfo");
+    QDir().mkpath(m_thumbnailDir);
+    // 探测以 I/O 与解码为主，限制并发避免与播放争抢资源
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &MediaIndexer::save);
+    load();
+}
+
+MediaIndexer::~MediaIndexer()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+    if (m_dirty) {
+        save();
+    }
+}
+
+/**
+ * @brief 查询缓存；仅当文件大小与修改时间均未变化时返回 true
+ */
+bool MediaIndexer::lookup(const QString& absPath, MediaInfo* info) const
+{
+    MediaInfo cached;
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_entries.constFind(absPath);
+        if (it == m_entries.constEnd()) return false;
+        cached = it.value();
+    }
+    const QFileInfo fi(absPath);
+    if (!fi.exists() || fi.size() != cached.size
+        || fi.lastModified().toMSecsSinceEpoch() != cached.modified) {
+        return false;
+    }
+    if (info) *info = cached;
+    return true;
+}
+
+/**
+ * @brief 请求探测：缓存有效时立即返回 true，否则提交到线程池异步探测
+ */
+bool MediaIndexer::request(const QString& absPath)
+{
+    if (lookup(absPath)) return true;
+    if (m_inFlight.contains(absPath)) return false;
+    m_inFlight.insert(absPath);
+    const QString thumbnailDir = m_thumbnailDir;
+    // 析构时等待线程池结束，因此工作线程回投时 this 一定有效
+    m_pool.start(QRunnable::create([this, absPath, thumbnailDir]() {
+        const MediaInfo info = probe(absPath, thumbnailDir);
+        QMetaObject::invokeMethod(this, [this, absPath, info]() {
+            m_inFlight.remove(absPath);
+            if (info.isValid()) {
+                store(info);
+            }
+        }, Qt::QueuedConnection);
+    }));
+    return false;
+}
+
+/**
+ * @brief 清理已不存在文件的索引项；文件存在性检查在锁外进行，避免逐个 stat 期间阻塞查询
+ */
+int MediaIndexer::prune()
+{
+    QStringList paths;
+    {
+        QReadLocker locker(&m_lock);
+        paths = m_entries.keys();
+    }
+    QStringList missing;
+    for (const QString& path : std::as_const(paths)) {
+        if (!QFileInfo::exists(path)) missing << path;
+    }
+    if (missing.isEmpty()) return 0;
+
+    QStringList thumbnails;
+    int removed = 0;
+    {
+        QWriteLocker locker(&m_lock);
+        for (const QString& path : std::as_const(missing)) {
+            auto it = m_entries.find(path);
+            if (it == m_entries.end()) continue;
+            if (!it->thumbnail.isEmpty()) thumbnails << it->thumbnail;
+            m_entries.erase(it);
+            ++removed;
+        }
+    }
+    for (const QString& thumbnail : std::as_const(thumbnails)) {
+        QFile::remove(thumbnail);
+    }
+    if (removed > 0) {
+        m_dirty = true;
+        m_saveTimer.start();
+    }
+    return removed;
+}
+
+void MediaIndexer::store(const MediaInfo& info)
+{
+    QString staleThumbnail;
+    {
+        QWriteLocker locker(&m_lock);
+        auto it = m_entries.find(info.path);
+        if (it != m_entries.end() && it->thumbnail != info.thumbnail) {
+            staleThumbnail = it->thumbnail;
+        }
+        m_entries.insert(info.path, info);
+    }
+    if (!staleThumbnail.isEmpty()) {
+        QFile::remove(staleThumbnail);
+    }
+    m_dirty = true;
+    m_saveTimer.start();
+    emit mediaInfoReady(info.path, info);
+}
+
+/**
+ * @brief 在调用线程同步探测单个文件：图片用 QImageReader，其余交给 FFmpeg
+ */
+MediaInfo MediaIndexer::probe(const QString& absPath, const QString& thumbnailDir)
+{
+    MediaInfo info;
+    const QFileInfo fi(absPath);
+    if (!fi.exists() || !fi.isFile()) return info;
+    info.path = absPath;
+    info.size = fi.size();
+    info.modified = fi.lastModified().toMSecsSinceEpoch();
+
+    QImage thumbnail;
+    const QByteArray suffix = fi.suffix().toLower().toUtf8();
+    if (QImageReader::supportedImageFormats().contains(suffix)) {
+        QImageReader reader(absPath);
+        const QSize size = reader.size();
+        if (size.isValid()) {
+            info.width = size.width();
+            info.height = size.height();
+            if (size.width() > ThumbnailWidth) {
+                reader.setScaledSize(QSize(ThumbnailWidth, qMax(1, size.height() * ThumbnailWidth / size.width())));
+            }
+        }
+        reader.read(&thumbnail);
+    } else {
+        probeWithFFmpeg(absPath, info, thumbnail);
+    }
+
+    if (!thumbnail.isNull()) {
+        const QString file = QDir(thumbnailDir).filePath(thumbnailName(info));
+        if (thumbnail.save(file, "JPG", 80)) {
+            info.thumbnail = file;
+        }
+    }
+    return info;
+}
+
+/**
+ * @brief 缩略图文件名：路径 + 大小 + 修改时间 的 SHA1，文件变化后自然生成新名字
+ */
+QString MediaIndexer::thumbnailName(const MediaInfo& info)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.path.toUtf8());
+    hash.addData(QByteArray::number(info.size));
+    hash.addData(QByteArray::number(info.modified));
+    return QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".jpg");
+}
+
+void MediaIndexer::load()
+{
+    QFile f(QDir(m_cacheDir).filePath(QStringLiteral("index.json")));
+    if (!f.open(QIODevice::ReadOnly)) return;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+    f.close();
+    if (!doc.isObject() || doc.object().value("version").toInt() != IndexVersion) return;
+    const QJsonArray entries = doc.object().value("entries").toArray();
+    QWriteLocker locker(&m_lock);
+    m_entries.reserve(entries.size());
+    for (const QJsonValue& value : entries) {
+        const MediaInfo info = fromJson(value.toObject());
+        if (!info.path.isEmpty()) {
+            m_entries.insert(info.path, info);
+        }
+    }
+}
+
+/**
+ * @brief 立即将索引写入磁盘（QSaveFile 保证写入过程中崩溃不会损坏旧索引）
+ */
+void MediaIndexer::save()
+{
+    m_saveTimer.stop();
+    QJsonArray entries;
+    {
+        QReadLocker locker(&m_lock);
+        for (const MediaInfo& info : m_entries) {
+            entries.append(toJson(info));
+        }
+    }
+    QJsonObject root;
+    root["version"] = IndexVersion;
+    root["entries"] = entries;
+    QDir().mkpath(m_cacheDir);
+    QSaveFile f(QDir(m_cacheDir).filePath(QStringLiteral("index.json")));
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "MediaIndexer: cannot write index" << f.fileName();
+        return;
+    }
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (f.commit()) {
+        m_dirty = false;
+    }
+}
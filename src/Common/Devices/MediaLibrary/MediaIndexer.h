@@ -0,0 +1,102 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QReadWriteLock>
+#include <QThreadPool>
+#include <QTimer>
+#include <QMetaType>
+
+/**
+ * @struct MediaInfo
+ * @brief 媒体元数据缓存项，以 路径 + 文件大小 + 修改时间 作为有效性判定
+ */
+struct MediaInfo {
+    QString path;                 ///< 文件绝对路径
+    qint64 size = -1;             ///< 文件大小（字节）
+    qint64 modified = -1;         ///< 修改时间（毫秒时间戳）
+    qint64 durationMs = 0;        ///< 时长（毫秒），图片为 0
+    QString videoCodec;           ///< 视频编码名称
+    QString audioCodec;           ///< 音频编码名称
+    int width = 0;                ///< 画面宽度
+    int height = 0;               ///< 画面高度
+    double frameRate = 0.0;       ///< 帧率
+    int sampleRate = 0;           ///< 音频采样率
+    int channels = 0;             ///< 音频声道数
+    QString thumbnail;            ///< 缩略图文件路径（可能为空）
+
+    bool isValid() const { return size >= 0; }
+
+    /**
+     * @brief 生成用于提示框的简要描述
+     */
+    QString summary() const;
+};
+Q_DECLARE_METATYPE(MediaInfo)
+
+/**
+ * @class MediaIndexer
+ * @brief 媒体索引器：在线程池中用 FFmpeg 探测媒体信息并生成缩略图，
+ *        结果按 路径 + 大小 + 修改时间 持久化到磁盘索引，重启后未变化的文件不再重复探测。
+ */
+class MediaIndexer : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int ThumbnailWidth = 160;     // 缩略图宽度（像素）
+    static constexpr int SaveDelayMs = 1000;       // 索引落盘的合并延迟
+
+    /**
+     * @brief 构造函数：加载磁盘索引
+     * @param cacheDir 索引与缩略图所在目录
+     */
+    explicit MediaIndexer(const QString& cacheDir, QObject* parent = nullptr);
+    ~MediaIndexer() override;
+
+    /**
+     * @brief 查询缓存；仅当文件大小与修改时间均未变化时返回 true
+     */
+    bool lookup(const QString& absPath, MediaInfo* info = nullptr) const;
+
+    /**
+     * @brief 请求探测：缓存有效时立即返回 true，否则提交到线程池异步探测
+     */
+    bool request(const QString& absPath);
+
+    /**
+     * @brief 清理索引：移除文件已不存在的索引项及其缩略图（仅由手动刷新等显式操作调用）
+     * @return 移除的索引项数量
+     */
+    int prune();
+
+    /**
+     * @brief 立即将索引写入磁盘
+     */
+    void save();
+
+    /**
+     * @brief 在调用线程同步探测单个文件（供工作线程使用）
+     */
+    static MediaInfo probe(const QString& absPath, const QString& thumbnailDir);
+
+signals:
+    /**
+     * @brief 某文件的元数据已可用（在索引器所在线程发出）
+     */
+    void mediaInfoReady(const QString& absPath, const MediaInfo& info);
+
+private:
+    void load();
+    void store(const MediaInfo& info);
+    static QString thumbnailName(const MediaInfo& info);
+
+private:
+    QString m_cacheDir;
+    QString m_thumbnailDir;
+    mutable QReadWriteLock m_lock;
+    QHash<QString, MediaInfo> m_entries;   ///< 路径 → 元数据
+    QSet<QString> m_inFlight;              ///< 正在探测的路径（仅在索引器线程访问）
+    QThreadPool m_pool;
+    QTimer m_saveTimer;
+    bool m_dirty = false;
+};
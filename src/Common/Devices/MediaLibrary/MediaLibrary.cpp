@@ -8,6 +8,7 @@
 #include "Common/AppConfig/ConstantDefines.h"
 #include <QGuiApplication>
 #include <QClipboard>
+#include <QIcon>
 /**
  * @brief 构造函数：初始化五个分类的组节点
  */
@@ -31,10 +32,43 @@ MediaLibrary::MediaLibrary(QObject* parent)
         invisibleRootItem()->appendRow(group);
         m_categories.insert(cat, group);
     }
+    // 元数据索引：线程池探测，结果持久化到缓存目录
+    m_indexer = new MediaIndexer(AppConstants::MEDIA_INDEX_CACHE_DIR, this);
+    connect(m_indexer, &MediaIndexer::mediaInfoReady, this, &MediaLibrary::onMediaInfoReady);
+
+    // 导入线程：分块复制，避免大文件阻塞界面
+    m_importThread = new QThread(this);
+    m_importer = new MediaImporter();
+    m_importer->moveToThread(m_importThread);
+    connect(m_importThread, &QThread::finished, m_importer, &QObject::deleteLater);
+    connect(m_importer, &MediaImporter::progress, this, &MediaLibrary::importProgress);
+    connect(m_importer, &MediaImporter::fileImported, this, &MediaLibrary::scheduleRescan);
+    connect(m_importer, &MediaImporter::fileFailed, this, [this](const QString& source, const QString& reason) {
+        m_importFailures << QStringLiteral("%1 (%2)").arg(source, reason);
+    });
+    connect(m_importer, &MediaImporter::finished, this, &MediaLibrary::onImportFinished);
+    m_importThread->start();
+
+    // 目录监视：存储目录变化时合并为一次增量刷新
+    m_rescanTimer = new QTimer(this);
+    m_rescanTimer->setSingleShot(true);
+    m_rescanTimer->setInterval(RescanDelayMs);
+    connect(m_rescanTimer, &QTimer::timeout, this, &MediaLibrary::rescanStorage);
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &MediaLibrary::scheduleRescan);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &MediaLibrary::onWatchedFileChanged);
+
     // 新增：初始化存储目录（Windows 文档库下），并扫描已有文件入库
     initializeStorageDir();
 }
 
+MediaLibrary::~MediaLibrary()
+{
+    m_importer->cancel();
+    m_importThread->quit();
+    m_importThread->wait();
+}
+
 /**
  * @brief 确保类别根项存在并返回
  */
@@ -55,16 +89,27 @@ QStandardItem* MediaLibrary::ensureCategory(Category cat)
  * @return 新增的索引；若重复则返回无效索引
  */
 QModelIndex MediaLibrary::addFile(const QString& absPath)
+{
+    QStandardItem* item = insertFileItem(absPath);
+    if (!item) return QModelIndex();
+    emit libraryChanged();
+    return item->index();
+}
+
+/**
+ * @brief 插入文件项但不发出 libraryChanged；新项追加在组末尾，直接赋序号而不重排整组
+ */
+QStandardItem* MediaLibrary::insertFileItem(const QString& absPath)
 {
     const QFileInfo fi(absPath);
-    if (!fi.exists() || !fi.isFile()) return QModelIndex();
+    if (!fi.exists() || !fi.isFile()) return nullptr;
 
     const Category cat = detectCategory(absPath);
     QStandardItem* group = ensureCategory(cat);
-    if (!group) return QModelIndex();
+    if (!group) return nullptr;
 
     if (existsInCategory(group, absPath)) {
-        return QModelIndex(); // 已存在，跳过
+        return nullptr; // 已存在，跳过
     }
 
     // 创建叶子项
@@ -73,14 +118,26 @@ QModelIndex MediaLibrary::addFile(const QString& absPath)
     item->setData(absPath, PathRole);
     item->setData(static_cast<int>(cat), CategoryRole);
     item->setData(group->row(), ParentRowRole); // 叶子项的父组行号
-    // 暂不设置 OrdinalRole，统一在重排时赋值
+    const int ordinal = group->rowCount() + 1;
+    item->setData(ordinal, OrdinalRole);
+    item->setText(QString::number(ordinal) + QStringLiteral("  ") + fi.fileName());
+    item->setToolTip(absPath);
     group->appendRow(item);
+    m_itemsByPath.insert(pathKey(absPath), item);
 
-    // 重排序号
-    renumberCategory(group);
+    // 存储目录由目录监视覆盖，目录外的文件单独监视
+    if (!isInStorageDir(absPath)) {
+        m_watcher->addPath(absPath);
+    }
 
-    emit libraryChanged();
-    return item->index();
+    // 命中缓存直接填充元数据，否则交给线程池探测
+    MediaInfo info;
+    if (m_indexer->lookup(absPath, &info)) {
+        applyMediaInfo(item, info);
+    } else {
+        m_indexer->request(absPath);
+    }
+    return item;
 }
 
 /**
@@ -92,43 +149,71 @@ QModelIndex MediaLibrary::addFile(const QString& absPath)
  */
 void MediaLibrary::addFiles(const QStringList& absPaths)
 {
-    QDir storage(QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).absolutePath());
+    const QString storageDir = QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).absolutePath();
 
+    QStringList toImport;
+    bool anyAdded = false;
     for (const QString& p : absPaths) {
         const QFileInfo fi(p);
         if (!fi.exists() || !fi.isFile()) continue;
         // 若源文件已在存储目录中，直接入库
         if (isInStorageDir(fi.absoluteFilePath())) {
-            addFile(fi.absoluteFilePath());
+            if (insertFileItem(fi.absoluteFilePath())) anyAdded = true;
             continue;
         }
+        toImport << fi.absoluteFilePath();
+    }
+    if (anyAdded) {
+        emit libraryChanged();
+    }
+    if (toImport.isEmpty()) return;
+
+    // 复制在导入线程中进行（同名目标强制覆盖），完成的文件经目录刷新入库
+    ++m_pendingImports;
+    MediaImporter* importer = m_importer;
+    QMetaObject::invokeMethod(importer, [importer, toImport, storageDir]() {
+        importer->importFiles(toImport, storageDir);
+    }, Qt::QueuedConnection);
+}
 
-        // 目标路径为存储目录下同名文件，若存在则先删除以实现强制覆盖
-        const QString targetPath = storage.absoluteFilePath(fi.fileName());
-        if (QFile::exists(targetPath)) {
-            // 尝试删除已有目标文件
-            if (!QFile::remove(targetPath)) {
-                // 删除失败：提示并跳过该文件复制，避免不一致
-                QMessageBox::warning(nullptr,
-                                     QStringLiteral("删除失败"),
-                                     QStringLiteral("无法覆盖目标文件（删除失败）：\n%1").arg(targetPath));
-                continue;
-            }
-        }
+/**
+ * @brief 取消正在进行的导入（已复制完成的文件保留）
+ */
+void MediaLibrary::cancelImport()
+{
+    if (m_pendingImports > 0) {
+        m_importer->cancel();
+    }
+}
 
-        // 复制到存储目录
-        if (QFile::copy(fi.absoluteFilePath(), targetPath)) {
-            addFile(targetPath);
-        } else {
-            // 复制失败：如果你希望弹窗提示，请告知；当前策略为跳过，不入库
-            // 可改为 QMessageBox::warning(...) 提示复制失败
-            QMessageBox::warning(nullptr,
-                                 QStringLiteral("复制失败"),
-                                 QStringLiteral("无法复制文件（复制失败）：\n%1").arg(fi.absoluteFilePath()));
+/**
+ * @brief 一批导入结束：立即刷新以入库最后的文件，并汇总提示复制失败的文件
+ */
+void MediaLibrary::onImportFinished(bool canceled)
+{
+    m_pendingImports = qMax(0, m_pendingImports - 1);
+    m_rescanTimer->stop();
+    rescanStorage();
+    if (!m_importFailures.isEmpty() && !canceled) {
+        QStringList shown = m_importFailures.mid(0, 20);
+        if (m_importFailures.size() > shown.size()) {
+            shown << QStringLiteral("... (%1)").arg(m_importFailures.size());
         }
+        QMessageBox::warning(nullptr,
+                             QStringLiteral("复制失败"),
+                             QStringLiteral("无法复制文件（复制失败）：\n%1").arg(shown.join('\n')));
     }
+    m_importFailures.clear();
+    emit importFinished(canceled);
 }
 
+/**
+ * @brief 查询文件的缓存元数据（文件未变化时有效）
+ */
+bool MediaLibrary::mediaInfo(const QString& absPath, MediaInfo* info) const
+{
+    return m_indexer->lookup(absPath, info);
+}
 
 /**
  * @brief 添加文件夹（仅添加该文件夹下的一层文件）
@@ -187,6 +272,7 @@ void MediaLibrary::removeIndexes(const QModelIndexList& indexes)
         }
 
         // 从模型移除
+        forgetItem(item);
         parentGroup->removeRow(item->row());
         needRenumber.insert(parentGroup);
     }
@@ -222,6 +308,7 @@ void MediaLibrary::clearLibrary()
                 }
             }
             // 删除成功或非存储目录文件，移除项
+            forgetItem(item);
             group->removeRow(r);
         }
     }
@@ -314,7 +401,7 @@ bool MediaLibrary::fromJson(const QJsonObject& obj)
     auto load = [&](Category cat, const char* key) {
         const QJsonArray arr = obj.value(QString::fromUtf8(key)).toArray();
         for (const QJsonValue& v : arr) {
-            addFile(v.toString());
+            insertFileItem(v.toString());
         }
     };
     load(Category::Video,   "Video");
@@ -424,14 +511,67 @@ void MediaLibrary::renumberCategory(QStandardItem* catItem)
 bool MediaLibrary::existsInCategory(QStandardItem* catItem, const QString& absPath) const
 {
     if (!catItem) return false;
-    for (int r = 0; r < catItem->rowCount(); ++r) {
-        const QStandardItem* item = catItem->child(r);
-        if (!item) continue;
-        if (item->data(PathRole).toString().compare(absPath, Qt::CaseInsensitive) == 0) {
-            return true;
-        }
+    const QStandardItem* item = m_itemsByPath.value(pathKey(absPath), nullptr);
+    return item && item->parent() == catItem;
+}
+
+/**
+ * @brief 路径索引键：规范化分隔符，Windows 上大小写不敏感（与 isInStorageDir 一致）
+ */
+QString MediaLibrary::pathKey(const QString& absPath)
+{
+#ifdef Q_OS_WIN
+    return QDir::cleanPath(absPath).toLower();
+#else
+    return QDir::cleanPath(absPath);
+#endif
+}
+
+/**
+ * @brief 在移除文件项之前清理路径索引与文件监视
+ * 元数据缓存保留：按大小与修改时间校验，重新入库（如加载工程）时无需重新探测；清理只在手动刷新中进行
+ */
+void MediaLibrary::forgetItem(QStandardItem* item)
+{
+    const QString path = item->data(PathRole).toString();
+    if (path.isEmpty()) return;
+    m_itemsByPath.remove(pathKey(path));
+    if (m_watcher->files().contains(path)) {
+        m_watcher->removePath(path);
+    }
+}
+
+/**
+ * @brief 把探测到的元数据写入文件项：提示框显示摘要，有缩略图时替换类别图标
+ */
+void MediaLibrary::applyMediaInfo(QStandardItem* item, const MediaInfo& info)
+{
+    QVariantMap meta;
+    meta["size"] = info.size;
+    meta["modified"] = info.modified;
+    meta["durationMs"] = info.durationMs;
+    meta["videoCodec"] = info.videoCodec;
+    meta["audioCodec"] = info.audioCodec;
+    meta["width"] = info.width;
+    meta["height"] = info.height;
+    meta["frameRate"] = info.frameRate;
+    meta["sampleRate"] = info.sampleRate;
+    meta["channels"] = info.channels;
+    item->setData(meta, MetadataRole);
+
+    const QString summary = info.summary();
+    item->setToolTip(summary.isEmpty() ? info.path : info.path + QStringLiteral("\n") + summary);
+    if (!info.thumbnail.isEmpty()) {
+        item->setData(info.thumbnail, ThumbnailRole);
+        item->setIcon(QIcon(info.thumbnail));
+    }
+}
+
+void MediaLibrary::onMediaInfoReady(const QString& absPath, const MediaInfo& info)
+{
+    if (QStandardItem* item = m_itemsByPath.value(pathKey(absPath), nullptr)) {
+        applyMediaInfo(item, info);
     }
-    return false;
 }
 
 /**
@@ -447,6 +587,8 @@ QHash<int, QByteArray> MediaLibrary::roleNames() const {
     names.insert(CategoryRole,  "category");
     names.insert(OrdinalRole,   "ordinal");
     names.insert(ParentRowRole, "parentRow");
+    names.insert(MetadataRole,  "metadata");
+    names.insert(ThumbnailRole, "thumbnail");
     return names;
 }
 
@@ -573,8 +715,14 @@ void MediaLibrary::initializeStorageDir()
     QDir storage(QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).absolutePath());
     const QFileInfoList infos = storage.entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
     for (const QFileInfo& fi : infos) {
-        addFile(fi.absoluteFilePath());
+        if (MediaImporter::isPartialFile(fi.fileName())) {
+            // 上次导入中断遗留的临时文件
+            QFile::remove(fi.absoluteFilePath());
+            continue;
+        }
+        insertFileItem(fi.absoluteFilePath());
     }
+    m_watcher->addPath(storage.absolutePath());
 }
 
 // 新增：在存储目录内生成不重名的文件名
@@ -644,59 +792,126 @@ return filePath.startsWith(storagePrefix);
 
 
 
+/**
+ * @brief 手动刷新：增量比对存储目录，校验存储目录外条目是否仍存在，并清理已不存在文件的元数据缓存
+ */
 void MediaLibrary::refresh() {
-    // 屏蔽信号，避免过程中产生大量中间状态通知
-    this->blockSignals(true);
     bool anyChange = false;
+    const QString storageKey = pathKey(QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).absolutePath());
+    QSet<QStandardItem*> needRenumber;
+    for (auto it = m_itemsByPath.begin(); it != m_itemsByPath.end();) {
+        QStandardItem* item = it.value();
+        const QString path = item->data(PathRole).toString();
+        // 存储目录内的条目由 rescanStorage 通过目录枚举处理
+        if (pathKey(QFileInfo(path).absolutePath()) == storageKey || QFileInfo::exists(path)) {
+            ++it;
+            continue;
+        }
+        it = m_itemsByPath.erase(it);
+        m_watcher->removePath(path);
+        QStandardItem* group = item->parent();
+        group->removeRow(item->row());
+        needRenumber.insert(group);
+        anyChange = true;
+    }
+    for (QStandardItem* group : needRenumber) {
+        renumberCategory(group);
+    }
+    if (anyChange) {
+        emit libraryChanged();
+    }
+    m_rescanTimer->stop();
+    rescanStorage();
+    m_indexer->prune();
+}
 
+void MediaLibrary::scheduleRescan()
+{
+    m_rescanTimer->start();
+}
+
+/**
+ * @brief 增量刷新存储目录：一次目录枚举得到存在性、大小与修改时间，
+ *        仅移除消失的条目、加入新文件，并对大小或修改时间变化的文件重新探测
+ */
+void MediaLibrary::rescanStorage()
+{
     // 确保存储目录存在
     if (!QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).exists()) {
         QDir().mkpath(AppConstants::MEDIA_LIBRARY_STORAGE_DIR);
     }
     QDir storage(QDir(AppConstants::MEDIA_LIBRARY_STORAGE_DIR).absolutePath());
+    const QString storageKey = pathKey(storage.absolutePath());
+    if (!m_watcher->directories().contains(storage.absolutePath())) {
+        m_watcher->addPath(storage.absolutePath());
+    }
 
-    // 当前存储目录文件集合
     const QFileInfoList infos = storage.entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
-    QSet<QString> storageFiles;
+    QHash<QString, QFileInfo> onDisk;
+    onDisk.reserve(infos.size());
     for (const QFileInfo& fi : infos) {
-        storageFiles.insert(fi.absoluteFilePath());
+        if (MediaImporter::isPartialFile(fi.fileName())) continue;
+        onDisk.insert(pathKey(fi.absoluteFilePath()), fi);
     }
 
-    // 当前模型中记录的所有路径集合
-    QSet<QString> modelPaths;
-    for (auto it = m_categories.begin(); it != m_categories.end(); ++it) {
-        QStandardItem* group = it.value();
-        if (!group) continue;
-        bool groupChanged = false;
-        for (int r = group->rowCount() - 1; r >= 0; --r) {
-            QStandardItem* item = group->child(r);
-            if (!item) continue;
-            const QString path = item->data(PathRole).toString();
-            if (path.isEmpty()) continue;
-
-            // 若磁盘上该文件已不存在，则移除项
-            if (!QFileInfo(path).exists()) {
-                group->removeRow(r);
-                groupChanged = true;
-                anyChange = true;
-            }
-        }
-        if (groupChanged) {
-            renumberCategory(group);
+    bool anyChange = false;
+    QSet<QStandardItem*> needRenumber;
+    // 移除存储目录中已消失的文件
+    for (auto it = m_itemsByPath.begin(); it != m_itemsByPath.end();) {
+        QStandardItem* item = it.value();
+        const QString path = item->data(PathRole).toString();
+        if (onDisk.contains(it.key()) || pathKey(QFileInfo(path).absolutePath()) != storageKey) {
+            ++it;
+            continue;
         }
+        it = m_itemsByPath.erase(it);
+        QStandardItem* group = item->parent();
+        group->removeRow(item->row());
+        needRenumber.insert(group);
+        anyChange = true;
+    }
+    for (QStandardItem* group : needRenumber) {
+        renumberCategory(group);
     }
 
-    // 将存储目录中新出现的文件加入模型
-    for (const QString& absPath : storageFiles) {
-        if (!modelPaths.contains(absPath)) {
-            addFile(absPath);
-            anyChange = true;
+    // 加入新文件；已有文件的大小或修改时间变化时重新探测
+    for (auto it = onDisk.cbegin(); it != onDisk.cend(); ++it) {
+        QStandardItem* item = m_itemsByPath.value(it.key(), nullptr);
+        if (!item) {
+            if (insertFileItem(it->absoluteFilePath())) anyChange = true;
+            continue;
+        }
+        const QVariantMap meta = item->data(MetadataRole).toMap();
+        if (!meta.isEmpty()
+            && (meta.value("size").toLongLong() != it->size()
+                || meta.value("modified").toLongLong() != it->lastModified().toMSecsSinceEpoch())) {
+            m_indexer->request(it->absoluteFilePath());
         }
     }
 
-    // 重新开启信号，并统一通知一次
-    this->blockSignals(false);
     if (anyChange) {
         emit libraryChanged();
     }
 }
+
+/**
+ * @brief 存储目录外的已入库文件发生变化：被删除则移除条目，否则重新探测
+ */
+void MediaLibrary::onWatchedFileChanged(const QString& path)
+{
+    QStandardItem* item = m_itemsByPath.value(pathKey(path), nullptr);
+    if (!item) return;
+    if (QFileInfo::exists(path)) {
+        // 部分编辑器以“写新文件再替换”的方式保存，监视会丢失，需重新添加
+        if (!m_watcher->files().contains(path)) {
+            m_watcher->addPath(path);
+        }
+        m_indexer->request(path);
+        return;
+    }
+    QStandardItem* group = item->parent();
+    forgetItem(item);
+    group->removeRow(item->row());
+    renumberCategory(group);
+    emit libraryChanged();
+}
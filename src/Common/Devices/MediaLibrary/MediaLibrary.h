@@ -7,6 +7,11 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QtGui/QStandardItemModel>
+#include <QFileSystemWatcher>
+#include <QThread>
+#include <QTimer>
+#include "MediaIndexer.h"
+#include "MediaImporter.h"
 
 #ifdef MEDIAMANGER_LIBRARY
 #define MEDIAMANGER_EXPORT Q_DECL_EXPORT
@@ -46,13 +51,18 @@ public:
         PathRole     = Qt::UserRole + 1,
         CategoryRole = Qt::UserRole + 2,
         OrdinalRole  = Qt::UserRole + 3,
-        ParentRowRole= Qt::UserRole + 4  // 新增：父组的行号（顶层组为 -1）
+        ParentRowRole= Qt::UserRole + 4, // 新增：父组的行号（顶层组为 -1）
+        MetadataRole = Qt::UserRole + 5, // 媒体元数据（QVariantMap，探测完成后填充）
+        ThumbnailRole= Qt::UserRole + 6  // 缩略图文件路径（无缩略图时为空）
     };
 
+    static constexpr int RescanDelayMs = 250;   // 目录变化后合并刷新的延迟
+
     /**
      * @brief 构造函数：初始化五个分类的组节点
      */
     explicit MediaLibrary(QObject* parent = nullptr);
+    ~MediaLibrary() override;
 
     static MediaLibrary* instance() {
         static MediaLibrary* sender = nullptr;
@@ -73,10 +83,25 @@ public:
     QModelIndex addFile(const QString& absPath);
 
     /**
-     * @brief 批量添加文件
+     * @brief 批量添加文件：存储目录外的文件交给后台线程分块复制，完成后增量入库
      */
     void addFiles(const QStringList& absPaths);
 
+    /**
+     * @brief 是否有导入任务在进行
+     */
+    bool isImporting() const { return m_pendingImports > 0; }
+
+    /**
+     * @brief 取消正在进行的导入（已复制完成的文件保留）
+     */
+    void cancelImport();
+
+    /**
+     * @brief 查询文件的缓存元数据（文件未变化时有效）
+     */
+    bool mediaInfo(const QString& absPath, MediaInfo* info) const;
+
     /**
      * @brief 添加文件夹（递归或扁平可按需扩展，这里仅一层）
      */
@@ -130,11 +155,39 @@ signals:
      * @brief 数据变更信号（用于通知视图层刷新或外部持久化）
      */
     void libraryChanged();
+
+    /**
+     * @brief 导入进度（字节）；currentFile 为正在复制的源文件
+     */
+    void importProgress(qint64 bytesDone, qint64 bytesTotal, const QString& currentFile);
+
+    /**
+     * @brief 一批导入结束
+     */
+    void importFinished(bool canceled);
 public slots:
     /**
-     *
+     * @brief 手动刷新：增量比对存储目录，并校验存储目录外条目是否仍存在
      */
     void refresh();
+private slots:
+    /**
+     * @brief 合并短时间内的多次目录变化，延迟执行一次增量刷新
+     */
+    void scheduleRescan();
+
+    /**
+     * @brief 增量刷新存储目录：一次目录枚举，仅处理新增、消失与变化的文件
+     */
+    void rescanStorage();
+
+    /**
+     * @brief 存储目录外的已入库文件发生变化（修改或删除）
+     */
+    void onWatchedFileChanged(const QString& path);
+
+    void onMediaInfoReady(const QString& absPath, const MediaInfo& info);
+    void onImportFinished(bool canceled);
 private:
     /**
      * @brief 根据扩展名判定类别
@@ -155,8 +208,37 @@ private:
      * @brief 判断该类别组内是否存在指定路径的文件（去重）
      */
     bool existsInCategory(QStandardItem* catItem, const QString& absPath) const;
+
+    /**
+     * @brief 插入文件项但不发出 libraryChanged，供批量操作合并通知
+     * @return 新增的项；若文件不存在或重复则返回 nullptr
+     */
+    QStandardItem* insertFileItem(const QString& absPath);
+
+    /**
+     * @brief 在移除文件项之前清理路径索引、文件监视与元数据缓存
+     */
+    void forgetItem(QStandardItem* item);
+
+    /**
+     * @brief 把探测到的元数据写入文件项（提示框、缩略图图标）
+     */
+    void applyMediaInfo(QStandardItem* item, const MediaInfo& info);
+
+    /**
+     * @brief 路径索引键（Windows 上大小写不敏感）
+     */
+    static QString pathKey(const QString& absPath);
 private:
     QHash<Category, QStandardItem*> m_categories;
+    QHash<QString, QStandardItem*> m_itemsByPath;   ///< 路径索引，替代逐项线性查找
+    MediaIndexer* m_indexer = nullptr;
+    MediaImporter* m_importer = nullptr;
+    QThread* m_importThread = nullptr;
+    QFileSystemWatcher* m_watcher = nullptr;
+    QTimer* m_rescanTimer = nullptr;
+    QStringList m_importFailures;
+    int m_pendingImports = 0;
     void initializeStorageDir();
     QString uniqueFileNameInStorage(const QString& fileName) const;
     // 新增：判断路径是否位于存储目录
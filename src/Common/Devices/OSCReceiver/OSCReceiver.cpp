@@ -5,10 +5,39 @@
 #include "OSCReceiver.h"
 #include <QJsonObject>
 #include <QByteArray>
+#include <QDateTime>
 #include <QHostAddress>
+#include <QMetaMethod>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+#include <utility>
 #include "tinyosc.h"
 #include <QThread>
 
+namespace {
+    constexpr quint64 ImmediateTimetag = 1;          // OSC 约定：时间标签 1 表示立即执行
+    constexpr qint64 NtpUnixOffsetSecs = 2208988800LL;
+
+    inline int pad4(int n) {
+        return (n + 3) & ~3;
+    }
+
+    /**
+     * 函数级注释：读取以 0 结尾、4 字节对齐的 OSC 字符串
+     * @return 下一个字段的偏移，越界时返回 -1
+     */
+    int readString(const char* data, int size, int offset, const char** out, int* len) {
+        const void* end = offset < size ? std::memchr(data + offset, '\0', size_t(size - offset)) : nullptr;
+        if (!end) {
+            return -1;
+        }
+        *out = data + offset;
+        *len = int(static_cast<const char*>(end) - *out);
+        return pad4(offset + *len + 1);
+    }
+}
+
 OSCReceiver::OSCReceiver(quint16 port, QObject *parent)
         : QObject(parent), mPort(port), mHost("0.0.0.0"), mSocket(nullptr) {
     // 启动线程
@@ -27,8 +56,17 @@ OSCReceiver::~OSCReceiver() {
     mThread->wait();
 }
 
+void OSCReceiver::setCoalescing(bool enabled) {
+    mCoalescing = enabled;
+}
+
 void OSCReceiver::initializeSocket() {
     mSocket = new QUdpSocket(this);
+    mBuffer.resize(2048);
+    mScheduleTimer = new QTimer(this);
+    mScheduleTimer->setSingleShot(true);
+    mScheduleTimer->setTimerType(Qt::PreciseTimer);
+    connect(mScheduleTimer, &QTimer::timeout, this, &OSCReceiver::deliverScheduled);
 
     if (mSocket->bind(QHostAddress(mHost), mPort,QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint)) {
         connect(mSocket, &QUdpSocket::readyRead, this, &OSCReceiver::processPendingDatagrams);
@@ -36,6 +74,9 @@ void OSCReceiver::initializeSocket() {
 }
 
 void OSCReceiver::cleanup() {
+    if (mScheduleTimer) {
+        mScheduleTimer->stop();
+    }
     if (mSocket) {
         mSocket->close();
         mSocket->deleteLater();
@@ -43,48 +84,273 @@ void OSCReceiver::cleanup() {
     }
 }
 
+/**
+ * 函数级注释：读取当前全部待处理数据报并解析，读取结束后统一投递
+ */
 void OSCReceiver::processPendingDatagrams() {
     while (mSocket && mSocket->hasPendingDatagrams()) {
-        QByteArray datagram;
-        datagram.resize(mSocket->pendingDatagramSize());
-
-        QHostAddress sender;
-        quint16 senderPort;
-        mSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-
-        // 使用 tinyosc 解析 OSC 数据
-        tosc_message oscMessage;
-        if (tosc_parseMessage(&oscMessage, datagram.data(), datagram.size()) == 0) {
-            const char *address = tosc_getAddress(&oscMessage);
-            result.insert("address", address);
-            message.address = QString(address);
-            message.port = mPort;
-
-            const char *format = tosc_getFormat(&oscMessage);
-
-            for (int i = 0; format[i] != '\0'; i++) {
-                const char type = format[i];
-                if (type == 'f') {
-                    double value = tosc_getNextFloat(&oscMessage);
-                    result.insert("type", "Float");
-                    result.insert("default", value);
-                    message.value = value;
-                } else if (type == 'i') {
-                    int32_t value = tosc_getNextInt32(&oscMessage);
-                    result.insert("type", "Int");
-                    result.insert("default", QVariant::fromValue(value));
-                    message.value = value;
-                } else if (type == 's') {
-                    const char *value = tosc_getNextString(&oscMessage);
-                    result.insert("type", "String");
-                    result.insert("default", value);
-                    message.value = QString(value);
+        const qint64 pending = mSocket->pendingDatagramSize();
+        if (pending > mBuffer.size()) {
+            mBuffer.resize(int(qMin<qint64>(pending, MaxDatagramSize)));
+        }
+        const qint64 size = mSocket->readDatagram(mBuffer.data(), mBuffer.size());
+        if (size <= 0) {
+            continue;
+        }
+        decodePacket(mBuffer.constData(), int(size), ImmediateTimetag);
+    }
+    flush();
+    armScheduleTimer();
+}
+
+/**
+ * 函数级注释：解析 OSC 包（消息或 #bundle，bundle 可嵌套）
+ * @param timetag 所在 bundle 的时间标签，单独的消息为立即执行
+ */
+void OSCReceiver::decodePacket(const char *data, int size, quint64 timetag) {
+    static const char BundleTag[8] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', '\0'};
+    if (size >= 8 && std::memcmp(data, BundleTag, 8) == 0) {
+        if (size < 16) {
+            return;
+        }
+        const quint64 bundleTimetag = qFromBigEndian<quint64>(data + 8);
+        int offset = 16;
+        while (offset + 4 <= size) {
+            const qint32 elementSize = qFromBigEndian<qint32>(data + offset);
+            offset += 4;
+            if (elementSize <= 0 || elementSize > size - offset) {
+                return;
+            }
+            decodePacket(data + offset, elementSize, bundleTimetag);
+            offset += elementSize;
+        }
+        return;
+    }
+    decodeMessage(data, size, timetag);
+}
+
+/**
+ * 函数级注释：解析单条 OSC 消息
+ * - 时间标签在未来时放入定时队列
+ */
+void OSCReceiver::decodeMessage(const char *data, int size, quint64 timetag) {
+    const char* addressPtr = nullptr;
+    int addressLen = 0;
+    int offset = readString(data, size, 0, &addressPtr, &addressLen);
+    if (offset < 0 || addressLen == 0 || addressPtr[0] != '/') {
+        return;
+    }
+    OSCMessage message;
+    message.address = QString::fromUtf8(addressPtr, addressLen);
+    message.port = mPort;
+
+    const char* tags = "";
+    int tagsLen = 0;
+    if (offset < size && data[offset] == ',') {
+        offset = readString(data, size, offset, &tags, &tagsLen);
+        if (offset < 0) {
+            return;
+        }
+    }
+
+    QVariantList args;
+    QString typeName;
+    QVariant lastValue;
+    QString lastType;
+    for (int i = 1; i < tagsLen; ++i) {
+        QVariant value;
+        switch (tags[i]) {
+            case 'i':
+            case 'c':
+            case 'r': {
+                if (offset + 4 > size) return;
+                const qint32 v = qFromBigEndian<qint32>(data + offset);
+                offset += 4;
+                if (tags[i] == 'i') {
+                    value = int(v);
+                    typeName = "Int";
+                } else if (tags[i] == 'c') {
+                    value = QString(QChar(v));
+                    typeName = "String";
+                } else {
+                    value = quint32(v);
+                    typeName = "Color";
                 }
+                break;
             }
+            case 'f': {
+                if (offset + 4 > size) return;
+                const quint32 bits = qFromBigEndian<quint32>(data + offset);
+                offset += 4;
+                float v;
+                std::memcpy(&v, &bits, sizeof(v));
+                value = double(v);
+                typeName = "Float";
+                break;
+            }
+            case 'd': {
+                if (offset + 8 > size) return;
+                const quint64 bits = qFromBigEndian<quint64>(data + offset);
+                offset += 8;
+                double v;
+                std::memcpy(&v, &bits, sizeof(v));
+                value = v;
+                typeName = "Double";
+                break;
+            }
+            case 'h':
+            case 't': {
+                if (offset + 8 > size) return;
+                if (tags[i] == 'h') {
+                    value = qint64(qFromBigEndian<qint64>(data + offset));
+                    typeName = "Int64";
+                } else {
+                    value = quint64(qFromBigEndian<quint64>(data + offset));
+                    typeName = "Timetag";
+                }
+                offset += 8;
+                break;
+            }
+            case 's':
+            case 'S': {
+                const char* str = nullptr;
+                int len = 0;
+                offset = readString(data, size, offset, &str, &len);
+                if (offset < 0) return;
+                value = QString::fromUtf8(str, len);
+                typeName = "String";
+                break;
+            }
+            case 'b':
+            case 'm': {
+                int len = 4;
+                if (tags[i] == 'b') {
+                    if (offset + 4 > size) return;
+                    len = qFromBigEndian<qint32>(data + offset);
+                    offset += 4;
+                }
+                if (len < 0 || offset + len > size) return;
+                value = QByteArray(data + offset, len);
+                offset += tags[i] == 'b' ? pad4(len) : 4;
+                typeName = "Blob";
+                break;
+            }
+            case 'T':
+            case 'F':
+                value = tags[i] == 'T';
+                typeName = "Bool";
+                break;
+            case 'I':
+                value = true;
+                typeName = "Impulse";
+                break;
+            case 'N':
+                typeName = "Nil";
+                break;
+            case '[':
+            case ']':
+                // 数组按顺序展开为参数
+                continue;
+            default:
+                // 未知类型无法确定长度，放弃整条消息
+                return;
+        }
+        if (value.isValid()) {
+            lastValue = value;
+            lastType = typeName;
+        }
+        args.append(value);
+    }
+
+    // 与旧版一致：值为最后一个参数，完整参数列表另行保存
+    message.value = lastValue;
+    message.type = lastType;
+    ReceivedMessage received{std::move(message), std::move(args)};
+
+    if (timetag != ImmediateTimetag) {
+        const qint64 dueMs = timetagToMsecs(timetag);
+        if (dueMs > QDateTime::currentMSecsSinceEpoch() && int(mScheduled.size()) < MaxScheduledMessages) {
+            mScheduled.push({dueMs, mScheduleOrder++, std::move(received)});
+            return;
+        }
+    }
+    enqueue(std::move(received));
+}
+
+/**
+ * 函数级注释：加入本次投递批次；开启合并时同一地址只保留最新值（位置保持首次出现的顺序）
+ */
+void OSCReceiver::enqueue(ReceivedMessage &&received) {
+    if (mCoalescing.load(std::memory_order_relaxed)) {
+        const int index = mBatchIndex.value(received.message.address, -1);
+        if (index >= 0) {
+            mBatch[index] = std::move(received);
+            return;
+        }
+        mBatchIndex.insert(received.message.address, mBatch.size());
+    }
+    mBatch.append(std::move(received));
+}
+
+/**
+ * 函数级注释：投递本批次消息，只为已连接的信号构造数据
+ */
+void OSCReceiver::flush() {
+    if (mBatch.isEmpty()) {
+        return;
+    }
+    static const QMetaMethod mapSignal = QMetaMethod::fromSignal(&OSCReceiver::receiveOSC);
+    static const QMetaMethod messageSignal = QMetaMethod::fromSignal(&OSCReceiver::receiveOSCMessage);
+    const bool wantMap = isSignalConnected(mapSignal);
+    const bool wantMessage = isSignalConnected(messageSignal);
+    for (const ReceivedMessage& received : std::as_const(mBatch)) {
+        const OSCMessage& message = received.message;
+        if (wantMap) {
+            QVariantMap result;
+            result.insert("address", message.address);
+            result.insert("type", message.type);
+            result.insert("default", message.value);
+            result.insert("args", received.args);
             emit receiveOSC(result);
+        }
+        if (wantMessage) {
             emit receiveOSCMessage(message);
         }
     }
+    mBatch.resize(0);
+    mBatchIndex.clear();
+}
+
+void OSCReceiver::deliverScheduled() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    while (!mScheduled.empty() && mScheduled.top().dueMs <= now) {
+        ReceivedMessage received = mScheduled.top().message;
+        mScheduled.pop();
+        enqueue(std::move(received));
+    }
+    flush();
+    armScheduleTimer();
+}
+
+void OSCReceiver::armScheduleTimer() {
+    if (!mScheduleTimer) {
+        return;
+    }
+    if (mScheduled.empty()) {
+        mScheduleTimer->stop();
+        return;
+    }
+    const qint64 delay = mScheduled.top().dueMs - QDateTime::currentMSecsSinceEpoch();
+    mScheduleTimer->start(int(qBound<qint64>(0, delay, std::numeric_limits<int>::max())));
+}
+
+/**
+ * 函数级注释：NTP 时间标签（1900 年起的秒 + 2^-32 秒小数）转换为 Unix 毫秒
+ */
+qint64 OSCReceiver::timetagToMsecs(quint64 timetag) {
+    const qint64 seconds = qint64(timetag >> 32) - NtpUnixOffsetSecs;
+    const qint64 fraction = qint64(((timetag & 0xffffffffULL) * 1000ULL) >> 32);
+    return seconds * 1000 + fraction;
 }
 
 
@@ -95,6 +361,6 @@ void OSCReceiver::setPort(const int &port) {
     }
     mPort = port;
     if (mSocket) {
-        mSocket->bind(QHostAddress(mHost), mPort);
+        mSocket->bind(QHostAddress(mHost), mPort, QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint);
     }
 }
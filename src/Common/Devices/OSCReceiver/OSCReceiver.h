@@ -7,14 +7,39 @@
 #include <QObject>
 #include "QThread"
 #include <QtNetwork/QUdpSocket>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+#include <QVariantList>
+#include <atomic>
+#include <queue>
+#include <vector>
 #include "OSCMessage.h"
 #include "tinyosc.h"
+
+/**
+ * @brief OSC 接收器（独立线程）
+ * - 数据报读入复用的缓冲区，直接在缓冲区上解析，不为每个数据报分配内存
+ * - 支持 #bundle（含嵌套）与时间标签：未来时间的 bundle 按时间标签定时投递，立即/过去的时间标签立即投递
+ * - 支持参数类型 i f d h s S c b T F N I t；值（"default"）与旧版一致为最后一个参数，
+ *   完整参数列表放在 receiveOSC 数据的 "args" 中
+ * - 开启合并（setCoalescing）后，一次读取突发内同一地址的多条消息只投递最新值；默认关闭，每条命令都会投递
+ * - 信号无连接时不构造对应的数据
+ */
 class OSCReceiver:public QObject {
     Q_OBJECT
 public:
+    static constexpr int MaxDatagramSize = 65536;
+    static constexpr int MaxScheduledMessages = 4096;   // 定时投递队列上限，超出时立即投递
+
     explicit OSCReceiver(quint16 port = 6000, QObject *parent = nullptr);
     ~OSCReceiver();
 
+    /**
+     * @brief 设置是否合并同一次读取中重复地址的消息（默认关闭；适合只关心最新值的数据流）
+     */
+    void setCoalescing(bool enabled);
+
 signals:
     void receiveOSCMessage(const OSCMessage& message);
     void receiveOSC(const QVariantMap& data);
@@ -25,13 +50,45 @@ public slots:
     void setPort(const int &port);
     void initializeSocket();
     void cleanup();
+private slots:
+    void deliverScheduled();
 private:
+    struct ReceivedMessage {
+        OSCMessage message;   // value 为最后一个参数
+        QVariantList args;    // 全部参数
+    };
+
+    struct ScheduledMessage {
+        qint64 dueMs;
+        quint64 order;
+        ReceivedMessage message;
+        bool operator>(const ScheduledMessage& other) const {
+            return dueMs != other.dueMs ? dueMs > other.dueMs : order > other.order;
+        }
+    };
+
+    void decodePacket(const char* data, int size, quint64 timetag);
+    void decodeMessage(const char* data, int size, quint64 timetag);
+    void enqueue(ReceivedMessage&& received);
+    void flush();
+    void armScheduleTimer();
+    static qint64 timetagToMsecs(quint64 timetag);
+
     quint16 mPort;
     QString mHost;
     QThread *mThread;
     QUdpSocket *mSocket;
-    QVariantMap result;
-    OSCMessage message;
+    QTimer *mScheduleTimer = nullptr;
+    QByteArray mBuffer;                          // 复用的接收缓冲区
+
+    // 本次读取突发内待投递的消息（按首次出现顺序，同一地址合并）
+    QVector<ReceivedMessage> mBatch;
+    QHash<QString, int> mBatchIndex;
+    std::atomic<bool> mCoalescing {false};
+
+    // 按时间标签定时投递的消息
+    std::priority_queue<ScheduledMessage, std::vector<ScheduledMessage>, std::greater<ScheduledMessage>> mScheduled;
+    quint64 mScheduleOrder = 0;
 };
 
 
@@ -5,9 +5,99 @@
 #include "OSCSender.h"
 #include <QJsonObject>
 #include <QByteArray>
+#include <cstring>
 #include <QHostAddress>
+#include <QMetaMethod>
+#include <QtEndian>
 #include <limits>
-#include "tinyosc.h"
+
+namespace {
+    /**
+     * 函数级注释：追加以 0 结尾并补齐到 4 字节的 OSC 字符串
+     */
+    void appendPadded(QByteArray& out, const char* data, int len) {
+        out.append(data, len);
+        out.append(4 - (len % 4), '\0');
+    }
+
+    void appendInt32(QByteArray& out, qint32 value) {
+        char bytes[4];
+        qToBigEndian(value, bytes);
+        out.append(bytes, 4);
+    }
+
+    void appendInt64(QByteArray& out, qint64 value) {
+        char bytes[8];
+        qToBigEndian(value, bytes);
+        out.append(bytes, 8);
+    }
+
+    /**
+     * 函数级注释：编码一个参数到类型标签与参数区
+     * - 整数在 int32 范围内编码为 i，超出时编码为 h；浮点编码为 f；字符串按 UTF-8 编码为 s
+     * - QVariantList 依次展开为多个参数
+     */
+    bool appendArgument(const QVariant& value, QByteArray& tags, QByteArray& args) {
+        switch (value.typeId()) {
+            case QMetaType::Double:
+            case QMetaType::Float: {
+                const float v = value.toFloat();
+                quint32 bits;
+                std::memcpy(&bits, &v, sizeof(bits));
+                tags.append('f');
+                appendInt32(args, qint32(bits));
+                return true;
+            }
+            case QMetaType::Int:
+            case QMetaType::Bool:
+                tags.append('i');
+                appendInt32(args, value.toInt());
+                return true;
+            case QMetaType::UInt:
+            case QMetaType::LongLong:
+            case QMetaType::ULongLong: {
+                if (value.typeId() == QMetaType::ULongLong
+                    && value.toULongLong() > quint64(std::numeric_limits<qint64>::max())) {
+                    return false;
+                }
+                const qint64 v = value.toLongLong();
+                if (v >= std::numeric_limits<qint32>::min() && v <= std::numeric_limits<qint32>::max()) {
+                    tags.append('i');
+                    appendInt32(args, qint32(v));
+                } else {
+                    tags.append('h');
+                    appendInt64(args, v);
+                }
+                return true;
+            }
+            case QMetaType::QString: {
+                const QByteArray utf8 = value.toString().toUtf8();
+                tags.append('s');
+                appendPadded(args, utf8.constData(), utf8.size());
+                return true;
+            }
+            case QMetaType::QByteArray: {
+                const QByteArray blob = value.toByteArray();
+                tags.append('b');
+                appendInt32(args, blob.size());
+                args.append(blob);
+                args.append((4 - blob.size() % 4) % 4, '\0');
+                return true;
+            }
+            case QMetaType::QVariantList: {
+                const QVariantList list = value.toList();
+                for (const QVariant& item : list) {
+                    if (!appendArgument(item, tags, args)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+}
 
 OSCSender* OSCSender::instance() {
     static OSCSender* sender = nullptr;
@@ -20,15 +110,17 @@ OSCSender* OSCSender::instance() {
  * @brief OSCSender构造函数 - 自动启动传输器
  */
 OSCSender::OSCSender(QString dstHost,quint16 port, QObject *parent):
+        m_timer(new QTimer(this)),
         mPort(port),
-        mHost(dstHost),
-        m_timer(new QTimer(this))
+        mHost(dstHost)
         {
         qRegisterMetaType<QVariantMap >("QVariantMap&");
         //注册信号传递数值类型
+        m_clock.start();
         mThread = new QThread(this);
         this->moveToThread(mThread);
         m_timer->setInterval(PROCESS_INTERVAL);
+        m_timer->setTimerType(Qt::PreciseTimer);
         m_timer->moveToThread(mThread);
         connect(mThread, &QThread::started, this, &OSCSender::initializeSocket);
         connect(mThread, &QThread::finished, this, &OSCSender::cleanup);
@@ -64,181 +156,245 @@ void OSCSender::cleanup() {
     }
 }
 void OSCSender::setHost(QString address,int port) {
+    QMutexLocker locker(&m_mutex);
     mHost=address;
     mPort = port;
 }
 
-void OSCSender::processQueue(){
+void OSCSender::setFlushInterval(const QString &host, int port, int intervalMs) {
+    {
+        QMutexLocker locker(&m_mutex);
+        const QString key = host + ':' + QString::number(port);
+        m_intervals.insert(key, qMax(1, intervalMs));
+        auto it = m_destinations.find(key);
+        if (it != m_destinations.end()) {
+            it->intervalMs = qMax(1, intervalMs);
+        }
+    }
+    // 定时器属于发送线程，在该线程内调整间隔
+    QMetaObject::invokeMethod(this, [this]() { updateTimerInterval(); }, Qt::QueuedConnection);
+}
 
-    // 处理队列中的消息，首先需要加锁，避免多线程冲突
+void OSCSender::setCoalescingEnabled(const QString &host, int port, bool enabled) {
     QMutexLocker locker(&m_mutex);
-    //当队列不为空时，处理队列中的消息，直到队列为空
-    while (!m_messageQueue.isEmpty()){
-        OSCMessage msg = m_messageQueue.dequeue();
-        char buffer[1024];
-        mHost = msg.host;
-        mPort = msg.port;
-        const QString &address = msg.address;
-        const QVariant &value = msg.value;
-
-        QString format;
-        std::vector<float> floatArgs;
-        std::vector<int32_t> intArgs;
-        std::vector<const char*> stringArgs;
-
-        // 构造格式字符串并根据值类型准备参数
-        if (value.typeId() == QMetaType::Double) {
-            format += "f";
-            floatArgs.push_back(static_cast<float>(value.toDouble()));
-        } else if (value.typeId() == QMetaType::Int) {
-            format += "i";
-            intArgs.push_back(value.toInt());
-        } else if (value.typeId() == QMetaType::QString) {
-            format += "s";
-            QByteArray ba = value.toString().toLatin1(); // must
-            stringArgs.push_back(ba.data());
-        } else if (value.typeId() == QMetaType::Bool) {
-            format += "i";
-            intArgs.push_back(value.toInt());
-        } else if (value.typeId() == QMetaType::LongLong) {
-            const qint64 v = value.toLongLong();
-            if (v < std::numeric_limits<int32_t>::min() || v > std::numeric_limits<int32_t>::max()) {
-                qWarning() << "OSC int32 overflow (qlonglong):" << v << "address:" << address;
-                continue;
-            }
-            format += "i";
-            intArgs.push_back(static_cast<int32_t>(v));
-        } else if (value.typeId() == QMetaType::ULongLong) {
-            const quint64 v = value.toULongLong();
-            if (v > static_cast<quint64>(std::numeric_limits<int32_t>::max())) {
-                qWarning() << "OSC int32 overflow (qulonglong):" << v << "address:" << address;
-                continue;
-            }
-            format += "i";
-            intArgs.push_back(static_cast<int32_t>(v));
-        } else {
-            qWarning() << "Unsupported value type in QVariantMap:" << value;
-            continue; // 跳过不支持的类型
+    const QString key = host + ':' + QString::number(port);
+    m_coalescing.insert(key, enabled);
+    auto it = m_destinations.find(key);
+    if (it != m_destinations.end()) {
+        it->coalescing = enabled;
+        if (!enabled) {
+            it->index.clear();
         }
+    }
+}
 
-        // 写入 OSC 消息
-        uint32_t len = 0;
-        if (floatArgs.size() + intArgs.size() + stringArgs.size() == 0) {
-            len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(), "");
-        } else {
-            // 动态展开参数
-            if (!floatArgs.empty()) {
-                len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                        format.toStdString().c_str(), floatArgs[0]);
-            } else if (!intArgs.empty()) {
-                len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                        format.toStdString().c_str(), intArgs[0]);
-            } else if (!stringArgs.empty()) {
-                len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                        format.toStdString().c_str(), stringArgs[0]);
+void OSCSender::setBundlingEnabled(const QString &host, int port, bool enabled) {
+    QMutexLocker locker(&m_mutex);
+    const QString key = host + ':' + QString::number(port);
+    m_bundling.insert(key, enabled);
+    auto it = m_destinations.find(key);
+    if (it != m_destinations.end()) {
+        it->bundling = enabled;
+    }
+}
+
+void OSCSender::setMtu(int bytes) {
+    QMutexLocker locker(&m_mutex);
+    m_mtu = qMax(64, bytes);
+}
+
+OSCSender::Stats OSCSender::getStats() const {
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+/**
+ * @brief 定时器间隔取所有目标发送间隔的最小值
+ */
+void OSCSender::updateTimerInterval() {
+    int interval = PROCESS_INTERVAL;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (int value : std::as_const(m_intervals)) {
+            interval = qMin(interval, value);
+        }
+    }
+    if (m_timer && m_timer->interval() != interval) {
+        m_timer->setInterval(interval);
+    }
+}
+
+/**
+ * @brief 查找或创建发送目标（调用方持有 m_mutex），目标未指定时使用默认主机与端口
+ */
+OSCSender::Destination &OSCSender::destinationFor(const QString &host, quint16 port) {
+    const QString targetHost = host.isEmpty() ? mHost : host;
+    const quint16 targetPort = port == 0 ? mPort : port;
+    const QString key = targetHost + ':' + QString::number(targetPort);
+    auto it = m_destinations.find(key);
+    if (it == m_destinations.end()) {
+        Destination destination;
+        destination.address = targetHost.compare("localhost", Qt::CaseInsensitive) == 0
+                                  ? QHostAddress(QHostAddress::LocalHost)
+                                  : QHostAddress(targetHost);
+        destination.port = targetPort;
+        destination.intervalMs = m_intervals.value(key, PROCESS_INTERVAL);
+        destination.coalescing = m_coalescing.value(key, false);
+        destination.bundling = m_bundling.value(key, false);
+        it = m_destinations.insert(key, destination);
+    }
+    return it.value();
+}
+
+/**
+ * @brief 返回编码后的 OSC 地址串（调用方持有 m_mutex）
+ */
+const QByteArray &OSCSender::encodedAddress(const QString &address) {
+    auto it = m_addressCache.constFind(address);
+    if (it != m_addressCache.constEnd()) {
+        return it.value();
+    }
+    if (m_addressCache.size() >= MaxAddressCache) {
+        m_addressCache.clear();
+    }
+    const QByteArray utf8 = address.toUtf8();
+    QByteArray encoded;
+    encoded.reserve(utf8.size() + 4);
+    appendPadded(encoded, utf8.constData(), utf8.size());
+    return m_addressCache.insert(address, encoded).value();
+}
+
+/**
+ * @brief 编码一条 OSC 消息（调用方持有 m_mutex）；无效值编码为无参数消息
+ */
+bool OSCSender::encode(const OSCMessage &message, QByteArray &out) {
+    QByteArray tags(",");
+    QByteArray args;
+    if (message.value.isValid() && !appendArgument(message.value, tags, args)) {
+        qWarning() << "Unsupported value type in OSC message:" << message.value << "address:" << message.address;
+        return false;
+    }
+    const QByteArray& address = encodedAddress(message.address);
+    out.reserve(address.size() + tags.size() + 4 + args.size());
+    out.append(address);
+    appendPadded(out, tags.constData(), tags.size());
+    out.append(args);
+    return true;
+}
+
+void OSCSender::processQueue(){
+    // 处理到期目标的待发送消息，首先需要加锁，避免多线程冲突
+    QMutexLocker locker(&m_mutex);
+    const qint64 now = m_clock.elapsed();
+    for (auto it = m_destinations.begin(); it != m_destinations.end(); ++it) {
+        Destination& destination = it.value();
+        if (destination.packets.isEmpty() || now - destination.lastFlushMs < destination.intervalMs) {
+            continue;
+        }
+        destination.lastFlushMs = now;
+        flushDestination(destination);
+    }
+}
+
+/**
+ * @brief 发送目标的全部待发送消息：尽量将多条消息装入同一个 bundle 数据报（调用方持有 m_mutex）
+ */
+void OSCSender::flushDestination(Destination &destination) {
+    static const char BundleHeader[16] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', '\0', 0, 0, 0, 0, 0, 0, 0, 1};
+    const QVector<QByteArray>& packets = destination.packets;
+    const int count = packets.size();
+    int i = 0;
+    while (i < count) {
+        int end = i;
+        int size = int(sizeof(BundleHeader));
+        if (destination.bundling) {
+            while (end < count && size + 4 + packets[end].size() <= m_mtu) {
+                size += 4 + packets[end].size();
+                ++end;
             }
         }
-        // 检查写入是否成功
-        if (len == 0) {
-            qWarning() << "Failed to write OSC message for address" << address;
-            continue; // 跳过失败的消息
+        if (end - i <= 1) {
+            // 单条消息（或超出 MTU 的消息）直接发送，不加 bundle 包装
+            writeDatagram(destination, packets[i].constData(), packets[i].size(), 1);
+            ++i;
+            continue;
         }
-        // 通过 QUdpSocket 发送数据
-        qint64 bytesSent = mSocket->writeDatagram(buffer, len, QHostAddress(mHost), mPort);
-        if (bytesSent < 0) {
-            qWarning() << "Failed to send OSC message for address" << address << "via QUdpSocket."<<mHost;
-            
+        m_datagram.resize(0);
+        m_datagram.append(BundleHeader, int(sizeof(BundleHeader)));
+        for (int k = i; k < end; ++k) {
+            appendInt32(m_datagram, packets[k].size());
+            m_datagram.append(packets[k]);
         }
+        writeDatagram(destination, m_datagram.constData(), m_datagram.size(), end - i);
+        i = end;
     }
-    
+    destination.packets.resize(0);
+    destination.index.clear();
+}
+
+bool OSCSender::writeDatagram(const Destination &destination, const char *data, int size, int messages) {
+    if (!mSocket) {
+        m_stats.dropped += messages;
+        return false;
+    }
+    const qint64 bytesSent = mSocket->writeDatagram(data, size, destination.address, destination.port);
+    if (bytesSent < 0) {
+        qWarning() << "Failed to send OSC datagram via QUdpSocket." << destination.address.toString()
+                   << mSocket->errorString();
+        m_stats.dropped += messages;
+        return false;
+    }
+    m_stats.sent += messages;
+    ++m_stats.datagrams;
+    return true;
 }
 
 bool OSCSender::sendOSCMessageWithQueue(const OSCMessage &message){
-    // 将OSCMessage加入队列，首先需要加锁，避免多线程冲突
-    QMutexLocker locker(&m_mutex);
-    //将OSCMessage加入队列
-    m_messageQueue.enqueue(message);
-    emit messageSent(message);
+    // 入队前编码，开启合并的目标同一地址只保留最新值，首先需要加锁，避免多线程冲突
+    {
+        QMutexLocker locker(&m_mutex);
+        QByteArray packet;
+        if (!encode(message, packet)) {
+            ++m_stats.dropped;
+            return false;
+        }
+        Destination& destination = destinationFor(message.host, quint16(message.port));
+        ++m_stats.queued;
+        const int index = destination.coalescing ? destination.index.value(message.address, -1) : -1;
+        if (index >= 0) {
+            destination.packets[index] = packet;
+            ++m_stats.coalesced;
+        } else if (destination.packets.size() >= MaxPendingPerDestination) {
+            ++m_stats.dropped;
+            return false;
+        } else {
+            if (destination.coalescing) {
+                destination.index.insert(message.address, destination.packets.size());
+            }
+            destination.packets.append(packet);
+        }
+    }
+    static const QMetaMethod sentSignal = QMetaMethod::fromSignal(&OSCSender::messageSent);
+    if (isSignalConnected(sentSignal)) {
+        emit messageSent(message);
+    }
     return true;
 }
 
 bool OSCSender::sendOSCMessageDirectly(const OSCMessage &message){
     // 直接发送消息，不加入队列，首先需要加锁，避免多线程冲突
-    QMutexLocker locker(&m_mutex);
-    char buffer[1024];
-    mHost = message.host;
-    mPort = message.port;
-    const QString &address = message.address;
-    const QVariant &value = message.value;
-
-    QString format;
-    std::vector<float> floatArgs;
-    std::vector<int32_t> intArgs;
-    std::vector<const char*> stringArgs;
-
-    // 构造格式字符串并根据值类型准备参数
-    if (value.typeId() == QMetaType::Double) {
-        format += "f";
-        floatArgs.push_back(static_cast<float>(value.toDouble()));
-    } else if (value.typeId() == QMetaType::Int) {
-        format += "i";
-        intArgs.push_back(value.toInt());
-    } else if (value.typeId() == QMetaType::QString) {
-        format += "s";
-        QByteArray ba = value.toString().toLatin1(); // must
-        stringArgs.push_back(ba.data());
-    } else if (value.typeId() == QMetaType::Bool) {
-        format += "i";
-        intArgs.push_back(value.toInt());
-    } else if (value.typeId() == QMetaType::LongLong) {
-        const qint64 v = value.toLongLong();
-        if (v < std::numeric_limits<int32_t>::min() || v > std::numeric_limits<int32_t>::max()) {
-            qWarning() << "OSC int32 overflow (qlonglong):" << v << "address:" << address;
+    {
+        QMutexLocker locker(&m_mutex);
+        QByteArray packet;
+        if (!encode(message, packet)) {
+            ++m_stats.dropped;
             return false;
         }
-        format += "i";
-        intArgs.push_back(static_cast<int32_t>(v));
-    } else if (value.typeId() == QMetaType::ULongLong) {
-        const quint64 v = value.toULongLong();
-        if (v > static_cast<quint64>(std::numeric_limits<int32_t>::max())) {
-            qWarning() << "OSC int32 overflow (qulonglong):" << v << "address:" << address;
+        const Destination& destination = destinationFor(message.host, quint16(message.port));
+        if (!writeDatagram(destination, packet.constData(), packet.size(), 1)) {
             return false;
         }
-        format += "i";
-        intArgs.push_back(static_cast<int32_t>(v));
-    } else {
-        qWarning() << "Unsupported value type in QVariantMap:" << value;
-        return false; // 跳过不支持的类型
-    }
-
-    // 写入 OSC 消息
-    uint32_t len = 0;
-    if (floatArgs.size() + intArgs.size() + stringArgs.size() == 0) {
-        len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(), "");
-    } else {
-        // 动态展开参数
-        if (!floatArgs.empty()) {
-            len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                    format.toStdString().c_str(), floatArgs[0]);
-        } else if (!intArgs.empty()) {
-            len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                    format.toStdString().c_str(), intArgs[0]);
-        } else if (!stringArgs.empty()) {
-            len = tosc_writeMessage(buffer, sizeof(buffer), address.toStdString().c_str(),
-                                    format.toStdString().c_str(), stringArgs[0]);
-        }
-    }
-    // 检查写入是否成功
-    if (len == 0) {
-        qWarning() << "Failed to write OSC message for address" << address;
-        return false; // 跳过失败的消息
-    }
-    // 通过 QUdpSocket 发送数据
-    qint64 bytesSent = mSocket->writeDatagram(buffer, len, QHostAddress(mHost), mPort);
-    if (bytesSent < 0) {
-        qWarning() << "Failed to send OSC message for address" << address << "via QUdpSocket."<<mHost;
-        return false;
     }
     emit messageSent(message);
     return true;
-}
\ No newline at end of file
+}
@@ -4,9 +4,12 @@
 #include <QThread>
 #include <QtNetwork/QUdpSocket>
 #include <QMutex>
-#include <QQueue>
+#include <QHash>
+#include <QVector>
 #include <QTimer>
 #include <QVariant>
+#include <QHostAddress>
+#include <QElapsedTimer>
 #include "OSCMessage.h"
 
 #ifdef OSCTRANSMITTER_LIBRARY
@@ -17,12 +20,32 @@
 /**
  * @brief OSC传输器类 - 多线程全局单例实现
  * 提供线程安全的OSC消息发送功能，支持队列和直接发送两种模式
+ * - 队列模式按目标（主机:端口）分组，入队时即编码，默认按入队顺序逐条发送
+ * - 开启合并的目标（状态反馈等只需最新值的流量）同一地址在发送前只保留最新值
+ * - 开启 bundle 的目标将多条消息打包为 #bundle，每个数据报不超过 MTU，单条消息不加 bundle 包装
+ * - 目标地址解析结果与编码后的 OSC 地址串均缓存
+ * - 每个目标可单独设置发送间隔；提供入队、合并、发送、丢弃计数
  */
 class OSCTRANSMITTER_EXPORT OSCSender : public QObject
 {
     Q_OBJECT
 
 public:
+    /**
+     * @brief 发送统计
+     */
+    struct Stats {
+        quint64 queued = 0;       // 入队消息数
+        quint64 coalesced = 0;    // 发送前被同地址新值覆盖的消息数
+        quint64 sent = 0;         // 已发送消息数
+        quint64 datagrams = 0;    // 已发送数据报数
+        quint64 dropped = 0;      // 因编码失败、队列已满或发送失败丢弃的消息数
+    };
+
+    static constexpr int DefaultMtu = 1472;                 // 以太网 MTU 减 IP/UDP 头
+    static constexpr int MaxPendingPerDestination = 8192;   // 每个目标待发送的最大地址数
+    static constexpr int MaxAddressCache = 4096;            // 编码地址缓存上限
+
     /**
      * @brief 构造函数，自动启动传输器
      * @param dstHost 默认目标主机地址
@@ -63,11 +86,38 @@ public slots:
     bool sendOSCMessageDirectly(const OSCMessage &message);
     
     /**
-     * @brief 设置目标主机和端口
+     * @brief 设置目标主机和端口（消息未指定目标时使用）
      * @param address 主机地址
      * @param port 端口号
      */
     void setHost(QString address, int port);
+
+    /**
+     * @brief 设置指定目标的发送间隔（线程安全）
+     * @param intervalMs 发送间隔（毫秒），最小 1
+     */
+    void setFlushInterval(const QString& host, int port, int intervalMs);
+
+    /**
+     * @brief 设置指定目标是否按地址合并待发送消息（线程安全，默认关闭）
+     * - 仅用于只关心最新值的状态流量；命令、触发类消息不能合并，否则脉冲与顺序会丢失
+     */
+    void setCoalescingEnabled(const QString& host, int port, bool enabled);
+
+    /**
+     * @brief 设置指定目标是否将多条消息打包为 bundle（线程安全，默认关闭，仅对确认支持 bundle 的接收端开启）
+     */
+    void setBundlingEnabled(const QString& host, int port, bool enabled);
+
+    /**
+     * @brief 设置数据报最大字节数（默认 DefaultMtu）
+     */
+    void setMtu(int bytes);
+
+    /**
+     * @brief 获取发送统计（线程安全）
+     */
+    Stats getStats() const;
     
     /**
      * @brief 初始化UDP套接字
@@ -86,15 +136,43 @@ signals:
     void messageSent(const OSCMessage &message);
     
 private:
+    /**
+     * @brief 单个发送目标的待发送消息（按地址合并）
+     */
+    struct Destination {
+        QHostAddress address;
+        quint16 port = 0;
+        int intervalMs = 0;
+        bool coalescing = false;
+        bool bundling = false;
+        qint64 lastFlushMs = 0;
+        QVector<QByteArray> packets;           // 已编码的消息（按首次入队顺序）
+        QHash<QString, int> index;             // OSC 地址 → packets 下标（仅合并模式）
+    };
+
+    Destination& destinationFor(const QString& host, quint16 port);
+    bool encode(const OSCMessage& message, QByteArray& out);
+    const QByteArray& encodedAddress(const QString& address);
+    void flushDestination(Destination& destination);
+    bool writeDatagram(const Destination& destination, const char* data, int size, int messages);
+    void updateTimerInterval();
+
     QTimer *m_timer;                    ///< 消息处理定时器
     quint16 mPort;                      ///< 目标端口
     QString mHost;                      ///< 目标主机
     QThread *mThread;                   ///< 工作线程
-    QUdpSocket *mSocket;                ///< UDP套接字
-    QMutex m_mutex;                     ///< 线程同步互斥锁
-    QQueue<OSCMessage> m_messageQueue;  ///< OSC消息队列
+    QUdpSocket *mSocket = nullptr;      ///< UDP套接字
+    mutable QMutex m_mutex;             ///< 线程同步互斥锁
+    QHash<QString, Destination> m_destinations;      ///< "主机:端口" → 目标
+    QHash<QString, QByteArray> m_addressCache;       ///< OSC 地址 → 编码后的地址串
+    QHash<QString, int> m_intervals;                 ///< "主机:端口" → 发送间隔
+    QHash<QString, bool> m_coalescing;               ///< "主机:端口" → 是否按地址合并
+    QHash<QString, bool> m_bundling;                 ///< "主机:端口" → 是否打包 bundle
+    QElapsedTimer m_clock;
+    QByteArray m_datagram;                           ///< 复用的打包缓冲区
+    int m_mtu = DefaultMtu;
+    Stats m_stats;
     
     /// 消息处理间隔时间（毫秒）
     static const int PROCESS_INTERVAL = 16;
 };
-
@@ -1,15 +1,24 @@
 #pragma once
 
 #include <QObject>
-#include <QReadWriteLock>
+#include <QMutex>
 #include <QHash>
-#include <QVector>
+#include <QSet>
+#include <QStringList>
+#include <QStringView>
+#include <QThread>
 #include <QPointer>
 #include <QVariant>
 #include <QByteArray>
 #include <QMetaType>
 #include <QMetaObject>
+#include <QMetaMethod>
+#include <QDebug>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 /**
  * 函数级注释：表示全局事件类型
@@ -53,13 +62,29 @@ Q_DECLARE_METATYPE(GlobalEvent)
 
 /**
  * 函数级注释：全局事件总线类，负责在模块之间分发基于地址的消息
- * - 支持按地址订阅与取消订阅
- * - 支持多订阅者，所有匹配订阅者都会收到对应事件
- * - 使用 Qt::QueuedConnection 分发事件，保证跨线程安全
+ * - 支持按地址订阅与取消订阅；订阅地址可使用 OSC 模式（? * [abc] [!a-z] {foo,bar}），
+ *   例如 /dataflow/{main,aux}/1[0-9]/play 订阅两个别名下节点 10~19 的播放地址；发布地址同样可使用 OSC 模式匹配已订阅的普通地址
+ * - 订阅按地址分段组织为前缀树：普通分段哈希查找，模式分段逐个匹配，分发不再遍历全部订阅
+ * - 订阅表为不可变快照（写时复制，只复制被修改的路径），发布只原子读取快照，不加锁
+ * - 接收者位于发布线程时直接调用（嵌套层数过深时退回排队），否则以 Qt::QueuedConnection 投递到接收者线程
+ * - 订阅可为类型化成员函数（void (T::*)(const GlobalEvent&)），也兼容 SLOT() 字符串（订阅时解析为 QMetaMethod）
+ * - 接收者销毁时自动取消其全部订阅
  */
 class STATUSCONTAINER_EXPORT GlobalEventBus : public QObject {
     Q_OBJECT
 public:
+    /**
+     * 函数级注释：分发方式
+     * - Auto：接收者位于发布线程时直接调用，否则排队
+     * - Queued：总是排队（与旧行为一致，适合不可重入的处理函数）
+     */
+    enum class DispatchMode {
+        Auto,
+        Queued
+    };
+
+    static constexpr int MaxDirectDepth = 8;    // 同一线程内直接分发的最大嵌套层数
+
     /**
      * 函数级注释：获取全局单例实例（线程安全懒汉式）
      */
@@ -71,7 +96,7 @@ public:
 
     /**
      * 函数级注释：发布一条事件到总线（默认视为命令事件）
-     * @param address  事件地址（如 /dataflow/alias/nodeId/path）
+     * @param address  事件地址（如 /dataflow/alias/nodeId/path），可为 OSC 模式
      * @param payload  事件载荷（可选，默认空）
      */
     void publish(const QString& address, const QVariant& payload = QVariant(), GlobalEventKind kind = GlobalEventKind::Command)
@@ -81,7 +106,10 @@ public:
         }
         GlobalEvent event(address, payload, kind);
         dispatch(event);
-        emit eventPublished(event);
+        static const QMetaMethod publishedSignal = QMetaMethod::fromSignal(&GlobalEventBus::eventPublished);
+        if (isSignalConnected(publishedSignal)) {
+            emit eventPublished(event);
+        }
     }
 
     /**
@@ -100,16 +128,41 @@ public:
         publish(address, payload, GlobalEventKind::Feedback);
     }
 
+    /**
+     * 函数级注释：以类型化成员函数订阅指定地址上的事件
+     * @param address  要订阅的事件地址，可为 OSC 模式
+     * @param receiver 接收对象（QObject 派生类）
+     * @param method   成员函数指针，形式如 &MyNode::onGlobalEvent
+     * - 同一对象对同一地址、同一成员函数的重复订阅将被忽略
+     */
+    template<typename Receiver>
+    void subscribe(const QString& address, Receiver* receiver, void (Receiver::*method)(const GlobalEvent&),
+                   DispatchMode mode = DispatchMode::Auto)
+    {
+        static_assert(std::is_base_of<QObject, Receiver>::value, "receiver must be a QObject");
+        if (!receiver || !method) {
+            return;
+        }
+        QByteArray key(reinterpret_cast<const char*>(&method), int(sizeof(method)));
+        key.prepend("&");
+        addSubscriber(address, receiver, key, mode,
+                      [method](QObject* target, const GlobalEvent& event) {
+                          (static_cast<Receiver*>(target)->*method)(event);
+                      });
+    }
+
     /**
      * 函数级注释：订阅指定地址上的事件
-     * @param address  要订阅的事件地址
+     * @param address  要订阅的事件地址，可为 OSC 模式
      * @param receiver 槽函数所在对象指针（QObject 派生类）
      * @param method   槽函数签名，形式如 SLOT(onGlobalEvent(GlobalEvent))
+     * - 订阅时解析为 QMetaMethod，分发时不再按名称查找
      * - 同一对象对同一地址、同一槽函数的重复订阅将被忽略
      */
-    void subscribe(const QString& address, QObject* receiver, const char* method)
+    void subscribe(const QString& address, QObject* receiver, const char* method,
+                   DispatchMode mode = DispatchMode::Auto)
     {
-        if (address.isEmpty() || !receiver || !method) {
+        if (!receiver || !method) {
             return;
         }
 
@@ -126,22 +179,29 @@ public:
         }
         sig = QMetaObject::normalizedSignature(sig.constData());
 
-        QWriteLocker locker(&_lock);
-        QVector<HandlerEndpoint>& list = _handlers[address];
-        for (const HandlerEndpoint& ep : list) {
-            if (ep.target == receiver && ep.method == sig) {
-                return;
+        const QMetaObject* meta = receiver->metaObject();
+        QMetaMethod metaMethod;
+        for (int i = meta->methodCount() - 1; i >= 0; --i) {
+            const QMetaMethod candidate = meta->method(i);
+            if (candidate.name() == sig && candidate.parameterCount() == 1) {
+                metaMethod = candidate;
+                break;
             }
         }
-        HandlerEndpoint ep;
-        ep.target = receiver;
-        ep.method = sig;
-        list.push_back(ep);
+        if (!metaMethod.isValid()) {
+            qWarning() << "GlobalEventBus: no method" << sig << "on" << meta->className();
+            return;
+        }
+
+        addSubscriber(address, receiver, sig, mode,
+                      [metaMethod](QObject* target, const GlobalEvent& event) {
+                          metaMethod.invoke(target, Qt::DirectConnection, Q_ARG(GlobalEvent, event));
+                      });
     }
 
     /**
-     * 函数级注释：取消某对象在指定地址上的所有槽函数订阅
-     * @param address  事件地址
+     * 函数级注释：取消某对象在指定地址上的所有订阅
+     * @param address  事件地址（与订阅时一致，模式地址按原文匹配）
      * @param receiver 槽函数所在对象指针
      */
     void unsubscribe(const QString& address, QObject* receiver)
@@ -149,19 +209,15 @@ public:
         if (address.isEmpty() || !receiver) {
             return;
         }
-        QWriteLocker locker(&_lock);
-        auto it = _handlers.find(address);
-        if (it == _handlers.end()) {
+        QMutexLocker locker(&_writeLock);
+        auto it = _addressesByReceiver.find(receiver);
+        if (it == _addressesByReceiver.end() || !it.value().remove(address)) {
             return;
         }
-        QVector<HandlerEndpoint>& list = it.value();
-        list.erase(std::remove_if(list.begin(), list.end(),
-                                  [receiver](const HandlerEndpoint& ep) {
-                                      return ep.target == receiver;
-                                  }),
-                   list.end());
-        if (list.isEmpty()) {
-            _handlers.erase(it);
+        removeReceiverAt(address, receiver);
+        if (it.value().isEmpty()) {
+            _addressesByReceiver.erase(it);
+            disconnect(receiver, &QObject::destroyed, this, nullptr);
         }
     }
 
@@ -174,20 +230,107 @@ public:
         if (!receiver) {
             return;
         }
-        QWriteLocker locker(&_lock);
-        for (auto it = _handlers.begin(); it != _handlers.end();) {
-            QVector<HandlerEndpoint>& list = it.value();
-            list.erase(std::remove_if(list.begin(), list.end(),
-                                      [receiver](const HandlerEndpoint& ep) {
-                                          return ep.target == receiver;
-                                      }),
-                       list.end());
-            if (list.isEmpty()) {
-                it = _handlers.erase(it);
+        QMutexLocker locker(&_writeLock);
+        auto it = _addressesByReceiver.find(receiver);
+        if (it == _addressesByReceiver.end()) {
+            return;
+        }
+        const auto addresses = std::move(it.value());
+        _addressesByReceiver.erase(it);
+        for (const QString& address : addresses) {
+            removeReceiverAt(address, receiver);
+        }
+        disconnect(receiver, &QObject::destroyed, this, nullptr);
+    }
+
+    /**
+     * 函数级注释：OSC 地址分段模式匹配
+     * - ? 任意单字符；* 任意长度；[abc]/[a-z] 字符集合，[!...] 取反；{foo,bar} 任一字符串
+     */
+    static bool matchSegment(QStringView pattern, QStringView text)
+    {
+        while (!pattern.isEmpty()) {
+            const QChar c = pattern.front();
+            if (c == QLatin1Char('*')) {
+                pattern = pattern.mid(1);
+                if (pattern.isEmpty()) {
+                    return true;
+                }
+                for (qsizetype i = 0; i <= text.size(); ++i) {
+                    if (matchSegment(pattern, text.mid(i))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            if (c == QLatin1Char('{')) {
+                const qsizetype close = pattern.indexOf(QLatin1Char('}'));
+                if (close < 0) {
+                    return false;
+                }
+                const QStringView rest = pattern.mid(close + 1);
+                qsizetype begin = 1;
+                while (begin <= close) {
+                    qsizetype end = pattern.indexOf(QLatin1Char(','), begin);
+                    if (end < 0 || end > close) {
+                        end = close;
+                    }
+                    const QStringView option = pattern.mid(begin, end - begin);
+                    if (text.startsWith(option) && matchSegment(rest, text.mid(option.size()))) {
+                        return true;
+                    }
+                    begin = end + 1;
+                }
+                return false;
+            }
+            if (text.isEmpty()) {
+                return false;
+            }
+            if (c == QLatin1Char('[')) {
+                const qsizetype close = pattern.indexOf(QLatin1Char(']'));
+                if (close < 0) {
+                    return false;
+                }
+                QStringView set = pattern.mid(1, close - 1);
+                const bool negate = set.startsWith(QLatin1Char('!'));
+                if (negate) {
+                    set = set.mid(1);
+                }
+                bool found = false;
+                for (qsizetype i = 0; i < set.size() && !found; ++i) {
+                    if (i + 2 < set.size() && set[i + 1] == QLatin1Char('-')) {
+                        found = text.front() >= set[i] && text.front() <= set[i + 2];
+                        i += 2;
+                    } else {
+                        found = text.front() == set[i];
+                    }
+                }
+                if (found == negate) {
+                    return false;
+                }
+                pattern = pattern.mid(close + 1);
             } else {
-                ++it;
+                if (c != QLatin1Char('?') && c != text.front()) {
+                    return false;
+                }
+                pattern = pattern.mid(1);
+            }
+            text = text.mid(1);
+        }
+        return text.isEmpty();
+    }
+
+    /**
+     * 函数级注释：分段是否包含 OSC 模式字符
+     */
+    static bool isPattern(QStringView segment)
+    {
+        for (const QChar c : segment) {
+            if (c == QLatin1Char('*') || c == QLatin1Char('?') || c == QLatin1Char('[') || c == QLatin1Char('{')) {
+                return true;
             }
         }
+        return false;
     }
 
 signals:
@@ -198,51 +341,216 @@ signals:
     void eventPublished(const GlobalEvent& event);
 
 private:
+    using Handler = std::function<void(QObject*, const GlobalEvent&)>;
+
+    /**
+     * 函数级注释：内部订阅端点结构，创建后不可变
+     */
+    struct HandlerEndpoint {
+        QPointer<QObject> target;
+        const QObject* owner = nullptr;   // 取消订阅时的比较键（对象销毁后 target 已为空）
+        QByteArray method;                 // 去重键：槽函数名或成员函数指针
+        DispatchMode mode = DispatchMode::Auto;
+        Handler handler;
+    };
+    using EndpointPtr = std::shared_ptr<const HandlerEndpoint>;
+
+    /**
+     * 函数级注释：前缀树节点，发布后不可变；修改时复制路径上的节点
+     */
+    struct TrieNode {
+        std::vector<EndpointPtr> endpoints;
+        QHash<QString, std::shared_ptr<const TrieNode>> literal;
+        std::vector<std::pair<QString, std::shared_ptr<const TrieNode>>> patterns;
+
+        bool isEmpty() const { return endpoints.empty() && literal.isEmpty() && patterns.empty(); }
+    };
+    using NodePtr = std::shared_ptr<const TrieNode>;
+    using EndpointEditor = std::function<void(std::vector<EndpointPtr>&)>;
+
     /**
      * 函数级注释：构造函数，注册元类型并初始化内部状态
      */
     explicit GlobalEventBus(QObject* parent = nullptr)
         : QObject(parent)
+        , _root(std::make_shared<const TrieNode>())
     {
         qRegisterMetaType<GlobalEvent>("GlobalEvent");
     }
 
     Q_DISABLE_COPY(GlobalEventBus)
 
+    static QStringList splitAddress(const QString& address)
+    {
+        return address.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+    }
+
     /**
-     * 函数级注释：将事件分发给所有已订阅该地址的接收者
-     * - 使用只读锁复制订阅列表，在锁外进行实际调用
-     * - 使用 Qt::QueuedConnection 保证跨线程调用安全
+     * 函数级注释：添加订阅端点（写锁内复制路径并原子替换快照）
+     * - 首次订阅的接收者连接 destroyed，销毁时自动取消全部订阅；全部取消订阅时断开该连接，再次订阅不会重复连接
      */
-    void dispatch(const GlobalEvent& event)
+    void addSubscriber(const QString& address, QObject* receiver, const QByteArray& key, DispatchMode mode, Handler handler)
+    {
+        if (address.isEmpty()) {
+            return;
+        }
+        auto endpoint = std::make_shared<HandlerEndpoint>();
+        endpoint->target = receiver;
+        endpoint->owner = receiver;
+        endpoint->method = key;
+        endpoint->mode = mode;
+        endpoint->handler = std::move(handler);
+
+        QMutexLocker locker(&_writeLock);
+        bool added = false;
+        const NodePtr root = edit(std::atomic_load(&_root), splitAddress(address), 0,
+                                  [&](std::vector<EndpointPtr>& endpoints) {
+                                      for (const EndpointPtr& existing : endpoints) {
+                                          if (existing->owner == receiver && existing->method == key) {
+                                              return;
+                                          }
+                                      }
+                                      endpoints.push_back(endpoint);
+                                      added = true;
+                                  });
+        if (!added) {
+            return;
+        }
+        std::atomic_store(&_root, root ? root : std::make_shared<const TrieNode>());
+
+        auto it = _addressesByReceiver.find(receiver);
+        if (it == _addressesByReceiver.end()) {
+            it = _addressesByReceiver.insert(receiver, QSet<QString>());
+            connect(receiver, &QObject::destroyed, this, [this, receiver]() {
+                unsubscribe(receiver);
+            }, Qt::DirectConnection);
+        }
+        it.value().insert(address);
+    }
+
+    /**
+     * 函数级注释：移除接收者在某地址上的全部端点（调用方持有 _writeLock）
+     */
+    void removeReceiverAt(const QString& address, const QObject* receiver)
+    {
+        const NodePtr root = edit(std::atomic_load(&_root), splitAddress(address), 0,
+                                  [receiver](std::vector<EndpointPtr>& endpoints) {
+                                      endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                                                     [receiver](const EndpointPtr& ep) {
+                                                                         return ep->owner == receiver;
+                                                                     }),
+                                                      endpoints.end());
+                                  });
+        std::atomic_store(&_root, root ? root : std::make_shared<const TrieNode>());
+    }
+
+    /**
+     * 函数级注释：复制 segments[index..] 路径上的节点并修改末端端点列表
+     * @return 新节点；修改后为空时返回 nullptr，由上层删除该分支
+     */
+    static NodePtr edit(const NodePtr& node, const QStringList& segments, int index, const EndpointEditor& editor)
     {
-        QVector<HandlerEndpoint> endpoints;
-        {
-            QReadLocker locker(&_lock);
-            auto it = _handlers.find(event.address);
-            if (it != _handlers.end()) {
-                endpoints = it.value();
+        auto copy = node ? std::make_shared<TrieNode>(*node) : std::make_shared<TrieNode>();
+        if (index == segments.size()) {
+            editor(copy->endpoints);
+        } else {
+            const QString& segment = segments[index];
+            if (isPattern(segment)) {
+                auto it = std::find_if(copy->patterns.begin(), copy->patterns.end(),
+                                       [&segment](const auto& entry) { return entry.first == segment; });
+                NodePtr child = edit(it != copy->patterns.end() ? it->second : NodePtr(), segments, index + 1, editor);
+                if (it != copy->patterns.end()) {
+                    if (child) {
+                        it->second = child;
+                    } else {
+                        copy->patterns.erase(it);
+                    }
+                } else if (child) {
+                    copy->patterns.emplace_back(segment, child);
+                }
+            } else {
+                NodePtr child = edit(copy->literal.value(segment), segments, index + 1, editor);
+                if (child) {
+                    copy->literal.insert(segment, child);
+                } else {
+                    copy->literal.remove(segment);
+                }
             }
         }
-        for (const HandlerEndpoint& ep : endpoints) {
-            if (!ep.target) {
-                continue;
+        return copy->isEmpty() ? nullptr : NodePtr(std::move(copy));
+    }
+
+    /**
+     * 函数级注释：在快照中收集与地址匹配的端点
+     * - 订阅侧模式分段与发布分段逐个匹配；发布分段为模式时匹配全部普通子分段
+     */
+    static void collect(const TrieNode& node, const QStringList& segments, int index, std::vector<EndpointPtr>& out)
+    {
+        if (index == segments.size()) {
+            out.insert(out.end(), node.endpoints.begin(), node.endpoints.end());
+            return;
+        }
+        const QString& segment = segments[index];
+        if (isPattern(segment)) {
+            for (auto it = node.literal.cbegin(); it != node.literal.cend(); ++it) {
+                if (matchSegment(segment, it.key())) {
+                    collect(*it.value(), segments, index + 1, out);
+                }
+            }
+            for (const auto& [pattern, child] : node.patterns) {
+                if (pattern == segment) {
+                    collect(*child, segments, index + 1, out);
+                }
+            }
+            return;
+        }
+        const auto literal = node.literal.constFind(segment);
+        if (literal != node.literal.cend()) {
+            collect(*literal.value(), segments, index + 1, out);
+        }
+        for (const auto& [pattern, child] : node.patterns) {
+            if (matchSegment(pattern, segment)) {
+                collect(*child, segments, index + 1, out);
             }
-            QMetaObject::invokeMethod(ep.target,
-                                      ep.method.constData(),
-                                      Qt::QueuedConnection,
-                                      Q_ARG(GlobalEvent, event));
         }
     }
 
     /**
-     * 函数级注释：内部订阅端点结构，记录目标对象与槽函数信息
+     * 函数级注释：将事件分发给所有匹配地址的接收者
+     * - 原子读取不可变快照，不加锁
+     * - 接收者位于当前线程时直接调用（嵌套过深时退回排队），否则排队到接收者线程
      */
-    struct HandlerEndpoint {
-        QPointer<QObject> target;
-        QByteArray method;
-    };
+    void dispatch(const GlobalEvent& event)
+    {
+        const NodePtr root = std::atomic_load(&_root);
+        if (root->isEmpty()) {
+            return;
+        }
+        std::vector<EndpointPtr> endpoints;
+        collect(*root, splitAddress(event.address), 0, endpoints);
+
+        static thread_local int depth = 0;
+        QThread* const current = QThread::currentThread();
+        for (const EndpointPtr& ep : endpoints) {
+            QObject* target = ep->target.data();
+            if (!target) {
+                continue;
+            }
+            if (ep->mode == DispatchMode::Auto && target->thread() == current && depth < MaxDirectDepth) {
+                ++depth;
+                ep->handler(target, event);
+                --depth;
+                continue;
+            }
+            QMetaObject::invokeMethod(target, [ep, event]() {
+                if (QObject* receiver = ep->target.data()) {
+                    ep->handler(receiver, event);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }
 
-    mutable QReadWriteLock _lock;
-    QHash<QString, QVector<HandlerEndpoint>> _handlers;
+    NodePtr _root;                                       // 订阅快照，std::atomic_load/atomic_store 访问
+    QMutex _writeLock;                                   // 串行化订阅修改
+    QHash<const QObject*, QSet<QString>> _addressesByReceiver;
 };
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <QLineEdit>
 #include <QToolButton>
 #include <QTimer>
+#include <QSet>
+#include <algorithm>
 #include "Elements/FaderWidget/FaderWidget.h"
 
 StatusContainer* StatusContainer::instance() {
@@ -35,6 +37,7 @@ void StatusContainer::registerWidget(QWidget* p, const QString& a) {
         it.value() = item;
     } else {
         _latest.insert(a, StatusItem(p, a, QVariant()));
+        _addressIndex.insert(a);
     }
 }
 
@@ -43,28 +46,45 @@ bool StatusContainer::updateState(const OSCMessage& message) {
 
     if (message.address.isEmpty()) return false;
 
-    // 暂无已注册控件指针，上层可在注册阶段补齐
-    StatusItem item(nullptr, message.address, message.value);
-
+    StatusItem finalItem;
     {
         QWriteLocker g(&_lock);
-        StatusItem finalItem;
-        auto it = _latest.find(item.address);
+        auto it = _latest.find(message.address);
         if (it != _latest.end()) {
-            StatusItem existing = it.value();
-            existing.value = item.value; // 仅更新值，保留已注册的控件指针
-            it.value() = existing;
-            finalItem = existing;
+            if (it.value().value == message.value && it.value().value.isValid()) {
+                // 重复写入相同值：状态不变，不入队、不记录变更
+                return true;
+            }
+            it.value().value = message.value; // 仅更新值，保留已注册的控件指针
+            finalItem = it.value();
         } else {
-            _latest.insert(item.address, item);
-            finalItem = item;
+            // 暂无已注册控件指针，上层可在注册阶段补齐
+            finalItem = StatusItem(nullptr, message.address, message.value);
+            _latest.insert(finalItem.address, finalItem);
+            _addressIndex.insert(finalItem.address);
         }
-        _queue.enqueue(finalItem);
+        _queue.push_back(finalItem);
+        recordChangeLocked(finalItem.address);
     }
-    emit statusUpdated(_queue.back());
+    emit statusUpdated(finalItem);
     return true;
 }
 
+/**
+ * 函数级注释：记录一条变更到环形缓冲区（调用方持有写锁）
+ */
+void StatusContainer::recordChangeLocked(const QString& address) {
+    ChangeEntry entry;
+    entry.seq = ++_sequence;
+    entry.address = address;
+    if (_changeLog.size() < ChangeLogCapacity) {
+        _changeLog.push_back(entry);
+    } else {
+        _changeLog[_changeHead] = entry;
+        _changeHead = (_changeHead + 1) % ChangeLogCapacity;
+    }
+}
+
 bool StatusContainer::updateState(const QString& address, const QVariant& value, const QString& type) {
     if (address.isEmpty()) return false;
     OSCMessage msg;
@@ -88,10 +108,9 @@ StatusItem StatusContainer::last(const QString& address) const {
 QVector<StatusItem> StatusContainer::queryByPrefix(const QString& prefix) const {
     QVector<StatusItem> out;
     QReadLocker g(&_lock);
-    for (auto it = _latest.constBegin(); it != _latest.constEnd(); ++it) {
-        if (it.key().startsWith(prefix)) {
-            out.push_back(it.value());
-        }
+    // 有序索引中以 prefix 开头的地址是连续的一段
+    for (auto it = _addressIndex.lower_bound(prefix); it != _addressIndex.end() && it->startsWith(prefix); ++it) {
+        out.push_back(_latest.value(*it));
     }
     return out;
 }
@@ -99,17 +118,64 @@ QVector<StatusItem> StatusContainer::queryByPrefix(const QString& prefix) const
 QVector<StatusItem> StatusContainer::drain() {
     QVector<StatusItem> out;
     QWriteLocker g(&_lock);
-    out.reserve(_queue.size());
-    while (!_queue.isEmpty()) {
-        out.push_back(_queue.dequeue());
+    out.swap(_queue);
+    return out;
+}
+
+quint64 StatusContainer::currentSequence() const {
+    QReadLocker g(&_lock);
+    return _sequence;
+}
+
+QVector<StatusItem> StatusContainer::changesSince(quint64 sinceSeq, quint64* latestSeq, bool* reset) const {
+    QVector<StatusItem> out;
+    QReadLocker g(&_lock);
+    if (latestSeq) {
+        *latestSeq = _sequence;
+    }
+    const quint64 oldest = _changeLog.isEmpty() ? _sequence + 1 : _changeLog[_changeHead].seq;
+    const bool truncated = sinceSeq > _sequence || sinceSeq < _resetSequence || sinceSeq + 1 < oldest;
+    if (reset) {
+        *reset = truncated;
+    }
+    if (truncated) {
+        out.reserve(int(_addressIndex.size()));
+        for (const QString& address : _addressIndex) {
+            out.push_back(_latest.value(address));
+        }
+        return out;
+    }
+
+    // 从最新向最旧遍历，同一地址只保留最后一次变更
+    const int count = _changeLog.size();
+    QSet<QString> seen;
+    for (int i = count - 1; i >= 0; --i) {
+        const ChangeEntry& entry = _changeLog[(_changeHead + i) % count];
+        if (entry.seq <= sinceSeq) {
+            break;
+        }
+        if (seen.contains(entry.address)) {
+            continue;
+        }
+        seen.insert(entry.address);
+        auto it = _latest.constFind(entry.address);
+        if (it != _latest.constEnd()) {
+            out.push_back(it.value());
+        }
     }
+    std::reverse(out.begin(), out.end());
     return out;
 }
 
 void StatusContainer::clearAll() {
     QWriteLocker g(&_lock);
     _latest.clear();
+    _addressIndex.clear();
     _queue.clear();
+    _changeLog.clear();
+    _changeHead = 0;
+    // 清空本身占用一个序号，之前的序号均需整体重置
+    _resetSequence = ++_sequence;
 }
 
 void StatusContainer::onGlobalEvent(const GlobalEvent& ev) {
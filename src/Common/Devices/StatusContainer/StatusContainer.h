@@ -2,11 +2,11 @@
 
 #include <QObject>
 #include <QReadWriteLock>
-#include <QQueue>
 #include <QHash>
 #include <QVector>
 #include <QVariant>
 #include <QString>
+#include <set>
 #include "OSCMessage.h"
 #include "StatusItem.h"
 #include "GlobalEventBus.hpp"
@@ -26,9 +26,11 @@ public:
      */
     static StatusContainer* instance();
 
+    static constexpr int ChangeLogCapacity = 8192;   // 变更日志环形缓冲区容量
+
     /**
      * 函数级注释：写入一条状态消息（地址唯一）。存储时不保留 host/port，仅保存 address/type/value。
-     * 内部会自动转换为 StatusItem 存储。
+     * 内部会自动转换为 StatusItem 存储。值与已存储值相同时视为重复写入，不入队、不记录变更、不发出信号。
      */
     bool updateState(const OSCMessage& message);
 
@@ -48,7 +50,7 @@ public:
     StatusItem last(const QString& address) const;
 
     /**
-     * 函数级注释：按前缀查询最近消息集合
+     * 函数级注释：按前缀查询最近消息集合（有序地址索引，开销与匹配数量成正比），结果按地址排序
      */
     QVector<StatusItem> queryByPrefix(const QString& prefix) const;
 
@@ -57,6 +59,20 @@ public:
      */
     QVector<StatusItem> drain();
 
+    /**
+     * 函数级注释：当前变更序号（每次有效写入加一，从 1 开始；0 表示尚无变更）
+     */
+    quint64 currentSequence() const;
+
+    /**
+     * 函数级注释：查询序号 sinceSeq 之后的变更，同一地址只返回最新值，按最后变更顺序排列
+     * @param sinceSeq   客户端已知的最新序号
+     * @param latestSeq  输出：当前变更序号，客户端下次以此查询
+     * @param reset      输出：sinceSeq 已被环形缓冲区覆盖（或来自清空之前）时为 true，
+     *                   此时返回全部已存储状态，客户端应整体替换本地镜像
+     */
+    QVector<StatusItem> changesSince(quint64 sinceSeq, quint64* latestSeq = nullptr, bool* reset = nullptr) const;
+
     /**
      * 函数级注释：清空所有已存储状态（工程切换时调用）
      */
@@ -99,7 +115,19 @@ private:
     explicit StatusContainer(QObject* parent = nullptr);
     Q_DISABLE_COPY(StatusContainer)
 
+    struct ChangeEntry {
+        quint64 seq = 0;
+        QString address;
+    };
+
+    void recordChangeLocked(const QString& address);
+
     mutable QReadWriteLock _lock;
     QHash<QString, StatusItem> _latest; // key: address
-    QQueue<StatusItem> _queue;
+    std::set<QString> _addressIndex;    // 有序地址索引，用于前缀查询
+    QVector<StatusItem> _queue;
+    QVector<ChangeEntry> _changeLog;    // 环形缓冲区，_changeHead 为最旧条目
+    int _changeHead = 0;
+    quint64 _sequence = 0;
+    quint64 _resetSequence = 0;         // 最近一次 clearAll 时的序号
 };
@@ -0,0 +1,302 @@
+//
+// Stream framing layer shared by the TCP server / client workers.
+//
+
+#ifndef NODEEDITORCPP_STREAMFRAMER_HPP
+#define NODEEDITORCPP_STREAMFRAMER_HPP
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QVariantMap>
+#include <QtEndian>
+#include <cstring>
+
+/**
+ * @brief 分帧配置
+ * - None：不分帧，每次读到的数据作为一帧（兼容旧行为）
+ * - LengthPrefix：帧头（可选） + 长度字段 + 负载，帧总长 = lengthOffset + lengthSize + 长度值 + lengthAdjustment
+ * - Delimiter：以分隔符结束（如 "\r\n"）
+ * - FixedSize：固定长度
+ */
+struct FramingConfig
+{
+    enum Mode {
+        None,
+        LengthPrefix,
+        Delimiter,
+        FixedSize
+    };
+
+    Mode mode = None;
+    // 长度前缀
+    QByteArray header;              ///< 帧同步头（可选），用于失步后重新对齐
+    int lengthOffset = 0;           ///< 长度字段在帧内的偏移
+    int lengthSize = 4;             ///< 长度字段字节数：1/2/4/8
+    bool bigEndian = true;          ///< 长度字段字节序
+    int lengthAdjustment = 0;       ///< 长度字段之后、负载之外的附加字节数（如 CRC），可为负
+    // 分隔符
+    QByteArray delimiter = "\n";
+    bool stripDelimiter = true;     ///< 输出帧是否去掉分隔符
+    // 固定长度
+    int fixedSize = 0;
+    // 单帧上限，超过视为失步或异常数据
+    int maxFrameSize = 1 << 20;
+
+    /**
+     * 函数级注释：长度前缀配置，帧内容包含帧头与长度字段，便于上层协议自行校验
+     */
+    static FramingConfig lengthPrefixed(int lengthSize, bool bigEndian = true, const QByteArray& header = QByteArray(),
+                                        int lengthAdjustment = 0)
+    {
+        FramingConfig config;
+        config.mode = LengthPrefix;
+        config.header = header;
+        config.lengthOffset = header.size();
+        config.lengthSize = lengthSize;
+        config.bigEndian = bigEndian;
+        config.lengthAdjustment = lengthAdjustment;
+        return config;
+    }
+
+    static FramingConfig delimited(const QByteArray& delimiter, bool strip = true)
+    {
+        FramingConfig config;
+        config.mode = Delimiter;
+        config.delimiter = delimiter;
+        config.stripDelimiter = strip;
+        return config;
+    }
+
+    static FramingConfig fixed(int size)
+    {
+        FramingConfig config;
+        config.mode = FixedSize;
+        config.fixedSize = size;
+        return config;
+    }
+};
+
+/**
+ * @class StreamFramer
+ * @brief 每个连接一个的流式分帧器。
+ *        数据由 readFrom() 直接从套接字读入内部缓冲区（无 readAll 中间拷贝），
+ *        drain() 以 QByteArrayView 切片回调完整帧；切片仅在回调期间有效，需要跨线程时由调用方复制。
+ *        已消费的区域在超过缓冲区一半时才整体前移，避免每帧 memmove。
+ */
+class StreamFramer
+{
+public:
+    StreamFramer() = default;
+    explicit StreamFramer(const FramingConfig& config) : m_config(config) {}
+
+    const FramingConfig& config() const { return m_config; }
+
+    void setConfig(const FramingConfig& config)
+    {
+        m_config = config;
+        reset();
+    }
+
+    void reset()
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    /** @brief 当前缓存但尚未成帧的字节数 */
+    qsizetype buffered() const { return m_tail - m_head; }
+
+    /** @brief 因失步或超长被丢弃的字节数 */
+    qint64 discardedBytes() const { return m_discarded; }
+
+    /**
+     * @brief 把设备上可读的数据全部读入缓冲区
+     * @return 本次读取的字节数
+     */
+    qint64 readFrom(QIODevice* device)
+    {
+        qint64 total = 0;
+        for (;;) {
+            const qint64 available = device->bytesAvailable();
+            if (available <= 0) break;
+            char* dst = prepare(available);
+            const qint64 n = device->read(dst, available);
+            if (n <= 0) break;
+            m_tail += n;
+            total += n;
+        }
+        return total;
+    }
+
+    /**
+     * @brief 追加一段已在内存中的数据
+     */
+    void append(const char* data, qsizetype size)
+    {
+        std::memcpy(prepare(size), data, size_t(size));
+        m_tail += size;
+    }
+
+    /**
+     * @brief 切出所有完整帧并逐一回调 onFrame(QByteArrayView)
+     * @return 输出的帧数
+     */
+    template<typename Callback>
+    int drain(Callback&& onFrame)
+    {
+        int frames = 0;
+        for (;;) {
+            const QByteArrayView view(m_buffer.constData() + m_head, buffered());
+            if (view.isEmpty()) break;
+
+            qsizetype consumed = 0;
+            qsizetype frameSize = 0;
+            switch (m_config.mode) {
+                case FramingConfig::None:
+                    frameSize = consumed = view.size();
+                    break;
+                case FramingConfig::FixedSize:
+                    if (m_config.fixedSize <= 0 || view.size() < m_config.fixedSize) break;
+                    frameSize = consumed = m_config.fixedSize;
+                    break;
+                case FramingConfig::Delimiter: {
+                    if (m_config.delimiter.isEmpty()) {
+                        frameSize = consumed = view.size();
+                        break;
+                    }
+                    const qsizetype index = view.indexOf(m_config.delimiter);
+                    if (index < 0) {
+                        if (view.size() > m_config.maxFrameSize) discard(view.size());
+                        break;
+                    }
+                    consumed = index + m_config.delimiter.size();
+                    frameSize = m_config.stripDelimiter ? index : consumed;
+                    break;
+                }
+                case FramingConfig::LengthPrefix:
+                    consumed = frameSize = nextLengthPrefixed(view);
+                    break;
+            }
+            if (consumed <= 0) {
+                // 长度前缀模式下失步重同步会消费数据但不出帧，此时继续尝试
+                if (m_resynced) {
+                    m_resynced = false;
+                    continue;
+                }
+                break;
+            }
+            onFrame(view.first(frameSize));
+            m_head += consumed;
+            ++frames;
+        }
+        compact();
+        return frames;
+    }
+
+    /**
+     * @brief 把一帧数据转换为既有信号使用的键值表（host/hex/utf-8/ascii/default）
+     */
+    static QVariantMap describe(const QString& host, const QByteArray& frame)
+    {
+        QVariantMap dataMap;
+        dataMap.insert("host", host);
+        dataMap.insert("hex", QString(frame.toHex()));
+        dataMap.insert("utf-8", QString::fromUtf8(frame));
+        dataMap.insert("ascii", QString::fromLatin1(frame));
+        dataMap.insert("default", frame);
+        return dataMap;
+    }
+
+private:
+    /**
+     * 函数级注释：返回长度前缀帧的总长度；数据不足返回 0；失步时丢弃数据并置 m_resynced
+     */
+    qsizetype nextLengthPrefixed(QByteArrayView view)
+    {
+        const QByteArray& header = m_config.header;
+        if (!header.isEmpty() && !view.startsWith(header)) {
+            const qsizetype index = view.indexOf(header, 1);
+            // 找不到帧头时保留末尾可能是半个帧头的字节
+            resync(index >= 0 ? index : qMax<qsizetype>(0, view.size() - header.size() + 1));
+            return 0;
+        }
+        const qsizetype prefix = qsizetype(m_config.lengthOffset) + m_config.lengthSize;
+        if (view.size() < prefix) return 0;
+
+        const uchar* field = reinterpret_cast<const uchar*>(view.constData()) + m_config.lengthOffset;
+        quint64 length = 0;
+        switch (m_config.lengthSize) {
+            case 1: length = field[0]; break;
+            case 2: length = m_config.bigEndian ? qFromBigEndian<quint16>(field) : qFromLittleEndian<quint16>(field); break;
+            case 4: length = m_config.bigEndian ? qFromBigEndian<quint32>(field) : qFromLittleEndian<quint32>(field); break;
+            case 8: length = m_config.bigEndian ? qFromBigEndian<quint64>(field) : qFromLittleEndian<quint64>(field); break;
+            default: return view.size();
+        }
+        const qint64 total = qint64(prefix) + qint64(qMin<quint64>(length, quint64(m_config.maxFrameSize) + 1))
+                             + m_config.lengthAdjustment;
+        if (total < prefix || total > m_config.maxFrameSize) {
+            if (!header.isEmpty()) {
+                resync(1);
+            } else {
+                // 无帧头时无法重新对齐，只能丢弃已缓存数据
+                resync(view.size());
+            }
+            return 0;
+        }
+        return view.size() >= total ? qsizetype(total) : 0;
+    }
+
+    void resync(qsizetype bytes)
+    {
+        if (bytes <= 0) return;
+        m_head += bytes;
+        m_discarded += bytes;
+        m_resynced = true;
+    }
+
+    void discard(qsizetype bytes)
+    {
+        m_head += bytes;
+        m_discarded += bytes;
+    }
+
+    /**
+     * 函数级注释：保证尾部至少有 size 字节可写并返回写指针；先前移已消费区域，不够再扩容
+     */
+    char* prepare(qint64 size)
+    {
+        if (m_tail + size > m_buffer.size()) {
+            compact(true);
+            if (m_tail + size > m_buffer.size()) {
+                m_buffer.resize(qMax<qint64>(m_tail + size, qint64(m_buffer.size()) * 2));
+            }
+        }
+        return m_buffer.data() + m_tail;
+    }
+
+    void compact(bool force = false)
+    {
+        if (m_head == m_tail) {
+            m_head = m_tail = 0;
+            return;
+        }
+        if (m_head > 0 && (force || m_head > m_buffer.size() / 2)) {
+            std::memmove(m_buffer.data(), m_buffer.constData() + m_head, size_t(m_tail - m_head));
+            m_tail -= m_head;
+            m_head = 0;
+        }
+    }
+
+private:
+    FramingConfig m_config;
+    QByteArray m_buffer;
+    qsizetype m_head = 0;      ///< 未消费数据起点
+    qsizetype m_tail = 0;      ///< 已写入数据终点
+    qint64 m_discarded = 0;
+    bool m_resynced = false;
+};
+
+Q_DECLARE_METATYPE(FramingConfig)
+
+#endif //NODEEDITORCPP_STREAMFRAMER_HPP
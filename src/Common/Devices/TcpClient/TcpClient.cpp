@@ -9,6 +9,7 @@ TcpClient::TcpClient(QString dstHost, int dstPort, QObject *parent) : QObject(pa
     host = std::move(dstHost);
     port = dstPort;
     
+    qRegisterMetaType<FramingConfig>("FramingConfig");
     // 创建工作线程
     workerThread = new QThread();
     
@@ -23,6 +24,7 @@ TcpClient::TcpClient(QString dstHost, int dstPort, QObject *parent) : QObject(pa
     connect(this, &TcpClient::disconnectFromServerRequest, worker, &TcpClientWorker::disconnectFromServer, Qt::QueuedConnection);
     connect(this, &TcpClient::sendMessageRequest, worker, &TcpClientWorker::sendMessage, Qt::QueuedConnection);
     connect(this, &TcpClient::stopTimerRequest, worker, &TcpClientWorker::stopTimer, Qt::QueuedConnection);
+    connect(this, &TcpClient::setFramingRequest, worker, &TcpClientWorker::setFraming, Qt::QueuedConnection);
     
     // 连接TcpClientWorker的信号到TcpClient的信号
     connect(worker, &TcpClientWorker::isReady, this, &TcpClient::isReady, Qt::QueuedConnection);
@@ -80,4 +82,9 @@ void TcpClient::sendMessage(const QString &message,const int &format)
 void TcpClient::stopTimer()
 {
     emit stopTimerRequest();
+}
+
+void TcpClient::setFraming(const FramingConfig &config)
+{
+    emit setFramingRequest(config);
 }
\ No newline at end of file
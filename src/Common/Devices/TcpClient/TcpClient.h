@@ -31,6 +31,9 @@ public slots:
     // 停止计时器
     void stopTimer();
 
+    // 设置接收分帧方式（默认不分帧，每次读取作为一条消息）
+    void setFraming(const FramingConfig &config);
+
 signals:
     // 连接状态信号
     void isReady(const bool &isReady);
@@ -43,6 +46,7 @@ signals:
     void disconnectFromServerRequest();
     void sendMessageRequest(const QString &message,const int &format);
     void stopTimerRequest();
+    void setFramingRequest(const FramingConfig &config);
 
 private:
     TcpClientWorker *worker;
@@ -24,6 +24,7 @@ void TcpClientWorker::initialize()
     
     // 连接信号和槽
     connect(tcpClient, &QTcpSocket::readyRead, this, &TcpClientWorker::onReadyRead);
+    tcpClient->setSocketOption(QAbstractSocket::LowDelayOption, 1);
     connect(tcpClient, &QTcpSocket::connected, this, &TcpClientWorker::onConnected);
     connect(tcpClient, &QTcpSocket::disconnected, this, &TcpClientWorker::onDisconnected);
     connect(tcpClient, qOverload<QAbstractSocket::SocketError>(&QTcpSocket::errorOccurred), 
@@ -122,12 +123,42 @@ void TcpClientWorker::sendMessage(const QString &message,const int &format)
         data = message.toUtf8();  // 默认使用UTF-8
         break;
     }
-    if(tcpClient->state() == QAbstractSocket::ConnectedState)
+    if(tcpClient->state() != QAbstractSocket::ConnectedState)
     {
-        tcpClient->write(data);
-    }else {
         qWarning() << "Not connected, message dropped!";
+        return;
+    }
+    if (data.isEmpty()) return;
+    // 背压：服务器长时间不读取时丢弃新数据
+    if (tcpClient->bytesToWrite() + m_outgoing.size() + data.size() > WriteHighWatermark) {
+        if (!m_congested) {
+            m_congested = true;
+            qWarning() << "Tcp server is not reading, dropping outgoing data";
+        }
+        return;
     }
+    m_congested = false;
+    // 合并写入：同一事件循环内的多次发送只触发一次 write
+    m_outgoing.append(data);
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &TcpClientWorker::flushWrites, Qt::QueuedConnection);
+    }
+}
+
+void TcpClientWorker::flushWrites()
+{
+    m_flushScheduled = false;
+    if (m_outgoing.isEmpty()) return;
+    if (tcpClient && tcpClient->state() == QAbstractSocket::ConnectedState) {
+        tcpClient->write(m_outgoing);
+    }
+    m_outgoing.clear();
+}
+
+void TcpClientWorker::setFraming(const FramingConfig &config)
+{
+    m_framer.setConfig(config);
 }
 
 void TcpClientWorker::stopTimer()
@@ -139,23 +170,22 @@ void TcpClientWorker::stopTimer()
 
 void TcpClientWorker::onReadyRead()
 {
-    QByteArray data = tcpClient->readAll();
-    if(data.isEmpty())
+    // 直接读入分帧缓冲区，只对完整帧发出消息
+    if (m_framer.readFrom(tcpClient) <= 0)
     {
         return;
     }
-    QVariantMap dataMap;
-    dataMap.insert("host", tcpClient->peerAddress().toString());
-    dataMap.insert("hex", QString(data.toHex())); // 转换为QString类型
-    dataMap.insert("utf-8", QString::fromUtf8(data)); // 修复UTF-8解码方式
-    dataMap.insert("ascii", QString::fromLatin1(data)); // 修复ANSI解码方式
-    dataMap.insert("default", data);
-    emit recMsg(dataMap);
+    const QString peer = tcpClient->peerAddress().toString();
+    m_framer.drain([this, &peer](QByteArrayView frame) {
+        emit recMsg(StreamFramer::describe(peer, frame.toByteArray()));
+    });
 }
 
 void TcpClientWorker::onConnected()
 {
     isConnected = true;
+    // 新连接从帧边界开始
+    m_framer.reset();
     m_timer->stop();
     emit isReady(isConnected);
 }
@@ -163,6 +193,7 @@ void TcpClientWorker::onConnected()
 void TcpClientWorker::onDisconnected()
 {
     isConnected = false;
+    m_outgoing.clear();
     emit isReady(isConnected);
     m_timer->start();
 }
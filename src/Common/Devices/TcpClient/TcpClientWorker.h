@@ -5,12 +5,16 @@
 #include <QTimer>
 #include <QObject>
 #include <QVariantMap>
+#include "../StreamFramer/StreamFramer.hpp"
 
 class TcpClientWorker : public QObject
 {
     Q_OBJECT
 
 public:
+    // 未发送数据上限，超过后丢弃新数据（服务器不读取时的背压）
+    static constexpr qint64 WriteHighWatermark = 8 * 1024 * 1024;
+
     explicit TcpClientWorker(QObject *parent = nullptr);
     ~TcpClientWorker();
 
@@ -30,6 +34,9 @@ public slots:
     // 停止重连计时器
     void stopTimer();
 
+    // 设置接收分帧方式（默认不分帧）
+    void setFraming(const FramingConfig &config);
+
 private slots:
     // 处理套接字事件的槽函数
     void onReadyRead();
@@ -37,6 +44,8 @@ private slots:
     void onDisconnected();
     void onErrorOccurred(QAbstractSocket::SocketError socketError);
     void reConnect();
+    // 把本轮事件循环内合并的数据一次性写出
+    void flushWrites();
 
 signals:
     // 连接状态信号
@@ -51,6 +60,10 @@ private:
     QString host;
     int port;
     bool isConnected = false;
+    StreamFramer m_framer;          // 接收分帧缓冲区
+    QByteArray m_outgoing;          // 合并的待发送数据
+    bool m_flushScheduled = false;
+    bool m_congested = false;
 };
 
 #endif //NODEEDITORCPP_TCPCLIENTWORKER_H
\ No newline at end of file
@@ -4,12 +4,26 @@
 
 #include "TcpServer.h"
 #include "QThread"
+#include <QMetaMethod>
+
+// 单个客户端连接：分帧器与待发送数据
+struct ClientConnection
+{
+    QTcpSocket *socket = nullptr;
+    QString host;
+    StreamFramer framer;
+    QByteArray outgoing;        // 本轮事件循环内合并的待发送数据
+    bool congested = false;     // 是否处于背压丢弃状态
+};
 
 // 创建一个工作类来处理所有网络操作
 class TcpWorker : public QObject
 {
     Q_OBJECT
 public:
+    // 单个客户端未发送数据上限，超过后丢弃新数据，避免慢客户端拖垮内存
+    static constexpr qint64 WriteHighWatermark = 8 * 1024 * 1024;
+
     explicit TcpWorker(QObject *parent = nullptr) : QObject(parent), mServer(nullptr) {}
     
     ~TcpWorker() {
@@ -34,13 +48,17 @@ public slots:
     
     void cleanup() {
         // 关闭所有客户端连接
-        for (QTcpSocket *clientSocket : mClientSockets) {
+        for (ClientConnection *connection : std::as_const(mConnections)) {
+            QTcpSocket *clientSocket = connection->socket;
+            clientSocket->disconnect(this);
             if (clientSocket->isOpen()) {
                 clientSocket->close();
             }
             clientSocket->deleteLater();
+            delete connection;
         }
-        mClientSockets.clear();
+        mConnections.clear();
+        mDirty.clear();
         
         // 关闭服务器并删除
         if (mServer) {
@@ -49,6 +67,16 @@ public slots:
             mServer = nullptr;
         }
     }
+
+    /**
+     * @brief 设置分帧方式，已有连接的缓存数据被清空
+     */
+    void setFraming(const FramingConfig &config) {
+        mFraming = config;
+        for (ClientConnection *connection : std::as_const(mConnections)) {
+            connection->framer.setConfig(config);
+        }
+    }
     
     void sendMessageToClients(const QString &message,const int &format) {
         QByteArray data;
@@ -67,83 +95,122 @@ public slots:
             data = message.toUtf8();  // 默认使用UTF-8
             break;
         }
-        for (QTcpSocket *clientSocket : mClientSockets) {
-
-            clientSocket->write(data);
-        }
+        sendByteArrayToClients(data);
     }
 
     void sendByteArrayToClients(const QByteArray &byteArray)
     {
-        for (QTcpSocket *clientSocket : mClientSockets) {
-
-            clientSocket->write(byteArray);
+        for (ClientConnection *connection : std::as_const(mConnections)) {
+            queueWrite(connection, byteArray);
         }
     }
     void sendByteArrayToClient(const QByteArray &byteArray,const QString &host)
     {
-        for (QTcpSocket *clientSocket : mClientSockets) {
-            if(clientSocket->peerAddress().toString() == host)
-            {
-                clientSocket->write(byteArray);
+        for (ClientConnection *connection : std::as_const(mConnections)) {
+            if (connection->host == host) {
+                queueWrite(connection, byteArray);
                 return;
             }
-            else
-            {
-                qDebug() << "Host not found";
-            }
-
         }
+        qDebug() << "Host not found" << host;
     }
 private slots:
     void onNewConnection() {
-        QTcpSocket *clientSocket = mServer->nextPendingConnection();
-        qDebug() << "New tcp client connected"<< clientSocket->peerAddress().toString();
-        connect(clientSocket, &QTcpSocket::readyRead, this, &TcpWorker::onReadyRead);
-        connect(clientSocket, &QTcpSocket::disconnected, this, &TcpWorker::onDisconnected);
-        mClientSockets.append(clientSocket); // Store the client socket
+        while (QTcpSocket *clientSocket = mServer->nextPendingConnection()) {
+            qDebug() << "New tcp client connected"<< clientSocket->peerAddress().toString();
+            // 写入已在应用层合并，关闭 Nagle 以降低延迟
+            clientSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            auto *connection = new ClientConnection;
+            connection->socket = clientSocket;
+            connection->host = clientSocket->peerAddress().toString();
+            connection->framer.setConfig(mFraming);
+            mConnections.insert(clientSocket, connection); // Store the client socket
+            connect(clientSocket, &QTcpSocket::readyRead, this, &TcpWorker::onReadyRead);
+            connect(clientSocket, &QTcpSocket::disconnected, this, &TcpWorker::onDisconnected);
+        }
     }
-    
+
+    /**
+     * @brief 只处理发出信号的连接：直接读入该连接的分帧缓冲区，按完整帧输出
+     */
     void onReadyRead() {
-        for (QTcpSocket *clientSocket : mClientSockets) {
-            if (clientSocket->bytesAvailable() > 0) {
-                QByteArray data = clientSocket->readAll();
-                QVariantMap dataMap;
-                
-                dataMap.insert("host", clientSocket->peerAddress().toString());
-                dataMap.insert("hex", QString(data.toHex())); // 转换为QString类型
-                dataMap.insert("utf-8", QString::fromUtf8(data)); // 修复UTF-8解码方式
-                dataMap.insert("ascii", QString::fromLatin1(data)); // 修复ascii解码方式
-                dataMap.insert("default", data);
-                
-                emit messageReceived(data);
-                emit dataReceived(dataMap);
-            }
-        }
+        ClientConnection *connection = mConnections.value(qobject_cast<QTcpSocket*>(sender()), nullptr);
+        if (!connection) return;
+        connection->framer.readFrom(connection->socket);
+        connection->framer.drain([this, connection](QByteArrayView frame) {
+            emit frameReceived(connection->host, frame.toByteArray());
+        });
     }
     
     void onDisconnected() {
         QTcpSocket *clientSocket = qobject_cast<QTcpSocket*>(sender());
         if (clientSocket) {
-            mClientSockets.removeAll(clientSocket);
+            if (ClientConnection *connection = mConnections.take(clientSocket)) {
+                mDirty.removeAll(connection);
+                delete connection;
+            }
             clientSocket->deleteLater();
         }
     }
 
+    /**
+     * @brief 把本轮事件循环内合并的数据一次性写入各连接
+     */
+    void flushWrites() {
+        mFlushScheduled = false;
+        for (ClientConnection *connection : std::as_const(mDirty)) {
+            if (!connection->outgoing.isEmpty()) {
+                connection->socket->write(connection->outgoing);
+                connection->outgoing.clear();
+            }
+        }
+        mDirty.clear();
+    }
+
+private:
+    /**
+     * @brief 合并写入：同一事件循环内的多次发送只触发一次 write；未发送数据超过上限时丢弃（背压）
+     */
+    void queueWrite(ClientConnection *connection, const QByteArray &data) {
+        if (data.isEmpty()) return;
+        const qint64 pending = connection->socket->bytesToWrite() + connection->outgoing.size();
+        if (pending + data.size() > WriteHighWatermark) {
+            if (!connection->congested) {
+                connection->congested = true;
+                qWarning() << "Tcp client" << connection->host << "is not reading, dropping outgoing data";
+            }
+            return;
+        }
+        connection->congested = false;
+        if (connection->outgoing.isEmpty()) {
+            connection->outgoing = data;   // 共享数据，不复制
+            mDirty.append(connection);
+        } else {
+            connection->outgoing.append(data);
+        }
+        if (!mFlushScheduled) {
+            mFlushScheduled = true;
+            QMetaObject::invokeMethod(this, &TcpWorker::flushWrites, Qt::QueuedConnection);
+        }
+    }
+
 signals:
     void serverReady(bool ready);
-    void messageReceived(const QByteArray &data);
-    void dataReceived(const QVariantMap &data);
+    void frameReceived(const QString &host, const QByteArray &frame);
 
 private:
     QTcpServer *mServer;
-    QList<QTcpSocket *> mClientSockets;
+    QHash<QTcpSocket *, ClientConnection *> mConnections;
+    QList<ClientConnection *> mDirty;     // 有待发送数据的连接
+    bool mFlushScheduled = false;
+    FramingConfig mFraming;
 };
 
 // TcpServer 实现
 TcpServer::TcpServer(QString dstHost, int dstPort, QObject *parent)
         : QObject(parent), mPort(dstPort), mHost(dstHost), mServer(nullptr)
 {
+    qRegisterMetaType<FramingConfig>("FramingConfig");
     // 创建工作线程
     mThread = new QThread(this);
     
@@ -159,8 +226,7 @@ TcpServer::TcpServer(QString dstHost, int dstPort, QObject *parent)
     
     // 连接工作对象的信号到 TcpServer 的信号
     connect(worker, &TcpWorker::serverReady, this, &TcpServer::isReady);
-    connect(worker, &TcpWorker::messageReceived, this, &TcpServer::arrayMsg);
-    connect(worker, &TcpWorker::dataReceived, this, &TcpServer::recMsg);
+    connect(worker, &TcpWorker::frameReceived, this, &TcpServer::onFrameReceived);
     
     // 连接 TcpServer 的槽到工作对象的槽
     connect(this, &TcpServer::initializeRequested, worker, &TcpWorker::initialize);
@@ -168,6 +234,7 @@ TcpServer::TcpServer(QString dstHost, int dstPort, QObject *parent)
     connect(this, &TcpServer::sendMessageRequested, worker, &TcpWorker::sendMessageToClients);
     connect(this, &TcpServer::sendByteArrayRequested, worker, &TcpWorker::sendByteArrayToClients);
     connect(this, &TcpServer::sendByteArrayToHostRequested, worker, &TcpWorker::sendByteArrayToClient);
+    connect(this, &TcpServer::setFramingRequested, worker, &TcpWorker::setFraming);
     
     // 启动线程
     mThread->start();
@@ -206,6 +273,26 @@ void TcpServer::sendBytesArrayToHost(const QByteArray &byteArray,const QString &
     emit sendByteArrayToHostRequested(byteArray,host);
 }
 
+void TcpServer::setFraming(const FramingConfig &config)
+{
+    emit setFramingRequested(config);
+}
+
+/**
+ * @brief 收到完整帧：仅在有接收者时构造对应的信号数据
+ */
+void TcpServer::onFrameReceived(const QString &host, const QByteArray &frame)
+{
+    static const QMetaMethod arraySignal = QMetaMethod::fromSignal(&TcpServer::arrayMsg);
+    static const QMetaMethod mapSignal = QMetaMethod::fromSignal(&TcpServer::recMsg);
+    if (isSignalConnected(arraySignal)) {
+        emit arrayMsg(frame);
+    }
+    if (isSignalConnected(mapSignal)) {
+        emit recMsg(StreamFramer::describe(host, frame));
+    }
+}
+
 void TcpServer::setHost(QString address, int port) {
     mHost = address;
     mPort = port;
@@ -7,6 +7,7 @@
 
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
+#include "../StreamFramer/StreamFramer.hpp"
 class TcpServer : public QObject
 {
     Q_OBJECT
@@ -22,6 +23,13 @@ public slots:
     void sendByteArray(const QByteArray &byteArray);
     void sendBytesArrayToHost(const QByteArray &byteArray,const QString &host);
     void setHost(QString address,int port);
+    /**
+     * @brief 设置接收分帧方式（默认不分帧，每次读取作为一条消息）
+     */
+    void setFraming(const FramingConfig &config);
+
+private slots:
+    void onFrameReceived(const QString &host, const QByteArray &frame);
 
 signals:
     // 对外信号
@@ -35,6 +43,7 @@ signals:
     void sendMessageRequested(const QString &message,const int &format);
     void sendByteArrayRequested(const QByteArray &byteArray);
     void sendByteArrayToHostRequested(const QByteArray &byteArray,const QString &host);
+    void setFramingRequested(const FramingConfig &config);
 private:
     quint16 mPort;
     QString mHost;
@@ -1,13 +1,12 @@
 #include "TimestampGenerator.hpp"
+#include "Common/AppConfig/ConfigManager.h"
 #include <QDebug>
 #include <QCoreApplication>
+#include <algorithm>
 
 // 静态成员初始化
 TimestampGenerator* TimestampGenerator::instance_ = nullptr;
 QMutex TimestampGenerator::instanceMutex_;
-const double TimestampGenerator::FRAME_INTERVAL_MS = 1000.0 / FRAME_RATE;
-const std::chrono::nanoseconds TimestampGenerator::FRAME_INTERVAL_NS = 
-    std::chrono::nanoseconds(static_cast<long long>(1000000000.0 / FRAME_RATE));
 
 /**
  * @brief 导出函数：获取帧计数器生成器实例
@@ -37,17 +36,96 @@ TimestampGenerator* TimestampGenerator::getInstance()
 
 /**
  * @brief 私有构造函数
- * 构造时初始化但不启动，等待getInstance()调用start()
+ * 构造时从 ConfigManager 读取采样率、块大小与时钟源，但不启动，等待getInstance()调用start()
  */
 TimestampGenerator::TimestampGenerator(QObject *parent)
     : QObject(parent)
+    , sampleRate_(ConfigManager::instance().getAudioSampleRate())
+    , blockSize_(ConfigManager::instance().getAudioBlockSize())
+    , frameRate_(0.0)
+    , frameIntervalMs_(0.0)
+    , clockSource_(ConfigManager::instance().isAudioDeviceDrivenClock() ? ClockSource::AudioDevice : ClockSource::InternalTimer)
+    , deviceClockOwner_(nullptr)
+    , deviceSampleAccumulator_(0)
+    , pendingDeviceTicks_(0)
     , frameCounter_(0)
     , isRunning_(false)
     , shouldStop_(false)
     , timerThread_(nullptr)
     , baseAbsoluteTime_(0)
 {
-    // qDebug() << "FrameCounter created with frequency:" << FRAME_RATE << "fps, interval:" << FRAME_INTERVAL_MS << "ms";
+    if (sampleRate_ <= 0) sampleRate_ = AppConfigs::AUDIO_SAMPLE_RATE;
+    if (blockSize_ <= 0) blockSize_ = AppConfigs::AUDIO_BLOCK_SIZE;
+    updateDerivedTiming();
+    // qDebug() << "FrameCounter created with frequency:" << frameRate_ << "fps, interval:" << frameIntervalMs_ << "ms";
+}
+
+/**
+ * @brief 根据采样率与块大小刷新帧率与帧间隔
+ */
+void TimestampGenerator::updateDerivedTiming()
+{
+    frameRate_ = static_cast<double>(sampleRate_) / static_cast<double>(blockSize_);
+    frameIntervalMs_ = 1000.0 / frameRate_;
+}
+
+/**
+ * @brief 计算第 frameIndex 帧相对起点的精确偏移
+ * 以 帧序号×块大小 得到总采样数后再换算纳秒，避免按帧间隔累加造成的舍入漂移
+ */
+std::chrono::nanoseconds TimestampGenerator::frameOffset(qint64 frameIndex) const
+{
+    const qint64 samples = frameIndex * blockSize_;
+    const qint64 wholeSeconds = samples / sampleRate_;
+    const qint64 remainder = samples % sampleRate_;
+    return std::chrono::nanoseconds(wholeSeconds * 1000000000LL + remainder * 1000000000LL / sampleRate_);
+}
+
+/**
+ * @brief 声明设备时钟所有权
+ */
+bool TimestampGenerator::claimDeviceClock(const void* owner)
+{
+    const void* expected = nullptr;
+    if (deviceClockOwner_.compare_exchange_strong(expected, owner)) {
+        deviceSampleAccumulator_.store(0);
+        return true;
+    }
+    return expected == owner;
+}
+
+/**
+ * @brief 释放设备时钟所有权
+ */
+void TimestampGenerator::releaseDeviceClock(const void* owner)
+{
+    const void* expected = owner;
+    deviceClockOwner_.compare_exchange_strong(expected, nullptr);
+}
+
+/**
+ * @brief 由音频设备回调推进时钟
+ * - 仅主设备生效；按实际输出采样数累计，每满一个块记一次待发出帧
+ * - 只做原子运算与 try_lock 唤醒，不会阻塞实时回调线程
+ */
+void TimestampGenerator::advanceDeviceClock(const void* owner, unsigned long frames)
+{
+    if (clockSource_.load(std::memory_order_relaxed) != ClockSource::AudioDevice ||
+        deviceClockOwner_.load(std::memory_order_relaxed) != owner) {
+        return;
+    }
+    qint64 accumulated = deviceSampleAccumulator_.load(std::memory_order_relaxed) + static_cast<qint64>(frames);
+    qint64 ticks = 0;
+    while (accumulated >= blockSize_) {
+        accumulated -= blockSize_;
+        ++ticks;
+    }
+    deviceSampleAccumulator_.store(accumulated, std::memory_order_relaxed);
+    if (ticks > 0) {
+        pendingDeviceTicks_.fetch_add(ticks, std::memory_order_release);
+        // 不持锁通知：唤醒可能丢失，等待方以短时间片复查计数，丢失只增加不到四分之一帧的延迟
+        tickCondition_.notify_one();
+    }
 }
 
 /**
@@ -98,6 +176,7 @@ void TimestampGenerator::stop()
         // 设置停止标志
         shouldStop_ = true;
         isRunning_ = false;
+        tickCondition_.notify_all();
         
         // 等待线程结束
         if (timerThread_ && timerThread_->joinable()) {
@@ -198,14 +277,26 @@ FrameInfo TimestampGenerator::createFrameInfo(qint64 frameCount) const
 
 /**
  * @brief 高精度计时线程函数
+ * - 第 n 帧的截止时间按 起点 + n×块大小/采样率 直接计算，不累加帧间隔，避免长时间运行的舍入漂移
+ * - 时钟源为 AudioDevice 时转入设备驱动循环
  */
 void TimestampGenerator::timerThreadFunction()
 {
-    auto nextFrameTime = startTime_;
+    qint64 frameIndex = 0;
+    auto deadlineBase = startTime_;
     
     while (!shouldStop_.load()) {
+        if (clockSource_.load() == ClockSource::AudioDevice) {
+            deviceDrivenLoop();
+            // 切回内部计时：以当前时刻为新的截止时间基准，避免补发积压帧
+            frameIndex = 0;
+            deadlineBase = std::chrono::high_resolution_clock::now();
+            continue;
+        }
+
         // 计算下一帧的时间点
-        nextFrameTime += FRAME_INTERVAL_NS;
+        ++frameIndex;
+        const auto nextFrameTime = deadlineBase + frameOffset(frameIndex);
         
         // 高精度睡眠到下一帧时间
         std::this_thread::sleep_until(nextFrameTime);
@@ -220,6 +311,59 @@ void TimestampGenerator::timerThreadFunction()
     }
 }
 
+/**
+ * @brief 设备时钟驱动下的计时线程循环
+ * - 等待主设备回调累计满一个块后发出帧计数，信号发射不在实时线程中进行
+ * - 若超过 1.5 个帧间隔没有设备推进（设备未启动/已停止），按内部截止时间补发一帧，保证下游不停摆
+ * - 补发的帧记为欠账：设备恢复后若一次性积压多帧（回调被延迟而非停止），先用积压抵消欠账，帧计数不会领先设备时钟
+ * - 等待按四分之一帧的时间片进行，设备回调的通知即使丢失也只会晚一点发出设备帧，不会被误判为补发
+ */
+void TimestampGenerator::deviceDrivenLoop()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    const auto interval = frameOffset(1);
+    const auto fallbackTimeout = interval + interval / 2;
+    const auto pollSlice = interval / 4;
+    auto lastTick = Clock::now();
+    qint64 fallbackDebt = 0;   // 设备停顿期间由内部计时补发、尚未被设备积压抵消的帧数
+
+    while (!shouldStop_.load() && clockSource_.load() == ClockSource::AudioDevice) {
+        const auto fallbackAt = lastTick + fallbackTimeout;
+        {
+            std::unique_lock<std::mutex> lock(tickMutex_);
+            tickCondition_.wait_until(lock, std::min(fallbackAt, Clock::now() + pollSlice), [this]() {
+                return shouldStop_.load() ||
+                       clockSource_.load() != ClockSource::AudioDevice ||
+                       pendingDeviceTicks_.load(std::memory_order_acquire) > 0;
+            });
+        }
+        if (shouldStop_.load() || clockSource_.load() != ClockSource::AudioDevice) {
+            break;
+        }
+
+        const qint64 pending = pendingDeviceTicks_.load(std::memory_order_acquire);
+        if (pending > 0) {
+            if (fallbackDebt > 0 && pending > 1) {
+                // 设备积压了多帧：其中已由补发帧代替的部分直接丢弃
+                const qint64 settled = std::min(pending - 1, fallbackDebt);
+                pendingDeviceTicks_.fetch_sub(settled, std::memory_order_acq_rel);
+                fallbackDebt -= settled;
+            } else {
+                // 设备逐帧推进（停止后重新启动，没有积压）：此前的补发不再需要抵消
+                fallbackDebt = 0;
+            }
+            pendingDeviceTicks_.fetch_sub(1, std::memory_order_acq_rel);
+            lastTick = Clock::now();
+            generateFrameCount();
+        } else if (Clock::now() >= fallbackAt) {
+            // 设备未推进：回退为内部计时
+            lastTick += interval;
+            ++fallbackDebt;
+            generateFrameCount();
+        }
+    }
+}
+
 /**
  * @brief 生成帧计数
  */
@@ -238,7 +382,7 @@ void TimestampGenerator::generateFrameCount()
     // // 每1000帧输出一次调试信息
     // if (currentFrame % 1000 == 0) {
     //     double actualFps = currentFrame * 1000.0 / frameInfo.getRelativeTimeMs(startTime_);
-    //     double theoreticalTime = frameInfo.getTheoreticalTimeMs(FRAME_RATE);
+    //     double theoreticalTime = frameInfo.getTheoreticalTimeMs(frameRate_);
     //     double actualTime = frameInfo.getRelativeTimeMs(startTime_);
     //     double drift = actualTime - theoreticalTime;
     //
@@ -263,7 +407,7 @@ qint64 TimestampGenerator::calculateFrameCountByTimeDelta(double timeDeltaMs) co
     qint64 currentFrame = frameCounter_.loadAcquire();
     
     // 计算时间差对应的帧数变化
-    double frameDelta = timeDeltaMs / FRAME_INTERVAL_MS;
+    double frameDelta = timeDeltaMs / frameIntervalMs_;
     
     // 计算新的帧计数（四舍五入到最近的整数）
     qint64 newFrameCount = currentFrame + static_cast<qint64>(std::round(frameDelta));
@@ -326,7 +470,7 @@ qint64 TimestampGenerator::calculateFrameCountByRelativeTime(double relativeTime
     }
     
     // 根据帧率计算帧计数
-    double frameCount = relativeTimeMs / FRAME_INTERVAL_MS;
+    double frameCount = relativeTimeMs / frameIntervalMs_;
     
     // 四舍五入到最近的整数
     return static_cast<qint64>(std::round(frameCount));
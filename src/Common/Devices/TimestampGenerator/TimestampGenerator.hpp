@@ -10,6 +10,8 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <cmath>  // 添加这个包含用于std::round和std::max
 
 #if defined(TIMESTAMPGENERATOR_LIBRARY)
@@ -66,8 +68,10 @@ struct TIMESTAMPGENERATOR FrameInfo
 
 /**
  * @brief 全局音频帧计数器生成器
- * 以50fps的频率生成统一的帧计数，确保所有音频组件使用相同的帧基准
- * 采用单例模式，线程安全，使用高精度计时器，实例化时自动启动
+ * 以 采样率/块大小 的频率生成统一的帧计数，确保所有音频组件使用相同的帧基准
+ * - 采样率与块大小来自 ConfigManager（Audio/SampleRate、Audio/BlockSize），每个帧计数对应一个音频块
+ * - 时钟源可选内部高精度计时线程，或由音频设备回调驱动（设备停止时自动回退为内部计时）
+ * 采用单例模式，线程安全，实例化时自动启动
  */
 class TIMESTAMPGENERATOR TimestampGenerator : public QObject
 {
@@ -80,6 +84,16 @@ public:
      * @return 全局帧计数器生成器实例
      */
     static TimestampGenerator* getInstance();
+
+    /**
+     * @brief 时钟源
+     * - InternalTimer：内部计时线程按绝对截止时间推进（无累计漂移）
+     * - AudioDevice：由声明时钟所有权的音频设备回调按实际输出采样数推进
+     */
+    enum class ClockSource {
+        InternalTimer,
+        AudioDevice
+    };
     
     /**
      * @brief 手动启动帧计数生成（通常不需要调用，实例化时自动启动）
@@ -127,15 +141,52 @@ public:
     
     /**
      * @brief 获取帧率
-     * @return 帧率（fps）
+     * @return 帧率（fps），等于 采样率 / 块大小
      */
-    double getFrameRate() const { return FRAME_RATE; }
+    double getFrameRate() const { return frameRate_; }
     
     /**
      * @brief 获取帧间隔
      * @return 间隔（毫秒）
      */
-    double getFrameInterval() const { return FRAME_INTERVAL_MS; }
+    double getFrameInterval() const { return frameIntervalMs_; }
+
+    /**
+     * @brief 获取全局音频采样率
+     * @return 采样率（Hz）
+     */
+    int getSampleRate() const { return sampleRate_; }
+
+    /**
+     * @brief 获取全局音频块大小（每个帧计数对应的单通道采样数）
+     * @return 块大小（采样数）
+     */
+    int getBlockSize() const { return blockSize_; }
+
+    /**
+     * @brief 获取当前时钟源
+     */
+    ClockSource getClockSource() const { return clockSource_.load(); }
+
+    /**
+     * @brief 声明设备时钟所有权（仅第一个声明者生效）
+     * @param owner 设备实例标识
+     * @return true 表示成为时钟主设备
+     */
+    bool claimDeviceClock(const void* owner);
+
+    /**
+     * @brief 释放设备时钟所有权
+     * @param owner 设备实例标识
+     */
+    void releaseDeviceClock(const void* owner);
+
+    /**
+     * @brief 由音频设备回调推进时钟（实时线程安全：不分配、不阻塞）
+     * @param owner 设备实例标识，非主设备的调用被忽略
+     * @param frames 本次回调输出的采样帧数
+     */
+    void advanceDeviceClock(const void* owner, unsigned long frames);
     
     /**
      * @brief 检查帧计数器是否正在运行
@@ -222,19 +273,45 @@ private:
      */
     void generateFrameCount();
     
+    /**
+     * @brief 设备时钟驱动下的计时线程循环
+     */
+    void deviceDrivenLoop();
+
     /**
      * @brief 创建当前帧信息
      * @param frameCount 帧计数
      * @return 帧信息
      */
     FrameInfo createFrameInfo(qint64 frameCount) const;
+
+    /**
+     * @brief 计算第 frameIndex 帧相对起点的精确偏移（整数运算，无累计舍入误差）
+     */
+    std::chrono::nanoseconds frameOffset(qint64 frameIndex) const;
+
+    /**
+     * @brief 根据采样率与块大小刷新帧率与帧间隔
+     */
+    void updateDerivedTiming();
     
     // 静态成员
     static TimestampGenerator* instance_;           // 单例实例
     static QMutex instanceMutex_;                   // 实例创建互斥锁
-    static inline double FRAME_RATE = 23.4375;              // 23.4375fps
-    static const double FRAME_INTERVAL_MS;         // 帧间隔（毫秒）
-    static const std::chrono::nanoseconds FRAME_INTERVAL_NS; // 帧间隔（纳秒）
+
+    // 时钟配置（构造时从 ConfigManager 读取，之后只读，各线程无需同步即可访问）
+    int sampleRate_;                                // 采样率（Hz）
+    int blockSize_;                                 // 块大小（采样数）
+    double frameRate_;                              // 帧率（fps）
+    double frameIntervalMs_;                        // 帧间隔（毫秒）
+    std::atomic<ClockSource> clockSource_;          // 时钟源
+
+    // 设备驱动时钟
+    std::atomic<const void*> deviceClockOwner_;     // 主设备标识
+    std::atomic<qint64> deviceSampleAccumulator_;   // 未满一块的累计采样数（仅主设备回调写入）
+    std::atomic<qint64> pendingDeviceTicks_;        // 待发出的设备驱动帧
+    std::mutex tickMutex_;                          // 与 tickCondition_ 配合
+    std::condition_variable tickCondition_;         // 设备驱动帧唤醒
     
     // 成员变量
     mutable QMutex frameCountMutex_;                // 帧计数保护互斥锁
@@ -1,12 +1,28 @@
 #include "WebSocketServer.h"
 #include <QDebug>
 #include <QThread>
+#include <QMetaMethod>
+
+namespace {
+    /**
+     * 函数级注释：估算服务端帧在线路上的字节数（服务端帧不加掩码）
+     */
+    qint64 wireSize(qint64 payload)
+    {
+        if (payload < 126) return payload + 2;
+        if (payload < 65536) return payload + 4;
+        return payload + 10;
+    }
+}
 
 WebSocketServer::WebSocketServer(QObject *parent)
     : QObject(parent)
 {
+    qRegisterMetaType<WebSocketClientStats>("WebSocketClientStats");
+    qRegisterMetaType<QList<WebSocketClientStats>>("QList<WebSocketClientStats>");
     mThread = new QThread(this);
     WebSocketWorker *worker = new WebSocketWorker();
+    m_worker = worker;
     worker->moveToThread(mThread);
     connect(mThread, &QThread::finished, worker, &QObject::deleteLater);
     connect(this, &WebSocketServer::initializeRequested, worker, &WebSocketWorker::initialize);
@@ -15,6 +31,13 @@ WebSocketServer::WebSocketServer(QObject *parent)
     connect(worker, &WebSocketWorker::newConnection, this, &WebSocketServer::newConnection);
     connect(worker, &WebSocketWorker::messageReceived, this, &WebSocketServer::messageReceived);
     connect(worker, &WebSocketWorker::connectionClosed, this, &WebSocketServer::connectionClosed);
+    connect(worker, &WebSocketWorker::clientStatsUpdated, this, [this](const QList<WebSocketClientStats> &stats) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stats = stats;
+        }
+        emit clientStatsUpdated(stats);
+    });
     mThread->start();
     emit initializeRequested(mPort);
 }
@@ -43,12 +66,29 @@ void WebSocketServer::start(quint16 port) {
 void WebSocketServer::stop() {
     emit cleanupRequested();
 }
-void WebSocketServer::broadcastMessage(const QByteArray &message,const int &messageType) {
-    emit broadcastRequested(message,messageType);
+void WebSocketServer::broadcastMessage(const QByteArray &message,const int &messageType, const QString &topic) {
+    emit broadcastRequested(message,messageType,topic);
 }
 
+void WebSocketServer::setSlowClientPolicy(SlowClientPolicy policy, int timeoutMs) {
+    WebSocketWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, policy, timeoutMs]() {
+        worker->setSlowClientPolicy(policy, timeoutMs);
+    }, Qt::QueuedConnection);
+}
+
+QList<WebSocketClientStats> WebSocketServer::clientStats() const {
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
 
-WebSocketWorker::WebSocketWorker(QObject *parent) : QObject(parent), m_server(nullptr) {}
+
+WebSocketWorker::WebSocketWorker(QObject *parent) : QObject(parent), m_server(nullptr) {
+    m_clock.start();
+    m_statsTimer = new QTimer(this);
+    m_statsTimer->setInterval(StatsIntervalMs);
+    connect(m_statsTimer, &QTimer::timeout, this, &WebSocketWorker::publishStats);
+}
 
 WebSocketWorker::~WebSocketWorker() { cleanup(); }
 
@@ -64,9 +104,13 @@ void WebSocketWorker::initialize(quint16 port) {
     }
 }
 void WebSocketWorker::cleanup() {
-    for (QWebSocket *client : m_clients) {
+    m_statsTimer->stop();
+    for (ClientState *state : std::as_const(m_clients)) {
+        QWebSocket *client = state->socket;
+        client->disconnect(this);
         if (client->isValid()) client->close();
         client->deleteLater();
+        delete state;
     }
     m_clients.clear();
     if (m_server) {
@@ -75,33 +119,171 @@ void WebSocketWorker::cleanup() {
         m_server = nullptr;
     }
 }
-void WebSocketWorker::broadcast(const QByteArray &msg,const int &messageType) {
-    if (messageType == 1) {
-        for (QWebSocket *client : m_clients) {
-            if (client->state() == QAbstractSocket::ConnectedState) {
-                client->sendTextMessage(msg);
-            }
+
+void WebSocketWorker::setSlowClientPolicy(SlowClientPolicy policy, int timeoutMs) {
+    m_policy = policy;
+    m_slowClientTimeoutMs = qMax(100, timeoutMs);
+}
+
+/**
+ * @brief 广播：消息只构造一次（文本只解码一次），各客户端队列共享同一份负载
+ */
+void WebSocketWorker::broadcast(const QByteArray &msg,const int &messageType, const QString &topic) {
+    if (m_clients.isEmpty()) return;
+    Message message;
+    message.topic = topic;
+    message.isText = messageType == 1;
+    if (message.isText) {
+        message.text = QString::fromUtf8(msg);
+    }
+    message.payload = msg;
+    message.enqueuedMs = m_clock.elapsed();
+    // 入队过程中可能因慢客户端断开而修改 m_clients，先取快照
+    const QList<ClientState*> clients = m_clients.values();
+    for (ClientState *client : clients) {
+        if (client->socket->state() == QAbstractSocket::ConnectedState) {
+            enqueue(client, message);
         }
-    }else
-    {
-        for (QWebSocket *client : m_clients) {
-            if (client->state() == QAbstractSocket::ConnectedState) {
-                client->sendBinaryMessage(msg);
-            }
+    }
+}
+
+/**
+ * @brief 入队：同主题覆盖旧值（最新值优先），队列满时挤出最旧的消息，然后尝试发送
+ */
+void WebSocketWorker::enqueue(ClientState *client, const Message &message) {
+    if (!message.topic.isEmpty()) {
+        auto it = client->topics.constFind(message.topic);
+        if (it != client->topics.constEnd()) {
+            *it.value() = message;
+            ++client->dropped;
+            pump(client);
+            return;
+        }
+    }
+    if (int(client->queue.size()) >= MaxQueuedMessages) {
+        const Message &oldest = client->queue.front();
+        if (!oldest.topic.isEmpty()) {
+            client->topics.remove(oldest.topic);
         }
+        client->queue.pop_front();
+        ++client->dropped;
     }
+    client->queue.push_back(message);
+    if (!message.topic.isEmpty()) {
+        client->topics.insert(message.topic, std::prev(client->queue.end()));
+    }
+    pump(client);
+}
 
+/**
+ * @brief 在途字节未超过发送窗口时把队列中的消息交给套接字
+ */
+void WebSocketWorker::pump(ClientState *client) {
+    while (!client->queue.empty() && client->outstanding < SendWindowBytes) {
+        const Message &message = client->queue.front();
+        if (message.isText) {
+            client->socket->sendTextMessage(message.text);
+        } else {
+            client->socket->sendBinaryMessage(message.payload);
+        }
+        const qint64 bytes = wireSize(message.payload.size());
+        client->outstanding += bytes;
+        client->sentBytes += bytes;
+        client->inFlight.emplace_back(client->sentBytes, message.enqueuedMs);
+        ++client->sent;
+        if (!message.topic.isEmpty()) {
+            client->topics.remove(message.topic);
+        }
+        client->queue.pop_front();
+    }
+    checkCongestion(client);
+}
+
+/**
+ * @brief 套接字写出后更新在途字节与延迟统计，并继续发送队列
+ */
+void WebSocketWorker::onBytesWritten(ClientState *client, qint64 bytes) {
+    client->writtenBytes += bytes;
+    client->outstanding = qMax<qint64>(0, client->sentBytes - client->writtenBytes);
+    const qint64 now = m_clock.elapsed();
+    while (!client->inFlight.empty() && client->inFlight.front().first <= client->writtenBytes) {
+        const qint64 latency = now - client->inFlight.front().second;
+        client->avgLatencyMs = client->avgLatencyMs * 0.9 + double(latency) * 0.1;
+        client->maxLatencyMs = qMax(client->maxLatencyMs, latency);
+        client->inFlight.pop_front();
+    }
+    pump(client);
+}
+
+/**
+ * @brief 拥塞检测：发送窗口持续占满超过超时时间，按策略断开慢客户端
+ */
+void WebSocketWorker::checkCongestion(ClientState *client) {
+    if (client->outstanding < SendWindowBytes) {
+        client->congestedSinceMs = -1;
+        return;
+    }
+    const qint64 now = m_clock.elapsed();
+    if (client->congestedSinceMs < 0) {
+        client->congestedSinceMs = now;
+        return;
+    }
+    if (m_policy == SlowClientPolicy::Disconnect && now - client->congestedSinceMs > m_slowClientTimeoutMs) {
+        qWarning() << "WebSocketWorker: disconnecting slow client" << client->socket->peerAddress().toString()
+                   << "outstanding" << client->outstanding << "bytes";
+        client->congestedSinceMs = -1;
+        client->queue.clear();
+        client->topics.clear();
+        // 积压的数据使关闭帧也无法及时送达，直接中止连接
+        client->socket->abort();
+    }
+}
+
+void WebSocketWorker::publishStats() {
+    static const QMetaMethod statsSignal = QMetaMethod::fromSignal(&WebSocketWorker::clientStatsUpdated);
+    QList<WebSocketClientStats> stats;
+    stats.reserve(m_clients.size());
+    // 断开慢客户端会修改 m_clients，遍历快照
+    const QList<ClientState*> clients = m_clients.values();
+    for (ClientState *client : clients) {
+        WebSocketClientStats item;
+        item.peer = client->socket->peerAddress().toString() + ':' + QString::number(client->socket->peerPort());
+        item.queuedMessages = int(client->queue.size());
+        item.outstandingBytes = client->outstanding;
+        item.avgLatencyMs = client->avgLatencyMs;
+        item.maxLatencyMs = client->maxLatencyMs;
+        item.sentMessages = client->sent;
+        item.droppedMessages = client->dropped;
+        stats.append(item);
+        client->maxLatencyMs = 0;
+        // 慢客户端的拥塞也需要在无新消息时被检测到
+        checkCongestion(client);
+    }
+    if (isSignalConnected(statsSignal)) {
+        emit clientStatsUpdated(stats);
+    }
+    if (m_clients.isEmpty()) {
+        m_statsTimer->stop();
+    }
 }
 
 void WebSocketWorker::onNewConnection() {
     QWebSocket *client = m_server->nextPendingConnection();
     if (!client) return;
+    auto *state = new ClientState;
+    state->socket = client;
     connect(client, &QWebSocket::binaryMessageReceived, this, &WebSocketWorker::onMessageReceived);
     connect(client, &QWebSocket::textMessageReceived, this, [this, client](const QString &msg) {
         emit messageReceived(client, msg.toUtf8());
     });
+    connect(client, &QWebSocket::bytesWritten, this, [this, state](qint64 bytes) {
+        onBytesWritten(state, bytes);
+    });
     connect(client, &QWebSocket::disconnected, this, &WebSocketWorker::onDisconnected);
-    m_clients.append(client);
+    m_clients.insert(client, state);
+    if (!m_statsTimer->isActive()) {
+        m_statsTimer->start();
+    }
     emit newConnection(client);
 }
 
@@ -114,7 +296,10 @@ void WebSocketWorker::onMessageReceived(const QByteArray &msg) {
 void WebSocketWorker::onDisconnected() {
     QWebSocket *client = qobject_cast<QWebSocket*>(sender());
     if (client) {
-        m_clients.removeAll(client);
+        if (ClientState *state = m_clients.take(client)) {
+            client->disconnect(this);
+            delete state;
+        }
         client->deleteLater();
         emit connectionClosed(client);
     }
@@ -8,6 +8,37 @@
 #include <QMutex>
 #include <QMap>
 #include <QThread>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <list>
+#include <deque>
+
+/**
+ * @brief 慢客户端处理策略
+ * - DropIntermediate：只丢弃中间状态，不断开
+ * - Disconnect：持续拥塞超过超时时间后断开
+ */
+enum class SlowClientPolicy {
+    DropIntermediate,
+    Disconnect
+};
+
+/**
+ * @brief 单个客户端的发送统计
+ */
+struct WebSocketClientStats {
+    QString peer;                 ///< 对端地址:端口
+    int queuedMessages = 0;       ///< 队列中等待发送的消息数
+    qint64 outstandingBytes = 0;  ///< 已交给套接字但尚未写出的字节数
+    double avgLatencyMs = 0.0;    ///< 入队到写出的平均延迟（指数滑动平均）
+    qint64 maxLatencyMs = 0;      ///< 统计周期内最大延迟
+    quint64 sentMessages = 0;     ///< 已发送消息数
+    quint64 droppedMessages = 0;  ///< 被覆盖或挤出的消息数
+};
+Q_DECLARE_METATYPE(WebSocketClientStats)
+
+class WebSocketWorker;
 
 
 class WebSocketServer : public QObject
@@ -20,23 +51,43 @@ public:
 
     void start(quint16 port);
     void stop();
-    void broadcastMessage(const QByteArray &message,const int &messageType = 0);
+    /**
+     * @brief 广播消息；topic 非空时同一主题在客户端队列中只保留最新值
+     * @param messageType 0 二进制，1 文本
+     */
+    void broadcastMessage(const QByteArray &message,const int &messageType = 0, const QString &topic = QString());
     void initialize(quint16 port);
     void cleanup();
     void setPort(quint16 port);
 
+    /**
+     * @brief 设置慢客户端策略与持续拥塞超时时间
+     */
+    void setSlowClientPolicy(SlowClientPolicy policy, int timeoutMs);
+
+    /**
+     * @brief 最近一次统计的各客户端发送状态
+     */
+    QList<WebSocketClientStats> clientStats() const;
+
 signals:
+    /**
+     * @brief 周期性的客户端发送统计（每秒一次，仅在有客户端时发出）
+     */
+    void clientStatsUpdated(const QList<WebSocketClientStats> &stats);
     void newConnection(QWebSocket *socket);
     void messageReceived(QWebSocket *socket, const QByteArray &message);
     void connectionClosed(QWebSocket *socket);
     void initializeRequested(quint16 port);
     void cleanupRequested();
-    void broadcastRequested(const QByteArray &message,const int &messageType = 0);
+    void broadcastRequested(const QByteArray &message,const int &messageType = 0, const QString &topic = QString());
 
 private:
     QWebSocketServer *m_server;
     QMap<QWebSocket*, QThread*> m_clientThreads;
-    QMutex m_mutex;
+    mutable QMutex m_mutex;
+    QList<WebSocketClientStats> m_stats;
+    WebSocketWorker *m_worker = nullptr;
     QThreadPool m_threadPool;
     QThread *mThread = nullptr;
     quint16 mPort = 2003;
@@ -45,25 +96,65 @@ private:
 class WebSocketWorker : public QObject {
     Q_OBJECT
 public:
+    static constexpr int MaxQueuedMessages = 64;              // 每客户端队列上限（条）
+    static constexpr qint64 SendWindowBytes = 256 * 1024;     // 每客户端在途字节上限，超过后消息留在队列
+    static constexpr int DefaultSlowClientTimeoutMs = 10000;  // 持续拥塞多久视为慢客户端
+    static constexpr int StatsIntervalMs = 1000;
+
     explicit WebSocketWorker(QObject *parent = nullptr);
     ~WebSocketWorker();
 
 public slots:
     void initialize(quint16 port) ;
     void cleanup() ;
-    void broadcast(const QByteArray &msg,const int &messageType = 0) ;
+    void broadcast(const QByteArray &msg,const int &messageType = 0, const QString &topic = QString()) ;
+    void setSlowClientPolicy(SlowClientPolicy policy, int timeoutMs);
 
 private slots:
     void onNewConnection() ;
     void onMessageReceived(const QByteArray &msg) ;
     void onDisconnected();
+    void publishStats();
 
 signals:
     void newConnection(QWebSocket *socket);
     void messageReceived(QWebSocket *socket, const QByteArray &message);
     void connectionClosed(QWebSocket *socket);
+    void clientStatsUpdated(const QList<WebSocketClientStats> &stats);
 private:
+    // 一次编码、所有客户端共享的消息（QByteArray/QString 隐式共享，入队不复制负载）
+    struct Message {
+        QString topic;
+        QByteArray payload;
+        QString text;             // 文本消息只解码一次
+        bool isText = false;
+        qint64 enqueuedMs = 0;
+    };
+    struct ClientState {
+        QWebSocket *socket = nullptr;
+        std::list<Message> queue;
+        QHash<QString, std::list<Message>::iterator> topics;    // 主题 → 队列中的位置
+        qint64 outstanding = 0;                                // 在途字节（估算含帧头）
+        qint64 sentBytes = 0;
+        qint64 writtenBytes = 0;
+        std::deque<std::pair<qint64, qint64>> inFlight;        // (累计字节终点, 入队时间)
+        qint64 congestedSinceMs = -1;
+        double avgLatencyMs = 0.0;
+        qint64 maxLatencyMs = 0;
+        quint64 sent = 0;
+        quint64 dropped = 0;
+    };
+
+    void enqueue(ClientState *client, const Message &message);
+    void pump(ClientState *client);
+    void onBytesWritten(ClientState *client, qint64 bytes);
+    void checkCongestion(ClientState *client);
+
     QWebSocketServer *m_server = nullptr;
-    QList<QWebSocket*> m_clients;
+    QHash<QWebSocket*, ClientState*> m_clients;
+    QElapsedTimer m_clock;
+    QTimer *m_statsTimer = nullptr;
+    SlowClientPolicy m_policy = SlowClientPolicy::Disconnect;
+    int m_slowClientTimeoutMs = DefaultSlowClientTimeoutMs;
 };
-#endif // WEBSOCKETSERVER_H
\ No newline at end of file
+#endif // WEBSOCKETSERVER_H
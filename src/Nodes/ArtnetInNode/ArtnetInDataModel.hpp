@@ -58,14 +58,12 @@ public:
             AbstractDelegateModel::registerExternalBinding("/filter", this, b);
         }
 
-        connect(artnet_Receiver, &ArtnetReceiver::receiveArtnet, this, &ArtnetInDataModel::getArtnet);
-        connect(this, &ArtnetInDataModel::universeChanged, artnet_Receiver, &ArtnetReceiver::universeFilter);
+        // 未指定 Universe 前监听全部宇宙
+        ArtnetReceiver::getInstance()->subscribe(-1, this, SLOT(onArtnetUniverse(ArtnetUniverseFrame)));
     }
 
     ~ArtnetInDataModel() override {
-//        artnet_Receiver->deleteLater();
-        // delete artnet_Receiver;
-
+        ArtnetReceiver::getInstance()->unsubscribe(this);
     }
 
     QString portCaption(QtNodes::PortType portType, QtNodes::PortIndex portIndex) const override
@@ -175,6 +173,7 @@ public:
 public Q_SLOTS:
     /**
      * 函数级注释：设置 Universe 属性，并同步到 UI
+     * - 重新订阅接收器，只接收该宇宙的变化
      */
     void setUniverse(int universe)
     {
@@ -182,6 +181,9 @@ public Q_SLOTS:
             return;
         }
         m_universe = universe;
+        ArtnetReceiver* receiver = ArtnetReceiver::getInstance();
+        receiver->unsubscribe(this);
+        receiver->subscribe(m_universe, this, SLOT(onArtnetUniverse(ArtnetUniverseFrame)));
         Q_EMIT universeChanged(m_universe);
     }
 
@@ -246,27 +248,31 @@ private Q_SLOTS:
     }
 
     /**
-     * 函数级注释：处理接收到的 Artnet 数据，根据当前属性进行过滤并输出
+     * 函数级注释：处理接收器推送的宇宙数据（仅订阅宇宙且内容变化时才会收到），根据当前属性进行过滤并输出
      */
-    void getArtnet(const QVariantMap &data) {
+    void onArtnetUniverse(const ArtnetUniverseFrame &frame) {
         if (m_filterEnabled) {
-            if (data.contains("universe") && data["universe"].toInt() == m_universe) {
-                if (!m_channelsFilter.isEmpty() && data.contains("default")) {
-                    QByteArray dmxData = data["default"].toByteArray();
-                    QVariantMap filteredData;
-                    filteredData["universe"] = data["universe"];
-                    filteredData["host"] = data["host"];
-                    for (int channel : m_channelsFilter) {
-                        if (channel >= 0 && channel < dmxData.size()) {
-                            int value = static_cast<unsigned char>(dmxData.at(channel));
-                            filteredData[QString::number(channel)] = value;
-                        }
+            if (frame.universe == m_universe && !m_channelsFilter.isEmpty()) {
+                QVariantMap filteredData;
+                filteredData["universe"] = frame.universe;
+                filteredData["host"] = frame.host;
+                for (int channel : m_channelsFilter) {
+                    if (channel >= 0 && channel < frame.dmxData.size()) {
+                        int value = static_cast<unsigned char>(frame.dmxData.at(channel));
+                        filteredData[QString::number(channel)] = value;
                     }
-                    m_outData = std::make_shared<VariableData>(filteredData);
-                    Q_EMIT dataUpdated(0);
                 }
+                m_outData = std::make_shared<VariableData>(filteredData);
+                Q_EMIT dataUpdated(0);
             }
         } else {
+            QVariantMap data;
+            data["universe"] = frame.universe;
+            data["sequence"] = frame.sequence;
+            data["physical"] = frame.physical;
+            data["host"] = frame.host;
+            data["hex"] = frame.dmxData.toHex();
+            data["default"] = frame.dmxData;
             m_outData = std::make_shared<VariableData>(data);
             Q_EMIT dataUpdated(0);
         }
@@ -340,6 +346,4 @@ private:
     QString m_channels;
     bool m_filterEnabled = false;
     QList<int> m_channelsFilter;
-
-    ArtnetReceiver * artnet_Receiver = new ArtnetReceiver();
 };
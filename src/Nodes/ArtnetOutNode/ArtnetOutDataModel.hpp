@@ -84,9 +84,6 @@ public:
         
         // 设置默认值
         setTargetHost("192.168.0.255");  // 默认广播地址
-        
-        // 初始化Universe数据缓存
-        m_universeCache.clear();
     }
 
     /**
@@ -131,8 +128,8 @@ public:
     NodeDataType dataType(PortType portType, PortIndex portIndex) const override
     {
         Q_UNUSED(portIndex)
-        Q_UNUSED(portType)
-        return VariableData().type();
+        // 输入为 DMX 宇宙数据；旧格式 Art-Net 数据包（VariableData）由数据流图自动转换
+        return portType == PortType::In ? DmxUniverseData().type() : VariableData().type();
     }
 
     /**
@@ -147,44 +144,21 @@ public:
     }
 
     /**
-     * 设置输入数据 - 接收ArtnetUniverseNode的输出并自动发送
-     * @param data 输入数据（来自ArtnetUniverseNode）
+     * 设置输入数据 - 接收 DMX 宇宙数据并自动发送
+     * - 不持有输入数据，上游可在下一帧原地复用其输出
+     * @param data 输入数据（DmxUniverseData）
      * @param portIndex 端口索引
      */
     void setInData(std::shared_ptr<NodeData> data, PortIndex const portIndex) override
     {
-        if (data == nullptr) {
-            // 如果数据为空，移除对应的Universe缓存
-            m_universeCache.remove(portIndex);
-            return;
-        }
-        
-        auto variableData = std::dynamic_pointer_cast<VariableData>(data);
-        if (!variableData) {
-            return;
-        }
-        
-        // 获取ArtnetUniverseNode的输出数据
-        QVariant defaultValue = variableData->value("default");
-        if (!defaultValue.isValid()) {
+        Q_UNUSED(portIndex);
+        auto universeData = std::dynamic_pointer_cast<DmxUniverseData>(data);
+        if (!universeData) {
             return;
         }
-        
-        QVariantMap artnetPacket = defaultValue.toMap();
-        if (artnetPacket.isEmpty()) {
-            return;
-        }
-        
-        // 验证是否为有效的Art-Net数据包
-        if (artnetPacket["protocol"].toString() != "Art-Net") {
-            return;
-        }
-        
-        // 缓存Universe数据
-        m_universeCache[portIndex] = artnetPacket;
-        
+
         // 自动发送该Universe的数据
-        sendUniverseData(artnetPacket);
+        sendUniverseData(*universeData);
     }
 
     /**
@@ -318,9 +292,9 @@ private slots:
 private:
     /**
      * 发送指定的Universe数据
-     * @param artnetPacket ArtnetUniverseNode输出的数据包
+     * @param universeData DMX 宇宙数据
      */
-    void sendUniverseData(const QVariantMap &artnetPacket) {
+    void sendUniverseData(const DmxUniverseData &universeData) {
         if (!m_artnetTransmitter) {
             setIsReady(false);
             // if (widget) {
@@ -335,39 +309,16 @@ private:
         frame.sequence = 0;
         frame.timestamp = QDateTime::currentMSecsSinceEpoch();
         
-        // 从ArtnetUniverseNode的数据包中提取Universe信息
-        frame.universe = static_cast<quint16>(artnetPacket["fullUniverse"].toInt());
-        
-        // 转换DMX数据
-        QByteArray dmxData = convertArtnetPacketToDmx(artnetPacket);
-        frame.setDmxData(dmxData);
+        frame.universe = static_cast<quint16>(universeData.universe());
+
+        // 独占存储时共享数据，不复制
+        frame.setDmxData(universeData.toByteArray());
         
         // 发送数据帧
         m_artnetTransmitter->enqueueFrame(frame);
 
     }
     
-    /**
-     * 将ArtnetUniverseNode的数据包转换为DMX数据
-     * @param artnetPacket ArtnetUniverseNode输出的数据包
-     * @return DMX字节数组（512字节）
-     */
-    QByteArray convertArtnetPacketToDmx(const QVariantMap &artnetPacket) {
-        QByteArray dmxData(512, 0);  // 初始化512个通道为0
-        
-        // 从数据包中提取DMX数据
-        QVariantList dmxList = artnetPacket["dmxData"].toList();
-        
-        // 确保数据长度正确
-        int dataLength = qMin(dmxList.size(), 512);
-        for (int i = 0; i < dataLength; ++i) {
-            int value = dmxList[i].toInt();
-            value = qBound(0, value, 255);  // 限制在0-255范围内
-            dmxData[i] = static_cast<char>(value);
-        }
-        
-        return dmxData;
-    }
 signals:
     void targetHostChanged(const QString &host);
     void isReadyChanged(bool ready);
@@ -391,7 +342,5 @@ private:
     // 配置参数
     QString m_targetHost;     // 目标主机地址
     bool m_isReady = false;
-    
-    // Universe数据缓存 - 键为端口索引，值为ArtnetUniverseNode的输出数据包
-    QMap<int, QVariantMap> m_universeCache;
+
 };
@@ -15,8 +15,8 @@ namespace Nodes
         , _processingTimer(new QTimer(this))
         , _isProcessing(false)
         , _lastProcessedTimestamp(0)
-        , _frameSize(2048)  // 默认帧大小
-        , _sampleRate(48000)  // 默认采样率
+        , _frameSize(TimestampGenerator::getInstance()->getBlockSize())  // 默认帧大小：全局块大小
+        , _sampleRate(TimestampGenerator::getInstance()->getSampleRate())  // 默认采样率：全局采样率
     {
         // 设置处理定时器
         _processingTimer->setInterval(15); // 15ms间隔处理音频数据
@@ -113,7 +113,7 @@ namespace Nodes
         bool hasValidInput = false;
 
         if (_inputBuffers && _inputBuffers->isActive()) {
-            if (_inputBuffers->getFrameByTimestamp(currentTime, inputFrame)) {
+            if (_inputBuffers->getFrameByTimestamp(*_inputCursor, currentTime, inputFrame)) {
                 hasValidInput = true;
             }
         }
@@ -307,6 +307,7 @@ void AudioAnalysisWorker::setInputBuffer(int port, std::shared_ptr<AudioTimestam
     
     if (port >= 0 ) {
         _inputBuffers = buffer;
+        _inputCursor = AudioTimestampRingQueue::createCursor();
     } else {
         qWarning() << "AudioAnalysisWorker: Invalid input port index:" << port
                    << "(valid range: 0 -";
@@ -79,6 +79,7 @@ namespace Nodes
         
     private:
         std::shared_ptr<AudioTimestampRingQueue> _inputBuffers;    ///< 输入音频缓冲区数组
+        std::shared_ptr<AudioQueueCursor> _inputCursor = AudioTimestampRingQueue::createCursor(); ///< 输入缓冲区的私有读者游标
         QTimer* _processingTimer;                                              ///< 处理定时器
         QMutex _mutex;                                                         ///< 互斥锁
         bool _isProcessing;                                                    ///< 处理状态标志
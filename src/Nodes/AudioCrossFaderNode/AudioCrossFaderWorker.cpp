@@ -27,6 +27,7 @@ namespace Nodes
         
         _isProcessing = true;
         _lastProcessedTimestamp = 0;
+        registerRenderProcessor();
         QObject::connect(TimestampGenerator::getInstance(),
                          &TimestampGenerator::frameCountUpdated,
                          this,
@@ -40,6 +41,7 @@ namespace Nodes
         QMutexLocker locker(&_mutex);
         if (_isProcessing) {
             _isProcessing = false;
+            AudioRenderGraph::instance().removeProcessor(this);
             QObject::disconnect(TimestampGenerator::getInstance(),
                                 &TimestampGenerator::frameCountUpdated,
                                 this,
@@ -55,8 +57,47 @@ namespace Nodes
 
     void AudioCrossFaderWorker::onFrameTick(qint64 frameCount)
     {
-        if (!_isProcessing || _inputBuffers.empty() || _outputBuffers.empty()) return;
-        if (frameCount == _lastProcessedTimestamp) return;
+        // 已由设备回调拉取时不再自行推进
+        if (AudioRenderGraph::instance().isDriven()) return;
+        QMutexLocker locker(&_mutex);
+        if (!_isProcessing || frameCount == _lastProcessedTimestamp) return;
+        if (renderFrame(frameCount, frameCount + 2)) {
+            _lastProcessedTimestamp = frameCount;
+            emit audioProcessed(_outputBuffers);
+        }
+    }
+
+    /**
+     * 函数级注释：渲染图拉取入口（设备回调线程）
+     * - tryLock：参数设置持锁时跳过本块，不阻塞回调线程
+     * - 拉取模式下输出不叠加延迟补偿，也不发出 audioProcessed 信号
+     */
+    void AudioCrossFaderWorker::renderBlock(qint64 timestamp)
+    {
+        if (!_mutex.tryLock()) return;
+        if (_isProcessing && timestamp != _lastProcessedTimestamp && renderFrame(timestamp, timestamp)) {
+            _lastProcessedTimestamp = timestamp;
+        }
+        _mutex.unlock();
+    }
+
+    void AudioCrossFaderWorker::registerRenderProcessor()
+    {
+        std::vector<const AudioTimestampRingQueue*> inputs;
+        std::vector<const AudioTimestampRingQueue*> outputs;
+        for (const auto& buffer : _inputBuffers) inputs.push_back(buffer.get());
+        for (const auto& buffer : _outputBuffers) outputs.push_back(buffer.get());
+        AudioRenderGraph::instance().updateProcessor(this, inputs, outputs);
+    }
+
+    /**
+     * 函数级注释：读取 A/B 输入并交叉淡化（自行推进与渲染图拉取共用，可在设备回调线程中执行）
+     * - 输入通过私有游标 acquireFrameView 读取（32 位浮点），不复制 QByteArray
+     * - 输出经 beginWriteFrame/commitWriteFrame 直接写入无锁队列槽位，不构造中间帧、不分配内存
+     */
+    bool AudioCrossFaderWorker::renderFrame(qint64 frameCount, qint64 outputTimestamp)
+    {
+        if (_inputBuffers.empty() || _outputBuffers.empty() || !_outputBuffers[0]) return false;
         
         // 自动淡入淡出：根据时间推进 mix
         if (_fadingActive) {
@@ -72,93 +113,51 @@ namespace Nodes
         }
         
         // Expect two inputs for crossfade: A (0) and B (1)
-        if (_inputBuffers.size() < 2) return;
+        if (_inputBuffers.size() < 2 || _inputViews.size() < 2) return false;
 
-        std::vector<AudioFrame> inputFrames(_inputBuffers.size());
-        bool hasA = false;
-        bool hasB = false;
-        
-        // Get A (Input 0)
-        if (_inputBuffers[0] && _inputBuffers[0]->isActive()) {
-            if (_inputBuffers[0]->getFrameByTimestamp(frameCount, inputFrames[0])) {
-                hasA = true;
-            }
-        }
-        
-        // Get B (Input 1)
-        if (_inputBuffers.size() > 1 && _inputBuffers[1] && _inputBuffers[1]->isActive()) {
-            if (_inputBuffers[1]->getFrameByTimestamp(frameCount, inputFrames[1])) {
-                hasB = true;
-            }
+        bool has[2] = {false, false};
+        for (int i = 0; i < 2; ++i) {
+            _inputViews[i] = AudioFrameView();
+            has[i] = _inputBuffers[i] && _inputBuffers[i]->isActive() &&
+                     _inputBuffers[i]->acquireFrameView(*_inputCursors[i], frameCount, _inputViews[i]) &&
+                     _inputViews[i].sampleCount > 0;
         }
-        
-        if (!hasA && !hasB) return;
-
-        performCrossFadeOperation(inputFrames, frameCount);
-        _lastProcessedTimestamp = frameCount;
-        emit audioProcessed(_outputBuffers);
-    }
-    
-    void AudioCrossFaderWorker::performCrossFadeOperation(const std::vector<AudioFrame>& inputFrames, qint64 timestamp)
-    {
+        const bool hasA = has[0];
+        const bool hasB = has[1];
+        if (!hasA && !hasB) return false;
 
-        bool hasA = !(inputFrames.size() < 1 || inputFrames[0].data.isEmpty());
-        bool hasB = !(inputFrames.size() < 2 || inputFrames[1].data.isEmpty());
-        if (!hasA && !hasB) return;
+        const AudioFrameView& a = _inputViews[0];
+        const AudioFrameView& b = _inputViews[1];
+        const int aCount = hasA ? a.sampleCount : 0;
+        const int bCount = hasB ? b.sampleCount : 0;
 
-        const uint8_t* aRaw = hasA ? reinterpret_cast<const uint8_t*>(inputFrames[0].data.constData()) : nullptr;
-        const uint8_t* bRaw = hasB ? reinterpret_cast<const uint8_t*>(inputFrames[1].data.constData()) : nullptr;
-        int aBytesPerSample = hasA ? inputFrames[0].bitsPerSample / 8 : 0;
-        int bBytesPerSample = hasB ? inputFrames[1].bitsPerSample / 8 : 0;
-        size_t aCount = hasA ? inputFrames[0].data.size() / std::max(1, aBytesPerSample) : 0;
-        size_t bCount = hasB ? inputFrames[1].data.size() / std::max(1, bBytesPerSample) : 0;
-        size_t sampleCount = std::max(aCount, bCount);
-        if (sampleCount == 0) return;
-
-        // Compute weights
-        float mix = _mix;
         // Always use equal-power curve
-        float theta = mix * static_cast<float>(M_PI_2);
+        float theta = _mix * static_cast<float>(M_PI_2);
         float wA = std::cos(theta);
         float wB = std::sin(theta);
         // Passthrough fallback when only one input is present
         if (!hasA && hasB) { wA = 0.0f; wB = 1.0f; }
         if (hasA && !hasB) { wA = 1.0f; wB = 0.0f; }
 
-        // Prepare output
-        AudioFrame outputFrame;
-        const AudioFrame& refIn = hasA ? inputFrames[0] : inputFrames[1];
-        outputFrame.sampleRate = refIn.sampleRate > 0 ? refIn.sampleRate : _sampleRate;
-        outputFrame.channels = 1;
-        outputFrame.bitsPerSample = 32;
-        outputFrame.timestamp = timestamp + 2; // small latency compensation
-        outputFrame.data.resize(sampleCount * sizeof(float));
-        float* out = reinterpret_cast<float*>(outputFrame.data.data());
-
-        // Convert inputs to float32 if needed and mix
-        for (size_t i = 0; i < sampleCount; ++i) {
-            float a = 0.0f;
-            float b = 0.0f;
-            if (hasA && i < aCount) {
-                if (inputFrames[0].bitsPerSample == 32) {
-                    a = reinterpret_cast<const float*>(aRaw)[i];
-                } else if (inputFrames[0].bitsPerSample == 16) {
-                    a = static_cast<float>(reinterpret_cast<const int16_t*>(aRaw)[i]) / 32768.0f;
-                }
+        const AudioFrameView& refIn = hasA ? a : b;
+        const int sampleRate = refIn.sampleRate > 0 ? refIn.sampleRate : _sampleRate;
+        int sampleCount = std::max(aCount, bCount);
+        float* out = _outputBuffers[0]->beginWriteFrame(sampleCount);
+        if (out) {
+            for (int i = 0; i < sampleCount; ++i) {
+                const float sa = i < aCount ? a.data[i] : 0.0f;
+                const float sb = i < bCount ? b.data[i] : 0.0f;
+                out[i] = sa * wA + sb * wB;
             }
-            if (hasB && i < bCount) {
-                if (inputFrames[1].bitsPerSample == 32) {
-                    b = reinterpret_cast<const float*>(bRaw)[i];
-                } else if (inputFrames[1].bitsPerSample == 16) {
-                    b = static_cast<float>(reinterpret_cast<const int16_t*>(bRaw)[i]) / 32768.0f;
-                }
-            }
-            out[i] = a * wA + b * wB;
+            _outputBuffers[0]->commitWriteFrame(outputTimestamp, sampleRate, 1);
         }
-        
-        if (!_outputBuffers.empty() && _outputBuffers[0]) {  
-            _outputBuffers[0]->pushFrame(outputFrame);
+
+        for (int i = 0; i < 2; ++i) {
+            if (has[i]) {
+                _inputBuffers[i]->verifyFrameView(*_inputCursors[i], _inputViews[i]);
+            }
         }
+        return out != nullptr;
     }
 
     void AudioCrossFaderWorker::initializeBuffers(int inputCount, int outputCount)
@@ -167,14 +166,20 @@ namespace Nodes
         
         _inputBuffers.clear();
         _inputBuffers.resize(inputCount);
+        _inputCursors.clear();
+        _inputCursors.resize(inputCount);
         for (int i = 0; i < inputCount; ++i) {
             _inputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+            _inputCursors[i] = AudioTimestampRingQueue::createCursor();
         }
+        // 预分配每块的输入视图，运行期不再分配
+        _inputViews.assign(static_cast<size_t>(inputCount), AudioFrameView());
         
+        // 输出由本 worker 单独写入（自行推进或渲染图拉取，二者由 _mutex 互斥），使用无锁队列
         _outputBuffers.clear();
         _outputBuffers.resize(outputCount);
         for (int i = 0; i < outputCount; ++i) {
-            _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+            _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
         }
     }
 
@@ -183,6 +188,9 @@ namespace Nodes
         QMutexLocker locker(&_mutex);
         if (port >= 0 && port < (int)_inputBuffers.size()) {
             _inputBuffers[port] = buffer;
+            // 每个输入源使用新的私有游标，避免沿用旧源的顺序访问缓存
+            _inputCursors[port] = AudioTimestampRingQueue::createCursor();
+            if (_isProcessing) registerRenderProcessor();
         }
     }
 
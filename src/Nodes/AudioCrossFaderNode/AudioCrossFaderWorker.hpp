@@ -6,6 +6,7 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include "Common/DataTypes/AudioTimestampRingQueue.h"
+#include "Common/DataTypes/AudioRenderGraph.h"
 #include "TimeCodeDefines.h"
 #include <memory>
 
@@ -14,7 +15,7 @@ namespace Nodes
     /**
      * @brief 音频交叉淡化处理工作线程类
      */
-    class AudioCrossFaderWorker : public QObject
+    class AudioCrossFaderWorker : public QObject, public AudioRenderProcessor
     {
         Q_OBJECT
 
@@ -61,17 +62,30 @@ namespace Nodes
         void setInputBuffer(int port, std::shared_ptr<AudioTimestampRingQueue> buffer);
         std::shared_ptr<AudioTimestampRingQueue> getOutputBuffer(int port);
 
+    public:
+        /**
+         * @brief 渲染图拉取入口（设备回调线程）：读取 timestamp 输入帧，输出同样标记为 timestamp
+         */
+        void renderBlock(qint64 timestamp) override;
+
     signals:
         void processingStatusChanged(bool isProcessing);
         void audioProcessed(const std::vector<std::shared_ptr<AudioTimestampRingQueue>>& outputBuffers);
 
     private:
         /**
-         * @brief 执行交叉淡化混合
+         * @brief 以零拷贝视图读取 inputTimestamp 的输入帧，交叉淡化后直接写入输出队列槽位，输出标记为 outputTimestamp（调用方持有 _mutex）
+         * @return true 表示已输出
+         */
+        bool renderFrame(qint64 inputTimestamp, qint64 outputTimestamp);
+        /**
+         * @brief 向音频渲染图登记当前输入/输出队列
          */
-        void performCrossFadeOperation(const std::vector<AudioFrame>& inputFrames, qint64 timestamp);
+        void registerRenderProcessor();
 
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _inputBuffers;
+        std::vector<std::shared_ptr<AudioQueueCursor>> _inputCursors;     ///< 输入缓冲区的私有读者游标
+        std::vector<AudioFrameView> _inputViews;                         ///< 本块各输入的零拷贝视图
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _outputBuffers;
         QMutex _mutex;
         bool _isProcessing;
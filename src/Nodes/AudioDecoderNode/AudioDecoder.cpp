@@ -23,10 +23,11 @@ extern "C" {
 #include <portaudio.h>
 #include <QDateTime>
 // #include <Common/Devices/AudioPipe/AudioPipe.h>
-static const int SAMPLE_RATE = 48000;
+// 采样率与每块采样数取自全局音频时钟配置，每个时间戳对应一块
+static const int SAMPLE_RATE = TimestampGenerator::getInstance()->getSampleRate();
 static const int LOOP_INTERVAL = 800;
 static const int FIXED_DELAY_FRAMES = 5;
-static const int SAMPLES_PER_CHANNEL = SAMPLE_RATE/TimestampGenerator::getInstance()->getFrameRate();;
+static const int SAMPLES_PER_CHANNEL = TimestampGenerator::getInstance()->getBlockSize();
 // 在构造函数中添加新的成员变量初始化
 AudioDecoder::AudioDecoder(QObject *parent)
     : QThread(parent)
@@ -248,11 +249,11 @@ void AudioDecoder::stopPlay() {
         // 刷新重采样器缓冲区（但不处理输出）
         if (swrContext) {
             uint8_t* flushBuffer = nullptr;
-            int flushSize = 2048 * 2 * 4;
+            int flushSize = SAMPLES_PER_CHANNEL * 2 * 4;
             flushBuffer = (uint8_t*)av_malloc(flushSize);
             if (flushBuffer) {
                 // 刷新但丢弃输出，避免产生额外音频
-                swr_convert(swrContext, &flushBuffer, 2048, nullptr, 0);
+                swr_convert(swrContext, &flushBuffer, SAMPLES_PER_CHANNEL, nullptr, 0);
                 av_freep(&flushBuffer);
             }
         }
@@ -312,7 +313,7 @@ void AudioDecoder::handleAudioFrame(AudioFrame frame) {
 
     for (int channel = 0; channel < frame.channels; channel++) {
         if (!channelAudioBuffers[channel])
-            channelAudioBuffers[channel] = std::make_shared<AudioTimestampRingQueue>();
+            channelAudioBuffers[channel] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
 
         AudioFrame channelFrame;
         channelFrame.sampleRate = frame.sampleRate;
@@ -357,7 +358,7 @@ void AudioDecoder::handleAudioFrame(AudioFrame frame) {
 std::shared_ptr<AudioTimestampRingQueue> AudioDecoder::getAudioBuffer(int index)
 {
     if (!channelAudioBuffers[index])
-        channelAudioBuffers[index] = std::make_shared<AudioTimestampRingQueue>();
+        channelAudioBuffers[index] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
     return channelAudioBuffers[index];
 }
 
@@ -97,7 +97,7 @@ namespace Nodes
         {
             if (!channelAudioBuffers_[port])
             {
-                channelAudioBuffers_[port]=std::make_shared<AudioTimestampRingQueue>();
+                channelAudioBuffers_[port]=std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
             }
             auto audioData = std::make_shared<AudioData>();
             audioData->setSharedAudioBuffer(channelAudioBuffers_[port]);
@@ -504,7 +504,7 @@ namespace Nodes
 
             for (int channel = 0; channel < frame.channels; channel++) {
                 if (!channelAudioBuffers_[channel])
-                    channelAudioBuffers_[channel] = std::make_shared<AudioTimestampRingQueue>();
+                    channelAudioBuffers_[channel] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
                 AudioFrame channelFrame;
                 channelFrame.sampleRate = frame.sampleRate;
                 channelFrame.channels = 1; // 单声道
@@ -533,8 +533,8 @@ namespace Nodes
         AudioDeviceInInterface *widget = new AudioDeviceInInterface();
         
         // 音频参数
-        int sampleRate_ = 48000;
-        int framesPerBuffer_ = sampleRate_/TimestampGenerator::getInstance()->getFrameRate();
+        int sampleRate_ = TimestampGenerator::getInstance()->getSampleRate();
+        int framesPerBuffer_ = TimestampGenerator::getInstance()->getBlockSize();
         int channels_ = 2;
         
         // 设备和状态
@@ -92,8 +92,10 @@ void AudioDeviceOutDataModel::updateDeviceList() {
 /**
  * 打开并启动音频输出流
  * - 根据当前选择设备设置通道数、采样格式、建议延迟
- * - 使用 BUFFER_SIZE 作为帧块大小，来源于 SAMPLE_RATE 与全局帧率的比值
+ * - 采样率与帧块大小取自 TimestampGenerator 全局配置，与其它音频节点保持一致
  * - 绑定静态回调 paCallback 执行实时输出
+ * - 声明设备时钟所有权（仅设备驱动时钟模式下生效）
+ * - 声明渲染图驱动权：回调中拉取矩阵/闪避/交叉淡化等处理器，端到端延迟固定为一个设备缓冲
  * - 失败时更新节点状态并返回 false
  */
 bool AudioDeviceOutDataModel::startAudioOutput() {
@@ -111,8 +113,8 @@ bool AudioDeviceOutDataModel::startAudioOutput() {
         &paStream,
         nullptr,
         &outputParameters,
-        SAMPLE_RATE,
-        BUFFER_SIZE,
+        TimestampGenerator::getInstance()->getSampleRate(),
+        static_cast<unsigned long>(TimestampGenerator::getInstance()->getBlockSize()),
         paClipOff | paDitherOff,  // 添加 paDitherOff 减少数字噪声
         paCallback,
         this
@@ -133,6 +135,8 @@ bool AudioDeviceOutDataModel::startAudioOutput() {
         return false;
     }
     updateNodeState(QtNodes::NodeValidationState::State::Valid,"");
+    TimestampGenerator::getInstance()->claimDeviceClock(this);
+    AudioRenderGraph::instance().attachDriver(this);
     isPlaying = true;
     return true;
 }
@@ -141,9 +145,12 @@ bool AudioDeviceOutDataModel::startAudioOutput() {
  * 停止音频输出流
  * - 仅在流处于播放状态时调用 Pa_StopStream
  * - 不关闭流与设备，保持资源以便后续快速恢复
+ * - 释放设备时钟所有权，全局时钟回退为内部计时
  */
 void AudioDeviceOutDataModel::stopAudioOutput() {
     if (paStream && isPlaying) {
+        TimestampGenerator::getInstance()->releaseDeviceClock(this);
+        AudioRenderGraph::instance().detachDriver(this);
         Pa_StopStream(paStream);
         isPlaying = false;
     }
@@ -184,6 +191,8 @@ void AudioDeviceOutDataModel::onDeviceChanged(const QString& deviceText) {
 
             // 重启音频流以应用新设备
             if (isPlaying) {
+                TimestampGenerator::getInstance()->releaseDeviceClock(this);
+                AudioRenderGraph::instance().detachDriver(this);
                 Pa_StopStream(paStream);
                 Pa_CloseStream(paStream);
                 paStream = nullptr;
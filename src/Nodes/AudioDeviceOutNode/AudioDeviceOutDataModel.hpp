@@ -15,11 +15,14 @@
 #include "PluginDefinition.hpp"
 #include <QVector>  // 添加 QVector 头文件
 #include <map>  // 添加 map 头文件
+#include <memory>
+#include <vector>
 #include <QSet>  // 添加 QSet 头文件
 #include <QMap>  // 添加 QMap 头文件
 #include <QRegularExpression>  // 添加 QRegExp 头文件
 #include <QTimer>
 #include "TimestampGenerator/TimestampGenerator.hpp"
+#include "Common/DataTypes/AudioRenderGraph.h"
 #include "Common/BaseClass/AbstractDelegateModel.h"
 using QtNodes::NodeData;
 using QtNodes::NodeDataType;
@@ -29,15 +32,14 @@ using QtNodes::PortType;
 using namespace NodeDataTypes;
 
 
-static const int SAMPLE_RATE = 48000;
-static const size_t BUFFER_SIZE = SAMPLE_RATE/TimestampGenerator::getInstance()->getFrameRate();
 namespace Nodes
 {
     /**
      * 音频设备输出节点模型
      * - 职责：从各输入端口的 AudioTimestampRingQueue 按全局时间戳消费帧并输出到 PortAudio
      * - 关键成员：设备选择、驱动筛选、PortAudio 流、输入端口共享缓冲与每端口上次消费时间戳
-     * - 时钟：依赖 TimestampGenerator 提供统一帧计数，缓冲大小由 SAMPLE_RATE / 全局帧率计算
+     * - 时钟：依赖 TimestampGenerator 提供统一帧计数，采样率与缓冲大小取自 TimestampGenerator 的全局配置；
+     *   设备驱动时钟模式下，第一个启动的输出设备以实际回调采样数推进全局时钟
      * - 线程：PortAudio 回调线程读取并混音/路由到设备通道，尽量避免锁与耗时操作
      */
     class AudioDeviceOutDataModel : public AbstractDelegateModel
@@ -65,6 +67,8 @@ namespace Nodes
         }
         
         ~AudioDeviceOutDataModel() {
+            TimestampGenerator::getInstance()->releaseDeviceClock(this);
+            AudioRenderGraph::instance().detachDriver(this);
             if (paStream) {
                 Pa_StopStream(paStream);
                 Pa_CloseStream(paStream);
@@ -96,7 +100,12 @@ namespace Nodes
                     // 获取AudioTimestampQueue（新的队列模式）
                     auto timestampQueue = audioData->getSharedAudioBuffer();
                     if (timestampQueue) {
-                        inputTimestampQueues[portIndex] = timestampQueue;
+                        auto reader = std::make_shared<PortReader>();
+                        reader->portIndex = portIndex;
+                        reader->queue = timestampQueue;
+                        reader->cursor = AudioTimestampRingQueue::createCursor();
+                        portReaders[portIndex] = reader;
+                        publishPortReaders();
                     }
                     
                     // 自动开始播放
@@ -106,8 +115,9 @@ namespace Nodes
                 } else {
                     // 从所有map中移除该端口的数据
                     inputAudioData.erase(portIndex);
-                    inputTimestampQueues.erase(portIndex);
-
+                    if (portReaders.erase(portIndex) > 0) {
+                        publishPortReaders();
+                    }
                 }
             }
         }
@@ -234,39 +244,56 @@ namespace Nodes
             memset(output, 0, static_cast<size_t>(frames) * static_cast<size_t>(deviceChannels) * sizeof(float));
 
             const qint64 currentGlobalTs = TimestampGenerator::getInstance()->getCurrentFrameCount();
+            // 拉取模式：作为驱动设备时先按拓扑序渲染上游处理器，随后所有端口读取同一时间戳
+            const qint64 renderedTs = AudioRenderGraph::instance().render(this, currentGlobalTs);
+            if (renderedTs == AudioRenderGraph::HeldPass) {
+                // 渲染图领先时钟已达上限：本块输出静音，不重复读取已播放的帧
+                TimestampGenerator::getInstance()->advanceDeviceClock(this, framesPerBuffer);
+                return paContinue;
+            }
+            // 界面线程发布的端口快照：回调线程只读列表，不查找、不插入
+            const std::shared_ptr<const PortReaderList> readers = std::atomic_load(&activePortReaders);
             // Iterate over all active audio input ports
-            for (auto& [portIndex, timestampQueue] : inputTimestampQueues) {
+            for (const std::shared_ptr<PortReader>& reader : *readers) {
+                const int portIndex = reader->portIndex;
+                const std::shared_ptr<AudioTimestampRingQueue>& timestampQueue = reader->queue;
                 // Check if port index is within device channel range
-                if (portIndex >= deviceChannels) {
+                if (portIndex >= deviceChannels || !timestampQueue) {
                     continue;
                 }
-        
-                // Check queue validity
-                if (!timestampQueue) {
-                    continue;
-                }
-
+                // 每个端口使用私有游标，与同一输出的其它消费者（矩阵、分析等）互不争用
+                AudioQueueCursor& cursor = *reader->cursor;
 
-                AudioFrame frame;
+                // 零拷贝读取：无锁模式下直接引用队列槽位，回调线程不加锁、不分配
+                AudioFrameView view;
 
-                qint64& lastTs = lastConsumedTimestamps[portIndex];
-                qint64 desiredTs = (currentGlobalTs == lastTs && lastTs > 0) ? (lastTs + 1) : currentGlobalTs;
-                if (timestampQueue->getFrameByTimestamp(desiredTs, frame)) {
-                    lastTs = frame.timestamp;
+                qint64& lastTs = reader->lastConsumedTs;
+                qint64 desiredTs = renderedTs >= 0 ? renderedTs
+                    : ((currentGlobalTs == lastTs && lastTs > 0) ? (lastTs + 1) : currentGlobalTs);
+                if (timestampQueue->acquireFrameView(cursor, desiredTs, view)) {
+                    lastTs = view.timestamp;
 
-                    const float* input = reinterpret_cast<const float*>(frame.data.constData());
-                    const int totalSamples = static_cast<int>(frame.data.size() / sizeof(float));
-                    const int samplesToProcess = std::min(frames, totalSamples);
+                    const int samplesToProcess = std::min(frames, view.sampleCount);
                     // Pointer stepping write, reducing multiplication
                     float* outPtr = output + portIndex;
-                    const float* inPtr = input;
+                    const float* inPtr = view.data;
                     int remaining = samplesToProcess;
                     while (remaining-- > 0) {
                         *outPtr = *inPtr++;
                         outPtr += deviceChannels;
                     }
+                    // 读取期间槽位被生产者改写：该通道输出静音，避免撕裂数据
+                    if (!timestampQueue->verifyFrameView(cursor, view)) {
+                        outPtr = output + portIndex;
+                        for (int i = 0; i < samplesToProcess; ++i) {
+                            *outPtr = 0.0f;
+                            outPtr += deviceChannels;
+                        }
+                    }
                 }
             }
+            // 设备驱动时钟：仅主设备推进，非主设备调用直接返回
+            TimestampGenerator::getInstance()->advanceDeviceClock(this, framesPerBuffer);
             return paContinue;
         }
 
@@ -307,7 +334,33 @@ private:
             return model->processAudio(outputBuffer, framesPerBuffer);
         }
 
+        /**
+         * @brief 发布端口快照（界面线程）
+         * - 回调线程通过 std::atomic_load 取得不可变列表；连接变化时整体替换，不修改回调正在遍历的容器
+         * - 上一份快照多保留一轮，回调线程持有的副本通常不是最后一个引用，避免在回调线程中释放
+         */
+        void publishPortReaders() {
+            auto snapshot = std::make_shared<PortReaderList>();
+            snapshot->reserve(portReaders.size());
+            for (const auto& entry : portReaders) {
+                snapshot->push_back(entry.second);
+            }
+            retiredPortReaders = std::atomic_load(&activePortReaders);
+            std::atomic_store(&activePortReaders, std::shared_ptr<const PortReaderList>(std::move(snapshot)));
+        }
+
     private:
+        /**
+         * @brief 单个输入端口的读取状态：队列与游标在创建后不变，lastConsumedTs 只由回调线程读写
+         */
+        struct PortReader {
+            int portIndex = 0;
+            std::shared_ptr<AudioTimestampRingQueue> queue;
+            std::shared_ptr<AudioQueueCursor> cursor;
+            qint64 lastConsumedTs = 0;  // 上次成功消费的时间戳
+        };
+        using PortReaderList = std::vector<std::shared_ptr<PortReader>>;
+
         // 成员变量
         bool isPlaying = false;
         AudioDeviceOutInterface* widget = new AudioDeviceOutInterface();
@@ -315,8 +368,9 @@ private:
         PaDeviceIndex selectedDeviceIndex = Pa_GetDefaultOutputDevice();
         // 稀疏存储：只存储实际连接的通道
         std::map<int, std::shared_ptr<AudioData>> inputAudioData;  // 每个端口的音频数据
-        std::map<int, std::shared_ptr<AudioTimestampRingQueue>> inputTimestampQueues;  // 每个端口对应的时间戳队列
-        std::map<int, qint64> lastConsumedTimestamps;  // 每个端口上次成功消费的时间戳
+        std::map<int, std::shared_ptr<PortReader>> portReaders;  // 每个端口的读取状态（仅界面线程）
+        std::shared_ptr<const PortReaderList> activePortReaders = std::make_shared<const PortReaderList>();  // 回调线程读取的快照（非空），std::atomic_load/atomic_store 访问
+        std::shared_ptr<const PortReaderList> retiredPortReaders;  // 上一份快照，延后释放
     };
 }
 
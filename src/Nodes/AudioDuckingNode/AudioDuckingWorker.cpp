@@ -10,28 +10,15 @@ namespace Nodes
         : QObject(parent)
         , _isProcessing(false)
         , _lastProcessedTimestamp(0)
-        , _frameSize(2048)
-        , _sampleRate(48000)
-    {
-        initializeGist(_frameSize, _sampleRate);
-    }
+        , _frameSize(TimestampGenerator::getInstance()->getBlockSize())
+        , _sampleRate(TimestampGenerator::getInstance()->getSampleRate())
+    {}
     
     AudioDuckingWorker::~AudioDuckingWorker()
     {
         stopProcessing();
     }
     
-    void AudioDuckingWorker::initializeGist(int frameSize, int sampleRate)
-    {
-        _frameSize = frameSize;
-        _sampleRate = sampleRate;
-        try {
-            _gistAnalyzer = std::make_unique<Gist<float>>(frameSize, sampleRate);
-        } catch (const std::exception& e) {
-            qWarning() << "AudioDuckingWorker: Failed to initialize GIST:" << e.what();
-        }
-    }
-
     void AudioDuckingWorker::startProcessing()
     {
         QMutexLocker locker(&_mutex);
@@ -39,6 +26,7 @@ namespace Nodes
         
         _isProcessing = true;
         _lastProcessedTimestamp = 0;
+        registerRenderProcessor();
         QObject::connect(TimestampGenerator::getInstance(),
                          &TimestampGenerator::frameCountUpdated,
                          this,
@@ -52,6 +40,7 @@ namespace Nodes
         QMutexLocker locker(&_mutex);
         if (_isProcessing) {
             _isProcessing = false;
+            AudioRenderGraph::instance().removeProcessor(this);
             QObject::disconnect(TimestampGenerator::getInstance(),
                                 &TimestampGenerator::frameCountUpdated,
                                 this,
@@ -67,95 +56,105 @@ namespace Nodes
 
     void AudioDuckingWorker::onFrameTick(qint64 frameCount)
     {
-        if (!_isProcessing || _inputBuffers.empty() || _outputBuffers.empty()) return;
-        if (frameCount == _lastProcessedTimestamp) return;
-        
-        // We expect at least Input 0 (Music) to process. Input 1 (Sidechain) is optional (if missing, no ducking).
-        if (_inputBuffers.size() < 1) return;
-
-        std::vector<AudioFrame> inputFrames(_inputBuffers.size());
-        bool hasMusicInput = false;
-        
-        // Get Music Frame (Input 0)
-        if (_inputBuffers[0] && _inputBuffers[0]->isActive()) {
-            if (_inputBuffers[0]->getFrameByTimestamp(frameCount, inputFrames[0])) {
-                hasMusicInput = true;
-            }
+        // 已由设备回调拉取时不再自行推进
+        if (AudioRenderGraph::instance().isDriven()) return;
+        QMutexLocker locker(&_mutex);
+        if (!_isProcessing || frameCount == _lastProcessedTimestamp) return;
+        if (renderFrame(frameCount, frameCount + 2)) {
+            _lastProcessedTimestamp = frameCount;
+            emit audioProcessed(_outputBuffers);
         }
-        
-        // Get Sidechain Frame (Input 1)
-        if (_inputBuffers.size() > 1 && _inputBuffers[1] && _inputBuffers[1]->isActive()) {
-            _inputBuffers[1]->getFrameByTimestamp(frameCount, inputFrames[1]);
+    }
+
+    /**
+     * 函数级注释：渲染图拉取入口（设备回调线程）
+     * - tryLock：参数设置持锁时跳过本块，不阻塞回调线程
+     * - 拉取模式下输出不叠加延迟补偿，也不发出 audioProcessed 信号
+     */
+    void AudioDuckingWorker::renderBlock(qint64 timestamp)
+    {
+        if (!_mutex.tryLock()) return;
+        if (_isProcessing && timestamp != _lastProcessedTimestamp && renderFrame(timestamp, timestamp)) {
+            _lastProcessedTimestamp = timestamp;
         }
-        
-        if (!hasMusicInput) return;
+        _mutex.unlock();
+    }
 
-        performDuckingOperation(inputFrames, frameCount);
-        _lastProcessedTimestamp = frameCount;
-        emit audioProcessed(_outputBuffers);
+    void AudioDuckingWorker::registerRenderProcessor()
+    {
+        std::vector<const AudioTimestampRingQueue*> inputs;
+        std::vector<const AudioTimestampRingQueue*> outputs;
+        for (const auto& buffer : _inputBuffers) inputs.push_back(buffer.get());
+        for (const auto& buffer : _outputBuffers) outputs.push_back(buffer.get());
+        AudioRenderGraph::instance().updateProcessor(this, inputs, outputs);
     }
-    
-    void AudioDuckingWorker::performDuckingOperation(const std::vector<AudioFrame>& inputFrames, qint64 timestamp)
+
+    /**
+     * 函数级注释：读取输入并闪避（自行推进与渲染图拉取共用，可在设备回调线程中执行）
+     * - 输入通过私有游标 acquireFrameView 读取，不复制 QByteArray
+     * - 输出经 beginWriteFrame/commitWriteFrame 直接写入无锁队列槽位，不构造中间帧、不分配内存
+     */
+    bool AudioDuckingWorker::renderFrame(qint64 frameCount, qint64 outputTimestamp)
     {
-        if (inputFrames.empty() || inputFrames[0].data.isEmpty()) return;
+        if (_inputBuffers.empty() || _inputViews.size() < _inputBuffers.size() ||
+            _outputBuffers.empty() || !_outputBuffers[0]) return false;
 
-        const AudioFrame& musicFrame = inputFrames[0];
-        const float* musicData = reinterpret_cast<const float*>(musicFrame.data.constData());
-        size_t sampleCount = musicFrame.data.size() / sizeof(float);
-        
-        std::vector<float> sidechainData;
-        bool hasSidechain = false;
+        // Input 0（音乐）必需；Input 1（侧链）可选，缺失时不闪避
+        AudioFrameView& music = _inputViews[0];
+        music = AudioFrameView();
+        if (!_inputBuffers[0] || !_inputBuffers[0]->isActive() ||
+            !_inputBuffers[0]->acquireFrameView(*_inputCursors[0], frameCount, music) || music.sampleCount <= 0) {
+            return false;
+        }
 
-        // Check sidechain input
-        if (inputFrames.size() > 1 && !inputFrames[1].data.isEmpty()) {
-            const AudioFrame& sidechainFrame = inputFrames[1];
-            size_t scSamples = sidechainFrame.data.size() / sizeof(float);
-            // Only process if we have data
-            if (scSamples > 0) {
-                const float* scRaw = reinterpret_cast<const float*>(sidechainFrame.data.constData());
-                sidechainData.assign(scRaw, scRaw + scSamples);
-                
-                // Pad or trim to match music frame size if necessary
-                // Use cyclic padding to maintain RMS level if data is smaller than frame size
-                if (sidechainData.size() < (size_t)_frameSize) {
-                    size_t originalSize = sidechainData.size();
-                    sidechainData.resize(_frameSize);
-                    for (size_t i = originalSize; i < (size_t)_frameSize; ++i) {
-                        sidechainData[i] = sidechainData[i % originalSize];
-                    }
-                } else if (sidechainData.size() > (size_t)_frameSize) {
-                    sidechainData.resize(_frameSize);
-                }
-                hasSidechain = true;
+        const AudioFrameView* sidechain = nullptr;
+        if (_inputBuffers.size() > 1) {
+            _inputViews[1] = AudioFrameView();
+            if (_inputBuffers[1] && _inputBuffers[1]->isActive() &&
+                _inputBuffers[1]->acquireFrameView(*_inputCursors[1], frameCount, _inputViews[1]) &&
+                _inputViews[1].sampleCount > 0) {
+                sidechain = &_inputViews[1];
             }
         }
 
-        float gainReduction = 1.0f;
-        
-        if (hasSidechain) {
-            // Apply Sidechain Gain before analysis
-            if (_sidechainGain > 0.001f) {
-                float scGainLinear = std::pow(10.0f, _sidechainGain / 20.0f);
-                for (float& s : sidechainData) {
-                    s *= scGainLinear;
-                }
+        const float finalGain = updateGain(sidechain, music.sampleCount);
+
+        int sampleCount = music.sampleCount;
+        float* outputData = _outputBuffers[0]->beginWriteFrame(sampleCount);
+        if (outputData) {
+            for (int i = 0; i < sampleCount; ++i) {
+                outputData[i] = music.data[i] * finalGain;
             }
+            _outputBuffers[0]->commitWriteFrame(outputTimestamp, music.sampleRate, music.channels);
+        }
+
+        _inputBuffers[0]->verifyFrameView(*_inputCursors[0], music);
+        if (sidechain) {
+            _inputBuffers[1]->verifyFrameView(*_inputCursors[1], *sidechain);
+        }
+        return outputData != nullptr;
+    }
+
+    float AudioDuckingWorker::updateGain(const AudioFrameView* sidechain, int sampleCount)
+    {
+        float gainReduction = 1.0f;
 
-            // Calculate RMS manually to avoid Gist windowing attenuation
+        if (sidechain) {
+            // 侧链 RMS 按 _frameSize 个采样计算：不足时循环补齐以保持电平，超出时截断
+            const int scSamples = sidechain->sampleCount;
+            const int length = _frameSize > 0 ? _frameSize : scSamples;
             double sumSq = 0.0;
-            for (float s : sidechainData) {
+            for (int i = 0; i < length; ++i) {
+                const float s = sidechain->data[i % scSamples];
                 sumSq += s * s;
             }
-            float rms = 0.0f;
-            if (!sidechainData.empty()) {
-                rms = std::sqrt((float)(sumSq / sidechainData.size()));
-            }
+            float rms = std::sqrt((float)(sumSq / length));
 
-            // Keep Gist analysis call to satisfy requirement (maybe used for other features later)
-            if (_gistAnalyzer) {
-                _gistAnalyzer->processAudioFrame(sidechainData);
+            // Apply Sidechain Gain before level detection
+            if (_sidechainGain > 0.001f) {
+                rms *= std::pow(10.0f, _sidechainGain / 20.0f);
             }
-            
+
             // Convert RMS to dB
             float rmsDb = (rms > 0.000001f) ? 20.0f * std::log10(rms) : -100.0f;
             
@@ -168,25 +167,8 @@ namespace Nodes
             }
         }
         
-        // Apply envelope (Attack/Release) - simplified block processing
-        // Ideally we do this sample by sample, but frame-based is okay for simple ducking 
-        // if frame rate is high enough (approx 21ms at 48k/1024, or 42ms at 2048).
-        // 42ms might be too slow for fast attack. 
-        // But since we are using Gist which is frame-based, we are limited to frame granularity unless we do sample-based RMS.
-        // Given the prompt "use gist analysis", I will stick to frame-based RMS from Gist.
-        
-        // Smooth the gain
+        // 包络按块推进：每块一个侧链电平，目标增益应用于整块，并从上一块的增益平滑过渡
         float targetGain = gainReduction;
-        // Simple smoothing: alpha filter
-        // We can't do proper attack/release per sample with just one RMS value per frame.
-        // We will apply the target gain to the whole frame, but smoothed from previous frame's gain.
-        
-        // Prepare output
-        AudioFrame outputFrame = musicFrame;
-        outputFrame.timestamp = timestamp + 2; // Latency compensation
-        outputFrame.data.resize(sampleCount * sizeof(float));
-        float* outputData = reinterpret_cast<float*>(outputFrame.data.data());
-        
         float currentGain = _envelope;
         
         // Time constants
@@ -222,15 +204,7 @@ namespace Nodes
         
         // Apply makeup gain
         float makeupLinear = std::pow(10.0f, _makeupGain / 20.0f);
-        float finalGain = _envelope * makeupLinear;
-        
-        for (size_t i = 0; i < sampleCount; ++i) {
-            outputData[i] = musicData[i] * finalGain;
-        }
-        
-        if (!_outputBuffers.empty() && _outputBuffers[0]) {
-            _outputBuffers[0]->pushFrame(outputFrame);
-        }
+        return _envelope * makeupLinear;
     }
 
     void AudioDuckingWorker::initializeBuffers(int inputCount, int outputCount)
@@ -239,14 +213,20 @@ namespace Nodes
         
         _inputBuffers.clear();
         _inputBuffers.resize(inputCount);
+        _inputCursors.clear();
+        _inputCursors.resize(inputCount);
         for (int i = 0; i < inputCount; ++i) {
             _inputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+            _inputCursors[i] = AudioTimestampRingQueue::createCursor();
         }
+        // 预分配每块的输入视图，运行期不再分配
+        _inputViews.assign(static_cast<size_t>(inputCount), AudioFrameView());
         
+        // 输出由本 worker 单独写入（自行推进或渲染图拉取，二者由 _mutex 互斥），使用无锁队列
         _outputBuffers.clear();
         _outputBuffers.resize(outputCount);
         for (int i = 0; i < outputCount; ++i) {
-            _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+            _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
         }
     }
 
@@ -255,6 +235,9 @@ namespace Nodes
         QMutexLocker locker(&_mutex);
         if (port >= 0 && port < (int)_inputBuffers.size()) {
             _inputBuffers[port] = buffer;
+            // 每个输入源使用新的私有游标，避免沿用旧源的顺序访问缓存
+            _inputCursors[port] = AudioTimestampRingQueue::createCursor();
+            if (_isProcessing) registerRenderProcessor();
         }
     }
 
@@ -6,8 +6,8 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include "Common/DataTypes/AudioTimestampRingQueue.h"
+#include "Common/DataTypes/AudioRenderGraph.h"
 #include "TimeCodeDefines.h"
-#include "Gist.h"
 #include <memory>
 
 namespace Nodes
@@ -15,7 +15,7 @@ namespace Nodes
     /**
      * @brief 音频闪避处理工作线程类
      */
-    class AudioDuckingWorker : public QObject
+    class AudioDuckingWorker : public QObject, public AudioRenderProcessor
     {
         Q_OBJECT
 
@@ -45,22 +45,42 @@ namespace Nodes
         void setInputBuffer(int port, std::shared_ptr<AudioTimestampRingQueue> buffer);
         std::shared_ptr<AudioTimestampRingQueue> getOutputBuffer(int port);
 
+    public:
+        /**
+         * @brief 渲染图拉取入口（设备回调线程）：读取 timestamp 输入帧，输出同样标记为 timestamp
+         */
+        void renderBlock(qint64 timestamp) override;
+
     signals:
         void processingStatusChanged(bool isProcessing);
         void audioProcessed(const std::vector<std::shared_ptr<AudioTimestampRingQueue>>& outputBuffers);
 
     private:
-        void performDuckingOperation(const std::vector<AudioFrame>& inputFrames, qint64 timestamp);
-        void initializeGist(int frameSize, int sampleRate);
+        /**
+         * @brief 以零拷贝视图读取 inputTimestamp 的输入帧，处理后直接写入输出队列槽位，输出标记为 outputTimestamp（调用方持有 _mutex）
+         * @return true 表示已输出
+         */
+        bool renderFrame(qint64 inputTimestamp, qint64 outputTimestamp);
+        /**
+         * @brief 由侧链电平推进包络，返回本块应用于音乐输入的增益（含补偿增益）
+         * @param sidechain 侧链视图，无侧链时为 nullptr
+         * @param sampleCount 本块采样数
+         */
+        float updateGain(const AudioFrameView* sidechain, int sampleCount);
+        /**
+         * @brief 向音频渲染图登记当前输入/输出队列
+         */
+        void registerRenderProcessor();
 
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _inputBuffers;
+        std::vector<std::shared_ptr<AudioQueueCursor>> _inputCursors;     ///< 输入缓冲区的私有读者游标
+        std::vector<AudioFrameView> _inputViews;                         ///< 本块各输入的零拷贝视图
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _outputBuffers;
         QMutex _mutex;
         bool _isProcessing;
         qint64 _lastProcessedTimestamp;
 
-        // Gist analyzer for sidechain
-        std::unique_ptr<Gist<float>> _gistAnalyzer;
+        // 侧链电平按 _frameSize 个采样计算（不足时循环补齐）
         int _frameSize = 2048;
         int _sampleRate = 48000;
 
@@ -0,0 +1,124 @@
+#include "AudioMatrixMixer.hpp"
+#include <algorithm>
+
+namespace Nodes
+{
+    /**
+     * 函数级注释：配置通道数与块大小
+     * - 预分配增益矩阵、路由表容量与平滑斜坡，之后 mixBlock() 不再分配
+     * - 新配置下当前增益与目标增益均清零
+     */
+    void AudioMatrixMixer::configure(int inputCount, int outputCount, int blockSize)
+    {
+        _inputCount = std::max(0, inputCount);
+        _outputCount = std::max(0, outputCount);
+        _blockSize = std::max(1, blockSize);
+
+        _targetGains = Eigen::MatrixXf::Zero(_inputCount, _outputCount);
+        _currentGains = Eigen::MatrixXf::Zero(_inputCount, _outputCount);
+
+        _routes.assign(static_cast<size_t>(_outputCount), std::vector<Route>());
+        for (auto& routes : _routes) {
+            routes.reserve(static_cast<size_t>(_inputCount));
+        }
+
+        _ramp.resize(_blockSize);
+        for (int i = 0; i < _blockSize; ++i) {
+            _ramp[i] = static_cast<float>(i + 1) / static_cast<float>(_blockSize);
+        }
+    }
+
+    /**
+     * 函数级注释：设置目标增益矩阵
+     * - double → float 的转换只在矩阵变化时做一次，不再每块转换
+     * - 矩阵尺寸与配置不一致时按重叠部分取值，其余视为 0
+     */
+    void AudioMatrixMixer::setGains(const Eigen::MatrixXd& matrix)
+    {
+        _targetGains.setZero();
+        const Eigen::Index rows = std::min<Eigen::Index>(matrix.rows(), _inputCount);
+        const Eigen::Index cols = std::min<Eigen::Index>(matrix.cols(), _outputCount);
+        _targetGains.topLeftCorner(rows, cols) = matrix.topLeftCorner(rows, cols).cast<float>();
+        rebuildRoutes();
+    }
+
+    /**
+     * 函数级注释：重建路由表
+     * - 仅保留 当前增益 或 目标增益 非零的输入-输出对：
+     *   目标为 0 但当前非 0 的路由需要再跑一块完成淡出
+     */
+    void AudioMatrixMixer::rebuildRoutes()
+    {
+        for (int out = 0; out < _outputCount; ++out) {
+            auto& routes = _routes[out];
+            routes.clear();
+            for (int in = 0; in < _inputCount; ++in) {
+                const float current = _currentGains(in, out);
+                const float target = _targetGains(in, out);
+                if (current != 0.0f || target != 0.0f) {
+                    routes.push_back(Route{in, current, target});
+                }
+            }
+        }
+    }
+
+    /**
+     * 函数级注释：混音一个块
+     * - out = Σ gain(i) * in(i)，仅遍历该输出的路由表
+     * - 增益未变化时为标量乘加；变化时乘以块内线性斜坡 current + (target-current)*ramp
+     * - 输入不足 blockSize 时只混入已有部分，其余保持 0
+     * - 最后统一削波到 [-1, 1]
+     * - 淡出完成（目标为 0）的路由在块末原地移除，不分配内存
+     */
+    void AudioMatrixMixer::mixBlock(const float* const* inputs, const int* inputSampleCounts, float* const* outputs)
+    {
+        for (int out = 0; out < _outputCount; ++out) {
+            auto& routes = _routes[out];
+            float* dst = outputs[out];
+            bool hasFinishedFade = false;
+
+            if (dst) {
+                Eigen::Map<Eigen::ArrayXf> mix(dst, _blockSize);
+                mix.setZero();
+
+                for (const Route& route : routes) {
+                    const float* src = inputs[route.input];
+                    const int count = src ? std::min(inputSampleCounts[route.input], _blockSize) : 0;
+                    if (count <= 0) {
+                        continue;
+                    }
+                    Eigen::Map<const Eigen::ArrayXf> in(src, count);
+                    if (route.current == route.target) {
+                        mix.head(count) += in * route.target;
+                    } else {
+                        mix.head(count) += in * (route.current + (route.target - route.current) * _ramp.head(count));
+                    }
+                }
+
+                // 削波保护
+                mix = mix.max(-1.0f).min(1.0f);
+            }
+
+            // 本块结束：当前增益到达目标
+            for (Route& route : routes) {
+                route.current = route.target;
+                _currentGains(route.input, out) = route.target;
+                hasFinishedFade = hasFinishedFade || route.target == 0.0f;
+            }
+            if (hasFinishedFade) {
+                routes.erase(std::remove_if(routes.begin(), routes.end(),
+                                            [](const Route& route) { return route.target == 0.0f; }),
+                             routes.end());
+            }
+        }
+    }
+
+    int AudioMatrixMixer::activeRouteCount() const
+    {
+        int count = 0;
+        for (const auto& routes : _routes) {
+            count += static_cast<int>(routes.size());
+        }
+        return count;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include "Eigen/Core"
+
+namespace Nodes
+{
+    /**
+     * @brief 稀疏/稠密增益矩阵混音内核
+     * - 增益以 float 缓存，矩阵变化时才从 double 转换一次
+     * - 每个输出只遍历增益非零的输入（路由表），全零增益直接跳过；矩阵稠密时退化为完整遍历
+     * - 增益变化在一个块内线性平滑，避免突变产生的咔嗒声
+     * - 所有缓冲在 configure() 时预分配，mixBlock() 运行期不分配内存；
+     *   逐样本运算写成 Eigen 数组表达式，由 Eigen 生成 SSE/AVX/NEON 向量化代码
+     * - 非线程安全：由 AudioMatrixWorker 在其工作线程中独占使用
+     */
+    class AudioMatrixMixer
+    {
+    public:
+        /**
+         * @brief 配置通道数与块大小并预分配缓冲
+         * @param inputCount 输入通道数
+         * @param outputCount 输出通道数
+         * @param blockSize 每块采样数
+         */
+        void configure(int inputCount, int outputCount, int blockSize);
+
+        /**
+         * @brief 设置目标增益矩阵（行 = 输入，列 = 输出）
+         * 当前增益保持不变，下一块内平滑过渡到目标增益
+         */
+        void setGains(const Eigen::MatrixXd& matrix);
+
+        /**
+         * @brief 混音一个块
+         * @param inputs 各输入通道采样指针，nullptr 表示该输入本块无数据
+         * @param inputSampleCounts 各输入通道可用采样数
+         * @param outputs 各输出通道写入目标（长度至少 blockSize），nullptr 表示跳过该输出
+         */
+        void mixBlock(const float* const* inputs, const int* inputSampleCounts, float* const* outputs);
+
+        int inputCount() const { return _inputCount; }
+        int outputCount() const { return _outputCount; }
+        int blockSize() const { return _blockSize; }
+
+        /**
+         * @brief 当前参与运算的输入-输出对数量（稀疏度指标）
+         */
+        int activeRouteCount() const;
+
+    private:
+        /**
+         * @brief 单条路由：一个输入到一个输出的增益
+         */
+        struct Route {
+            int input;
+            float current;  // 上一块结束时的增益
+            float target;   // 目标增益
+        };
+
+        void rebuildRoutes();
+
+        int _inputCount = 0;
+        int _outputCount = 0;
+        int _blockSize = 0;
+        Eigen::MatrixXf _targetGains;              ///< 目标增益（float 缓存）
+        Eigen::MatrixXf _currentGains;             ///< 当前增益
+        std::vector<std::vector<Route>> _routes;   ///< 每个输出的非零路由表
+        Eigen::ArrayXf _ramp;                      ///< 块内平滑斜坡 (i+1)/blockSize
+    };
+}
@@ -1,6 +1,7 @@
 #include "AudioMatrixWorker.hpp"
 #include "TimestampGenerator/TimestampGenerator.hpp"
 #include <QDebug>
+#include <algorithm>
 
 namespace Nodes
 {
@@ -36,6 +37,7 @@ namespace Nodes
         }
         _isProcessing = true;
         _lastProcessedTimestamp = 0;
+        registerRenderProcessor();
         QObject::connect(TimestampGenerator::getInstance(),
                          &TimestampGenerator::frameCountUpdated,
                          this,
@@ -53,6 +55,7 @@ namespace Nodes
         
         if (_isProcessing) {
             _isProcessing = false;
+            AudioRenderGraph::instance().removeProcessor(this);
 
             QObject::disconnect(TimestampGenerator::getInstance(),
                                 &TimestampGenerator::frameCountUpdated,
@@ -71,6 +74,8 @@ namespace Nodes
     {
         QMutexLocker locker(&_mutex);
         _matrix = matrix;
+        // 增益在下一块内平滑过渡到新矩阵
+        _mixer.setGains(_matrix);
     }
     
     /**
@@ -78,6 +83,11 @@ namespace Nodes
      */
     void AudioMatrixWorker::processAudioData()
     {
+        // 已由设备回调拉取时不再自行推进
+        if (AudioRenderGraph::instance().isDriven()) {
+            return;
+        }
+        QMutexLocker locker(&_mutex);
         if (!_isProcessing || _inputBuffers.empty() || _outputBuffers.empty()) {
             return;
         }
@@ -88,24 +98,9 @@ namespace Nodes
             return;
         }
         
-        // 收集所有输入通道的音频帧
-        std::vector<AudioFrame> inputFrames(_inputBuffers.size());
-        bool hasValidInput = false;
-
-        for (size_t i = 0; i < _inputBuffers.size(); ++i) {
-            if (_inputBuffers[i] && _inputBuffers[i]->isActive()) {
-                if (_inputBuffers[i]->getFrameByTimestamp(currentTime, inputFrames[i])) {
-                    hasValidInput = true;
-                }
-            }
-        }
-
-        if (!hasValidInput) {
+        if (!mixFrame(currentTime, currentTime + 2)) {
             return;
         }
-
-        // 执行矩阵运算
-        performMatrixOperation(inputFrames, currentTime);
         
         _lastProcessedTimestamp = currentTime;
         
@@ -119,31 +114,102 @@ namespace Nodes
      */
     void AudioMatrixWorker::onFrameTick(qint64 frameCount)
     {
+        // 已由设备回调拉取时不再自行推进
+        if (AudioRenderGraph::instance().isDriven()) {
+            return;
+        }
+        QMutexLocker locker(&_mutex);
         if (!_isProcessing || _inputBuffers.empty() || _outputBuffers.empty()) {
             return;
         }
         if (frameCount == _lastProcessedTimestamp) {
             return;
         }
-        std::vector<AudioFrame> inputFrames(_inputBuffers.size());
+        if (!mixFrame(frameCount, frameCount + 2)) {
+            return;
+        }
+        _lastProcessedTimestamp = frameCount;
+        emit audioProcessed(_outputBuffers);
+    }
+    
+    /**
+     * 函数级注释：渲染图拉取入口（设备回调线程）
+     * - tryLock：参数更新或端口重连持锁时跳过本块，不阻塞回调线程
+     * - 不发出 audioProcessed 信号，避免在实时线程中分配队列事件
+     */
+    void AudioMatrixWorker::renderBlock(qint64 timestamp)
+    {
+        if (!_mutex.tryLock()) {
+            return;
+        }
+        if (_isProcessing && timestamp != _lastProcessedTimestamp && mixFrame(timestamp, timestamp)) {
+            _lastProcessedTimestamp = timestamp;
+        }
+        _mutex.unlock();
+    }
+
+    /**
+     * 函数级注释：向音频渲染图登记输入/输出队列，渲染图据此确定与上下游处理器的先后顺序
+     */
+    void AudioMatrixWorker::registerRenderProcessor()
+    {
+        std::vector<const AudioTimestampRingQueue*> inputs;
+        std::vector<const AudioTimestampRingQueue*> outputs;
+        for (const auto& buffer : _inputBuffers) {
+            inputs.push_back(buffer.get());
+        }
+        for (const auto& buffer : _outputBuffers) {
+            outputs.push_back(buffer.get());
+        }
+        AudioRenderGraph::instance().updateProcessor(this, inputs, outputs);
+    }
+
+    /**
+     * 函数级注释：以零拷贝视图读取输入并混音
+     * - 各输入通过私有游标 acquireFrameView，不复制 QByteArray
+     * - 混音完成后校验视图，读取期间被生产者改写的输入计入该游标的 lateFrames
+     * @param inputTimestamp 读取输入的时间戳
+     * @param outputTimestamp 输出帧时间戳（自行推进时为 input + 2 的延迟补偿，拉取模式下与输入相同）
+     * @return true 表示至少有一个输入命中
+     */
+    bool AudioMatrixWorker::mixFrame(qint64 inputTimestamp, qint64 outputTimestamp)
+    {
+        const size_t inputCount = std::min(_inputBuffers.size(), _inputViews.size());
         bool hasValidInput = false;
-        for (size_t i = 0; i < _inputBuffers.size(); ++i) {
-            if (_inputBuffers[i] && _inputBuffers[i]->isActive()) {
-                if (_inputBuffers[i]->getFrameByTimestamp(frameCount, inputFrames[i])) {
-                    hasValidInput = true;
+        int sampleRate = 0;
+
+        for (size_t i = 0; i < inputCount; ++i) {
+            _inputViews[i] = AudioFrameView();
+            _inputPtrs[i] = nullptr;
+            _inputCounts[i] = 0;
+            if (_inputBuffers[i] && _inputBuffers[i]->isActive() &&
+                _inputBuffers[i]->acquireFrameView(*_inputCursors[i], inputTimestamp, _inputViews[i])) {
+                _inputPtrs[i] = _inputViews[i].data;
+                _inputCounts[i] = _inputViews[i].sampleCount;
+                if (sampleRate == 0) {
+                    sampleRate = _inputViews[i].sampleRate;
                 }
+                hasValidInput = true;
             }
         }
+
         if (!hasValidInput) {
-            return;
+            return false;
         }
-        performMatrixOperation(inputFrames, frameCount);
-        _lastProcessedTimestamp = frameCount;
-        emit audioProcessed(_outputBuffers);
+
+        mixToOutputs(outputTimestamp, sampleRate);
+
+        for (size_t i = 0; i < inputCount; ++i) {
+            if (_inputPtrs[i]) {
+                _inputBuffers[i]->verifyFrameView(*_inputCursors[i], _inputViews[i]);
+            }
+        }
+        return true;
     }
-    
+
     /**
-     * @brief 使用矩阵运算执行音频矩阵操作
+     * 函数级注释：对已取出的输入帧执行矩阵混音
+     * - 兼容接口：输入为完整 AudioFrame，混音与输出路径与 mixFrame 相同
      * @param inputFrames 输入音频帧向量
      * @param timestamp 时间戳
      */
@@ -153,69 +219,73 @@ namespace Nodes
             return;
         }
 
-        const size_t frameSize = 2048 * 4 / sizeof(float);
-        const int inputChannels = _matrix.rows();
-        const int outputChannels = _matrix.cols();
-        
-        // 创建输入矩阵：inputChannels × frameSize
-        Eigen::MatrixXf inputMatrix(inputChannels, frameSize);
-        
-        // 填充输入矩阵数据
-        for (int inChannel = 0; inChannel < inputChannels; ++inChannel) {
-            if (inChannel < static_cast<int>(inputFrames.size())) {
-                const auto& frameData = inputFrames[inChannel].data;
-                const float* audioSamples = reinterpret_cast<const float*>(frameData.constData());
-                const size_t availableSamples = frameData.size() / sizeof(float);
-                const size_t samplesToCopy = std::min(frameSize, availableSamples);
-                
-                // 直接填充到矩阵中
-                for (size_t sample = 0; sample < samplesToCopy; ++sample) {
-                    inputMatrix(inChannel, sample) = audioSamples[sample];
-                }
-                
-                // 如果数据不足，填充零
-                for (size_t sample = samplesToCopy; sample < frameSize; ++sample) {
-                    inputMatrix(inChannel, sample) = 0.0f;
-                }
-            } else {
-                // 通道不存在，填充零
-                inputMatrix.row(inChannel).setZero();
+        const size_t inputCount = std::min(inputFrames.size(), _inputPtrs.size());
+        for (size_t i = 0; i < _inputPtrs.size(); ++i) {
+            _inputPtrs[i] = nullptr;
+            _inputCounts[i] = 0;
+        }
+        for (size_t i = 0; i < inputCount; ++i) {
+            const auto& frameData = inputFrames[i].data;
+            if (!frameData.isEmpty()) {
+                _inputPtrs[i] = reinterpret_cast<const float*>(frameData.constData());
+                _inputCounts[i] = static_cast<int>(frameData.size() / static_cast<int>(sizeof(float)));
             }
         }
-        
-        // 执行矩阵乘法：outputMatrix = _matrix^T × inputMatrix
-        // 结果矩阵维度：outputChannels × frameSize
-        Eigen::MatrixXf outputMatrix = _matrix.transpose().cast<float>() * inputMatrix;
-        
-        // 提取每个输出通道的数据并创建音频帧
-        for (int outChannel = 0; outChannel < outputChannels; ++outChannel) {
-            if (outChannel < static_cast<int>(_outputBuffers.size()) && _outputBuffers[outChannel]) {
-                AudioFrame outputFrame;
-                outputFrame.timestamp = timestamp + 2;
-                outputFrame.sampleRate = inputFrames[0].sampleRate;
-                outputFrame.channels = 1;
-                outputFrame.bitsPerSample = 32;
-                
-                // 分配输出数据内存
-                outputFrame.data.resize(frameSize * sizeof(float));
-                float* outputData = reinterpret_cast<float*>(outputFrame.data.data());
-                
-                // 从输出矩阵提取当前通道的数据
-                for (size_t sample = 0; sample < frameSize; ++sample) {
-                    float outputSample = outputMatrix(outChannel, sample);
-                    
-                    // 应用幅度限制（削波保护）
-                    if (outputSample > 1.0f) outputSample = 1.0f;
-                    else if (outputSample < -1.0f) outputSample = -1.0f;
-                    
-                    outputData[sample] = outputSample;
-                }
-                
-                // 将处理后的音频帧添加到输出缓冲区
-                _outputBuffers[outChannel]->pushFrame(outputFrame);
+
+        mixToOutputs(timestamp + 2, inputFrames[0].sampleRate);
+    }
+
+    /**
+     * 函数级注释：混音并写入输出缓冲区
+     * - 输出队列为 LockFreeSpsc 时通过 beginWriteFrame/commitWriteFrame 直接在槽位内混音，无中间帧、无拷贝
+     * - 否则混到预分配的备用缓冲后 pushFrame
+     * @param outputTimestamp 输出帧时间戳
+     * @param sampleRate 输出采样率
+     */
+    void AudioMatrixWorker::mixToOutputs(qint64 outputTimestamp, int sampleRate)
+    {
+        const int blockSize = _mixer.blockSize();
+        const int outputCount = std::min(_mixer.outputCount(), static_cast<int>(_outputBuffers.size()));
+        if (sampleRate <= 0) {
+            sampleRate = TimestampGenerator::getInstance()->getSampleRate();
+        }
+
+        for (int out = 0; out < _mixer.outputCount(); ++out) {
+            _outputPtrs[out] = nullptr;
+            if (out >= outputCount || !_outputBuffers[out]) {
+                continue;
+            }
+            int writable = blockSize;
+            float* slot = _outputBuffers[out]->beginWriteFrame(writable);
+            if (slot && writable < blockSize) {
+                // 槽位容量不足一个块：放弃直写，改用备用缓冲
+                _outputBuffers[out]->commitWriteFrame(0, sampleRate, 1);
+                slot = nullptr;
             }
+            _outputPtrs[out] = slot ? slot : _fallbackOutputs[out].data();
+        }
+
+        _mixer.mixBlock(_inputPtrs.data(), _inputCounts.data(), _outputPtrs.data());
+
+        for (int out = 0; out < outputCount; ++out) {
+            if (!_outputBuffers[out]) {
+                continue;
+            }
+            if (_outputPtrs[out] != _fallbackOutputs[out].data()) {
+                _outputBuffers[out]->commitWriteFrame(outputTimestamp, sampleRate, 1);
+                continue;
+            }
+            AudioFrame outputFrame;
+            outputFrame.timestamp = outputTimestamp;
+            outputFrame.sampleRate = sampleRate;
+            outputFrame.channels = 1;
+            outputFrame.bitsPerSample = 32;
+            outputFrame.data = QByteArray(reinterpret_cast<const char*>(_fallbackOutputs[out].data()),
+                                          blockSize * static_cast<int>(sizeof(float)));
+            _outputBuffers[out]->pushFrame(outputFrame);
         }
     }
+
     /**
  * @brief 初始化缓冲区
  * @param inputCount 输入端口数量
@@ -232,20 +302,33 @@ void AudioMatrixWorker::initializeBuffers(int inputCount, int outputCount, const
     // 初始化输入缓冲区
     _inputBuffers.clear();
     _inputBuffers.resize(inputCount);
+    _inputCursors.clear();
+    _inputCursors.resize(inputCount);
     for (int i = 0; i < inputCount; ++i) {
         _inputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+        _inputCursors[i] = AudioTimestampRingQueue::createCursor();
     }
     
-    // 初始化输出缓冲区
+    // 初始化输出缓冲区：本 worker 为唯一写者，下游多个消费者通过各自游标无锁读取
     _outputBuffers.clear();
     _outputBuffers.resize(outputCount);
     for (int i = 0; i < outputCount; ++i) {
-        _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>();
+        _outputBuffers[i] = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
     }
     
     // 设置矩阵
     _matrix = matrix;
 
+    // 预分配混音内核与每块工作缓冲，运行期不再分配
+    const int blockSize = TimestampGenerator::getInstance()->getBlockSize();
+    _mixer.configure(inputCount, outputCount, blockSize);
+    _mixer.setGains(_matrix);
+    _inputViews.assign(static_cast<size_t>(inputCount), AudioFrameView());
+    _inputPtrs.assign(static_cast<size_t>(inputCount), nullptr);
+    _inputCounts.assign(static_cast<size_t>(inputCount), 0);
+    _outputPtrs.assign(static_cast<size_t>(outputCount), nullptr);
+    _fallbackOutputs.assign(static_cast<size_t>(outputCount), std::vector<float>(static_cast<size_t>(blockSize), 0.0f));
+
 }
 
 /**
@@ -259,6 +342,11 @@ void AudioMatrixWorker::setInputBuffer(int port, std::shared_ptr<AudioTimestampR
     
     if (port >= 0 && port < static_cast<int>(_inputBuffers.size())) {
         _inputBuffers[port] = buffer;
+        // 每个输入源使用新的私有游标，避免沿用旧源的顺序访问缓存
+        _inputCursors[port] = AudioTimestampRingQueue::createCursor();
+        if (_isProcessing) {
+            registerRenderProcessor();
+        }
 
     } else {
         qWarning() << "AudioMatrixWorker: Invalid input port index:" << port 
@@ -6,15 +6,17 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include "Common/DataTypes/AudioTimestampRingQueue.h"
+#include "Common/DataTypes/AudioRenderGraph.h"
 #include "TimeCodeDefines.h"
 #include "Eigen/Core"
+#include "AudioMatrixMixer.hpp"
 namespace Nodes
 {
     /**
      * @brief LTC解码工作线程类
      * 负责在独立线程中处理音频数据解码
      */
-    class AudioMatrixWorker : public QObject
+    class AudioMatrixWorker : public QObject, public AudioRenderProcessor
     {
         Q_OBJECT
 
@@ -58,7 +60,20 @@ namespace Nodes
          */
         void onFrameTick(qint64 frameCount);
 
+        /**
+         * @brief 对已取出的输入帧执行矩阵混音并写入输出缓冲区
+         * @param inputFrames 输入音频帧向量（按输入端口排列）
+         * @param timestamp 时间戳
+         */
         void performMatrixOperation(const std::vector<AudioFrame>& inputFrames, qint64 timestamp);
+
+    public:
+        /**
+         * @brief 渲染图拉取入口（设备回调线程）：读取 timestamp 输入帧，输出同样标记为 timestamp
+         * @param timestamp 本块全局时间戳
+         */
+        void renderBlock(qint64 timestamp) override;
+
     signals:
         /**
          * @brief 处理状态变化信号
@@ -96,9 +111,32 @@ namespace Nodes
         std::shared_ptr<AudioTimestampRingQueue> getOutputBuffer(int port);
         
     private:
+        /**
+         * @brief 以零拷贝视图读取各输入在 timestamp 的帧并混音
+         * @return true 表示至少有一个输入命中并已输出
+         */
+        bool mixFrame(qint64 inputTimestamp, qint64 outputTimestamp);
+
+        /**
+         * @brief 使用 _inputPtrs/_inputCounts 混音并直接写入各输出的环形队列槽位
+         */
+        void mixToOutputs(qint64 outputTimestamp, int sampleRate);
+
+        /**
+         * @brief 向音频渲染图登记当前输入/输出队列
+         */
+        void registerRenderProcessor();
+
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _inputBuffers;    ///< 输入音频缓冲区数组
+        std::vector<std::shared_ptr<AudioQueueCursor>> _inputCursors;          ///< 输入缓冲区的私有读者游标
         std::vector<std::shared_ptr<AudioTimestampRingQueue>> _outputBuffers;   ///< 输出音频缓冲区数组
         Eigen::MatrixXd _matrix;                                               ///< 矩阵数据
+        AudioMatrixMixer _mixer;                                               ///< 预分配的增益矩阵混音内核
+        std::vector<AudioFrameView> _inputViews;                               ///< 本块各输入的零拷贝视图
+        std::vector<const float*> _inputPtrs;                                  ///< 本块各输入采样指针
+        std::vector<int> _inputCounts;                                         ///< 本块各输入采样数
+        std::vector<float*> _outputPtrs;                                       ///< 本块各输出写入目标
+        std::vector<std::vector<float>> _fallbackOutputs;                      ///< 输出队列不支持直写时的备用缓冲
         QMutex _mutex;                                                         ///< 互斥锁
         bool _isProcessing;                                                    ///< 处理状态标志
         qint64 _lastProcessedTimestamp;                                        ///< 上次处理的时间戳
@@ -10,8 +10,8 @@ namespace Nodes
         : QObject(parent)
         , _isProcessing(false)
         , _lastProcessedTimestamp(0)
-        , _frameSize(2048)
-        , _sampleRate(48000)
+        , _frameSize(TimestampGenerator::getInstance()->getBlockSize())
+        , _sampleRate(TimestampGenerator::getInstance()->getSampleRate())
     {
         initializeGist(_frameSize, _sampleRate);
     }
@@ -103,12 +103,12 @@ void FmodDecoderWorker::initFMOD()
     // 我们只需要通过 DSP 捕获音频数据
     coreSystem_->setOutput(FMOD_OUTPUTTYPE_NOSOUND); 
 
-    // 设置软件格式为 48kHz RAW 12 声道（7.1.4），保证所有通道可被捕获
-    coreSystem_->setSoftwareFormat(48000, FMOD_SPEAKERMODE_RAW, 12);
+    // 设置软件格式为全局采样率 RAW 12 声道（7.1.4），保证所有通道可被捕获
+    coreSystem_->setSoftwareFormat(TimestampGenerator::getInstance()->getSampleRate(), FMOD_SPEAKERMODE_RAW, 12);
 
-    // 设置 DSP 缓冲区大小为 2048 采样点，缓冲数量 8
-    // 2048 对应我们的帧大小，有助于减少抖动
-    coreSystem_->setDSPBufferSize(2048, 8);
+    // 设置 DSP 缓冲区大小为全局块大小，缓冲数量 8
+    // 与我们的帧大小一致，有助于减少抖动
+    coreSystem_->setDSPBufferSize(static_cast<unsigned int>(TimestampGenerator::getInstance()->getBlockSize()), 8);
     
     // 4. 初始化 Studio System
     // 启用 Live Update 以便 FMOD Studio 可以连接并实时调试
@@ -306,7 +306,7 @@ FMOD_RESULT F_CALLBACK FmodDecoderWorker::captureDSPCallback(FMOD_DSP_STATE *dsp
         if (!self->timestampAligned_) {
             self->baseFrameCount_ = TimestampGenerator::getInstance()->getCurrentFrameCount();
             self->emittedFrameCount_ = 0;
-            self->samplesPerFrame_ = 2048; // 强制 2048
+            self->samplesPerFrame_ = TimestampGenerator::getInstance()->getBlockSize(); // 与全局块大小对齐
             self->timestampAligned_ = true;
             
             // 初始化通道缓存
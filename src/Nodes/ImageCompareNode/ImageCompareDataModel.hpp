@@ -120,18 +120,63 @@ namespace Nodes
                 break;
             }
         }
+        /**
+         * @brief 线程安全且计算密集：数据流调度器可在线程池中执行 setInData
+         */
+        ExecutionFlags executionFlags() const override
+        {
+            return ThreadSafe | ComputeHeavy;
+        }
+
+        /**
+         * @brief 计算两幅图像的差异
+         * - 已在工作线程（数据流调度器线程池）中时直接计算，结果排队回节点所在线程输出
+         * - 在主线程时仍使用 QtConcurrent 异步计算，避免阻塞界面
+         */
         void calculateImagedifference()
 {
     if (m_inImage0 && m_inImage1) {
         // 获取当前方法索引（主线程操作）
         const int methodIndex = m_method;
 
+        if (QThread::currentThread() != thread()) {
+            // 在工作线程计算，输出赋值与通知回到节点所在线程，outData() 不会与赋值并发
+            const double result = compareImages(methodIndex, m_inImage0->imgMat(), m_inImage1->imgMat());
+            QMetaObject::invokeMethod(this, [this, result]() {
+                m_outVariable = std::make_shared<VariableData>(result);
+                Q_EMIT dataUpdated(0);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
         // 深拷贝图像数据用于异步处理
         cv::Mat img0 = m_inImage0->imgMat().clone();
         cv::Mat img1 = m_inImage1->imgMat().clone();
 
         // 启动异步任务
         QFuture<double> future = QtConcurrent::run([this, methodIndex, img0, img1]() {
+            return compareImages(methodIndex, img0, img1);
+        });
+
+        // 连接完成信号
+        if (m_watcher) {
+            QObject::disconnect(m_watcher, nullptr, nullptr, nullptr);
+            m_watcher->deleteLater();
+        }
+        m_watcher = new QFutureWatcher<double>(this);
+        QObject::connect(m_watcher, &QFutureWatcher<double>::finished, this, [this]() {
+            m_outVariable = std::make_shared<VariableData>(m_watcher->result());
+            Q_EMIT dataUpdated(0);
+        });
+        m_watcher->setFuture(future);
+    }
+}
+
+    /**
+     * @brief 按方法计算差异（MSE/SSIM/PSNR），不访问成员状态，可在任意线程调用
+     */
+    double compareImages(int methodIndex, const cv::Mat& img0, const cv::Mat& img1)
+    {
             // 转换为灰度图像
             cv::Mat gray0, gray1;
             cv::cvtColor(img0, gray0, cv::COLOR_BGR2GRAY);
@@ -159,21 +204,7 @@ namespace Nodes
                 break;
             }
             return result;
-        });
-
-        // 连接完成信号
-        if (m_watcher) {
-            QObject::disconnect(m_watcher, nullptr, nullptr, nullptr);
-            m_watcher->deleteLater();
-        }
-        m_watcher = new QFutureWatcher<double>(this);
-        QObject::connect(m_watcher, &QFutureWatcher<double>::finished, this, [this]() {
-            m_outVariable = std::make_shared<VariableData>(m_watcher->result());
-            Q_EMIT dataUpdated(0);
-        });
-        m_watcher->setFuture(future);
     }
-}
 
 // 添加SSIM计算方法
     double calculateSSIM(const cv::Mat& i1, const cv::Mat& i2) {
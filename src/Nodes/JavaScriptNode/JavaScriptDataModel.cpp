@@ -17,6 +17,7 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QCheckBox>
+#include <QRegularExpression>
 #include "JavaScriptDataModel.hpp"
 
 using QtNodes::NodeData;
@@ -95,57 +96,131 @@ void JavaScriptDataModel::loadScripts(QString code) {
         return;
     }
 
-    // 如果已经有一个脚本在执行，则不启动新的执行
-    if (m_jsExecuting) {
-        return;
-    }
+    applyScript(code);
+}
 
-    try {
-        // 标记JavaScript正在执行
-        m_jsExecuting = true;
-        
-        // 使用QtConcurrent在后台线程中执行JavaScript代码
-        QFuture<QJSValue> future = QtConcurrent::run(
-            [this, code]() -> QJSValue {
-                try {
-                    // 在后台线程中执行JavaScript代码
-                    return m_jsEngine->evaluate(code);
-                } catch (const std::exception& e) {
-                    qWarning() << "JavaScript执行异常:" << e.what();
-                    // 创建一个错误对象返回
-                    QJSValue errorObj = m_jsEngine->newObject();
-                    errorObj.setProperty("isError", true);
-                    errorObj.setProperty("message", QString(e.what()));
-                    errorObj.setProperty("lineNumber", -1);
-                    return errorObj;
-                }
-            }
-        );
-        
-        // 设置watcher监视执行结果
-        m_jsWatcher.setFuture(future);
-    } catch (const std::exception& e) {
-        m_jsExecuting = false;
-        qWarning() << "JavaScript执行异常:" << e.what();
+/**
+ * @brief 加载脚本
+ * - 主线程引擎按普通程序执行一次顶层代码，随后按 typeof onInput === 'function' 判断是否定义了处理函数
+ * - 定义了 onInput：引擎线程的独立引擎加载同一脚本并缓存 onInput；否则清空引擎线程
+ */
+bool JavaScriptDataModel::applyScript(const QString& code) {
+    const bool loaded = evaluateOnMainEngine(code);
+    const bool workerMode = loaded && m_jsEngine->evaluate(QStringLiteral("typeof onInput === 'function'")).toBool();
+    if (m_jsWorker) {
+        m_jsWorker->setPortCounts(InPortCount, OutPortCount);
+        m_jsWorker->loadScript(workerMode ? code : QString());
     }
+    return loaded;
 }
 
-void JavaScriptDataModel::handleJsExecutionFinished() {
-    // 重置执行状态
-    m_jsExecuting = false;
-    
-    QJSValue result = m_jsWatcher.result();
-    
+/**
+ * @brief 创建引擎线程与工作对象，线程结束时释放工作对象
+ */
+void JavaScriptDataModel::initEngineThread() {
+    m_jsThread = new QThread();
+    m_jsThread->setObjectName("JavaScriptEngine");
+    m_jsWorker = new JavaScriptEngineWorker();
+    m_jsWorker->moveToThread(m_jsThread);
+    connect(m_jsThread, &QThread::finished, m_jsWorker, &QObject::deleteLater);
+    connect(m_jsWorker, &JavaScriptEngineWorker::outputReady,
+            this, &JavaScriptDataModel::handleWorkerOutput, Qt::QueuedConnection);
+    connect(m_jsWorker, &JavaScriptEngineWorker::mainCallRequested,
+            this, &JavaScriptDataModel::handleMainCall, Qt::QueuedConnection);
+    connect(m_jsWorker, &JavaScriptEngineWorker::statsUpdated,
+            this, &JavaScriptDataModel::handleCallStats, Qt::QueuedConnection);
+    m_jsThread->start();
+}
+
+/**
+ * @brief 在主线程引擎中加载脚本，并缓存 initInterface / inputEventHandler 句柄
+ * @param code 脚本代码
+ * @return 是否加载成功
+ */
+bool JavaScriptDataModel::evaluateOnMainEngine(const QString& code) {
+    m_initInterfaceFunc = QJSValue();
+    m_inputEventHandlerFunc = QJSValue();
+    m_mainFunctions.clear();
+
+    QJSValue result = m_jsEngine->evaluate(code);
     if (result.isError()) {
         qWarning() << "JavaScript执行错误:"
                   << result.property("lineNumber").toInt()
                   << result.toString();
+        return false;
     }
-    
+    m_initInterfaceFunc = scriptFunction("initInterface");
+    m_inputEventHandlerFunc = scriptFunction("inputEventHandler");
+    return true;
+}
+
+/**
+ * @brief 按名称取脚本中的函数
+ * 顶层 let/const/class 声明不在全局对象上，因此按标识符求值而不是读取 globalObject 属性
+ */
+QJSValue JavaScriptDataModel::scriptFunction(const QString& name) const {
+    // 名称会拼入求值代码，只接受标识符
+    static const QRegularExpression identifier(QStringLiteral("^[A-Za-z_$][A-Za-z0-9_$]*$"));
+    if (!identifier.match(name).hasMatch()) {
+        return QJSValue();
+    }
+    const QJSValue function = m_jsEngine->evaluate(
+        QStringLiteral("typeof %1 === 'function' ? %1 : undefined").arg(name));
+    return function.isCallable() ? function : QJSValue();
+}
+
+void JavaScriptDataModel::handleWorkerOutput(int portIndex, const QVariantMap& data) {
+    {
+        QMutexLocker locker(&m_dataMutex);
+        out_data[portIndex] = data;
+    }
+    emit dataUpdated(portIndex);
+}
+
+void JavaScriptDataModel::handleMainCall(const QString& functionName, const QVariantList& args) {
+    auto it = m_mainFunctions.find(functionName);
+    if (it == m_mainFunctions.end()) {
+        it = m_mainFunctions.insert(functionName, scriptFunction(functionName));
+    }
+    if (!it.value().isCallable()) {
+        qDebug() << "JavaScript中未找到函数" << functionName;
+        return;
+    }
+    QJSValueList jsArgs;
+    for (const QVariant& arg : args) {
+        jsArgs << m_jsEngine->toScriptValue(arg);
+    }
+    QJSValue result = it.value().call(jsArgs);
+    if (result.isError()) {
+        qWarning() << functionName << "执行错误:"
+                  << result.property("lineNumber").toInt()
+                  << result.toString();
+    }
+}
+
+void JavaScriptDataModel::handleCallStats(const JavaScriptCallStats& stats) {
+    widget->editButton->setToolTip(QString("编辑脚本\n"
+                                           "onInput 调用: %1（合并 %2，丢弃 %3）\n"
+                                           "最近/平均/最大耗时: %4 / %5 / %6 ms\n"
+                                           "主线程 inputEventHandler 平均/最大耗时: %7 / %8 ms")
+                                       .arg(stats.calls)
+                                       .arg(stats.coalesced)
+                                       .arg(stats.dropped)
+                                       .arg(stats.lastMs, 0, 'f', 3)
+                                       .arg(stats.averageMs, 0, 'f', 3)
+                                       .arg(stats.maxMs, 0, 'f', 3)
+                                       .arg(m_mainStats.averageMs, 0, 'f', 3)
+                                       .arg(m_mainStats.maxMs, 0, 'f', 3));
 }
 
 void JavaScriptDataModel::initJSEngine() {
-    // 创建JavaScript引擎
+    // 重新创建JavaScript引擎，旧引擎的函数句柄一并失效
+    m_initInterfaceFunc = QJSValue();
+    m_inputEventHandlerFunc = QJSValue();
+    m_mainFunctions.clear();
+    if (m_jsEngine) {
+        m_jsEngine->deleteLater();
+    }
     m_jsEngine = new QJSEngine(this);
     m_jsEngine->installExtensions(QJSEngine::AllExtensions);
     // 创建Node全局对象
@@ -163,11 +238,7 @@ void JavaScriptDataModel::initJSEngine() {
     
     // 先执行脚本，但不直接调用initInterface
     if (!script.isEmpty()) {
-        QJSValue result = m_jsEngine->evaluate(script);
-        if (result.isError()) {
-            qWarning() << "JavaScript初始化错误:"
-                      << result.property("lineNumber").toInt()
-                      << result.toString();
+        if (!applyScript(script)) {
             return;
         }
         
@@ -195,10 +266,9 @@ Q_INVOKABLE void JavaScriptDataModel::initInterface() {
         return;
     }
 
-    // 检查并执行JavaScript中的initInterface函数
-    QJSValue initInterfaceFunc = m_jsEngine->globalObject().property("initInterface");
-    if (initInterfaceFunc.isCallable()) {
-        QJSValue initResult = initInterfaceFunc.call();
+    // 执行缓存的initInterface函数
+    if (m_initInterfaceFunc.isCallable()) {
+        QJSValue initResult = m_initInterfaceFunc.call();
         if (initResult.isError()) {
             qWarning() << "initInterface执行错误:"
                       << initResult.property("lineNumber").toInt()
@@ -220,21 +290,16 @@ Q_INVOKABLE void JavaScriptDataModel::inputEventHandler(int portIndex)
         return;
     }
 
-    // 检查并执行JavaScript中的inputEventHandler函数
-    QJSValue inputEventHandlerFunc = m_jsEngine->globalObject().property("inputEventHandler");
-    if (inputEventHandlerFunc.isCallable()) {
-        // 创建参数列表并传递portIndex
-        QJSValueList args;
-        args << portIndex;
-        
-        // 调用JavaScript函数并传递参数
-        QJSValue result = inputEventHandlerFunc.call(args);
+    // 执行缓存的inputEventHandler函数
+    if (m_inputEventHandlerFunc.isCallable()) {
+        QElapsedTimer timer;
+        timer.start();
+        QJSValue result = m_inputEventHandlerFunc.call(QJSValueList() << portIndex);
+        m_mainStats.record(timer.nsecsElapsed() / 1e6);
         if (result.isError()) {
             qWarning() << "inputEventHandler执行错误:"
                       << result.property("lineNumber").toInt()
                       << result.toString();
         }
-    } else {
-        qDebug() << "JavaScript中未找到inputEventHandler函数";
     }
-}
\ No newline at end of file
+}
@@ -25,6 +25,7 @@
 #include <QMutexLocker>
 #include <QMetaObject>
 #include "Common/BaseClass/AbstractDelegateModel.h"
+#include "JavaScriptEngineWorker.h"
 using QtNodes::NodeData;
 using QtNodes::NodeDelegateModel;
 using QtNodes::PortIndex;
@@ -56,23 +57,29 @@ public:
         PortEditable = true;
         inputPortIndex = 0;
 
-        // 初始化JavaScript引擎
+        // 启动引擎线程，再初始化主线程JavaScript引擎
+        initEngineThread();
         initJSEngine();
         connect(widget->codeWidget->importJS,SIGNAL(clicked(bool)), this, SLOT(onRunButtonClicked()));
         connect(widget->codeWidget->updateUI, &QPushButton::clicked, this, [this]() {
             clearLayout();
             initInterface();
         });
-        // 连接Future完成信号到处理槽
-        connect(&m_jsWatcher, &QFutureWatcher<QJSValue>::finished, this, &JavaScriptDataModel::handleJsExecutionFinished);
     }
     
     /**
-     * @brief 析构函数
+     * @brief 析构函数，先中断引擎线程中正在执行的脚本再停止线程（工作对象随线程结束释放）
      */
     ~JavaScriptDataModel()
     {
-
+        if (m_jsThread) {
+            if (m_jsWorker) {
+                m_jsWorker->interrupt();
+            }
+            m_jsThread->quit();
+            m_jsThread->wait();
+            delete m_jsThread;
+        }
     }
     
     /**
@@ -161,7 +168,12 @@ public:
         {
             inputPortIndex = portIndex;
             in_data[portIndex] = d->getMap();
-            inputEventHandler(portIndex);
+            // 脚本定义了 onInput 时在引擎线程处理，否则在主线程调用 inputEventHandler
+            if (m_jsWorker && m_jsWorker->hasHandler()) {
+                m_jsWorker->postInput(portIndex, in_data[portIndex]);
+            } else {
+                inputEventHandler(portIndex);
+            }
         }
     }
 
@@ -217,9 +229,24 @@ private Q_SLOTS:
     }
     
     /**
-     * @brief 处理JavaScript异步执行完成
+     * @brief 接收引擎线程输出
+     * @param portIndex 输出端口索引
+     * @param data 输出数据
      */
-    void handleJsExecutionFinished();
+    void handleWorkerOutput(int portIndex, const QVariantMap& data);
+
+    /**
+     * @brief 在主线程引擎中执行引擎线程请求的全局函数
+     * @param functionName 函数名
+     * @param args 参数
+     */
+    void handleMainCall(const QString& functionName, const QVariantList& args);
+
+    /**
+     * @brief 显示调用耗时统计（编辑按钮提示）
+     * @param stats 引擎线程统计
+     */
+    void handleCallStats(const Nodes::JavaScriptCallStats& stats);
 
 
 private:
@@ -227,6 +254,28 @@ private:
      * @brief 初始化JavaScript引擎
      */
     void initJSEngine();
+
+    /**
+     * @brief 创建引擎线程与工作对象
+     */
+    void initEngineThread();
+
+    /**
+     * @brief 加载脚本：主线程引擎执行一次；定义了 onInput 函数时引擎线程同时加载
+     * @return 主线程引擎是否加载成功
+     */
+    bool applyScript(const QString& code);
+
+    /**
+     * @brief 在主线程引擎中加载脚本并缓存处理函数句柄
+     * @return 是否加载成功
+     */
+    bool evaluateOnMainEngine(const QString& code);
+
+    /**
+     * @brief 查找主线程引擎中脚本定义的函数
+     */
+    QJSValue scriptFunction(const QString& name) const;
     
     /**
      * @brief 执行JavaScript脚本
@@ -318,11 +367,15 @@ private:
     QMap<unsigned int, QVariantMap> out_data; // 输出数据存储
     JavaScriptInterface *widget;             // 界面控件
     unsigned inputPortIndex;                 // 当前输入端口索引
-    QJSEngine *m_jsEngine;                    // JavaScript引擎
+    QJSEngine *m_jsEngine = nullptr;          // 主线程JavaScript引擎（界面）
+    QJSValue m_initInterfaceFunc;             // 缓存的 initInterface 句柄
+    QJSValue m_inputEventHandlerFunc;         // 缓存的 inputEventHandler 句柄
+    QHash<QString, QJSValue> m_mainFunctions; // 缓存的 Node.callMain 目标函数
+    JavaScriptCallStats m_mainStats;          // 主线程 inputEventHandler 耗时统计
+    QThread *m_jsThread = nullptr;            // 引擎线程
+    JavaScriptEngineWorker *m_jsWorker = nullptr; // 引擎线程工作对象（onInput）
     QMap<int, QWidget*> m_widgets;           // 存储创建的控件
     int m_widgetCounter = 0;                 // 控件ID计数器
-    QFutureWatcher<QJSValue> m_jsWatcher;    // JavaScript执行Future监视器
-    bool m_jsExecuting = false;              // JavaScript是否正在执行
     QString script=R"(
 var slider1;
 function initInterface() {
@@ -333,6 +386,8 @@ function inputEventHandler(index){
     console.log(index)
     console.log(Node.getInputValue(index)["default"])
 }
+// 定义 onInput(index, data) 时改为在引擎线程中处理输入（不可直接操作控件，可用 Node.callMain 调用主线程函数）
+// 此时顶层代码只在引擎线程执行，主线程只使用函数声明（initInterface 与 callMain 目标）
 )";
  QMutex m_dataMutex;  // 添加互斥锁保护数据访问
 };
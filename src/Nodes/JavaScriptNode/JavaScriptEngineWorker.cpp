@@ -0,0 +1,194 @@
+//
+// Created by WuBin on 2025/9/8.
+//
+
+#include "JavaScriptEngineWorker.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include "JSEngineDefines/JSEngineDefines.hpp"
+
+using namespace Nodes;
+
+JavaScriptEngineWorker::JavaScriptEngineWorker(QObject* parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<Nodes::JavaScriptCallStats>("Nodes::JavaScriptCallStats");
+}
+
+void JavaScriptEngineWorker::loadScript(const QString& script) {
+    QMetaObject::invokeMethod(this, "evaluateScript", Qt::QueuedConnection, Q_ARG(QString, script));
+}
+
+/**
+ * 函数级注释：投递输入
+ * - 同一端口尚未处理时只替换数据；新端口超过 MaxQueuedPorts 时丢弃最旧的端口
+ * - 队列由空变为非空时才排队一次 processInputs
+ */
+void JavaScriptEngineWorker::postInput(int portIndex, const QVariantMap& data) {
+    QMutexLocker locker(&m_queueMutex);
+    if (m_pending.contains(portIndex)) {
+        QMutexLocker statsLocker(&m_statsMutex);
+        ++m_stats.coalesced;
+    } else {
+        if (m_order.size() >= MaxQueuedPorts) {
+            m_pending.remove(m_order.takeFirst());
+            QMutexLocker statsLocker(&m_statsMutex);
+            ++m_stats.dropped;
+        }
+        m_order.append(portIndex);
+    }
+    m_pending.insert(portIndex, data);
+    if (!m_drainScheduled) {
+        m_drainScheduled = true;
+        QMetaObject::invokeMethod(this, "processInputs", Qt::QueuedConnection);
+    }
+}
+
+void JavaScriptEngineWorker::setPortCounts(int inputCount, int outputCount) {
+    m_inputCount = inputCount;
+    m_outputCount = outputCount;
+}
+
+/**
+ * 函数级注释：QJSEngine::setInterrupted 可在其他线程调用，正在执行的脚本会抛出错误返回
+ */
+void JavaScriptEngineWorker::interrupt() {
+    m_interrupted = true;
+    QMutexLocker locker(&m_engineMutex);
+    if (m_engine) {
+        m_engine->setInterrupted(true);
+    }
+}
+
+JavaScriptCallStats JavaScriptEngineWorker::getStats() const {
+    QMutexLocker locker(&m_statsMutex);
+    return m_stats;
+}
+
+/**
+ * 函数级注释：在引擎线程中加载脚本
+ * - 每次加载重建引擎，旧脚本定义的函数不会残留
+ * - 加载后缓存 onInput 句柄
+ */
+void JavaScriptEngineWorker::evaluateScript(const QString& script) {
+    m_onInput = QJSValue();
+    m_hasHandler = false;
+    {
+        QMutexLocker locker(&m_engineMutex);
+        delete m_engine;
+        m_engine = nullptr;
+        if (script.isEmpty() || m_interrupted) {
+            return;
+        }
+        m_engine = new QJSEngine(this);
+    }
+    m_engine->installExtensions(QJSEngine::ConsoleExtension | QJSEngine::GarbageCollectionExtension);
+    QJSEngine::setObjectOwnership(this, QJSEngine::CppOwnership);
+    m_engine->globalObject().setProperty("Node", m_engine->newQObject(this));
+
+    const QJSValue result = m_engine->evaluate(script);
+    if (result.isError()) {
+        const QString message = QString("line %1: %2")
+                                    .arg(result.property("lineNumber").toInt())
+                                    .arg(result.toString());
+        qWarning() << "JavaScript引擎线程加载错误:" << message;
+        emit scriptError(message);
+        return;
+    }
+    // 顶层 let/const 声明不在全局对象上，按标识符求值取处理函数
+    const QJSValue onInput = m_engine->evaluate(QStringLiteral("typeof onInput === 'function' ? onInput : undefined"));
+    if (onInput.isCallable()) {
+        m_onInput = onInput;
+        m_hasHandler = true;
+    }
+}
+
+/**
+ * 函数级注释：取出当前队列中的全部输入，依次调用缓存的 onInput 句柄
+ */
+void JavaScriptEngineWorker::processInputs() {
+    QList<int> order;
+    QHash<int, QVariantMap> pending;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        order.swap(m_order);
+        pending.swap(m_pending);
+        m_drainScheduled = false;
+    }
+    for (int portIndex : order) {
+        m_inputs.insert(portIndex, pending.value(portIndex));
+    }
+    if (!m_onInput.isCallable()) {
+        return;
+    }
+    for (int portIndex : order) {
+        if (m_interrupted) {
+            return;
+        }
+        m_inputIndex = portIndex;
+        QElapsedTimer timer;
+        timer.start();
+        const QJSValue result = m_onInput.call(
+            {QJSValue(portIndex), JSEngineDefines::variantMapToJSValue(m_engine, m_inputs.value(portIndex))});
+        recordCall(timer.nsecsElapsed());
+        if (result.isError()) {
+            qWarning() << "onInput执行错误:"
+                       << result.property("lineNumber").toInt()
+                       << result.toString();
+        }
+    }
+}
+
+void JavaScriptEngineWorker::recordCall(qint64 nsecs) {
+    JavaScriptCallStats snapshot;
+    bool notify = false;
+    {
+        QMutexLocker locker(&m_statsMutex);
+        m_stats.record(nsecs / 1e6);
+        if (!m_statsClock.isValid() || m_statsClock.elapsed() >= StatsIntervalMs) {
+            m_statsClock.start();
+            snapshot = m_stats;
+            notify = true;
+        }
+    }
+    if (notify) {
+        emit statsUpdated(snapshot);
+    }
+}
+
+QJSValue JavaScriptEngineWorker::getInputValue(int portIndex) {
+    if (portIndex >= 0 && portIndex < m_inputCount.load() && m_inputs.contains(portIndex)) {
+        return JSEngineDefines::variantMapToJSValue(m_engine, m_inputs.value(portIndex));
+    }
+    return m_engine->newObject();
+}
+
+void JavaScriptEngineWorker::setOutputValue(int portIndex, const QJSValue& value) {
+    if (portIndex >= 0 && portIndex < m_outputCount.load()) {
+        // 在引擎线程完成转换，主线程只接收 QVariantMap
+        emit outputReady(portIndex, JSEngineDefines::jsValueToVariantMap(value));
+    }
+}
+
+unsigned int JavaScriptEngineWorker::getInputCount() {
+    return unsigned(m_inputCount.load());
+}
+
+unsigned int JavaScriptEngineWorker::getOutputCount() {
+    return unsigned(m_outputCount.load());
+}
+
+unsigned int JavaScriptEngineWorker::inputIndex() {
+    return unsigned(m_inputIndex);
+}
+
+void JavaScriptEngineWorker::callMain(const QString& functionName, const QJSValue& args) {
+    QVariantList list;
+    if (args.isArray()) {
+        list = args.toVariant().toList();
+    } else if (!args.isUndefined()) {
+        list << args.toVariant();
+    }
+    emit mainCallRequested(functionName, list);
+}
@@ -0,0 +1,133 @@
+//
+// Created by WuBin on 2025/9/8.
+//
+
+#pragma once
+
+#include <QObject>
+#include <QtQml/QJSEngine>
+#include <QtQml/QJSValue>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QVariantMap>
+#include <QMetaType>
+#include <atomic>
+
+namespace Nodes {
+
+/**
+ * @brief 脚本调用耗时统计（毫秒）
+ */
+struct JavaScriptCallStats {
+    quint64 calls = 0;          // 处理函数调用次数
+    quint64 coalesced = 0;      // 处理前同一端口重复到达而被合并的输入数
+    quint64 dropped = 0;        // 队列已满被丢弃的输入数
+    double lastMs = 0.0;
+    double averageMs = 0.0;
+    double maxMs = 0.0;
+
+    void record(double ms) {
+        ++calls;
+        lastMs = ms;
+        averageMs += (ms - averageMs) / double(calls);
+        maxMs = qMax(maxMs, ms);
+    }
+};
+
+/**
+ * @brief JavaScript 引擎线程工作对象（移动到专用线程，拥有独立的 QJSEngine）
+ * - 加载脚本后缓存 onInput(index, data) 的函数句柄，调用时不再按名称查找
+ * - 输入队列按端口合并为最新值，不同端口数量超过 MaxQueuedPorts 时丢弃最旧的输入
+ * - 输入数据在引擎线程转换为 JS 对象；输出与界面调用（Node.callMain）以信号排队回到主线程
+ * - 引擎线程中的 Node 只提供数据接口，控件只能在主线程引擎的 initInterface 中创建
+ */
+class JavaScriptEngineWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MaxQueuedPorts = 64;      // 输入队列中最多保留的端口数
+    static constexpr int StatsIntervalMs = 1000;   // statsUpdated 最小发出间隔
+
+    explicit JavaScriptEngineWorker(QObject* parent = nullptr);
+
+    /**
+     * @brief 加载脚本（任意线程，排队到引擎线程执行）
+     */
+    void loadScript(const QString& script);
+
+    /**
+     * @brief 投递输入（任意线程）
+     * @param portIndex 输入端口索引
+     * @param data 输入数据
+     */
+    void postInput(int portIndex, const QVariantMap& data);
+
+    /**
+     * @brief 当前脚本是否定义了 onInput 处理函数
+     */
+    bool hasHandler() const { return m_hasHandler.load(std::memory_order_acquire); }
+
+    void setPortCounts(int inputCount, int outputCount);
+
+    /**
+     * @brief 中断正在执行的脚本并停止处理后续输入（任意线程，用于析构前让引擎线程尽快返回）
+     */
+    void interrupt();
+
+    JavaScriptCallStats getStats() const;
+
+    // 以下接口供引擎线程中的脚本通过 Node 对象调用
+    Q_INVOKABLE QJSValue getInputValue(int portIndex);
+    Q_INVOKABLE void setOutputValue(int portIndex, const QJSValue& value);
+    Q_INVOKABLE unsigned int getInputCount();
+    Q_INVOKABLE unsigned int getOutputCount();
+    Q_INVOKABLE unsigned int inputIndex();
+    /**
+     * @brief 在主线程引擎中调用全局函数（用于更新界面）
+     * @param functionName 主线程脚本中的函数名
+     * @param args 参数（数组按多个参数传递）
+     */
+    Q_INVOKABLE void callMain(const QString& functionName, const QJSValue& args = QJSValue());
+
+Q_SIGNALS:
+    void outputReady(int portIndex, const QVariantMap& data);
+    void mainCallRequested(const QString& functionName, const QVariantList& args);
+    void scriptError(const QString& message);
+    void statsUpdated(const Nodes::JavaScriptCallStats& stats);
+
+private Q_SLOTS:
+    void evaluateScript(const QString& script);
+    void processInputs();
+
+private:
+    void recordCall(qint64 nsecs);
+
+    QJSEngine* m_engine = nullptr;              // 仅引擎线程创建、使用；替换与中断由 m_engineMutex 保护
+    QMutex m_engineMutex;
+    std::atomic<bool> m_interrupted {false};
+    QJSValue m_onInput;                         // 缓存的处理函数句柄
+    std::atomic<bool> m_hasHandler {false};
+    std::atomic<int> m_inputCount {4};
+    std::atomic<int> m_outputCount {1};
+
+    // 待处理输入（任意线程写，引擎线程取）
+    QMutex m_queueMutex;
+    QList<int> m_order;
+    QHash<int, QVariantMap> m_pending;
+    bool m_drainScheduled = false;
+
+    // 引擎线程中的最新输入
+    QHash<int, QVariantMap> m_inputs;
+    int m_inputIndex = 0;
+
+    mutable QMutex m_statsMutex;
+    JavaScriptCallStats m_stats;
+    QElapsedTimer m_statsClock;
+};
+
+}
+
+Q_DECLARE_METATYPE(Nodes::JavaScriptCallStats)
@@ -418,8 +418,8 @@ namespace Nodes
                 QMutexLocker locker(&_mutex);
                 if (_isProcessing) {
                     currentFps = _fps;
-                    // 保持小缓冲（≈1帧，2048样本）以降低端到端延迟，避免停止/开始时时间码跳变
-                    if ((_pendingSamples.size() - _pendingReadOffset) < 2048) {
+                    // 保持小缓冲（≈1个音频块）以降低端到端延迟，避免停止/开始时时间码跳变
+                    if ((_pendingSamples.size() - _pendingReadOffset) < static_cast<int>(BUFFER_SIZE)) {
                         int generated = encodeOneLtcFrameLocked();
                         // 生成线程不触发 UI 时间码，防止“未播放的未来时间码”导致不一致
                     }
@@ -439,7 +439,7 @@ namespace Nodes
 
     /**
      * @brief 系统时间戳驱动的消费回调
-     * - 从缓存中读取 2048 个采样
+     * - 从缓存中读取一个音频块（BUFFER_SIZE）的采样
      * - 打上系统时间戳
      * - 放入环形队列
      */
@@ -450,7 +450,7 @@ namespace Nodes
             return;
         }
 
-        // 读取“整帧样本数”（BUFFER_SIZE = SAMPLE_RATE / fps），保证与时间码帧边界严格对齐
+        // 读取一个音频块（BUFFER_SIZE = 全局块大小），与全局时间戳一一对应
         const int samplesNeeded = BUFFER_SIZE;
         QVector<float> block;
         
@@ -8,8 +8,9 @@
 #include "NodeDataList.hpp"
 #include "TimeCodeDefines.h"
 #include <ltc.h>
-static const int SAMPLE_RATE = 48000;
-static const size_t BUFFER_SIZE = SAMPLE_RATE/TimestampGenerator::getInstance()->getFrameRate();
+// 采样率与每个时间戳的采样数取自全局音频时钟配置
+static const int SAMPLE_RATE = TimestampGenerator::getInstance()->getSampleRate();
+static const size_t BUFFER_SIZE = TimestampGenerator::getInstance()->getBlockSize();
 namespace Nodes
 {
     /**
@@ -42,7 +42,9 @@ namespace Nodes
         ~LuaDataModel()
         {
             if(luaEngine!=nullptr){
-                luaEngine->deleteLater();
+                // 同步停止工作线程，避免脚本在节点销毁后继续访问 Node
+                delete luaEngine;
+                luaEngine=nullptr;
             }
             widget->deleteLater();
 
@@ -100,7 +102,11 @@ namespace Nodes
                 in[portIndex]=LuaQVariantMap(d->getMap());
                 inputPortIndex=portIndex;
                 //            in_dictionary[portIndex].setVariant( d->value());
-                onButtonClicked();
+                if (!luaEngine) {
+                    onButtonClicked();
+                }
+                // 投递到常驻工作线程，由 on_input 或已编译的脚本处理
+                luaEngine->postInput(int(portIndex), d->getMap());
                 //            Q_EMIT dataUpdated(0);
             }
         }
@@ -172,9 +178,8 @@ namespace Nodes
             }
 
             luaEngine->setCode(code);
-
-
-            luaEngine->start();
+            // 常驻线程：脚本变更时重新编译并执行脚本主体
+            luaEngine->requestRun();
 
         }
     public:
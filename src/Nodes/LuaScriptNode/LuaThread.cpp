@@ -17,17 +17,24 @@ using namespace Nodes;
 LuaThread::LuaThread(const QString &script,
                     QObject *ptr,
                     QObject *parent):
+                    QThread(parent),
                     scriptContent(script),
                     nodeInstance(ptr) {
     init();
 }
 LuaThread::~LuaThread() {
-
+    stop();
+    if (luaState) {
+        lua_close(luaState);
+        luaState = nullptr;
+    }
 }
 
 void LuaThread::init() {
     // 初始化Lua状态机
     luaState = luaL_newstate();
+    // 计数钩子通过额外空间找到所属线程对象
+    *static_cast<LuaThread**>(lua_getextraspace(luaState)) = this;
     // 打开标准库
     luaL_openlibs(luaState);
     // 注册print函数
@@ -42,48 +49,194 @@ void LuaThread::init() {
     auto instancePtr = static_cast<LuaDataModel*>(nodeInstance);
     //设置c++类实例全局名称为Node
     luabridge::setGlobal(luaState,instancePtr,"Node");
-    // 尝试加载 Lua 脚本，解析返回的错误信息
 }
 void LuaThread::setCode(QString code) {
-    scriptContent=code;
+    QMutexLocker locker(&mutex);
+    if (code != scriptContent) {
+        scriptContent = code;
+        codeChanged = true;
+    }
 }
-void LuaThread::run() {
 
-    switch (luaL_loadstring(luaState, scriptContent.toStdString().c_str())) {
-        case LUA_ERRSYNTAX: {
-            qDebug()<<getError(lua_tostring(luaState,1));
-            lua_pop(luaState, 1);  // 清除栈上的错误信息
-            return;
-        }
-        case LUA_YIELD: {
-            qDebug()<<getError(lua_tostring(luaState,1));
-            lua_pop(luaState, 1);  // 清除栈上的错误信息
-            return;
-        }
-        case LUA_ERRRUN: {
-             qDebug()<<getError(lua_tostring(luaState,1));
-            lua_pop(luaState, 1);  // 清除栈上的错误信息
-            return;
-        }
-        case LUA_ERRERR: {
-            qDebug()<<getError(lua_tostring(luaState,1));
-            lua_pop(luaState, 1);  // 清除栈上的错误信息
-            return;
+void LuaThread::requestRun() {
+    {
+        QMutexLocker locker(&mutex);
+        runRequested = true;
+        condition.wakeOne();
+    }
+    if (!isRunning()) {
+        stopRequested = false;
+        start();
+    }
+}
+
+void LuaThread::postInput(int port, const QVariantMap &data) {
+    QMutexLocker locker(&mutex);
+    if (!pendingInputs.contains(port)) {
+        inputOrder.append(port);
+    }
+    pendingInputs.insert(port, data);
+    condition.wakeOne();
+}
+
+void LuaThread::setInstructionBudget(int instructions) {
+    instructionBudget = instructions;
+}
+
+void LuaThread::stop() {
+    stopRequested = true;
+    {
+        QMutexLocker locker(&mutex);
+        condition.wakeAll();
+    }
+    if (isRunning()) {
+        wait();
+    }
+}
+
+/**
+ * @brief 线程主循环：依次处理运行请求与输入事件，空闲时等待
+ */
+void LuaThread::run() {
+    while (!stopRequested) {
+        bool doRun = false;
+        bool recompile = false;
+        int port = -1;
+        QVariantMap data;
+        {
+            QMutexLocker locker(&mutex);
+            while (!stopRequested && !runRequested && inputOrder.isEmpty()) {
+                condition.wait(&mutex);
+            }
+            if (stopRequested) {
+                break;
+            }
+            if (runRequested) {
+                doRun = true;
+                runRequested = false;
+                recompile = codeChanged;
+                codeChanged = false;
+            } else {
+                port = inputOrder.takeFirst();
+                data = pendingInputs.take(port);
+            }
         }
-        case LUA_ERRMEM: {
-             qDebug()<<getError(lua_tostring(luaState,1));
-            lua_pop(luaState, 1);  // 清除栈上的错误信息
-            return;
+
+        if (doRun) {
+            if (recompile || chunkRef == LUA_NOREF) {
+                if (!compileChunk()) {
+                    continue;
+                }
+            }
+            runChunk();
+        } else {
+            dispatchInput(port, data);
         }
+    }
+}
+
+/**
+ * @brief 编译脚本并保存到注册表，释放旧的脚本与处理函数
+ * @return 是否编译成功
+ */
+bool LuaThread::compileChunk() {
+    QByteArray source;
+    {
+        QMutexLocker locker(&mutex);
+        source = scriptContent.toUtf8();
+    }
+    releaseRef(chunkRef);
+    releaseRef(handlerRef);
+    if (luaL_loadbuffer(luaState, source.constData(), size_t(source.size()), "=LuaScript") != LUA_OK) {
+        qDebug()<<getError(lua_tostring(luaState,-1));
+        lua_pop(luaState, 1);  // 清除栈上的错误信息
+        return false;
+    }
+    chunkRef = luaL_ref(luaState, LUA_REGISTRYINDEX);
+    return true;
+}
+
+/**
+ * @brief 执行已编译的脚本主体，并缓存全局函数 on_input
+ */
+void LuaThread::runChunk() {
+    if (chunkRef == LUA_NOREF) {
+        return;
+    }
+    // 清除旧的 on_input，避免新脚本未定义时沿用旧函数
+    lua_pushnil(luaState);
+    lua_setglobal(luaState, "on_input");
+    releaseRef(handlerRef);
+
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, chunkRef);
+    if (!protectedCall(0)) {
+        return;
+    }
+    if (lua_getglobal(luaState, "on_input") == LUA_TFUNCTION) {
+        handlerRef = luaL_ref(luaState, LUA_REGISTRYINDEX);
+    } else {
+        lua_pop(luaState, 1);
+    }
+}
 
+/**
+ * @brief 处理一个输入事件：调用 on_input(port, data)，未定义时重新执行已编译的脚本
+ */
+void LuaThread::dispatchInput(int port, const QVariantMap &data) {
+    if (handlerRef == LUA_NOREF) {
+        runChunk();
+        return;
     }
-    // 尝试运行lua脚本，并返回错误信息
-    if (lua_pcall(luaState, 0, LUA_MULTRET, 0)!=LUA_OK) {
-        qDebug()<<getError(lua_tostring(luaState,1));
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, handlerRef);
+    lua_pushinteger(luaState, port);
+    LuaQVariantMap(data).toLuaTable(luaState);
+    protectedCall(2);
+}
+
+/**
+ * @brief 在指令数预算内调用栈顶函数，出错时输出错误信息
+ * @param nargs 参数个数
+ * @return 是否成功
+ */
+bool LuaThread::protectedCall(int nargs) {
+    const int budget = instructionBudget.load();
+    instructionsLeft = budget;
+    // 停止请求也通过钩子中止，因此不限制预算时仍安装钩子
+    lua_sethook(luaState, instructionHook, LUA_MASKCOUNT, HookInterval);
+    const int status = lua_pcall(luaState, nargs, 0, 0);
+    lua_sethook(luaState, nullptr, 0, 0);
+    if (status != LUA_OK) {
+        qDebug()<<getError(lua_tostring(luaState,-1));
         lua_pop(luaState, 1);  // 清除栈上的错误信息
+        return false;
     }
+    return true;
+}
 
+void LuaThread::releaseRef(int &ref) {
+    if (ref != LUA_NOREF) {
+        luaL_unref(luaState, LUA_REGISTRYINDEX, ref);
+        ref = LUA_NOREF;
+    }
 }
+
+/**
+ * @brief 计数钩子：每 HookInterval 条指令扣减预算，预算耗尽或请求停止时抛出 Lua 错误中止调用
+ */
+void LuaThread::instructionHook(lua_State *L, lua_Debug *ar) {
+    Q_UNUSED(ar)
+    auto self = *static_cast<LuaThread**>(lua_getextraspace(L));
+    if (self->stopRequested) {
+        luaL_error(L, "script stopped");
+    }
+    if (self->instructionBudget.load() > 0) {
+        self->instructionsLeft -= HookInterval;
+        if (self->instructionsLeft <= 0) {
+            luaL_error(L, "instruction budget exceeded (%d)", self->instructionBudget.load());
+        }
+    }
+}
+
 // 将lua中的异常提示解析出来
 QString LuaThread::getError(const char* error){
     std::string errorString(error);
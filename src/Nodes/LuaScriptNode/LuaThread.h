@@ -8,6 +8,9 @@
 #include <QString>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QHash>
+#include <QList>
+#include <atomic>
 #include <iostream>
 #include <unordered_map>
 #include "QVariant"
@@ -19,9 +22,20 @@ extern "C" {
 
 namespace Nodes
 {
+    /**
+     * @brief 常驻的 Lua 脚本工作线程，每个节点一个 Lua 虚拟机
+     * - 脚本在 setCode 后的首次运行时编译一次，编译结果保存在注册表中，再次运行不再重新编译
+     * - 脚本运行后若定义了全局函数 on_input(port, data)，输入事件直接调用该函数，data 为 Lua 表；
+     *   未定义时退回旧行为，每个输入事件重新执行已编译的脚本
+     * - 输入事件进入队列，同一端口在处理前重复到达时只保留最新数据
+     * - 每次调用有指令数预算，超出或请求停止时中止本次调用，避免失控脚本阻塞
+     */
     class LuaThread : public QThread {
         Q_OBJECT
     public:
+        static constexpr int DefaultInstructionBudget = 10000000;   // 每次调用的默认指令数预算
+        static constexpr int HookInterval = 1000;                    // 计数钩子触发间隔（指令数）
+
         LuaThread(const QString& scriptContent,
             QObject *ptr,
             QObject* parent = nullptr);
@@ -29,14 +43,56 @@ namespace Nodes
         ~LuaThread() ;
         void init();
         QString getError(const char* err);
+        /**
+         * @brief 设置脚本源码，下次运行时重新编译
+         */
         void setCode(QString code);
+        /**
+         * @brief 请求运行脚本主体（脚本变更时先编译），线程未启动时自动启动
+         */
+        void requestRun();
+        /**
+         * @brief 投递输入事件（线程安全），同一端口未处理时以最新数据替换
+         * @param port 输入端口索引
+         * @param data 输入数据
+         */
+        void postInput(int port, const QVariantMap& data);
+        /**
+         * @brief 设置每次调用的指令数预算，小于等于 0 表示不限制
+         */
+        void setInstructionBudget(int instructions);
+        /**
+         * @brief 停止线程并等待退出
+         */
+        void stop();
     protected:
         void run() override ;
 
     private:
+        bool compileChunk();
+        void runChunk();
+        void dispatchInput(int port, const QVariantMap& data);
+        bool protectedCall(int nargs);
+        void releaseRef(int& ref);
+        static void instructionHook(lua_State* L, lua_Debug* ar);
+
         lua_State* luaState = nullptr;  // Lua的状态机
         QString scriptContent;  // Lua脚本的内容
         QObject *nodeInstance;
+
+        int chunkRef = LUA_NOREF;       // 注册表中已编译的脚本
+        int handlerRef = LUA_NOREF;     // 注册表中的 on_input 函数
+
+        QMutex mutex;
+        QWaitCondition condition;
+        bool codeChanged = true;
+        bool runRequested = false;
+        QList<int> inputOrder;                  // 待处理端口（按到达顺序）
+        QHash<int, QVariantMap> pendingInputs;  // 各端口最新数据
+
+        std::atomic<bool> stopRequested{false};
+        std::atomic<int> instructionBudget{DefaultInstructionBudget};
+        int instructionsLeft = 0;               // 本次调用剩余指令数（仅工作线程）
     };
 }
 #endif //NODEEDITORCPP_LUATHREAD_H
@@ -5,7 +5,7 @@
 #include "TimestampGenerator/TimestampGenerator.hpp"
 
 // PortAudio缓冲区大小（帧数）
-static const int FRAMES_PER_BUFFER = 48000/(TimestampGenerator::getInstance()->getFrameRate());
+static const int FRAMES_PER_BUFFER = TimestampGenerator::getInstance()->getBlockSize();
 
 /**
  * @brief 构造函数，初始化噪音生成器
@@ -49,7 +49,7 @@ QJsonObject* NoiseGenerator::initializeGenerator(int sampleRate, int channels, i
     this->bitsPerSample = bitsPerSample;
     
     // 创建音频缓冲区
-    channelAudioBuffers = std::make_shared<AudioTimestampRingQueue>();
+    channelAudioBuffers = std::make_shared<AudioTimestampRingQueue>(64, AudioQueueMode::LockFreeSpsc);
     channelAudioBuffers->setActive(true);
     
     // 返回音频参数
@@ -17,6 +17,8 @@
 #include <opencv2/opencv.hpp>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include "Common/BaseClass/AbstractDelegateModel.h"
 #include "Common/Devices/StatusContainer/GlobalEventBus.hpp"
 using QtNodes::NodeData;
@@ -198,12 +200,18 @@ namespace Nodes
                 break;
             }
         }
-       /**
-     * @brief 性能优化的ONNX Runtime图像推理函数
-     * @details 使用缓存的会话和预分配内存，优化图像预处理流程，支持CUDA加速
+    /**
+     * @brief 线程安全且计算密集：数据流调度器可在线程池中执行 setInData
      */
+    ExecutionFlags executionFlags() const override
+    {
+        return ThreadSafe | ComputeHeavy;
+    }
+
     /**
      * @brief 异步推理入口（不在UI线程执行推理）
+     * - 输入帧先写入“最新待处理帧”，推理忙时不会丢失：当前推理结束后接着处理最新一帧
+     * - 工作线程（数据流调度器线程池）与 UI 线程的 QtConcurrent 路径共用同一个忙标志，推理始终串行
      */
     void imageReasoning()
     {
@@ -212,24 +220,59 @@ namespace Nodes
             emit dataUpdated(1);
             return;
         }
-        if (!m_inferenceWatcher) {
-            m_inferenceWatcher = new QFutureWatcher<void>(this);
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            m_pendingImage = m_inImage0->imgMat();
+            m_pendingConf = m_confThreshold;
+            m_pendingClassId = m_selectedClassId;
+            m_hasPending = true;
         }
-        if (m_inferenceWatcher->isRunning()) {
+        if (m_inferenceBusy.exchange(true)) {
+            // 正在推理，结束后会取走最新的待处理帧
             return;
         }
-        cv::Mat matCopy = m_inImage0->imgMat();
-        double conf = m_confThreshold;
-        int clsId = m_selectedClassId;
-        
-        auto future = QtConcurrent::run([this, matCopy, conf, clsId](){
-            runInferenceOnImage(matCopy, conf, clsId);
+        if (QThread::currentThread() != thread()) {
+            drainPendingInference();
+            return;
+        }
+        if (!m_inferenceWatcher) {
+            m_inferenceWatcher = new QFutureWatcher<void>(this);
+        }
+        auto future = QtConcurrent::run([this](){
+            drainPendingInference();
         });
         m_inferenceWatcher->setFuture(future);
     }
+
+    /**
+     * @brief 持有忙标志时调用：依次处理待处理帧，直到没有新帧后释放忙标志
+     */
+    void drainPendingInference()
+    {
+        for (;;) {
+            cv::Mat image;
+            double conf = 0.0;
+            int clsId = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_pendingMutex);
+                if (!m_hasPending || m_cancelRequested.load()) {
+                    m_hasPending = false;
+                    m_inferenceBusy.store(false);
+                    return;
+                }
+                image = m_pendingImage;
+                conf = m_pendingConf;
+                clsId = m_pendingClassId;
+                m_pendingImage = cv::Mat();
+                m_hasPending = false;
+            }
+            runInferenceOnImage(image, conf, clsId);
+        }
+    }
  
     /**
-     * @brief 在工作线程中执行推理与后处理，并在主线程更新输出
+     * @brief 性能优化的ONNX Runtime图像推理函数：在工作线程中执行推理与后处理，并在主线程更新输出
+     * @details 使用缓存的会话和预分配内存，优化图像预处理流程，支持CUDA加速
      * @param inputImage 输入图像副本
      */
     void runInferenceOnImage(cv::Mat inputImage, double confidence, int classId)
@@ -295,6 +338,10 @@ namespace Nodes
                 f.waitForFinished();
             }
         }
+        // 线程池路径没有 future，等待其处理完当前帧后退出
+        while (m_inferenceBusy.load()) {
+            QThread::msleep(1);
+        }
     }
 
 
@@ -710,5 +757,12 @@ namespace Nodes
         QString m_cachedModelPath;
         bool m_useCuda = false;
         std::atomic<bool> m_cancelRequested{false};
+        // 推理串行化：忙标志 + 最新待处理帧
+        std::atomic<bool> m_inferenceBusy{false};
+        std::mutex m_pendingMutex;
+        cv::Mat m_pendingImage;
+        double m_pendingConf = 0.4;
+        int m_pendingClassId = 0;
+        bool m_hasPending = false;
     };
 }
@@ -57,6 +57,8 @@ namespace Nodes
         void setup() {
 
             OSC_Receiver=new OSCReceiver(m_port);
+            // 数据流只关心每个地址的最新值
+            OSC_Receiver->setCoalescing(true);
             widget=new OscInInterface();
             {
                 NodeDelegateModel::ExternalBinding b;
@@ -111,6 +111,9 @@ void PythonScriptDataModel::initPythonWorkerThread() {
     connect(m_pythonWorker, &PythonWorkerThread::messageReceived,
             this, &PythonScriptDataModel::handlePythonMessage);
 
+    connect(m_pythonWorker, &PythonWorkerThread::statsUpdated,
+            this, &PythonScriptDataModel::handleExecutionStats);
+
 }
 
 /**
@@ -183,3 +186,19 @@ void PythonScriptDataModel::handlePythonMessage(const QString& message) {
     qDebug() << "Python消息:" << message;
 }
 
+/**
+ * @brief 处理Python执行耗时统计更新
+ * @param stats 执行耗时统计
+ */
+void PythonScriptDataModel::handleExecutionStats(const PythonExecutionStats& stats) {
+    widget->editButton->setToolTip(QString("编辑Python脚本\n"
+                                           "调用次数: %1（合并 %2）\n"
+                                           "最近/平均/最大耗时: %3 / %4 / %5 ms\n"
+                                           "脚本加载耗时: %6 ms")
+                                       .arg(stats.invocations)
+                                       .arg(stats.coalesced)
+                                       .arg(stats.lastMs, 0, 'f', 2)
+                                       .arg(stats.averageMs, 0, 'f', 2)
+                                       .arg(stats.maxMs, 0, 'f', 2)
+                                       .arg(stats.loadMs, 0, 'f', 2));
+}
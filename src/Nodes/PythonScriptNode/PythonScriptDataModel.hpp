@@ -104,6 +104,12 @@ private:
      */
     void handlePythonMessage(const QString& message);
 
+    /**
+     * @brief 处理Python执行耗时统计更新（显示在编辑按钮提示中）
+     * @param stats 执行耗时统计
+     */
+    void handleExecutionStats(const PythonExecutionStats& stats);
+
 public:
     /**
      * @brief 析构函数
@@ -200,7 +206,11 @@ public:
         {
             inputPortIndex = portIndex;
             in_data[portIndex] = d->getMap();
-
+            // 转发到工作线程，由脚本的 on_input / input_event_handler 处理
+            if (m_pythonWorker) {
+                m_pythonWorker->setInputData(portIndex, in_data[portIndex]);
+                m_pythonWorker->setInputEventIndex(portIndex);
+            }
         }
     }
 
@@ -354,10 +364,10 @@ def init_interface():
     print("初始化界面")
     pass
 
-def input_event_handler(index):
-    print(f"输入事件: {index}")
-    value = worker.get_input_value(index)
-    print(f"输入值: {value}")
+# 输入端口更新时调用，data 为该端口最新数据
+def on_input(port, data):
+    print(f"输入事件: {port}")
+    print(f"输入值: {data}")
     pass
 )";
     QMutex m_dataMutex;  // 添加互斥锁保护数据访问
@@ -117,6 +117,8 @@ QMutex& PythonInterpreterManager::getInitMutex() {
 PythonWorkerThread::PythonWorkerThread(QObject *parent)
     : QThread(parent)
 {
+    qRegisterMetaType<Nodes::PythonExecutionStats>("Nodes::PythonExecutionStats");
+
     // 确保主解释器已初始化
     auto& manager = PythonInterpreterManager::getInstance();
     if (!manager.initializeMainInterpreter()) {
@@ -311,22 +313,21 @@ void PythonWorkerThread::run()
             try {
                 {
                     QMutexLocker locker(&m_mutex);
-                    // 等待执行请求或脚本变更
-                    if (!m_executing.load() && !m_scriptChanged) {
+                    // 等待执行请求或输入事件
+                    if (!m_executing.load() && !m_inputsPending.load()) {
                         m_condition.wait(&m_mutex, 100);
                         continue;
                     } 
                 }
                 
-                // 处理脚本执行请求
+                // 处理脚本执行请求（脚本变更时重新编译）
                 if (m_executing.load()) {
                     executePythonScript();
                 }
                 
-                // 处理脚本变更
-                if (m_scriptChanged) {
-                    m_scriptChanged = false;
-                    // qDebug() << "脚本已更新";
+                // 处理输入事件
+                if (m_inputsPending.load()) {
+                    processPendingInputs();
                 }
                 
             } catch (const std::exception& e) {
@@ -365,6 +366,12 @@ void PythonWorkerThread::cleanupPythonSubInterpreter()
         try {
             qDebug() << "开始清理Python子解释器，ID:" << m_subInterpreter->id();
 
+            // 缓存的代码对象与入口函数属于子解释器，需在激活状态下释放
+            {
+                py::subinterpreter_scoped_activate guard(*m_subInterpreter);
+                releaseCachedObjects();
+            }
+
             // 重置子解释器
             m_subInterpreter.reset();
 
@@ -465,16 +472,26 @@ void PythonWorkerThread::setScript(const QString& script)
 }
 
 /**
- * @brief 标记要触发的输入事件索引，并唤醒线程执行
- *        同步记录最近一次触发索引，供脚本查询。
+ * @brief 标记输入端口有新数据并唤醒线程
+ *        同一端口在处理前重复到达时只保留一次调用（处理时读取最新数据）。
  * @param index 输入端口索引
  */
 void PythonWorkerThread::setInputEventIndex(int index)
 {
+    if (index < 0) {
+        return;
+    }
+    bool inserted;
+    {
+        QMutexLocker locker(&m_dataMutex);
+        inserted = m_pendingInputs.insert(index).second;
+        m_inputsPending = true;
+    }
+    if (!inserted) {
+        QMutexLocker locker(&m_statsMutex);
+        ++m_stats.coalesced;
+    }
     QMutexLocker locker(&m_mutex);
-    m_pendingInputIndex = index;
-    m_lastInputIndex = index;      // 记录最近一次触发的索引
-    m_executing = true;
     m_condition.wakeOne();
 }
 
@@ -522,7 +539,7 @@ void PythonWorkerThread::setPortCounts(int inputCount, int outputCount)
 
 /**
  * @brief 在子解释器中执行Python脚本
- * 使用RAII方式管理子解释器的激活状态
+ * 使用RAII方式管理子解释器的激活状态；脚本未变更时直接执行缓存的代码对象
  */
 void PythonWorkerThread::executePythonScript()
 {
@@ -531,25 +548,172 @@ void PythonWorkerThread::executePythonScript()
         m_executing = false;  // 重置执行状态
         return;
     }
-    
-    try {  
+
+    QString script;
+    bool recompile;
+    {
+        QMutexLocker locker(&m_mutex);
+        script = m_script;
+        recompile = m_scriptChanged;
+        m_scriptChanged = false;
+        // 执行前重置，执行期间的新请求会在下一轮处理
+        m_executing = false;
+    }
+
+    bool success = true;
+    QString errorMessage;
+    {
         // 激活子解释器
         py::subinterpreter_scoped_activate guard(*m_subInterpreter);
-        
-        py::exec(m_script.toStdString(), m_mainModule.attr("__dict__"));
-        
-    } catch (const py::error_already_set& e) {
-        qDebug() << "Python脚本执行错误:" << e.what();
-        emit executionFinished(false, QString::fromStdString(e.what()));
+        try {
+            success = loadCompiledScript(script, recompile);
+        } catch (const py::error_already_set& e) {
+            qDebug() << "Python脚本执行错误:" << e.what();
+            success = false;
+            errorMessage = QString::fromStdString(e.what());
+        } catch (const std::exception& e) {
+            qDebug() << "执行Python脚本时发生异常:" << e.what();
+            success = false;
+            errorMessage = QString::fromStdString(e.what());
+        }
+        if (!success) {
+            releaseCachedObjects();
+        }
+    }
 
-    } catch (const std::exception& e) {
-        qDebug() << "执行Python脚本时发生异常:" << e.what();
-        emit executionFinished(false, QString::fromStdString(e.what()));
+    emit executionFinished(success, errorMessage);
+}
+
+/**
+ * @brief 编译脚本（仅在变更后）并执行脚本主体，缓存入口函数
+ * @param script 脚本源码
+ * @param recompile 是否重新编译
+ * @return 是否成功
+ */
+bool PythonWorkerThread::loadCompiledScript(const QString& script, bool recompile)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    py::module_ builtins = py::module_::import("builtins");
+    if (recompile || !m_compiledCode) {
+        m_compiledCode = py::object();
+        m_compiledCode = builtins.attr("compile")(script.toStdString(), "<PythonScriptNode>", "exec");
     }
-    
-    // 执行完成后重置执行状态
-    m_executing = false;
-    emit executionFinished(true, "");
+
+    py::dict globals = m_mainModule.attr("__dict__");
+    // 移除上一个脚本的入口函数，避免新脚本未定义时仍沿用旧函数
+    globals.attr("pop")("on_input", py::none());
+    globals.attr("pop")("input_event_handler", py::none());
+    m_onInput = py::object();
+    m_inputEventHandler = py::object();
+
+    builtins.attr("exec")(m_compiledCode, globals);
+
+    if (globals.contains("on_input") && PyCallable_Check(globals["on_input"].ptr())) {
+        m_onInput = globals["on_input"];
+    }
+    if (globals.contains("input_event_handler") && PyCallable_Check(globals["input_event_handler"].ptr())) {
+        m_inputEventHandler = globals["input_event_handler"];
+    }
+
+    PythonExecutionStats snapshot;
+    {
+        QMutexLocker locker(&m_statsMutex);
+        m_stats.loadMs = timer.nsecsElapsed() / 1e6;
+        snapshot = m_stats;
+    }
+    emit statsUpdated(snapshot);
+    return true;
+}
+
+/**
+ * @brief 取出待处理端口，以各端口最新数据依次调用入口函数
+ */
+void PythonWorkerThread::processPendingInputs()
+{
+    std::set<int> ports;
+    QMap<int, QVariantMap> inputs;
+    {
+        QMutexLocker locker(&m_dataMutex);
+        ports.swap(m_pendingInputs);
+        m_inputsPending = false;
+        for (int port : ports) {
+            inputs.insert(port, m_inputData.value(port));
+        }
+    }
+    if (!m_subInterpreter || ports.empty()) {
+        return;
+    }
+
+    py::subinterpreter_scoped_activate guard(*m_subInterpreter);
+    if (!m_onInput && !m_inputEventHandler) {
+        return;
+    }
+    for (int port : ports) {
+        if (shouldStop()) {
+            break;
+        }
+        m_lastInputIndex = port;
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            if (m_onInput) {
+                m_onInput(port, PythonEngineDefines::variantMapToPyDict(inputs.value(port)));
+            } else {
+                m_inputEventHandler(port);
+            }
+        } catch (const py::error_already_set& e) {
+            qDebug() << "Python输入处理函数执行错误:" << e.what();
+            emit executionFinished(false, QString::fromStdString(e.what()));
+        } catch (const std::exception& e) {
+            qDebug() << "执行Python输入处理函数时发生异常:" << e.what();
+            emit executionFinished(false, QString::fromStdString(e.what()));
+        }
+        recordInvocation(timer.nsecsElapsed());
+    }
+}
+
+/**
+ * @brief 记录一次入口函数调用耗时
+ * @param nsecs 耗时（纳秒）
+ */
+void PythonWorkerThread::recordInvocation(qint64 nsecs)
+{
+    const double ms = nsecs / 1e6;
+    PythonExecutionStats snapshot;
+    bool notify = false;
+    {
+        QMutexLocker locker(&m_statsMutex);
+        ++m_stats.invocations;
+        m_stats.lastMs = ms;
+        m_stats.averageMs += (ms - m_stats.averageMs) / double(m_stats.invocations);
+        m_stats.maxMs = qMax(m_stats.maxMs, ms);
+        if (!m_statsClock.isValid() || m_statsClock.elapsed() >= StatsIntervalMs) {
+            m_statsClock.start();
+            snapshot = m_stats;
+            notify = true;
+        }
+    }
+    if (notify) {
+        emit statsUpdated(snapshot);
+    }
+}
+
+PythonExecutionStats PythonWorkerThread::getExecutionStats() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_stats;
+}
+
+/**
+ * @brief 释放缓存的代码对象与入口函数
+ */
+void PythonWorkerThread::releaseCachedObjects()
+{
+    m_onInput = py::object();
+    m_inputEventHandler = py::object();
+    m_compiledCode = py::object();
 }
 
 
@@ -5,9 +5,12 @@
 #include <QWaitCondition>
 #include <QString>
 #include <QVariantMap>
+#include <QElapsedTimer>
+#include <QMetaType>
 #include <QDebug>
 #include <atomic>
 #include <optional>
+#include <set>
 #include "pybind11/pybind11.h"
 #include "pybind11/embed.h"
 #include "pybind11/eval.h"
@@ -43,15 +46,31 @@ private:
     friend class PythonWorkerThread;
 };
 
+/**
+ * @brief Python脚本执行耗时统计（毫秒）
+ */
+struct PythonExecutionStats {
+    quint64 invocations = 0;     // 入口函数调用次数
+    quint64 coalesced = 0;       // 调用期间同一端口重复到达而被合并的输入数
+    double lastMs = 0.0;         // 最近一次调用耗时
+    double averageMs = 0.0;      // 平均调用耗时
+    double maxMs = 0.0;          // 最大调用耗时
+    double loadMs = 0.0;         // 最近一次编译并执行脚本主体的耗时
+};
+
 /**
  * @brief Python工作线程类，为每个Python脚本创建独立的子解释器实例
  * 提供启动、停止和设置脚本的功能，支持真正的并发执行
+ * - 脚本在 setScript 后编译一次并缓存代码对象，此后执行不再重新解析源码
+ * - 脚本主体执行后缓存入口函数：on_input(port, data) 优先，其次兼容 input_event_handler(index)
+ * - 输入事件在脚本调用期间到达时按端口合并，下一轮以每个端口的最新数据批量调用
  */
 class PythonWorkerThread : public QThread
 {
     Q_OBJECT
 
 public:
+    static constexpr int StatsIntervalMs = 1000;   // statsUpdated 最小发出间隔
     /**
      * @brief 构造函数
      * @param parent 父对象
@@ -111,12 +130,17 @@ public:
     void setPortCounts(int inputCount, int outputCount);
 public:
     /**
-     * @brief 标记本次执行要触发的输入事件索引
-     *        执行脚本后，会调用用户脚本的 input_event_handler(index)
+     * @brief 标记输入端口有新数据，唤醒线程调用入口函数
+     *        on_input(port, data) 或 input_event_handler(index)；调用期间重复到达的同一端口只调用一次
      * @param index 输入端口索引（>=0 生效）
      */
     void setInputEventIndex(int index);
 
+    /**
+     * @brief 获取脚本执行耗时统计（线程安全）
+     */
+    PythonExecutionStats getExecutionStats() const;
+
 protected:
     /**
      * @brief 线程运行函数
@@ -140,6 +164,27 @@ private:
      */
     bool shouldStop() const;
 
+    /**
+     * @brief 编译脚本并执行脚本主体，缓存代码对象与入口函数（需已激活子解释器）
+     * @return 是否成功
+     */
+    bool loadCompiledScript(const QString& script, bool recompile);
+
+    /**
+     * @brief 以各端口最新数据批量调用入口函数
+     */
+    void processPendingInputs();
+
+    /**
+     * @brief 记录一次调用耗时，按间隔发出 statsUpdated
+     */
+    void recordInvocation(qint64 nsecs);
+
+    /**
+     * @brief 释放缓存的 Python 对象（需已激活子解释器）
+     */
+    void releaseCachedObjects();
+
 private slots:
     /**
      * @brief 获取输入值（Python接口）
@@ -182,11 +227,20 @@ signals:
      */
     void messageReceived(const QString& message);
 
+    /**
+     * @brief 执行耗时统计更新信号（最多每 StatsIntervalMs 发出一次）
+     * @param stats 当前统计
+     */
+    void statsUpdated(const Nodes::PythonExecutionStats& stats);
+
 private:
     // Python解释器相关
     std::optional<py::subinterpreter> m_subInterpreter;  // 子解释器
     py::module_ m_mainModule;                            // Python主模块
     QString m_script;                                    // Python脚本内容
+    py::object m_compiledCode;                           // 缓存的脚本代码对象
+    py::object m_onInput;                                // on_input(port, data) 入口（可为空）
+    py::object m_inputEventHandler;                      // input_event_handler(index) 入口（可为空）
     
     // 线程控制
     std::atomic<bool> m_stopRequested{false};  // 停止请求标志
@@ -197,7 +251,14 @@ private:
     // 数据存储
     QMap<int, QVariantMap> m_inputData;        // 输入数据
     QMap<int, QVariantMap> m_outputData;       // 输出数据
+    std::set<int> m_pendingInputs;             // 待调用入口函数的输入端口（按端口合并）
+    std::atomic<bool> m_inputsPending{false};  // 是否有待处理的输入事件
     mutable QMutex m_dataMutex;                // 数据访问互斥锁
+
+    // 执行耗时统计
+    PythonExecutionStats m_stats;
+    mutable QMutex m_statsMutex;
+    QElapsedTimer m_statsClock;
     
     // 端口配置
     int m_inputPortCount{4};                   // 输入端口数量
@@ -206,11 +267,6 @@ private:
     // 脚本执行控制
     bool m_scriptChanged{false};
 
-    /**
-     * @brief 待触发的输入事件索引；<0 表示不触发
-     */
-    int m_pendingInputIndex{-1};
-
     /**
      * @brief 标记是否已调用过 init_interface（当脚本变更会重置）
      */
@@ -223,4 +279,6 @@ private:
     int m_lastInputIndex{-1};
 };
 
-} // namespace Nodes
\ No newline at end of file
+} // namespace Nodes
+
+Q_DECLARE_METATYPE(Nodes::PythonExecutionStats)
\ No newline at end of file
@@ -3,11 +3,11 @@ def init_interface():
     # 这里可创建/更新 UI（通过 C++ 暴露的控件 API），示例不做 UI。
     print("Python界面初始化完成")
 
-# input_event_handler(index): 每次某个输入端口更新时触发
-def input_event_handler(index):
-    # 读取输入端口数据（QVariantMap 已转换为 Python dict/嵌套结构）
-    data = worker.get_input_value(index)
-    print(f"输入端口 {index} 的数据:", data)
+# on_input(port, data): 每次某个输入端口更新时触发，data 为该端口最新数据
+# （QVariantMap 已转换为 Python dict/嵌套结构）。脚本只在保存时编译并执行一次，
+# 之后每个输入事件直接调用本函数；旧脚本的 input_event_handler(index) 仍然支持。
+def on_input(port, data):
+    print(f"输入端口 {port} 的数据:", data)
 
     # 假设 Data Info 结构中 default.channels 是一个列表
     default = data.get("default", {})
@@ -110,6 +110,8 @@ namespace Nodes
             connect(client, &TcpClient::isReady, this, &TSETLDataModel::onConnectionStatusChanged, Qt::QueuedConnection);
             connect(client, &TcpClient::recMsg, this, &TSETLDataModel::recMsg, Qt::QueuedConnection);
             connect(this, &TSETLDataModel::stopTCPClient, client, &TcpClient::stopTimer, Qt::QueuedConnection);
+            // TSETL 帧：0xFBFBFBFB + 2字节小端长度 + JSON + 2字节CRC，按帧交给 parseTSETLMessage，拆包/粘包由分帧层处理
+            client->setFraming(FramingConfig::lengthPrefixed(2, false, QByteArray("\xFB\xFB\xFB\xFB", 4), 2));
 
             // Initial sync
             widget->hostEdit->setText(m_host);
@@ -4,9 +4,15 @@
 
 #include "TimeLineNodeModel.h"
 #include <QMessageBox>
-TimeLineNodeModel::TimeLineNodeModel(QObject* parent):m_clock(new TimeLineNodeClock(this))
+TimeLineNodeModel::TimeLineNodeModel(QObject* parent):m_clock(new TimeLineNodeClock(this)),m_clipIndex(new TimelineClipIndex(this))
 {
     connect(m_clock,&TimeLineNodeClock::currentFrameChanged,this,&TimeLineNodeModel::onGetClipCurrentData);
+    // 时间轴结构变化时剪辑索引失效（剪辑起止帧变化与销毁由索引自行监听）
+    connect(this,&QAbstractItemModel::rowsInserted,m_clipIndex,&TimelineClipIndex::invalidate);
+    connect(this,&QAbstractItemModel::rowsRemoved,m_clipIndex,&TimelineClipIndex::invalidate);
+    connect(this,&QAbstractItemModel::rowsMoved,m_clipIndex,&TimelineClipIndex::invalidate);
+    connect(this,&QAbstractItemModel::modelReset,m_clipIndex,&TimelineClipIndex::invalidate);
+    connect(this,&QAbstractItemModel::layoutChanged,m_clipIndex,&TimelineClipIndex::invalidate);
 }
 
 QJsonObject TimeLineNodeModel::save() const
@@ -26,6 +32,7 @@ void TimeLineNodeModel::load(const QJsonObject& json)
         qCritical() << tr("基础数据加载失败:\n%1").arg(e.what());
         return;
     }
+    m_clipIndex->invalidate();
 
     try { // 时钟数据加载
         m_clock->load(json["clock"].toObject());
@@ -67,6 +74,7 @@ qint64 TimeLineNodeModel::getPlayheadPos() const
 
 qint64 TimeLineNodeModel::onUpdateTimeLineLength()
 {
+    m_clipIndex->invalidate();
     m_clock->setMaxFrames(BaseTimeLineModel::onUpdateTimeLineLength());
     return m_clock->getMaxFrames();
 }
@@ -78,19 +86,13 @@ TimeCodeType TimeLineNodeModel::getTimeCodeType() const
 
 QList<QVariantMap> TimeLineNodeModel::onGetClipCurrentData(qint64 currentFrame) const {
     QList<QVariantMap> clipDataList;
-    // 遍历所有轨道
-    for (TrackData* track : getTracks()) {
-        // 遍历轨道中的所有片段
-
-        for (AbstractClipModel* clip : track->clips) {
-            // 检查当前帧是否在片段范围内
-            if (currentFrame >= clip->start() && currentFrame <= clip->end()) {
-                // 获取片段在当前帧的数据
-                QVariantMap data = clip->currentData(currentFrame);
-                if(!data.isEmpty()) {
-                    clipDataList.append(data);
-                }
-            }
+    // 只遍历该帧处于活动区间的剪辑（按轨道顺序）；复制列表（隐式共享），剪辑回调中索引重建不影响本次遍历
+    const QList<AbstractClipModel*> activeClips = clipIndex()->activeClips(currentFrame);
+    for (AbstractClipModel* clip : activeClips) {
+        // 获取片段在当前帧的数据
+        QVariantMap data = clip->currentData(currentFrame);
+        if(!data.isEmpty()) {
+            clipDataList.append(data);
         }
     }
     return clipDataList;
@@ -99,84 +101,102 @@ QList<QVariantMap> TimeLineNodeModel::onGetClipCurrentData(qint64 currentFrame)
 QVariant TimeLineNodeModel::clipData(ClipId clipID, TimelineRoles role) const
 {
     QVariant result;
-    // 遍历所有轨道查找指定的片段
-    for (const auto& track : m_tracks) {
-        for (const auto& clip : track->clips) {
-            if (clip->id() == clipID) {
-                switch (role) {
-                    case ClipIdRole:
-                        result=clip->id();
-                        break;
-                    case ClipInRole:
-                         result=clip->start();
-                        break;
-                    case ClipOutRole:
-                         result=clip->end();
-                        break;
-                    case ClipLengthRole:
-                        result=clip->end() - clip->start();
-                    case ClipTypeRole:
-                        result=clip->type();
-                        break;
-                    case ClipShowWidgetRole:
-                        result=clip->isEmbedWidget();
-                        break;
-                    // case ClipResizableRole:
-                    //     return QVariant::fromValue(clip->isResizeable());
-                    case ClipShowBorderRole:
-                        result=clip->isShowBorder();
-                        break;
-                    case ClipModelRole:
-                        result= QVariant::fromValue(clip);
-                        break;
-                    case ClipOscWidgetsRole:
-                        result=QVariant::fromValue(clip->getExternalControlAddressMapping());
-                        break;
-                    default:
-                        break;
-                }
-            }
-        }
+    AbstractClipModel* clip = clipIndex()->clip(clipID);
+    if (!clip) {
+        return result;
+    }
+    switch (role) {
+        case ClipIdRole:
+            result=clip->id();
+            break;
+        case ClipInRole:
+             result=clip->start();
+            break;
+        case ClipOutRole:
+             result=clip->end();
+            break;
+        case ClipLengthRole:
+            result=clip->end() - clip->start();
+        case ClipTypeRole:
+            result=clip->type();
+            break;
+        case ClipShowWidgetRole:
+            result=clip->isEmbedWidget();
+            break;
+        // case ClipResizableRole:
+        //     return QVariant::fromValue(clip->isResizeable());
+        case ClipShowBorderRole:
+            result=clip->isShowBorder();
+            break;
+        case ClipModelRole:
+            result= QVariant::fromValue(clip);
+            break;
+        case ClipOscWidgetsRole:
+            result=QVariant::fromValue(clip->getExternalControlAddressMapping());
+            break;
+        default:
+            break;
     }
     return result;
 }
 
 bool TimeLineNodeModel::setClipData(ClipId clipID, TimelineRoles role, QVariant value)
 {
-    // 遍历所有轨道查找指定的片段
-    for (auto& track : m_tracks) {
-        for (auto& clip : track->clips) {
-            if (clip->id() == clipID) {
-                bool success = false;
-                switch (role) {
-                    case ClipInRole:
-                        clip->setStart(value.toInt());
-                        success = true;
-                        break;
-                    case ClipOutRole:
-                        clip->setEnd(value.toInt());
-                        success = true;
-                        break;
-                    case ClipShowWidgetRole:
-                        clip->setEmbedWidget(value.toBool());
-                        success = true;
-                        break;
-                    // case ClipResizableRole:
-                    //     clip->setResizeable(value.toBool());
-                    //     success = true;
-                    //     break;
-                    case ClipShowBorderRole:
-                        clip->setShowBorder(value.toBool());
-                        success = true;
-                        break;
-                }
-                if (success) {
-                    // 发出数据改变信号
-                    emit dataChanged(createIndex(0, 0), createIndex(rowCount(), 0));
-                    return true;
-                }
+    AbstractClipModel* clip = clipIndex()->clip(clipID);
+    if (!clip) {
+        return false;
+    }
+    bool success = false;
+    switch (role) {
+        case ClipInRole:
+            clip->setStart(value.toInt());
+            m_clipIndex->invalidate();
+            success = true;
+            break;
+        case ClipOutRole:
+            clip->setEnd(value.toInt());
+            m_clipIndex->invalidate();
+            success = true;
+            break;
+        case ClipShowWidgetRole:
+            clip->setEmbedWidget(value.toBool());
+            success = true;
+            break;
+        // case ClipResizableRole:
+        //     clip->setResizeable(value.toBool());
+        //     success = true;
+        //     break;
+        case ClipShowBorderRole:
+            clip->setShowBorder(value.toBool());
+            success = true;
+            break;
+    }
+    if (success) {
+        // 发出数据改变信号
+        emit dataChanged(createIndex(0, 0), createIndex(rowCount(), 0));
+    }
+    return success;
+}
+
+/**
+ * 函数级注释：获取剪辑索引
+ * - 剪辑总数与索引不一致（增删剪辑未经模型信号通知）时同样重建
+ */
+TimelineClipIndex* TimeLineNodeModel::clipIndex() const
+{
+    int clipCount = 0;
+    for (TrackData* track : getTracks()) {
+        clipCount += int(track->clips.size());
+    }
+    if (!m_clipIndex->isValid(clipCount)) {
+        QList<AbstractClipModel*> clips;
+        clips.reserve(clipCount);
+        for (TrackData* track : getTracks()) {
+            for (AbstractClipModel* clip : track->clips) {
+                clips.append(clip);
             }
         }
+        m_clipIndex->rebuild(clips);
     }
-    return false;
+    return m_clipIndex;
 }
@@ -7,6 +7,7 @@
 #include  "TimeCodeDefines.h"
 #include "TimeLineNodeClock.hpp"
 #include "TimeLineDefines.h"
+#include "Common/BaseClass/TimelineClipIndex.h"
 class TimeLineNodeModel : public BaseTimeLineModel {
     Q_OBJECT
 
@@ -42,6 +43,13 @@ public slots:
 
     QList<QVariantMap> onGetClipCurrentData(qint64 currentFrame) const;
 private:
+    /**
+     * 获取剪辑索引，失效时按当前轨道重建
+     */
+    TimelineClipIndex* clipIndex() const;
+
     //时钟对象
     TimeLineNodeClock* m_clock;
+    // 剪辑区间索引与 ClipId 索引
+    TimelineClipIndex* m_clipIndex;
 };
\ No newline at end of file
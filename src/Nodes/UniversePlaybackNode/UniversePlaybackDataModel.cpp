@@ -241,8 +241,7 @@ QString UniversePlaybackDataModel::portCaption(QtNodes::PortType portType, QtNod
 NodeDataType UniversePlaybackDataModel::dataType(PortType portType, PortIndex portIndex) const
 {
     Q_UNUSED(portIndex)
-    Q_UNUSED(portType)
-    return VariableData().type();
+    return portType == PortType::Out ? DmxUniverseData().type() : VariableData().type();
 }
 
 std::shared_ptr<NodeData> UniversePlaybackDataModel::outData(PortIndex const port)
@@ -423,8 +422,7 @@ void UniversePlaybackDataModel::adjustUniverseCount(int videoHeight)
             universeData.fill(char(0x00));
             dmxDataList.append(universeData);
 
-            auto outputData = std::make_shared<VariableData>();
-            universeOutputs.append(outputData);
+            universeOutputs.append(std::make_shared<DmxUniverseData>());
         }
 
         currentUniverseCount = newUniverseCount;
@@ -636,39 +634,20 @@ void UniversePlaybackDataModel::updateUniverseData(int universeIndex) {
         return;
     }
 
-    universeOutputs[universeIndex] = std::make_shared<VariableData>();
-
-    QVariantMap artnetPacket;
-
-    artnetPacket["protocol"] = "Art-Net";
-    artnetPacket["version"] = 14;
-    artnetPacket["opcode"] = 0x5000;
+    // 下游未持有上一帧输出时原地复用，稳态下每帧不分配内存
+    std::shared_ptr<DmxUniverseData>& output = universeOutputs[universeIndex];
+    if (!output || output.use_count() > 1) {
+        output = std::make_shared<DmxUniverseData>();
+    }
 
     int baseUniverse = m_universe;
     int subnet = m_subnet;
     int net = m_net;
     int currentUniverse = (baseUniverse + universeIndex) % 16;
-
-    artnetPacket["universe"] = currentUniverse;
-    artnetPacket["subnet"] = subnet;
-    artnetPacket["net"] = net;
-
     int fullUniverse = (net << 8) | (subnet << 4) | currentUniverse;
-    artnetPacket["fullUniverse"] = fullUniverse;
-
-    QVariantList dmxList;
-    const QByteArray& dmx = dmxDataList[universeIndex];
-    dmxList.reserve(512);
-    for (int i = 0; i < 512; ++i) {
-        dmxList.append(int(static_cast<unsigned char>(dmx[i])));
-    }
-    artnetPacket["dmxData"] = dmxList;
-    artnetPacket["dataLength"] = 512;
 
-    int activeChannels = 0;
-    artnetPacket["activeChannels"] = activeChannels;
-    artnetPacket["timestamp"] = QDateTime::currentMSecsSinceEpoch();
-    
-    universeOutputs[universeIndex]->insert("default", artnetPacket);
+    output->setUniverse(fullUniverse);
+    output->setChannels(dmxDataList[universeIndex]);
+    output->setTimestamp(QDateTime::currentMSecsSinceEpoch());
     Q_EMIT dataUpdated(universeIndex);
 }
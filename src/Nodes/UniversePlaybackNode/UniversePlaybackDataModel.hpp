@@ -197,7 +197,7 @@ private:
 
     // 数据存储（动态大小）
     QList<QByteArray> dmxDataList;                    // 动态数量的Universe的512通道DMX数据
-    QList<std::shared_ptr<VariableData>> universeOutputs; // 动态数量的Universe输出数据
+    QList<std::shared_ptr<DmxUniverseData>> universeOutputs; // 动态数量的Universe输出数据
     
     qint64 m_currentTimestampMs {0};
 
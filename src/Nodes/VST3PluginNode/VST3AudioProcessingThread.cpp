@@ -13,8 +13,8 @@ VST3AudioProcessingThread::VST3AudioProcessingThread(QObject* parent)
     : QThread(parent)
     , running_(0)
     , paused_(0)
-    , sampleRate_(48000.0)
-    , blockSize_(2048)
+    , sampleRate_(TimestampGenerator::getInstance()->getSampleRate())
+    , blockSize_(TimestampGenerator::getInstance()->getBlockSize())
     , lastProcessTimestamp_(0)
     , audioEffect_(nullptr)
     , processingData_(nullptr)
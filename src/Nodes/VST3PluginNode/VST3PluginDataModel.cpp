@@ -23,8 +23,8 @@ VST3PluginDataModel::VST3PluginDataModel(const QString& path){
     widget = new VST3PluginInterface();
 
     // 初始化音频处理参数
-    sampleRate_ = 48000;
-    blockSize_ = sampleRate_/TimestampGenerator::getInstance()->getFrameRate();
+    sampleRate_ = TimestampGenerator::getInstance()->getSampleRate();
+    blockSize_ = TimestampGenerator::getInstance()->getBlockSize();
 
     // 创建音频处理线程
     audioProcessingThread_ = std::make_unique<VST3AudioProcessingThread>(this);
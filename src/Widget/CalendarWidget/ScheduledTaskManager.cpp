@@ -1,49 +1,231 @@
 #include "ScheduledTaskManager.hpp"
 
+#include <functional>
+#include <queue>
+#include <vector>
 #include "StatusContainer/StatusContainer.h"
 
 /**
- * @brief 构造：可选传入模型，默认不启动定时器
+ * @brief 调度线程：最小堆保存每个任务的下一次触发时刻，单次精确定时器只等待堆顶
+ *
+ * 截止时间使用墙上时钟（毫秒时间戳），定时器每次最多睡眠 MaxSleepMs，
+ * 醒来后只检查堆顶，因此系统时间跳变或挂起恢复后能在一秒内发现错过的触发。
+ */
+class ScheduledTaskWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ScheduledTaskWorker(QObject* parent = nullptr)
+        : QObject(parent), m_timer(new QTimer(this))
+    {
+        m_timer->setSingleShot(true);
+        m_timer->setTimerType(Qt::PreciseTimer);
+        connect(m_timer, &QTimer::timeout, this, &ScheduledTaskWorker::onTimeout);
+    }
+
+public slots:
+    /**
+     * @brief 替换全部调度条目并重新计算触发时刻
+     */
+    void setSchedule(const QVector<ScheduleEntry>& entries)
+    {
+        m_entries = entries;
+        // 定时器运行中时从上次检查之后开始计算，避免重建期间到期的任务被跳过
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const qint64 from = m_timer->isActive() ? qMin(m_lastCheckMs + 1, now) : now;
+        m_heap = Heap();
+        for (int i = 0; i < m_entries.size(); ++i) {
+            const qint64 next = nextFireAtOrAfter(m_entries.at(i), from);
+            if (next >= 0) {
+                m_heap.push({next, i});
+            }
+        }
+        arm();
+    }
+
+    void start()
+    {
+        m_running = true;
+        m_lastCheckMs = QDateTime::currentMSecsSinceEpoch();
+        arm();
+    }
+
+    void stop()
+    {
+        m_running = false;
+        m_timer->stop();
+    }
+
+    void setTolerance(int toleranceMs)
+    {
+        m_toleranceMs = qMax(0, toleranceMs);
+    }
+
+    void setCatchUpPolicy(int policy)
+    {
+        m_policy = policy;
+    }
+
+signals:
+    void taskDue(const ScheduledTaskItem& item, qint64 lateMs);
+
+private slots:
+    /**
+     * @brief 依次弹出所有已到期的条目；触发后从当前时刻起计算下一次，错过的多次循环只处理一次
+     */
+    void onTimeout()
+    {
+        if (!m_running) return;
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        while (!m_heap.empty() && m_heap.top().atMs <= now) {
+            const Deadline due = m_heap.top();
+            m_heap.pop();
+            const ScheduleEntry& entry = m_entries.at(due.entry);
+            const qint64 lateMs = now - due.atMs;
+            if (lateMs <= m_toleranceMs || m_policy == ScheduledTaskManager::FireOnceIfMissed) {
+                emit taskDue(entry.item, lateMs);
+            } else {
+                qWarning() << "Scheduled task missed" << entry.item.remarks << "late by" << lateMs << "ms";
+            }
+            const qint64 next = nextFireAtOrAfter(entry, now + 1);
+            if (next >= 0) {
+                m_heap.push({next, due.entry});
+            }
+        }
+        m_lastCheckMs = now;
+        arm();
+    }
+
+private:
+    struct Deadline {
+        qint64 atMs;
+        int entry;
+        bool operator>(const Deadline& other) const { return atMs > other.atMs; }
+    };
+    using Heap = std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>;
+
+    /**
+     * @brief 等待到堆顶截止时间（最长 MaxSleepMs）
+     */
+    void arm()
+    {
+        if (!m_running || m_heap.empty()) {
+            m_timer->stop();
+            return;
+        }
+        const qint64 wait = m_heap.top().atMs - QDateTime::currentMSecsSinceEpoch();
+        m_timer->start(int(qBound<qint64>(0, wait, ScheduledTaskManager::MaxSleepMs)));
+    }
+
+    /**
+     * @brief 计算条目在 fromMs（含）之后的第一次触发时刻；没有则返回 -1
+     */
+    static qint64 nextFireAtOrAfter(const ScheduleEntry& entry, qint64 fromMs)
+    {
+        if (entry.once) {
+            return entry.onceAtMs >= fromMs ? entry.onceAtMs : -1;
+        }
+        const QDate today = QDateTime::fromMSecsSinceEpoch(fromMs).date();
+        // 今天的时刻可能已过，最多向后看 7 天
+        for (int i = 0; i <= 7; ++i) {
+            const QDate day = today.addDays(i);
+            if (!(entry.dayMask & (1u << (day.dayOfWeek() - 1)))) continue;
+            const qint64 at = QDateTime(day, entry.timeOfDay).toMSecsSinceEpoch();
+            if (at >= fromMs) return at;
+        }
+        return -1;
+    }
+
+private:
+    QTimer* m_timer;
+    QVector<ScheduleEntry> m_entries;
+    Heap m_heap;
+    qint64 m_lastCheckMs = 0;
+    int m_toleranceMs = 1000;
+    int m_policy = ScheduledTaskManager::FireOnceIfMissed;
+    bool m_running = false;
+};
+
+/**
+ * @brief 构造：创建调度线程，可选传入模型，默认不启动
  */
 ScheduledTaskManager::ScheduledTaskManager(ScheduledTaskModel* model, QObject* parent)
-    : QObject(parent), m_model(model) {
-    connect(&m_timer, &QTimer::timeout, this, &ScheduledTaskManager::onTick);
+    : QObject(parent) {
+    qRegisterMetaType<ScheduledTaskItem>("ScheduledTaskItem");
+    qRegisterMetaType<QVector<ScheduleEntry>>("QVector<ScheduleEntry>");
+
+    m_rebuildTimer.setSingleShot(true);
+    m_rebuildTimer.setInterval(RebuildDelayMs);
+    connect(&m_rebuildTimer, &QTimer::timeout, this, &ScheduledTaskManager::rebuildSchedule);
+
+    m_thread = new QThread(this);
+    auto* worker = new ScheduledTaskWorker();
+    worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, worker, &ScheduledTaskWorker::deleteLater);
+    connect(this, &ScheduledTaskManager::scheduleRequested, worker, &ScheduledTaskWorker::setSchedule);
+    connect(this, &ScheduledTaskManager::startRequested, worker, &ScheduledTaskWorker::start);
+    connect(this, &ScheduledTaskManager::stopRequested, worker, &ScheduledTaskWorker::stop);
+    connect(this, &ScheduledTaskManager::setToleranceRequested, worker, &ScheduledTaskWorker::setTolerance);
+    connect(this, &ScheduledTaskManager::setCatchUpPolicyRequested, worker, &ScheduledTaskWorker::setCatchUpPolicy);
+    connect(worker, &ScheduledTaskWorker::taskDue, this, &ScheduledTaskManager::onTaskDue);
+    m_thread->start();
+
+    setModel(model);
 }
 
 /**
- * @brief 析构：停止定时器
+ * @brief 析构：停止调度并结束线程
  */
 ScheduledTaskManager::~ScheduledTaskManager() {
     stop();
+    m_thread->quit();
+    m_thread->wait();
 }
 
 /**
- * @brief 设置模型（可在运行时切换）
+ * @brief 设置模型（可在运行时切换），模型的任何修改都会触发重建
  */
 void ScheduledTaskManager::setModel(ScheduledTaskModel* model) {
+    if (m_model) {
+        disconnect(m_model, nullptr, this, nullptr);
+    }
     m_model = model;
-    m_lastTriggerTime.clear();
+    if (m_model) {
+        connect(m_model, &ScheduledTaskModel::modelChanged, this, &ScheduledTaskManager::scheduleRebuild);
+        connect(m_model, &QAbstractItemModel::dataChanged, this, &ScheduledTaskManager::scheduleRebuild);
+        connect(m_model, &QAbstractItemModel::modelReset, this, &ScheduledTaskManager::scheduleRebuild);
+        connect(m_model, &QAbstractItemModel::rowsInserted, this, &ScheduledTaskManager::scheduleRebuild);
+        connect(m_model, &QAbstractItemModel::rowsRemoved, this, &ScheduledTaskManager::scheduleRebuild);
+    }
+    scheduleRebuild();
 }
 
 /**
- * @brief 启动轮询
+ * @brief 启动调度
  */
-void ScheduledTaskManager::start(int intervalMs) {
-    m_timer.start(intervalMs);
+void ScheduledTaskManager::start() {
+    emit startRequested();
 }
 
 /**
- * @brief 停止轮询
+ * @brief 停止调度
  */
 void ScheduledTaskManager::stop() {
-    m_timer.stop();
+    emit stopRequested();
 }
 
 /**
  * @brief 设置秒级容差
  */
 void ScheduledTaskManager::setToleranceSeconds(int seconds) {
-    m_toleranceSec = qMax(0, seconds);
+    emit setToleranceRequested(qMax(0, seconds) * 1000);
+}
+
+/**
+ * @brief 设置追补策略
+ */
+void ScheduledTaskManager::setCatchUpPolicy(CatchUpPolicy policy) {
+    emit setCatchUpPolicyRequested(policy);
 }
 
 /**
@@ -53,105 +235,62 @@ void ScheduledTaskManager::setToleranceSeconds(int seconds) {
 //     m_useQueue = useQueue;
 // }
 
+void ScheduledTaskManager::scheduleRebuild() {
+    m_rebuildTimer.start();
+}
+
 /**
- * @brief 定时器回调：轮询并执行任务
- * 
- * 逻辑：
- * - 遍历模型中的所有任务项
- * - 按类型分别判断是否应触发
- * - 触发则发送 OSC，并发出 taskExecuted 信号
+ * @brief 编译当前模型的全部任务并交给调度线程
  */
-void ScheduledTaskManager::onTick() {
-    if (!m_model) return;
-
-    const auto& items = m_model->items();
-    const QDateTime now = QDateTime::currentDateTime();
-
-    for (const auto& item : items) {
-        bool fire = false;
-        if (item.scheduled.type.compare("once", Qt::CaseInsensitive) == 0) {
-            fire = shouldTriggerOnce(item, now);
-        } else {
-            fire = shouldTriggerLoop(item, now);
-        }
-
-        if (fire) {
-            qDebug()<<"The scheduled task has been carried out"<<item.remarks<<item.scheduled.time.toString("yyyy-MM-dd hh:mm:ss");
-            executeTask(item.osc);
-            emit taskExecuted(item);
+void ScheduledTaskManager::rebuildSchedule() {
+    QVector<ScheduleEntry> entries;
+    if (m_model) {
+        const auto& items = m_model->items();
+        entries.reserve(items.size());
+        for (const auto& item : items) {
+            ScheduleEntry entry;
+            if (compileItem(item, entry)) {
+                entries.append(entry);
+            }
         }
     }
+    emit scheduleRequested(entries);
 }
 
 /**
- * @brief 判断一次性任务是否应触发
- * 
- * 规则：
- * - 若当前时间 >= 计划时间，且未触发过则触发
- * - 容差仅用于靠近计划时间的提前/延后触发允许窗口
+ * @brief 调度线程报告任务到期：在界面线程派发 OSC
  */
-bool ScheduledTaskManager::shouldTriggerOnce(const ScheduledTaskItem& item, const QDateTime& now) {
-    /**
-     * @brief 一次性任务触发判定（仅在到达设定时间点触发，过时不处理）
-     *
-     * 规则：
-     * - 当前日期必须与计划日期相同
-     * - 当前“时分秒”未超过计划时间（不允许过时触发）
-     * - 当前时间与计划时间的差值在容差秒数以内（容差默认 1 秒）
-     *   若需要严格“只有相同时才触发”，请将容差设置为 0（setToleranceSeconds(0)）
-     */
-    const QDateTime sched = item.scheduled.time;
-    if (!sched.isValid()) return false;
-
-    const QString key = keyForItem(item);
-    // 日期必须相同
-    if (now.date() != sched.date()) return false;
-
-    // 计算“计划时间 - 当前时间”的毫秒差值
-    const int diffMs = sched.time().msecsSinceStartOfDay() - now.time().msecsSinceStartOfDay();
-
-    // 仅允许在计划时间点到来之前/刚到时触发；已过时（diffMs < 0）不触发
-    if (diffMs >= 0 && diffMs <= m_toleranceSec * 1000) {
-
-        return true;
-    }
-    return false;
+void ScheduledTaskManager::onTaskDue(const ScheduledTaskItem& item, qint64 lateMs) {
+    qDebug()<<"The scheduled task has been carried out"<<item.remarks<<item.scheduled.time.toString("yyyy-MM-dd hh:mm:ss")
+            <<(lateMs > 0 ? QString("(late %1 ms)").arg(lateMs) : QString());
+    executeTask(item.osc);
+    emit taskExecuted(item);
 }
 
 /**
- * @brief 判断循环任务是否应触发
- * 
+ * @brief 把任务项编译为调度条目
+ *
  * 规则：
- * - 星期条件匹配（conditions 为空视为每天）
- * - 当前时间与计划的“时:分:秒”匹配（秒级容差）
- * - 防抖：同一任务同一天同一分钟只触发一次
+ * - once：计划的完整日期时间，已过时的任务不会被调度
+ * - loop：计划时间的时分秒，在 conditions 列出的星期触发；conditions 为空视为无效配置
  */
-bool ScheduledTaskManager::shouldTriggerLoop(const ScheduledTaskItem& item, const QDateTime& now) {
-    const QTime schedTime = item.scheduled.time.time();
-    if (!schedTime.isValid()) return false;
-
-    // 星期匹配：conditions 为空视为无效配置；否则必须包含当前星期名
-    const int dow = now.date().dayOfWeek(); // 1..7（周一=1）
-    const QString dowName = ScheduledTaskModel::dayOfWeekToName(dow);
-    const auto& conds = item.scheduled.conditions;
-    const bool dayMatch = conds.contains(dowName, Qt::CaseInsensitive);
-    if (!dayMatch) return false;
-
-    // 时间匹配（容差秒）
-    const int diffMs = now.time().msecsSinceStartOfDay() - schedTime.msecsSinceStartOfDay();
-    if (diffMs < 0 || diffMs > m_toleranceSec * 1000) return false;
-
-    // // 防抖：避免在同一分钟内重复触发
-    // const QString key = keyForItem(item);
-    // const auto last = m_lastTriggerTime.value(key);
-    // if (last.isValid()) {
-    //     const bool sameDay = (last.date() == now.date());
-    //     const bool sameMinute = (last.time().hour() == now.time().hour() &&
-    //                              last.time().minute() == now.time().minute());
-    //     if (sameDay && sameMinute) return false;
-    // }
-    // m_lastTriggerTime.insert(key, now);
-    return true;
+bool ScheduledTaskManager::compileItem(const ScheduledTaskItem& item, ScheduleEntry& entry) {
+    entry.item = item;
+    entry.once = item.scheduled.type.compare("once", Qt::CaseInsensitive) == 0;
+    if (entry.once) {
+        if (!item.scheduled.time.isValid()) return false;
+        entry.onceAtMs = item.scheduled.time.toMSecsSinceEpoch();
+        return true;
+    }
+    entry.timeOfDay = item.scheduled.time.time();
+    if (!entry.timeOfDay.isValid()) return false;
+    entry.dayMask = 0;
+    for (int dow = 1; dow <= 7; ++dow) {
+        if (item.scheduled.conditions.contains(ScheduledTaskModel::dayOfWeekToName(dow), Qt::CaseInsensitive)) {
+            entry.dayMask |= quint8(1u << (dow - 1));
+        }
+    }
+    return entry.dayMask != 0;
 }
 
 /**
@@ -165,17 +304,4 @@ void ScheduledTaskManager::executeTask(const OSCMessage& msg) {
     // }
 }
 
-/**
- * @brief 生成稳定键，用于标记/防抖
- */
-QString ScheduledTaskManager::keyForItem(const ScheduledTaskItem& item) {
-    const auto& s = item.scheduled;
-    const auto& o = item.osc;
-    return QString("%1|%2|%3|%4|%5|%6")
-        .arg(s.type)
-        .arg(s.time.toString(Qt::ISODate))
-        .arg(o.host)
-        .arg(o.port)
-        .arg(o.address)
-        .arg(o.value.toString());
-}
\ No newline at end of file
+#include "ScheduledTaskManager.moc"
@@ -3,24 +3,53 @@
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
-#include <QSet>
-#include <QMap>
+#include <QThread>
+#include <QVector>
 #include <QString>
 #include "ScheduledTaskModel.hpp"
 // #include "../../Common/Devices/OSCSender/OSCSender.h"
 
+/**
+ * @brief 预编译后的调度条目（类型与星期条件只在编译时解析一次）
+ */
+struct ScheduleEntry {
+    ScheduledTaskItem item;   // 任务快照（隐式共享），触发时原样交回界面线程
+    bool once = true;         // once：一次性；否则按星期循环
+    qint64 onceAtMs = 0;      // 一次性任务的触发时刻（毫秒时间戳）
+    QTime timeOfDay;          // 循环任务的时分秒（含毫秒）
+    quint8 dayMask = 0;       // 循环任务的星期掩码，bit0 = 周一 … bit6 = 周日
+};
+Q_DECLARE_METATYPE(ScheduledTaskItem)
+Q_DECLARE_METATYPE(ScheduleEntry)
+Q_DECLARE_METATYPE(QVector<ScheduleEntry>)
+
 /**
  * @brief 计划任务执行器
- * 
+ *
  * 职责：
- * - 轮询 ScheduledTaskModel 的任务，根据当前时间判断是否触发
- * - 支持 once（一次性）与 loop（循环）两种任务类型
- * - 触发后通过 OSCSender 发送 OSC 消息
- * - 内置防重复与容差控制，避免同一时间点重复触发
+ * - 模型变化时把 ScheduledTaskModel 的任务编译成调度条目，交给独立线程
+ * - 调度线程为每个任务预先计算下一次触发时刻并放入最小堆，只睡眠到最近的截止时间
+ * - 支持 once（一次性）与 loop（循环）两种任务类型，触发后重新计算下一次时刻
+ * - 睡眠期间（如系统挂起）错过的任务按追补策略处理
+ * - 触发后在界面线程通过 StatusContainer 派发 OSC 消息
  */
 class ScheduledTaskManager : public QObject {
     Q_OBJECT
 public:
+    /**
+     * @brief 错过触发时刻的处理方式
+     * - SkipMissed：丢弃错过的触发，直接等待下一次
+     * - FireOnceIfMissed：补发一次（循环任务错过多次也只补一次），再等待下一次
+     */
+    enum CatchUpPolicy {
+        SkipMissed,
+        FireOnceIfMissed
+    };
+    Q_ENUM(CatchUpPolicy)
+
+    static constexpr int MaxSleepMs = 1000;          // 单次最长睡眠，用于发现系统时间跳变与挂起
+    static constexpr int RebuildDelayMs = 0;         // 模型连续修改时合并为一次重建
+
     /**
      * @brief 构造函数
      * @param model 可选的任务模型（可后续 setModel 替换）
@@ -40,22 +69,27 @@ public:
     void setModel(ScheduledTaskModel* model);
 
     /**
-     * @brief 启动定时轮询
-     * @param intervalMs 轮询间隔（毫秒），默认 1000ms
+     * @brief 启动调度
      */
-    void start(int intervalMs = 1000);
+    void start();
 
     /**
-     * @brief 停止定时轮询
+     * @brief 停止调度
      */
     void stop();
 
     /**
-     * @brief 设置触发容差秒数（用于时间对比，默认 1 秒）
+     * @brief 设置触发容差秒数：超过截止时间该秒数后才执行的触发视为“错过”，按追补策略处理（默认 1 秒）
      * @param seconds 容差秒
      */
     void setToleranceSeconds(int seconds);
 
+    /**
+     * @brief 设置错过触发时刻的追补策略（默认 FireOnceIfMissed）
+     * @param policy 追补策略
+     */
+    void setCatchUpPolicy(CatchUpPolicy policy);
+
     /**
      * @brief 设置是否使用队列发送（true：入队列；false：直接发送）
      * @param useQueue 布尔
@@ -69,28 +103,39 @@ signals:
      */
     void taskExecuted(const ScheduledTaskItem& item);
 
+    // 内部信号，用于线程间通信
+    void scheduleRequested(const QVector<ScheduleEntry>& entries);
+    void startRequested();
+    void stopRequested();
+    void setToleranceRequested(int toleranceMs);
+    void setCatchUpPolicyRequested(int policy);
+
 private slots:
     /**
-     * @brief 定时器回调：轮询并执行应触发的任务
+     * @brief 调度线程报告任务到期
+     * @param item 到期的任务项
+     * @param lateMs 相对截止时间的延迟（毫秒）
      */
-    void onTick();
+    void onTaskDue(const ScheduledTaskItem& item, qint64 lateMs);
 
-private:
     /**
-     * @brief 判断一次性任务是否应触发，并记录防重复状态
-     * @param item 任务项
-     * @param now 当前时间
-     * @return 是否应触发
+     * @brief 重新编译任务快照并交给调度线程
+     */
+    void rebuildSchedule();
+
+    /**
+     * @brief 模型变化时延迟重建，合并连续修改
      */
-    bool shouldTriggerOnce(const ScheduledTaskItem& item, const QDateTime& now);
+    void scheduleRebuild();
 
+private:
     /**
-     * @brief 判断循环任务是否应触发，并进行防抖控制
+     * @brief 把任务项编译为调度条目
      * @param item 任务项
-     * @param now 当前时间
-     * @return 是否应触发
+     * @param entry 输出的调度条目
+     * @return 任务是否有效
      */
-    bool shouldTriggerLoop(const ScheduledTaskItem& item, const QDateTime& now);
+    static bool compileItem(const ScheduledTaskItem& item, ScheduleEntry& entry);
 
     /**
      * @brief 发送 OSC 消息（可选择直接或入队列）
@@ -98,18 +143,9 @@ private:
      */
     void executeTask(const OSCMessage& msg);
 
-    /**
-     * @brief 为任务生成稳定键，用于防重复/防抖标识
-     * @param item 任务项
-     * @return 字符串键
-     */
-    static QString keyForItem(const ScheduledTaskItem& item);
-
 private:
-    QTimer m_timer;
+    QThread* m_thread = nullptr;
+    QTimer m_rebuildTimer;
     ScheduledTaskModel* m_model = nullptr;
-    int m_toleranceSec = 1;
     // bool m_useQueue = true;
-    // 循环任务（loop）最近一次触发时间
-    QMap<QString, QDateTime> m_lastTriggerTime;
-};
\ No newline at end of file
+};
@@ -105,9 +105,11 @@ bool ScheduledTaskModel::setData(const QModelIndex& idx, const QVariant& value,
     case RoleRemarks:
         it.remarks = value.toString(); break;
     default:
-        break;
+        return false;
     }
-    return false;
+    // 通知视图与任务执行器（执行器据此重新计算触发时刻）
+    emit dataChanged(idx, idx, {role});
+    return true;
 }
 
 /**
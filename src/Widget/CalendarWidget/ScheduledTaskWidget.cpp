@@ -36,9 +36,9 @@ ScheduledTaskWidget::ScheduledTaskWidget(QWidget* parent)
     // 当 m_model 初始化后，启动任务执行器
     if (!m_manager) {
         m_manager = new ScheduledTaskManager(m_model, this);
-        m_manager->setToleranceSeconds(1);     // 秒级容差
+        m_manager->setToleranceSeconds(1);     // 迟到超过 1 秒视为错过，按追补策略处理
         // m_manager->setUseQueue(true);         // 默认使用队列
-        m_manager->start(1000);                // 每秒轮询一次
+        m_manager->start();                    // 按最近的截止时间精确唤醒
     }
 }
 
@@ -5,21 +5,45 @@
 #include "LogHandler.hpp"
 #include "spdlog/sinks/rotating_file_sink.h"
 
-#include <QTableWidget>
-#include <QVBoxLayout>
-#include <QWidget>
-#include <QHeaderView>
 #include <QDebug>
-#include <QMutex>
+#include <QDateTime>
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/daily_file_sink.h>
-#include <mutex>
+#include <array>
+#include <chrono>
 #include <QDir>
 #include <QMessageBox>
-#include <QRegularExpression>
 #include "../../Common/AppConfig/ConfigManager.h"
 
+namespace {
+    /**
+     * 调用点限流槽：全部为原子量，日志热路径不加锁。
+     * 哈希冲突的调用点共用一个槽，只会让限流略微提前，不影响正确性。
+     */
+    struct CallSiteSlot {
+        std::atomic<qint64> windowStart{0};   // 当前窗口起点（毫秒）
+        std::atomic<quint32> count{0};        // 当前窗口内的条数
+        std::atomic<quint32> suppressed{0};   // 当前窗口内被丢弃的条数
+    };
+
+    std::array<CallSiteSlot, LogHandler::CallSiteSlots> callSites;
+
+    qint64 monotonicMs() {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t callSiteKey(const QMessageLogContext &context, const QString &msg) {
+        if (context.file) {
+            // 文件名是字符串常量，指针即可区分调用点
+            return std::hash<const void *>()(context.file) ^ (size_t(context.line) * 0x9E3779B97F4A7C15ULL);
+        }
+        // Release 版本没有调用点信息，按消息前缀区分
+        return qHash(QStringView(msg).left(32));
+    }
+}
+
 LogHandler::LogHandler(LogWidget *tableWidget) {
     // 设置静态成员
     LogHandler::logTableWidget = tableWidget;
@@ -32,19 +56,26 @@ LogHandler::LogHandler(LogWidget *tableWidget) {
 LogHandler::~LogHandler() {
     // 解除消息处理器
     qInstallMessageHandler(nullptr);
+    // 把异步队列中剩余的日志写盘
+    if (logger) {
+        logger->flush();
+    }
 }
 
 bool LogHandler::initLogHandler() {
-    // 初始化 spdlog 日志器
+    // 初始化 spdlog 异步日志器：格式化与写盘在后台线程完成，队列满时覆盖最旧的记录而不阻塞调用线程
     try{
         QDir().mkpath(AppConstants::LOGS_STORAGE_DIR);
         std::string logFilePath = (AppConstants::LOGS_STORAGE_DIR.toStdString()+"/log.txt");
         auto dailySink = std::make_shared<spdlog::sinks::daily_file_sink_mt>(logFilePath, 0, 0);
-        logger = std::make_shared<spdlog::logger>("logger", dailySink);
+        spdlog::init_thread_pool(QueueSize, 1);
+        logger = std::make_shared<spdlog::async_logger>("logger", dailySink, spdlog::thread_pool(),
+                                                        spdlog::async_overflow_policy::overrun_oldest);
         spdlog::register_logger(logger);
         spdlog::set_default_logger(logger);
         logger->set_level(spdlog::level::debug);  // 设置日志级别
-        logger->flush_on(spdlog::level::debug);   // 确保每条日志立即写入
+        logger->flush_on(spdlog::level::err);     // 错误级别立即写盘，其余定期写盘
+        spdlog::flush_every(std::chrono::seconds(FlushIntervalSec));
         logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");// 设置日志格式，包含文件名和行号
 
         return true;
@@ -55,104 +86,88 @@ bool LogHandler::initLogHandler() {
     }
 }
 
-void LogHandler::customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-    static std::mutex log_mutex;
-    std::lock_guard<std::mutex> lock(log_mutex);  // 确保多线程安全
-    
-    // 生成时间戳
-    QString timestamp = QDateTime::currentDateTime().toString("HH:mm:ss.zzz");
-
-    // 提取debug信息中的函数名、文件名和行号
-    QString logMessage = QString("[%1:%2] %3").arg(context.function)
-            .arg(context.line)
-            .arg(msg);
-    std::string log_msg = logMessage.toStdString();
-    QString level;
-    QIcon icon;
-    
-    // 将日志重定向到 spdlog
+bool LogHandler::admit(QtMsgType type, const QMessageLogContext &context, const QString &msg, quint32 &suppressed) {
+    suppressed = 0;
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        return true;
+    }
+    CallSiteSlot &slot = callSites[callSiteKey(context, msg) % callSites.size()];
+    const qint64 now = monotonicMs();
+    qint64 start = slot.windowStart.load(std::memory_order_relaxed);
+    if (now - start >= 1000 && slot.windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        // 新窗口：由抢到窗口的线程报告上一个窗口的丢弃数
+        suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+        slot.count.store(0, std::memory_order_relaxed);
+    }
+    if (slot.count.fetch_add(1, std::memory_order_relaxed) < quint32(RateLimitPerSecond)) {
+        return true;
+    }
+    slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+    rateLimited.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+quint64 LogHandler::droppedMessages() {
+    quint64 dropped = rateLimited.load(std::memory_order_relaxed);
+    if (logger) {
+        if (auto pool = spdlog::thread_pool()) {
+            dropped += pool->overrun_counter();
+        }
+    }
+    return dropped;
+}
+
+void LogHandler::dispatch(QtMsgType type, const QString &location, const QString &msg) {
+    // 将日志重定向到 spdlog（仅入队，不等待写盘）
+    const std::string logMsg = QString("[%1] %2").arg(location, msg).toStdString();
     switch (type) {
         case QtDebugMsg:
-            logger->debug(log_msg);
-            level="Debug";
-            icon=QIcon(":/icons/icons/debug.png");
+            logger->debug(logMsg);
             break;
         case QtWarningMsg:
-            logger->warn(log_msg);
-            level="Warn";
-            icon=QIcon(":/icons/icons/warn.png");
+            logger->warn(logMsg);
             break;
         case QtCriticalMsg:
-            logger->critical(log_msg);
-            level="Critical";
-            icon=QIcon(":/icons/icons/trace.png");
+        case QtFatalMsg:
+            logger->critical(logMsg);
             break;
         case QtInfoMsg:
-            logger->info(log_msg);
-            level="Info";
-            icon=QIcon(":/icons/icons/info.png");
+            logger->info(logMsg);
             break;
-        case QtFatalMsg:
-            logger->critical(log_msg);
-            level="Fatal";
-            icon=QIcon(":/icons/icons/critical.png");
-            // abort();
     }
 
-    // 将日志显示在 QTableWidget 中
-    appendLogToTable(timestamp, level, icon, logMessage);
+    // 推送到界面模型，由模型按批刷新；无界面模式下跳过
+    if (logTableWidget) {
+        LogEntry entry;
+        entry.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        entry.type = type;
+        entry.location = location;
+        entry.message = msg;
+        logTableWidget->logModel()->append(entry);
+    }
 }
 
-// 追加日志到 QTableWidget
-void LogHandler::appendLogToTable(const QString &timestamp, const QString &level, const QIcon &icon, const QString &logMessage) {
-    if (!logTableWidget) return;
-    
-    // 将 UI 更新操作转移到主线程
-    QMetaObject::invokeMethod(logTableWidget, [=]() {
-        // 检查是否需要应用过滤器
-        QString currentFilter = logTableWidget->property("currentFilter").toString();
-        if (!currentFilter.isEmpty() && currentFilter != "All" && currentFilter != level) {
-            return; // 如果不符合过滤条件，不添加此日志
-        }
-        
-        // 解析 spdlog 格式的日志信息，按 [] 分隔
-        QRegularExpression regex("\\[|\\]");
-        QStringList logParts = logMessage.split(regex, Qt::SkipEmptyParts);
-        
-        // 检查是否需要删除旧日志条目以保持在最大条目数限制内
-        int maxEntries = ConfigManager::instance().getMaxLogEntries();
-        while (logTableWidget->rowCount() >= maxEntries) {
-            logTableWidget->removeRow(0); // 删除最早的日志条目
-        }
-        
-        // 插入新行并填充数据
-        int rowCount = logTableWidget->rowCount();
-        logTableWidget->insertRow(rowCount);
-        
-        // 使用setItem而不是每次创建新的QTableWidgetItem，减少内存分配
-        logTableWidget->setItem(rowCount, 0, new QTableWidgetItem(timestamp));  // 第一列为时间戳
-        
-        QTableWidgetItem *levelItem = new QTableWidgetItem(icon, level);
-        logTableWidget->setItem(rowCount, 1, levelItem);  // 第二列为类型
-        
-        // 优化循环，减少不必要的条件检查
-        int colCount = logTableWidget->columnCount();
-        for (int i = 0; i < logParts.size() && i + 2 < colCount; ++i) {
-            logTableWidget->setItem(rowCount, i + 2, new QTableWidgetItem(logParts[i].trimmed()));
-        }
-        
-        // 仅在添加新日志时滚动到底部，避免频繁重绘
-        static int lastScrollRow = -1;
-        if (lastScrollRow != rowCount) {
-            logTableWidget->scrollToBottom();
-            lastScrollRow = rowCount;
-        }
-    }, Qt::QueuedConnection);
+void LogHandler::customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    quint32 suppressed = 0;
+    const bool admitted = admit(type, context, msg, suppressed);
+
+    // 提取debug信息中的函数名和行号
+    const QString location = QString("%1:%2").arg(context.function).arg(context.line);
+    if (suppressed > 0) {
+        dispatch(QtWarningMsg, location, QString("%1 similar messages suppressed").arg(suppressed));
+    }
+    if (!admitted) {
+        return;
+    }
+    dispatch(type, location, msg);
+
+    if (type == QtFatalMsg) {
+        // 进程即将终止，确保致命错误落盘
+        logger->flush();
+    }
 }
 
 // 静态成员的初始化
 std::shared_ptr<spdlog::logger> LogHandler::logger = nullptr;
 LogWidget* LogHandler::logTableWidget = nullptr;
-
-
-
+std::atomic<quint64> LogHandler::rateLimited{0};
@@ -14,11 +14,16 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/daily_file_sink.h>
-#include <mutex>
+#include <atomic>
 #include "LogWidget.hpp"
 
 class LogHandler {
 public:
+    static constexpr int QueueSize = 8192;             // 异步日志队列长度，满时覆盖最旧的记录
+    static constexpr int FlushIntervalSec = 1;         // 定期写盘间隔
+    static constexpr int RateLimitPerSecond = 50;      // 每个调用点每秒最多记录的消息数
+    static constexpr int CallSiteSlots = 1024;         // 限流表大小（按调用点哈希）
+
     LogHandler(LogWidget *tableWidget);
 
     ~LogHandler();
@@ -37,16 +42,28 @@ public:
      */
     static void customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
 
+    /**
+     * 被丢弃的日志条数（调用点限流 + 异步队列溢出）
+     * @return quint64 丢弃条数
+     */
+    static quint64 droppedMessages();
+
 private:
     /**
-     * 追加日志到表格
-     * @param const QString &timestamp 时间戳
-     * @param const QString &level 日志级别
-     * @param const QIcon &icon 图标
-     * @param const QString &logMessage 日志消息
+     * 调用点限流：同一调用点在一秒窗口内超过 RateLimitPerSecond 条后丢弃
+     * @param QtMsgType type 消息类型（Critical/Fatal 不限流）
+     * @param const QMessageLogContext &context 消息上下文
+     * @param const QString &msg 消息内容（无调用点信息时用于区分来源）
+     * @param quint32 &suppressed 输出：上一个窗口内被丢弃的条数，非零时调用方补记一条提示
+     * @return bool 是否允许记录
      */
-    static void appendLogToTable(const QString &timestamp, const QString &level, const QIcon &icon, const QString &logMessage);
-    
+    static bool admit(QtMsgType type, const QMessageLogContext &context, const QString &msg, quint32 &suppressed);
+
+    /**
+     * 写入文件日志并推送到界面模型
+     */
+    static void dispatch(QtMsgType type, const QString &location, const QString &msg);
+
     /**
      * spdlog 日志器
      */
@@ -56,4 +73,9 @@ private:
      * 日志表格
      */
     static LogWidget *logTableWidget;
+
+    /**
+     * 被限流丢弃的条数
+     */
+    static std::atomic<quint64> rateLimited;
 };
@@ -0,0 +1,174 @@
+#include "LogModel.hpp"
+#include <QDateTime>
+#include "../../Common/AppConfig/ConfigManager.h"
+
+LogModel::LogModel(int capacity, QObject *parent)
+    : QAbstractTableModel(parent),
+      m_capacity(qMax(1, capacity))
+{
+    m_ring.resize(m_capacity);
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setInterval(FlushIntervalMs);
+    connect(m_flushTimer, &QTimer::timeout, this, &LogModel::flushPending);
+    m_flushTimer->start();
+}
+
+void LogModel::append(const LogEntry &entry) {
+    QMutexLocker locker(&m_pendingMutex);
+    if (m_pending.size() >= 2 * m_capacity) {
+        // 界面来不及显示的记录只保留最新的 m_capacity 条，成批删除以摊薄开销
+        const int excess = m_pending.size() - m_capacity;
+        m_pending.remove(0, excess);
+        m_dropped += excess;
+    }
+    m_pending.append(entry);
+}
+
+void LogModel::clear() {
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_pending.clear();
+    }
+    beginResetModel();
+    m_start = 0;
+    m_count = 0;
+    endResetModel();
+}
+
+void LogModel::setCapacity(int capacity) {
+    capacity = qMax(1, capacity);
+    if (capacity == m_capacity) return;
+    // 按时间顺序重新排列，只保留最新的 capacity 条
+    const int keep = qMin(m_count, capacity);
+    if (keep < m_count) {
+        beginRemoveRows(QModelIndex(), 0, m_count - keep - 1);
+    }
+    QVector<LogEntry> ring(capacity);
+    for (int i = 0; i < keep; ++i) {
+        ring[i] = entryAt(m_count - keep + i);
+    }
+    m_ring.swap(ring);
+    m_capacity = capacity;
+    m_start = 0;
+    const bool removed = keep < m_count;
+    m_count = keep;
+    if (removed) {
+        endRemoveRows();
+    }
+}
+
+quint64 LogModel::droppedCount() const {
+    QMutexLocker locker(&m_pendingMutex);
+    return m_dropped;
+}
+
+QString LogModel::levelName(QtMsgType type) {
+    switch (type) {
+        case QtDebugMsg: return QStringLiteral("Debug");
+        case QtWarningMsg: return QStringLiteral("Warn");
+        case QtCriticalMsg: return QStringLiteral("Critical");
+        case QtInfoMsg: return QStringLiteral("Info");
+        case QtFatalMsg: return QStringLiteral("Fatal");
+    }
+    return QStringLiteral("Debug");
+}
+
+QIcon LogModel::levelIcon(QtMsgType type) const {
+    // 图标只在界面线程按级别加载一次
+    auto it = m_icons.constFind(type);
+    if (it != m_icons.constEnd()) return it.value();
+    QString path;
+    switch (type) {
+        case QtDebugMsg: path = ":/icons/icons/debug.png"; break;
+        case QtWarningMsg: path = ":/icons/icons/warn.png"; break;
+        case QtCriticalMsg: path = ":/icons/icons/trace.png"; break;
+        case QtInfoMsg: path = ":/icons/icons/info.png"; break;
+        case QtFatalMsg: path = ":/icons/icons/critical.png"; break;
+    }
+    return m_icons.insert(type, QIcon(path)).value();
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_count;
+}
+
+int LogModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_count) return QVariant();
+    const LogEntry &entry = entryAt(index.row());
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+        switch (index.column()) {
+            case TimestampColumn:
+                return QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("HH:mm:ss.zzz");
+            case LevelColumn:
+                return levelName(entry.type);
+            case LocationColumn:
+                return entry.location;
+            case MessageColumn:
+                return entry.message;
+            default:
+                break;
+        }
+    } else if (role == Qt::DecorationRole && index.column() == LevelColumn) {
+        return levelIcon(entry.type);
+    }
+    return QVariant();
+}
+
+QVariant LogModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const QStringList headers = {"Timestamp", "Level", "File", "Message"};
+    return headers.value(section);
+}
+
+void LogModel::flushPending() {
+    // 跟随设置中的最大条目数
+    setCapacity(ConfigManager::instance().getMaxLogEntries());
+    QVector<LogEntry> batch;
+    quint64 dropped = 0;
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        if (m_pending.isEmpty() && m_dropped == m_reportedDropped) return;
+        batch.swap(m_pending);
+        dropped = m_dropped - m_reportedDropped;
+        m_reportedDropped = m_dropped;
+    }
+    if (dropped > 0) {
+        // 让丢弃在界面上可见
+        LogEntry note;
+        note.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        note.type = QtWarningMsg;
+        note.location = QStringLiteral("LogModel");
+        note.message = QStringLiteral("%1 log messages dropped (console overloaded)").arg(dropped);
+        batch.append(note);
+    }
+
+    // 一批超过容量时只保留最新的部分
+    int first = 0;
+    if (batch.size() > m_capacity) {
+        first = batch.size() - m_capacity;
+    }
+    const int incoming = batch.size() - first;
+
+    // 一次性移除被挤出的最旧记录
+    const int overflow = m_count + incoming - m_capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_start = (m_start + overflow) % m_capacity;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    // 一次性插入本批记录
+    beginInsertRows(QModelIndex(), m_count, m_count + incoming - 1);
+    for (int i = first; i < batch.size(); ++i) {
+        m_ring[(m_start + m_count) % m_capacity] = std::move(batch[i]);
+        ++m_count;
+    }
+    endInsertRows();
+}
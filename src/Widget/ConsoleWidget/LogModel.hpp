@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QIcon>
+#include <QMutex>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * 单条日志记录（时间戳保存为毫秒数，显示时再格式化）
+ */
+struct LogEntry {
+    qint64 timestampMs = 0;
+    QtMsgType type = QtDebugMsg;
+    QString location;   ///< 函数名:行号
+    QString message;
+};
+
+/**
+ * 日志表格模型：固定容量的环形缓冲区。
+ * 任意线程调用 append() 只把记录放入待处理批次；界面线程以约 20Hz 的频率批量并入，
+ * 每批最多一次 beginRemoveRows 与一次 beginInsertRows，日志刷屏时界面开销与消息数量无关。
+ */
+class LogModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    static constexpr int FlushIntervalMs = 50;   // 界面刷新间隔（约 20Hz）
+
+    enum Column {
+        TimestampColumn,
+        LevelColumn,
+        LocationColumn,
+        MessageColumn,
+        ColumnCount
+    };
+
+    /**
+     * @param capacity 最多保留的日志条数
+     */
+    explicit LogModel(int capacity, QObject *parent = nullptr);
+
+    /**
+     * 追加日志（线程安全）；待处理批次积压过多时丢弃最旧的记录
+     * @param const LogEntry &entry 日志记录
+     */
+    void append(const LogEntry &entry);
+
+    /**
+     * 清空所有日志
+     */
+    void clear();
+
+    /**
+     * 修改容量，超出部分从最旧的记录开始删除
+     * @param int capacity 新容量
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * 因待处理批次溢出而被丢弃的记录数
+     */
+    quint64 droppedCount() const;
+
+    /**
+     * 级别名称（"Debug"/"Info"/"Warn"/"Critical"/"Fatal"）
+     */
+    static QString levelName(QtMsgType type);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private slots:
+    /**
+     * 把待处理批次并入环形缓冲区
+     */
+    void flushPending();
+
+private:
+    const LogEntry &entryAt(int row) const { return m_ring[(m_start + row) % m_capacity]; }
+    QIcon levelIcon(QtMsgType type) const;
+
+private:
+    QVector<LogEntry> m_ring;      // 环形缓冲区
+    int m_capacity = 0;
+    int m_start = 0;               // 最旧记录的位置
+    int m_count = 0;
+
+    mutable QMutex m_pendingMutex;
+    QVector<LogEntry> m_pending;   // 其他线程写入的待处理批次
+    quint64 m_dropped = 0;
+    quint64 m_reportedDropped = 0;
+    QTimer *m_flushTimer = nullptr;
+    mutable QHash<int, QIcon> m_icons;
+};
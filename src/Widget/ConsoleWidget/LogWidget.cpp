@@ -5,12 +5,27 @@
 #include <QTextStream>
 #include <QDateTime>
 #include <QActionGroup>
+#include <QScrollBar>
+#include <QRegularExpression>
+#include "../../Common/AppConfig/ConfigManager.h"
 LogWidget::LogWidget() {
-    setColumnCount(4);  // 时间、级别、文件、消息
-    QStringList headers = {"Timestamp", "Level", "File", "Message"};
-    setHorizontalHeaderLabels(headers);
+    // 时间、级别、文件、消息；数据来自环形缓冲区模型，按批刷新
+    m_model = new LogModel(ConfigManager::instance().getMaxLogEntries(), this);
+    m_proxy = new QSortFilterProxyModel(this);
+    m_proxy->setSourceModel(m_model);
+    m_proxy->setFilterKeyColumn(LogModel::LevelColumn);
+    setModel(m_proxy);
     horizontalHeader()->setSectionResizeMode(3,QHeaderView::Stretch);
-    setEditTriggers(QAbstractItemView::DoubleClicked);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 6);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    // 每批插入后，若视图原本停在底部则滚动到底部
+    connect(m_proxy, &QAbstractItemModel::rowsAboutToBeInserted, this, [this]() {
+        m_followTail = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    });
+    connect(m_proxy, &QAbstractItemModel::rowsInserted, this, [this]() {
+        if (m_followTail) scrollToBottom();
+    });
     
     // 设置右键菜单策略
     setContextMenuPolicy(Qt::DefaultContextMenu);
@@ -67,23 +82,18 @@ void LogWidget::contextMenuEvent(QContextMenuEvent *event)
 }
 
 void LogWidget::clearTableWidget() {
-    clearContents();  // 仅清空内容，不清空表头
-    setRowCount(0);   // 清空所有行
+    m_model->clear();   // 仅清空内容，不清空表头
 }
 
 void LogWidget::setLogFilter(const QString &level) {
     m_currentFilter = level;
     
-    // 应用过滤器
-    for (int row = 0; row < rowCount(); ++row) {
-        bool show = true;
-        if (level != "All") {
-            QTableWidgetItem *levelItem = item(row, 1);
-            if (levelItem && levelItem->text() != level) {
-                show = false;
-            }
-        }
-        setRowHidden(row, !show);
+    // 应用过滤器（级别列精确匹配）
+    if (level == "All") {
+        m_proxy->setFilterRegularExpression(QRegularExpression());
+    } else {
+        m_proxy->setFilterRegularExpression(
+            QRegularExpression(QStringLiteral("^%1$").arg(QRegularExpression::escape(level))));
     }
 }
 
@@ -100,22 +110,21 @@ void LogWidget::exportLog() {
         QTextStream stream(&file);
         
         // 写入表头
+        const int columns = m_proxy->columnCount();
         QStringList headers;
-        for (int col = 0; col < columnCount(); ++col) {
-            headers << horizontalHeaderItem(col)->text();
+        for (int col = 0; col < columns; ++col) {
+            headers << m_proxy->headerData(col, Qt::Horizontal).toString();
         }
         stream << headers.join(",") << "\n";
         
-        // 写入数据行
-        for (int row = 0; row < rowCount(); ++row) {
-            if (!isRowHidden(row)) {
-                QStringList rowData;
-                for (int col = 0; col < columnCount(); ++col) {
-                    QTableWidgetItem *item = this->item(row, col);
-                    rowData << (item ? "\"" + item->text().replace("\"", "\"\"") + "\"" : "");
-                }
-                stream << rowData.join(",") << "\n";
+        // 写入数据行（仅导出当前过滤后可见的行）
+        for (int row = 0; row < m_proxy->rowCount(); ++row) {
+            QStringList rowData;
+            for (int col = 0; col < columns; ++col) {
+                QString text = m_proxy->index(row, col).data().toString();
+                rowData << "\"" + text.replace("\"", "\"\"") + "\"";
             }
+            stream << rowData.join(",") << "\n";
         }
         
         file.close();
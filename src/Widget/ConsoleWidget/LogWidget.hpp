@@ -1,11 +1,13 @@
 #pragma once
 
-#include <QTableWidget>
+#include <QTableView>
+#include <QSortFilterProxyModel>
 #include <QMenu>
 #include <QAction>
+#include "LogModel.hpp"
 
 
-class LogWidget : public QTableWidget
+class LogWidget : public QTableView
 {
     Q_OBJECT
 
@@ -21,6 +23,11 @@ public:
      * @return QList<QAction*> 操作项列表
      */
     QList<QAction*> getActions();
+    /**
+     * 获取日志模型（LogHandler 从任意线程向其追加日志）
+     * @return LogModel* 日志模型
+     */
+    LogModel *logModel() const { return m_model; }
 protected:
     /**
      * 上下文菜单事件
@@ -44,4 +51,7 @@ public:
 
 private:
     QString m_currentFilter = "All"; // 当前过滤级别
+    LogModel *m_model = nullptr;
+    QSortFilterProxyModel *m_proxy = nullptr;
+    bool m_followTail = true;        // 插入前是否停在底部
 };
@@ -32,6 +32,12 @@ ExternalControler::ExternalControler():
     if (config.isOscEnabled()) {
         OSC_Receiver = new OSCReceiver(config.getExtraControlPort());
         OSC_Feedback = new OSCSender(config.getExtraFeedbackHost(), config.getExtraFeedbackPort());
+        // 状态反馈只需最新值：按地址合并高频更新，放宽发送间隔，并将同一周期的反馈打包为 bundle
+        const QString feedbackHost = config.getExtraFeedbackHost();
+        const int feedbackPort = config.getExtraFeedbackPort();
+        OSC_Feedback->setCoalescingEnabled(feedbackHost, feedbackPort, true);
+        OSC_Feedback->setBundlingEnabled(feedbackHost, feedbackPort, true);
+        OSC_Feedback->setFlushInterval(feedbackHost, feedbackPort, AppConfigs::EXTRA_FEEDBACK_INTERVAL_MS);
 
         connect(OSC_Receiver, &OSCReceiver::receiveOSCMessage, StatusContainer::instance(), &StatusContainer::parseOSC);
         connect(StatusContainer::instance(), &StatusContainer::statusUpdated, this, [this](const StatusItem& item) {
@@ -66,6 +66,26 @@ void PageWebSocketHandler::handleRequest(HTTPServerRequest& request,
                                 }
                             }
                         }
+                        if (obj.contains("prefix")) {
+                            const auto items = StatusContainer::instance()->queryByPrefix(obj["prefix"].toString());
+                            for (const auto& item : items) {
+                                send(QJsonDocument(item.toJsonObject()).toJson(QJsonDocument::Compact).toStdString());
+                            }
+                        }
+                        if (obj.contains("since")) {
+                            // 增量同步：返回序号之后的变更，最后回复当前序号；reset 为 true 时客户端应替换本地镜像
+                            quint64 latestSeq = 0;
+                            bool reset = false;
+                            const auto items = StatusContainer::instance()->changesSince(
+                                quint64(obj["since"].toVariant().toULongLong()), &latestSeq, &reset);
+                            for (const auto& item : items) {
+                                send(QJsonDocument(item.toJsonObject()).toJson(QJsonDocument::Compact).toStdString());
+                            }
+                            QJsonObject seqObj;
+                            seqObj["seq"] = QString::number(latestSeq);
+                            seqObj["reset"] = reset;
+                            send(QJsonDocument(seqObj).toJson(QJsonDocument::Compact).toStdString());
+                        }
                         QString addr = obj.value("address").toString();
                         if (addr.isEmpty()) addr = obj.value("addr").toString();
                         if (!addr.isEmpty()) {
@@ -48,6 +48,17 @@ MediaLibraryWidget::MediaLibraryWidget(QWidget* parent)
     lay->setContentsMargins(0, 0, 0, 0);
     lay->setSpacing(0);
     lay->addWidget(m_tree);
+    // 导入进度条（仅导入期间显示）
+    m_importProgress = new QProgressBar(this);
+    m_importProgress->setRange(0, 1000);
+    m_importProgress->setTextVisible(true);
+    m_importProgress->setVisible(false);
+    lay->addWidget(m_importProgress);
+    connect(m_model, &MediaLibrary::importProgress,
+            this,    &MediaLibraryWidget::onImportProgress);
+    connect(m_model, &MediaLibrary::importFinished, this, [this](bool) {
+        if (!m_model->isImporting()) m_importProgress->setVisible(false);
+    });
     setLayout(lay);
     // 通用操作（空白、组、子项都显示）
     // QMenu ctx(m_tree);
@@ -171,7 +182,7 @@ void MediaLibraryWidget::setChildrenFlag(QStandardItem* groupItem)
         Qt::ItemFlags flags = child->flags();
         flags |= Qt::ItemIsUserCheckable;
         child->setFlags(flags);
-        child->setIcon(categoryIcon(child->data(MediaLibrary::CategoryRole).toInt()));
+        child->setIcon(itemIcon(child));
 
     }
 }
@@ -292,9 +303,8 @@ void MediaLibraryWidget::onRowsInserted(const QModelIndex& parent, int first, in
         QStandardItem* child = parentItem->child(r);
         if (!child) continue;
         // 不再设置 Qt::ItemIsUserCheckable / checkState
-        // 为子项补充类型图标
-        const int cat = child->data(MediaLibrary::CategoryRole).toInt();
-        child->setIcon(categoryIcon(cat));
+        // 为子项补充类型图标（已有缩略图时使用缩略图）
+        child->setIcon(itemIcon(child));
 
     }
 }
@@ -317,6 +327,31 @@ QIcon MediaLibraryWidget::categoryIcon(int cat) const
     }
 }
 
+/**
+ * @brief 子项图标：有缩略图时使用缩略图，否则使用类别图标
+ */
+QIcon MediaLibraryWidget::itemIcon(const QStandardItem* item) const
+{
+    const QString thumbnail = item->data(MediaLibrary::ThumbnailRole).toString();
+    if (!thumbnail.isEmpty()) {
+        return QIcon(thumbnail);
+    }
+    return categoryIcon(item->data(MediaLibrary::CategoryRole).toInt());
+}
+
+/**
+ * @brief 导入进度：显示进度条与当前文件名，导入结束后隐藏
+ */
+void MediaLibraryWidget::onImportProgress(qint64 bytesDone, qint64 bytesTotal, const QString& currentFile)
+{
+    m_importProgress->setVisible(true);
+    const int value = bytesTotal > 0 ? static_cast<int>(bytesDone * 1000 / bytesTotal) : 1000;
+    m_importProgress->setValue(value);
+    const QString name = QFileInfo(currentFile).fileName();
+    m_importProgress->setFormat(name.isEmpty() ? QStringLiteral("%p%")
+                                               : QStringLiteral("%1  %p%").arg(name));
+}
+
 /**
  * @brief 事件过滤器：接收 Windows 资源管理器拖拽到 TreeView 空白区域
  * - DragEnter / DragMove：若包含 URL 则接受提出的动作
@@ -10,6 +10,7 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include <QProcess>
+#include <QProgressBar>
 #include "MediaLibrary/MediaLibrary.h"
 
 /**
@@ -82,6 +83,11 @@ private slots:
      */
     void onLibraryChanged();
 
+    /**
+     * @brief 导入进度：显示进度条与当前文件名，导入结束后隐藏
+     */
+    void onImportProgress(qint64 bytesDone, qint64 bytesTotal, const QString& currentFile);
+
 
 private:
     /**
@@ -107,9 +113,15 @@ private:
      */
     QIcon categoryIcon(int cat) const;
 
+    /**
+     * @brief 子项图标：有缩略图时使用缩略图，否则使用类别图标
+     */
+    QIcon itemIcon(const QStandardItem* item) const;
+
 private:
     MediaLibrary* m_model = nullptr;
     QTreeView* m_tree = nullptr;
+    QProgressBar* m_importProgress = nullptr;
     QAction* m_actImportFiles = nullptr;
     QAction* m_actImportFolder = nullptr;
     QAction* m_actDeleteChecked = nullptr;
@@ -12,6 +12,7 @@
 #include <QScreen>
 #include <QGroupBox>
 #include <QScrollArea>
+#include <QComboBox>
 
 #include "PushButton.h"
 
@@ -37,7 +38,7 @@ SettingWidget::SettingWidget(QWidget* parent)
     m_listWidget->setFrameShape(QFrame::NoFrame);
     m_listWidget->setSpacing(6);
     {
-        const QStringList items = {QStringLiteral("常规设置"), QStringLiteral("网络设置"), QStringLiteral("日志设置")};
+        const QStringList items = {QStringLiteral("常规设置"), QStringLiteral("网络设置"), QStringLiteral("日志设置"), QStringLiteral("音频设置")};
         QFontMetrics fm(m_listWidget->font());
         int maxTextW = 0;
         for (const auto& t : items) maxTextW = std::max(maxTextW, fm.horizontalAdvance(t));
@@ -54,6 +55,9 @@ SettingWidget::SettingWidget(QWidget* parent)
         auto* it3 = new QListWidgetItem(QStringLiteral("日志设置"));
         it3->setSizeHint(QSize(0, rowHeight));
         m_listWidget->addItem(it3);
+        auto* it4 = new QListWidgetItem(QStringLiteral("音频设置"));
+        it4->setSizeHint(QSize(0, rowHeight));
+        m_listWidget->addItem(it4);
         m_listWidget->setCurrentRow(0);
     }
     contentLayout->addWidget(m_listWidget);
@@ -87,6 +91,13 @@ SettingWidget::SettingWidget(QWidget* parent)
 
     m_darkThemeCheck = new QCheckBox("启用暗色主题", this);
     formGeneral->addRow("主题:", m_darkThemeCheck);
+
+    m_dataflowSchedulerCheck = new QCheckBox("按拓扑序批量传播（重启生效）", this);
+    formGeneral->addRow("数据流调度:", m_dataflowSchedulerCheck);
+
+    m_dataflowTickRateSpin = new IntDragValueWidget(this);
+    m_dataflowTickRateSpin->setRange(1, 240);
+    formGeneral->addRow("数据流刷新率 (Hz):", m_dataflowTickRateSpin);
     
     layoutGeneral->addLayout(formGeneral);
     layoutGeneral->addStretch();
@@ -168,6 +179,14 @@ SettingWidget::SettingWidget(QWidget* parent)
     m_mqttEnabledCheck = new QCheckBox("启用", this);
     formNet->addRow("MQTT外部反馈/控制:", m_mqttEnabledCheck);
 
+    auto* lblArtnetSection = new QLabel(QStringLiteral("Art-Net 设置"));
+    lblArtnetSection->setFont(titleFont);
+    formNet->addRow(lblArtnetSection);
+
+    m_artnetRefreshRateSpin = new IntDragValueWidget(this);
+    m_artnetRefreshRateSpin->setRange(1, 44);
+    formNet->addRow("Art-Net 刷新率 (Hz):", m_artnetRefreshRateSpin);
+
     layoutNet->addLayout(formNet);
     layoutNet->addStretch();
     m_stackedWidget->addWidget(pageNet);
@@ -196,6 +215,41 @@ SettingWidget::SettingWidget(QWidget* parent)
     layoutLog->addStretch();
     m_stackedWidget->addWidget(pageLog);
 
+    // --- 页面 4: 音频设置 ---
+    auto* pageAudio = new QWidget();
+    auto* layoutAudio = new QVBoxLayout(pageAudio);
+
+    auto* lblAudio = new QLabel("音频设置 (重启生效)");
+    lblAudio->setFont(titleFont);
+    layoutAudio->addWidget(lblAudio);
+
+    auto* lineAudio = new QFrame();
+    lineAudio->setFrameShape(QFrame::HLine);
+    lineAudio->setFrameShadow(QFrame::Sunken);
+    layoutAudio->addWidget(lineAudio);
+
+    auto* formAudio = new QFormLayout();
+    formAudio->setFieldGrowthPolicy(QFormLayout::AllNonFixedFieldsGrow);
+
+    m_audioSampleRateCombo = new QComboBox(this);
+    for (int rate : {44100, 48000, 96000}) {
+        m_audioSampleRateCombo->addItem(QString::number(rate), rate);
+    }
+    formAudio->addRow("采样率 (Hz):", m_audioSampleRateCombo);
+
+    m_audioBlockSizeCombo = new QComboBox(this);
+    for (int block : {128, 256, 512, 1024, 2048}) {
+        m_audioBlockSizeCombo->addItem(QString::number(block), block);
+    }
+    formAudio->addRow("块大小 (采样):", m_audioBlockSizeCombo);
+
+    m_audioDeviceClockCheck = new QCheckBox("由音频输出设备回调驱动", this);
+    formAudio->addRow("全局音频时钟:", m_audioDeviceClockCheck);
+
+    layoutAudio->addLayout(formAudio);
+    layoutAudio->addStretch();
+    m_stackedWidget->addWidget(pageAudio);
+
     // 连接列表与页面切换
     connect(m_listWidget, &QListWidget::currentRowChanged, m_stackedWidget, &QStackedWidget::setCurrentIndex);
 
@@ -219,6 +273,8 @@ void SettingWidget::loadCurrentSettings() {
     
     m_maxRecentFilesSpin->setValue(config.getMaxRecentFiles());
     m_darkThemeCheck->setChecked(config.isDefaultDarkTheme());
+    m_dataflowSchedulerCheck->setChecked(config.isDataflowSchedulerEnabled());
+    m_dataflowTickRateSpin->setValue(qRound(config.getDataflowTickRate()));
     
     m_httpPortSpin->setValue(config.getHttpServerPort());
     m_extraFeedbackHostEdit->setText(config.getExtraFeedbackHost());
@@ -234,8 +290,15 @@ void SettingWidget::loadCurrentSettings() {
     m_mqttFeedbackTopicEdit->setText(config.getMqttFeedbackTopic());
     m_mqttEnabledCheck->setChecked(config.isMqttEnabled());
     m_webPasswordEdit->setText(config.getWebAccessPassword());
+    m_artnetRefreshRateSpin->setValue(qRound(config.getArtnetRefreshRate()));
     // Log Settings
     m_maxLogEntriesSpin->setValue(config.getMaxLogEntries());
+    // Audio Settings
+    const int rateIndex = m_audioSampleRateCombo->findData(config.getAudioSampleRate());
+    m_audioSampleRateCombo->setCurrentIndex(rateIndex >= 0 ? rateIndex : m_audioSampleRateCombo->findData(48000));
+    const int blockIndex = m_audioBlockSizeCombo->findData(config.getAudioBlockSize());
+    m_audioBlockSizeCombo->setCurrentIndex(blockIndex >= 0 ? blockIndex : m_audioBlockSizeCombo->findData(2048));
+    m_audioDeviceClockCheck->setChecked(config.isAudioDeviceDrivenClock());
 }
 
 void SettingWidget::saveSettings() {
@@ -248,6 +311,8 @@ void SettingWidget::saveSettings() {
     obj["ExtraControlPort"] = m_extraControlPortSpin->value();
     obj["OscInternalControlHost"] = m_oscInternalHostEdit->text();
     obj["DefaultDarkTheme"] = m_darkThemeCheck->isChecked();
+    obj["DataflowSchedulerEnabled"] = m_dataflowSchedulerCheck->isChecked();
+    obj["DataflowTickRate"] = m_dataflowTickRateSpin->value();
     obj["OscEnabled"] = m_oscEnabledCheck->isChecked();
     obj["MqttEnabled"] = m_mqttEnabledCheck->isChecked();
     obj["MqttHost"] = m_mqttHostEdit->text();
@@ -257,8 +322,13 @@ void SettingWidget::saveSettings() {
     obj["MqttControlTopic"] = m_mqttControlTopicEdit->text();
     obj["MqttFeedbackTopic"] = m_mqttFeedbackTopicEdit->text();
     obj["WebAccessPassword"] = m_webPasswordEdit->text();
+    obj["ArtnetRefreshRate"] = m_artnetRefreshRateSpin->value();
     // Log Settings
     obj["MaxLogEntries"] = m_maxLogEntriesSpin->value();
+    // Audio Settings
+    obj["AudioSampleRate"] = m_audioSampleRateCombo->currentData().toInt();
+    obj["AudioBlockSize"] = m_audioBlockSizeCombo->currentData().toInt();
+    obj["AudioDeviceDrivenClock"] = m_audioDeviceClockCheck->isChecked();
 
     ConfigManager::instance().updateConfig(obj);
     
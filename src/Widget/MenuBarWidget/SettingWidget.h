@@ -7,6 +7,7 @@
 #include <QDialogButtonBox>
 #include <QListWidget>
 #include <QStackedWidget>
+#include <QComboBox>
 #include "../GUI/Elements/IntDragValueWidget/IntDragValueWidget.hpp"
 class SettingWidget : public QDialog {
     Q_OBJECT
@@ -28,6 +29,8 @@ private:
     // General Settings
     IntDragValueWidget* m_maxRecentFilesSpin;
     QCheckBox* m_darkThemeCheck;
+    QCheckBox* m_dataflowSchedulerCheck;
+    IntDragValueWidget* m_dataflowTickRateSpin;
 
     // Network Settings
     IntDragValueWidget* m_httpPortSpin;
@@ -44,7 +47,13 @@ private:
     QLineEdit* m_mqttControlTopicEdit;
     QLineEdit* m_mqttFeedbackTopicEdit;
     QLineEdit* m_webPasswordEdit;
+    IntDragValueWidget* m_artnetRefreshRateSpin;
 
     // Log Settings
     IntDragValueWidget* m_maxLogEntriesSpin;
+
+    // Audio Settings
+    QComboBox* m_audioSampleRateCombo;
+    QComboBox* m_audioBlockSizeCombo;
+    QCheckBox* m_audioDeviceClockCheck;
 };
@@ -14,6 +14,7 @@
 
 #include "Common/BaseClass/AbstractDelegateModel.h"
 #include "Common/DataTypes/NodeDataList.hpp"
+#include "Common/AppConfig/ConfigManager.h"
 using QtNodes::InvalidNodeId;
 using QtNodes::ConnectionPolicy;
 using QtNodes::NodeDataType;
@@ -26,7 +27,17 @@ using namespace NodeDataTypes;
 CustomDataFlowGraphModel::CustomDataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry)
         : _registry(std::move(registry))
         , _nextNodeId{0}
-{}
+        , _scheduler(new DataflowScheduler(this))
+{
+    _scheduler->setTickRate(ConfigManager::instance().getDataflowTickRate());
+    _scheduler->setEnabled(ConfigManager::instance().isDataflowSchedulerEnabled());
+}
+
+CustomDataFlowGraphModel::~CustomDataFlowGraphModel()
+{
+    // 节点对象随 _models 销毁，先等待线程池中仍在执行的节点任务
+    _scheduler->waitForIdle();
+}
 
 std::unordered_set<NodeId> CustomDataFlowGraphModel::allNodeIds() const
 {
@@ -88,11 +99,7 @@ NodeId CustomDataFlowGraphModel::addNode(QString const nodeType)
         if (auto derived = dynamic_cast<AbstractDelegateModel*>(model.get())) {
             derived->onModelReady();
         }
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [newId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(newId, portIndex);
-                });
+        connectDataUpdated(newId, model.get());
 
         connect(model.get(),
                 &NodeDelegateModel::portsAboutToBeDeleted,
@@ -153,8 +160,12 @@ bool CustomDataFlowGraphModel::connectionPossible(ConnectionId const connectionI
 //
     if (portVacant(PortType::Out) && portVacant(PortType::In)){
 //        接口未占用时，判断数据类型是否一致，或端口类型为万能类
-        return getDataType(PortType::Out).id == getDataType(PortType::In).id or
-           getDataType(PortType::In).id == VariableData().type().id;
+        // DMX 宇宙数据与 VariableData（旧格式 Art-Net 数据包）之间可互转，见 convertForInPort
+        const QString outId = getDataType(PortType::Out).id;
+        const QString inId = getDataType(PortType::In).id;
+        return outId == inId or
+           inId == VariableData().type().id or
+           (inId == DmxUniverseData().type().id && outId == VariableData().type().id);
 
     } else{
 //        返回不允许连接
@@ -167,6 +178,7 @@ bool CustomDataFlowGraphModel::connectionPossible(ConnectionId const connectionI
 void CustomDataFlowGraphModel::addConnection(ConnectionId const connectionId)
 {
     _connectivity.insert(connectionId);
+    _scheduler->connectionAdded(connectionId);
 
     sendConnectionCreation(connectionId);
 
@@ -583,10 +595,7 @@ bool CustomDataFlowGraphModel::setPortData(
     switch (role) {
         case PortRole::Data:
             if (portType == PortType::In) {
-                model->setInData(value.value<std::shared_ptr<NodeData>>(), portIndex);
-
-                // Triggers repainting on the scene.
-                Q_EMIT inPortDataWasSet(nodeId, portType, portIndex);
+                deliverInData(model.get(), nodeId, portIndex, value.value<std::shared_ptr<NodeData>>());
             }
             break;
 
@@ -597,6 +606,38 @@ bool CustomDataFlowGraphModel::setPortData(
     return false;
 }
 
+std::shared_ptr<NodeData> CustomDataFlowGraphModel::convertForInPort(NodeDelegateModel* model,
+                                                                     PortIndex portIndex,
+                                                                     const std::shared_ptr<NodeData>& data) const
+{
+    if (!data) {
+        return data;
+    }
+    static const QString dmxTypeId = DmxUniverseData().type().id;
+    const QString inTypeId = model->dataType(PortType::In, portIndex).id;
+
+    if (auto dmx = std::dynamic_pointer_cast<DmxUniverseData>(data)) {
+        return inTypeId == dmxTypeId ? data : std::static_pointer_cast<NodeData>(dmx->toVariableData());
+    }
+    if (inTypeId == dmxTypeId) {
+        if (auto variable = std::dynamic_pointer_cast<VariableData>(data)) {
+            return DmxUniverseData::fromVariableData(*variable);
+        }
+    }
+    return data;
+}
+
+void CustomDataFlowGraphModel::deliverInData(NodeDelegateModel* model,
+                                             NodeId nodeId,
+                                             PortIndex portIndex,
+                                             const std::shared_ptr<NodeData>& data)
+{
+    model->setInData(convertForInPort(model, portIndex, data), portIndex);
+
+    // Triggers repainting on the scene.
+    Q_EMIT inPortDataWasSet(nodeId, PortType::In, portIndex);
+}
+
 bool CustomDataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
 {
 
@@ -610,6 +651,7 @@ bool CustomDataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
         disconnected = true;
 //        qDebug()<<"delete connect:"+QString::number(connectionId.outNodeId)+" to "+QString::number(connectionId.inNodeId);
         _connectivity.erase(it);
+        _scheduler->connectionRemoved(connectionId);
     }
 
     if (disconnected) {
@@ -638,6 +680,7 @@ bool CustomDataFlowGraphModel::deleteNode(NodeId const nodeId)
     }
 
     _nodeGeometryData.erase(nodeId);
+    _scheduler->nodeRemoved(nodeId);
     _models.erase(nodeId);
 
     Q_EMIT nodeDeleted(nodeId);
@@ -681,6 +724,11 @@ QJsonObject CustomDataFlowGraphModel::saveNode(NodeId const nodeId) const
     nodeJson["input-count"] = nodeData(nodeId, NodeRole::InPortCount).toInt();
     nodeJson["output-count"] = nodeData(nodeId, NodeRole::OutPortCount).toInt();
     nodeJson["port-editable"] = nodeData(nodeId, NodeRole::PortEditable).toBool();
+    // 调度亲和性（默认值不保存）
+    const auto affinity = _scheduler->nodeAffinity(nodeId);
+    if (affinity != DataflowScheduler::Affinity::Scheduled) {
+        nodeJson["dataflow-affinity"] = DataflowScheduler::affinityToString(affinity);
+    }
 
     {
         QPointF const pos = nodeData(nodeId, NodeRole::Position).value<QPointF>();
@@ -708,7 +756,11 @@ QJsonObject CustomDataFlowGraphModel::save() const
 
     QJsonArray connJsonArray;
     for (auto const &cid : _connectivity) {
-        connJsonArray.append(toJson(cid));
+        QJsonObject connJson = toJson(cid);
+        if (!_scheduler->connectionCoalescing(cid)) {
+            connJson["coalesce"] = false;
+        }
+        connJsonArray.append(connJson);
     }
     sceneJson["connections"] = connJsonArray;
     QJsonArray groupJsonArray;
@@ -740,11 +792,7 @@ void CustomDataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
     std::unique_ptr<NodeDelegateModel> model = _registry->create(delegateModelName);
 
     if (model) {
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [restoredNodeId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(restoredNodeId, portIndex);
-                });
+        connectDataUpdated(restoredNodeId, model.get());
         model->setNodeID(restoredNodeId);
         model->setParentAlias(modelAlias());
         _models[restoredNodeId] = std::move(model);
@@ -761,6 +809,10 @@ void CustomDataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
         setNodeData(restoredNodeId, NodeRole::InPortCount, nodeJson["input-count"].toInt());
         setNodeData(restoredNodeId, NodeRole::OutPortCount, nodeJson["output-count"].toInt());
         _models[restoredNodeId]->load(internalDataJson);
+        if (nodeJson.contains("dataflow-affinity")) {
+            _scheduler->setNodeAffinity(restoredNodeId,
+                                        DataflowScheduler::affinityFromString(nodeJson["dataflow-affinity"].toString()));
+        }
 
         if (auto derived = dynamic_cast<AbstractDelegateModel*>(_models[restoredNodeId].get())) {
             derived->onModelReady();
@@ -788,6 +840,7 @@ void CustomDataFlowGraphModel::load(QJsonObject const &jsonDocument)
 
     _groups.clear();
     _connectivity.clear();
+    _scheduler->clear();
 
     const auto emitProgress = [this](const QString& phase, int current, int total) {
         if (current == 0 || current == total || (current % 20) == 0) {
@@ -847,6 +900,9 @@ void CustomDataFlowGraphModel::load(QJsonObject const &jsonDocument)
         for (QJsonValueRef connection : connectionJsonArray) {
             QJsonObject connJson = connection.toObject();
             ConnectionId connId = fromJson(connJson);
+            if (connJson.contains("coalesce")) {
+                _scheduler->setConnectionCoalescing(connId, connJson["coalesce"].toBool(true));
+            }
             addConnection(connId);
             ++i;
             emitProgress(tr("连接"), i, total);
@@ -870,6 +926,30 @@ void CustomDataFlowGraphModel::onOutPortDataUpdated(NodeId const nodeId, PortInd
     }
 }
 
+void CustomDataFlowGraphModel::connectDataUpdated(NodeId nodeId, NodeDelegateModel* model)
+{
+    // 节点可通过动态属性 "dataflowAffinity" 声明默认亲和性（direct / node-thread）
+    const QVariant affinity = model->property("dataflowAffinity");
+    if (affinity.isValid()) {
+        _scheduler->setNodeAffinity(nodeId, DataflowScheduler::affinityFromString(affinity.toString()));
+    }
+    // 节点声明的执行特性（线程安全/计算密集）决定能否在线程池中并行执行
+    if (auto derived = dynamic_cast<AbstractDelegateModel*>(model)) {
+        _scheduler->setNodeExecution(nodeId, derived->executionFlags());
+    }
+
+    // 直接连接：在发出线程读取输出值；启用调度时只记录最新值，由调度器按拓扑序批量下发
+    connect(model,
+            &NodeDelegateModel::dataUpdated,
+            [nodeId, model, this](PortIndex const portIndex) {
+                if (_scheduler->isEnabled()) {
+                    _scheduler->outputUpdated(nodeId, portIndex, model->outData(portIndex));
+                } else {
+                    onOutPortDataUpdated(nodeId, portIndex);
+                }
+            });
+}
+
 void CustomDataFlowGraphModel::propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex)
 {
     QVariant emptyData{};
@@ -13,6 +13,7 @@
 #include "QtNodes/internal/Serializable.hpp"
 #include "QtNodes/StyleCollection"
 #include "Widget/PortEditWidget/PortEditAddRemoveWidget.hpp"
+#include "DataflowScheduler.h"
 #include <QJsonObject>
 using QtNodes::AbstractGraphModel;
 using QtNodes::Serializable;
@@ -48,6 +49,8 @@ class CustomDataFlowGraphModel: public AbstractGraphModel, public Serializable
      */
     CustomDataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry);
 
+    ~CustomDataFlowGraphModel() override;
+
     /**
      * 数据模型注册表
      * @return std::shared_ptr<NodeDelegateModelRegistry> 注册表
@@ -228,6 +231,14 @@ class CustomDataFlowGraphModel: public AbstractGraphModel, public Serializable
     }
 
     QString modelAlias() const { return _modelAlias; }
+
+    /**
+     * 数据流批量调度器
+     * - 未启用时（默认）输出更新立即同步下发到下游
+     * - 节点亲和性保存在节点 JSON 的 "dataflow-affinity"，关闭合并的连接保存 "coalesce": false
+     * @return DataflowScheduler * 调度器
+     */
+    DataflowScheduler *scheduler() const { return _scheduler; }
 Q_SIGNALS:
     /**
      * 加载进度
@@ -261,6 +272,35 @@ private:
      * @param ConnectionId const connectionId 连接ID
      */
     void sendConnectionDeletion(ConnectionId const connectionId);
+    /**
+     * 按输入端口声明的类型转换数据
+     * - DmxUniverseData → VariableData 端口：转为旧格式 Art-Net 数据包
+     * - VariableData → DmxUniverseData 端口：解析旧格式 Art-Net 数据包
+     * @return 无需转换时原样返回
+     */
+    std::shared_ptr<NodeData> convertForInPort(NodeDelegateModel* model,
+                                               PortIndex portIndex,
+                                               const std::shared_ptr<NodeData>& data) const;
+    /**
+     * 向节点输入端口下发数据（类型转换 + setInData + 重绘通知）
+     * - 可在节点所在线程调用（调度器 NodeThread 亲和性）
+     * @param NodeDelegateModel* model 节点代理模型
+     * @param NodeId nodeId 节点ID
+     * @param PortIndex portIndex 端口索引
+     * @param data 数据
+     */
+    void deliverInData(NodeDelegateModel* model,
+                       NodeId nodeId,
+                       PortIndex portIndex,
+                       const std::shared_ptr<NodeData>& data);
+    /**
+     * 连接节点输出更新信号：按调度器是否启用选择立即下发或批量调度
+     * @param NodeId nodeId 节点ID
+     * @param NodeDelegateModel* model 节点代理模型
+     */
+    void connectDataUpdated(NodeId nodeId, NodeDelegateModel* model);
+
+    friend class DataflowScheduler;
 
     private Q_SLOTS:
 /**
@@ -311,5 +351,7 @@ private:
     std::unordered_set<GroupId> _groups;
 
     mutable std::unordered_map<NodeId, NodeGeometryData> _nodeGeometryData;
+    //数据流批量调度器
+    DataflowScheduler *_scheduler;
     };
 
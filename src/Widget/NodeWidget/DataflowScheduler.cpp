@@ -0,0 +1,637 @@
+//
+// Created by WuBin on 2025/9/3.
+//
+
+#include "DataflowScheduler.h"
+
+#include <QMetaMethod>
+#include <QPointer>
+#include <QThread>
+#include <algorithm>
+
+#include "CustomDataFlowGraphModel.h"
+#include "WorkStealingPool.h"
+
+using QtNodes::ConnectionId;
+using QtNodes::NodeData;
+using QtNodes::NodeId;
+using QtNodes::PortIndex;
+
+DataflowScheduler::DataflowScheduler(CustomDataFlowGraphModel* graph)
+    : QObject(graph)
+    , m_graph(graph)
+{
+    qRegisterMetaType<DataflowScheduler::Stats>("DataflowScheduler::Stats");
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &DataflowScheduler::flush);
+    m_sinceFlush.start();
+    m_rateClock.start();
+}
+
+DataflowScheduler::~DataflowScheduler() {
+    waitForIdle();
+}
+
+/**
+ * 函数级注释：开启/关闭调度
+ * - 关闭时立即把尚未处理的更新按拓扑序下发完，避免丢失最后的值
+ */
+void DataflowScheduler::setEnabled(bool enabled) {
+    const bool wasEnabled = m_enabled.exchange(enabled, std::memory_order_acq_rel);
+    if (wasEnabled && !enabled) {
+        flush();
+    }
+}
+
+void DataflowScheduler::setTickRate(double hz) {
+    m_tickRate = hz;
+}
+
+void DataflowScheduler::setNodeAffinity(NodeId nodeId, Affinity affinity) {
+    QWriteLocker locker(&m_topologyLock);
+    if (affinity == Affinity::Scheduled) {
+        m_affinity.erase(nodeId);
+    } else {
+        m_affinity[nodeId] = affinity;
+    }
+}
+
+DataflowScheduler::Affinity DataflowScheduler::nodeAffinity(NodeId nodeId) const {
+    QReadLocker locker(&m_topologyLock);
+    const auto it = m_affinity.find(nodeId);
+    return it == m_affinity.end() ? Affinity::Scheduled : it->second;
+}
+
+void DataflowScheduler::setConnectionCoalescing(const ConnectionId& connectionId, bool latestValueWins) {
+    {
+        QWriteLocker locker(&m_topologyLock);
+        if (latestValueWins) {
+            m_everyValueEdges.erase(connectionId);
+        } else {
+            m_everyValueEdges.insert(connectionId);
+        }
+    }
+    if (latestValueWins) {
+        QMutexLocker locker(&m_pendingMutex);
+        m_edgeQueues.erase(connectionId);
+    }
+}
+
+void DataflowScheduler::setNodeExecution(NodeId nodeId, AbstractDelegateModel::ExecutionFlags flags) {
+    QWriteLocker locker(&m_topologyLock);
+    if (flags == AbstractDelegateModel::MainThreadOnly) {
+        m_execution.erase(nodeId);
+    } else {
+        m_execution[nodeId] = flags;
+    }
+}
+
+bool DataflowScheduler::connectionCoalescing(const ConnectionId& connectionId) const {
+    QReadLocker locker(&m_topologyLock);
+    return m_everyValueEdges.find(connectionId) == m_everyValueEdges.end();
+}
+
+void DataflowScheduler::connectionAdded(const ConnectionId& connectionId) {
+    QWriteLocker locker(&m_topologyLock);
+    auto& edges = m_outEdges[connectionId.outNodeId];
+    if (std::find(edges.begin(), edges.end(), connectionId) == edges.end()) {
+        edges.push_back(connectionId);
+    }
+    m_topologyDirty = true;
+}
+
+void DataflowScheduler::connectionRemoved(const ConnectionId& connectionId) {
+    {
+        QWriteLocker locker(&m_topologyLock);
+        const auto it = m_outEdges.find(connectionId.outNodeId);
+        if (it != m_outEdges.end()) {
+            auto& edges = it->second;
+            edges.erase(std::remove(edges.begin(), edges.end(), connectionId), edges.end());
+            if (edges.empty()) {
+                m_outEdges.erase(it);
+            }
+        }
+        m_everyValueEdges.erase(connectionId);
+        m_topologyDirty = true;
+    }
+    QMutexLocker locker(&m_pendingMutex);
+    m_edgeQueues.erase(connectionId);
+}
+
+void DataflowScheduler::nodeRemoved(NodeId nodeId) {
+    waitForIdle(nodeId);
+    {
+        QWriteLocker locker(&m_topologyLock);
+        m_outEdges.erase(nodeId);
+        m_affinity.erase(nodeId);
+        m_execution.erase(nodeId);
+        m_topologyDirty = true;
+    }
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.erase(nodeId);
+}
+
+void DataflowScheduler::clear() {
+    {
+        QWriteLocker locker(&m_topologyLock);
+        m_outEdges.clear();
+        m_affinity.clear();
+        m_execution.clear();
+        m_everyValueEdges.clear();
+        m_topologyDirty = true;
+    }
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.clear();
+    m_edgeQueues.clear();
+}
+
+/**
+ * 函数级注释：记录输出更新
+ * - Direct 亲和性的下游立即下发（在图模型线程直接调用，其他线程的更新排队到图模型线程）；
+ *   其余下游只记录端口最新值，关闭合并的连接追加到队列
+ * - 首个待处理更新负责预约一次刷新（跨线程时排队到调度器线程）
+ */
+void DataflowScheduler::outputUpdated(NodeId nodeId, PortIndex portIndex, const std::shared_ptr<NodeData>& value) {
+    m_updates.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<ConnectionId> direct;
+    bool scheduled = false;
+    bool arm = false;
+    {
+        QReadLocker topology(&m_topologyLock);
+        const auto it = m_outEdges.find(nodeId);
+        if (it == m_outEdges.end()) {
+            return;
+        }
+
+        quint64 fanout = 0;
+        QMutexLocker pending(&m_pendingMutex);
+        for (const ConnectionId& connectionId : it->second) {
+            if (connectionId.outPortIndex != portIndex) {
+                continue;
+            }
+            ++fanout;
+            const auto affinity = m_affinity.find(connectionId.inNodeId);
+            if (affinity != m_affinity.end() && affinity->second == Affinity::Direct) {
+                direct.push_back(connectionId);
+                continue;
+            }
+            scheduled = true;
+            if (m_everyValueEdges.find(connectionId) != m_everyValueEdges.end()) {
+                auto& queue = m_edgeQueues[connectionId];
+                if (queue.size() >= MaxQueuedValues) {
+                    queue.erase(queue.begin());
+                }
+                queue.push_back(value);
+            }
+        }
+        m_potential.fetch_add(fanout, std::memory_order_relaxed);
+
+        if (scheduled) {
+            m_pending[nodeId][portIndex] = value;
+            // 刷新过程中本线程产生的更新由当前刷新继续处理
+            const bool inFlush = m_flushing && QThread::currentThread() == thread();
+            if (!m_flushArmed && !inFlush) {
+                m_flushArmed = true;
+                arm = true;
+            }
+        }
+    }
+
+    if (!direct.empty()) {
+        if (QThread::currentThread() == thread()) {
+            for (const ConnectionId& connectionId : direct) {
+                deliver(connectionId, value, Affinity::Direct);
+            }
+        } else {
+            // 线程池或其他线程发出的更新：节点表只在图模型线程访问，排队到该线程下发
+            QMetaObject::invokeMethod(this, [this, direct = std::move(direct), value]() {
+                for (const ConnectionId& connectionId : direct) {
+                    deliver(connectionId, value, Affinity::Direct);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    if (arm) {
+        if (QThread::currentThread() == thread()) {
+            armFlush();
+        } else {
+            QMetaObject::invokeMethod(this, &DataflowScheduler::armFlush, Qt::QueuedConnection);
+        }
+    }
+}
+
+/**
+ * 函数级注释：预约刷新，距上次刷新不足一个周期时延后到周期边界
+ */
+void DataflowScheduler::armFlush() {
+    if (m_timer.isActive()) {
+        return;
+    }
+    int delay = 0;
+    if (m_tickRate > 0.0) {
+        const qint64 interval = qint64(1000.0 / m_tickRate);
+        delay = int(qMax<qint64>(0, interval - m_sinceFlush.elapsed()));
+    }
+    m_timer.start(delay);
+}
+
+/**
+ * 函数级注释：计算拓扑层级与连通分量
+ * - 层级：Kahn 算法，无入边节点为 0 层，其余为所有上游层级最大值 + 1；同层节点互不依赖
+ * - 环路上的节点排在所有层级之后，每个节点独占一层（按 NodeId 升序），保持逐个处理
+ * - 连通分量：按连接做并查集；不同分量之间没有数据依赖，可各自独立推进
+ * - 读锁下检查是否需要重建，重建在写锁下进行并再次检查，读取拓扑的线程不会看到重建到一半的结果
+ */
+void DataflowScheduler::ensureTopology() {
+    {
+        QReadLocker locker(&m_topologyLock);
+        if (!m_topologyDirty) {
+            return;
+        }
+    }
+    QWriteLocker locker(&m_topologyLock);
+    if (!m_topologyDirty) {
+        return;
+    }
+
+    std::unordered_map<NodeId, int> inDegree;
+    std::unordered_map<NodeId, NodeId> parent;
+    const auto findRoot = [&parent](NodeId nodeId) {
+        NodeId root = nodeId;
+        while (parent[root] != root) {
+            root = parent[root];
+        }
+        while (parent[nodeId] != root) {
+            const NodeId next = parent[nodeId];
+            parent[nodeId] = root;
+            nodeId = next;
+        }
+        return root;
+    };
+    for (const auto& [outNodeId, edges] : m_outEdges) {
+        inDegree.emplace(outNodeId, 0);
+        parent.emplace(outNodeId, outNodeId);
+        for (const ConnectionId& connectionId : edges) {
+            ++inDegree[connectionId.inNodeId];
+            parent.emplace(connectionId.inNodeId, connectionId.inNodeId);
+            const NodeId a = findRoot(outNodeId);
+            const NodeId b = findRoot(connectionId.inNodeId);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    m_level.clear();
+    m_level.reserve(inDegree.size());
+    std::vector<NodeId> ready;
+    for (const auto& [nodeId, degree] : inDegree) {
+        if (degree == 0) {
+            ready.push_back(nodeId);
+            m_level[nodeId] = 0;
+        }
+    }
+
+    int maxLevel = 0;
+    while (!ready.empty()) {
+        const NodeId nodeId = ready.back();
+        ready.pop_back();
+        const int level = m_level[nodeId];
+        maxLevel = std::max(maxLevel, level);
+
+        const auto it = m_outEdges.find(nodeId);
+        if (it == m_outEdges.end()) {
+            continue;
+        }
+        for (const ConnectionId& connectionId : it->second) {
+            int& next = m_level[connectionId.inNodeId];
+            next = std::max(next, level + 1);
+            if (--inDegree[connectionId.inNodeId] == 0) {
+                ready.push_back(connectionId.inNodeId);
+            }
+        }
+    }
+
+    std::vector<NodeId> cyclic;
+    for (const auto& [nodeId, degree] : inDegree) {
+        if (degree > 0) {
+            cyclic.push_back(nodeId);
+        }
+    }
+    std::sort(cyclic.begin(), cyclic.end());
+    for (NodeId nodeId : cyclic) {
+        m_level[nodeId] = ++maxLevel;
+    }
+
+    m_component.clear();
+    m_component.reserve(parent.size());
+    for (const auto& entry : parent) {
+        m_component[entry.first] = int(findRoot(entry.first));
+    }
+
+    m_topologyDirty = false;
+}
+
+/**
+ * 函数级注释：有任务在线程池中执行的连通分量
+ */
+std::unordered_set<int> DataflowScheduler::busyComponents() const {
+    std::unordered_set<int> busy;
+    QMutexLocker locker(&m_inflightMutex);
+    for (const auto& entry : m_inflight) {
+        const auto it = m_component.find(entry.first);
+        if (it != m_component.end()) {
+            busy.insert(it->second);
+        }
+    }
+    return busy;
+}
+
+/**
+ * 函数级注释：一个刷新周期
+ * - 每轮从每个空闲连通分量中取出层级最小（且高于该分量已处理层级）的脏节点，下发其端口最新值
+ * - 同一轮的下游节点互不依赖：声明 ThreadSafe 的节点投递到工作窃取线程池并行执行，其余在本线程执行；
+ *   有任务在线程池中的分量暂停推进，任务完成后再继续，其他分量不受影响
+ * - 下游同步产生的更新写回待处理表，在下一轮中继续处理，同一周期内完成传播
+ * - 层级不高于已处理层级的更新（环路、其他线程对已处理节点的更新）留到下一周期
+ */
+void DataflowScheduler::flush() {
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_flushArmed = false;
+    }
+    m_timer.stop();
+    m_sinceFlush.restart();
+    ensureTopology();
+
+    std::unordered_set<int> busy = busyComponents();
+    std::unordered_map<int, int> processed;
+    m_flushing = true;
+
+    while (true) {
+        std::unordered_map<int, int> batchLevel;
+        std::vector<std::pair<NodeId, PortValues>> batch;
+        {
+            QMutexLocker locker(&m_pendingMutex);
+            for (auto it = m_pending.begin(); it != m_pending.end();) {
+                const auto component = m_component.find(it->first);
+                if (component == m_component.end()) {
+                    // 已没有任何连接
+                    it = m_pending.erase(it);
+                    continue;
+                }
+                const int level = m_level[it->first];
+                const auto done = processed.find(component->second);
+                if (busy.count(component->second) == 0 && (done == processed.end() || level > done->second)) {
+                    const auto current = batchLevel.find(component->second);
+                    if (current == batchLevel.end() || level < current->second) {
+                        batchLevel[component->second] = level;
+                    }
+                }
+                ++it;
+            }
+            for (auto it = m_pending.begin(); it != m_pending.end();) {
+                const int component = m_component[it->first];
+                const auto level = batchLevel.find(component);
+                if (level != batchLevel.end() && m_level[it->first] == level->second) {
+                    batch.emplace_back(it->first, std::move(it->second));
+                    it = m_pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (batch.empty()) {
+            break;
+        }
+        for (const auto& [component, level] : batchLevel) {
+            processed[component] = level;
+        }
+
+        // 按下游节点归并本轮的全部下发，保持来源顺序
+        std::map<NodeId, Target> targets;
+        for (const auto& [nodeId, ports] : batch) {
+            for (const auto& [portIndex, value] : ports) {
+                QReadLocker topology(&m_topologyLock);
+                const auto it = m_outEdges.find(nodeId);
+                if (it == m_outEdges.end()) {
+                    break;
+                }
+                for (const ConnectionId& connectionId : it->second) {
+                    if (connectionId.outPortIndex != portIndex) {
+                        continue;
+                    }
+                    const auto affinity = m_affinity.find(connectionId.inNodeId);
+                    const Affinity targetAffinity = affinity == m_affinity.end() ? Affinity::Scheduled : affinity->second;
+                    if (targetAffinity == Affinity::Direct) {
+                        continue;
+                    }
+                    Target& target = targets[connectionId.inNodeId];
+                    target.affinity = targetAffinity;
+                    const auto execution = m_execution.find(connectionId.inNodeId);
+                    target.execution = execution == m_execution.end() ? ExecutionFlags() : execution->second;
+
+                    if (m_everyValueEdges.find(connectionId) == m_everyValueEdges.end()) {
+                        target.deliveries.push_back({connectionId, value});
+                        continue;
+                    }
+                    QMutexLocker pending(&m_pendingMutex);
+                    const auto queue = m_edgeQueues.find(connectionId);
+                    if (queue != m_edgeQueues.end()) {
+                        for (auto& queued : queue->second) {
+                            target.deliveries.push_back({connectionId, std::move(queued)});
+                        }
+                        m_edgeQueues.erase(queue);
+                    }
+                }
+            }
+        }
+
+        const auto parallel = [](const Target& target) {
+            return target.affinity == Affinity::Scheduled &&
+                   target.execution.testFlag(AbstractDelegateModel::ThreadSafe);
+        };
+        const auto parallelCount = std::count_if(targets.begin(), targets.end(),
+                                                 [&](const auto& entry) { return parallel(entry.second); });
+
+        for (auto& [nodeId, target] : targets) {
+            if (parallel(target) &&
+                (parallelCount > 1 || target.execution.testFlag(AbstractDelegateModel::ComputeHeavy))) {
+                const int component = m_component[nodeId];
+                submit(nodeId, std::move(target.deliveries), component);
+                busy.insert(component);
+                continue;
+            }
+            for (const Delivery& delivery : target.deliveries) {
+                deliver(delivery.connectionId, delivery.value, target.affinity);
+            }
+        }
+    }
+
+    m_flushing = false;
+    m_ticks.fetch_add(1, std::memory_order_relaxed);
+    updateRates();
+
+    // 只剩忙碌分量的更新时不预约，由线程池任务完成后预约
+    QMutexLocker locker(&m_pendingMutex);
+    if (m_flushArmed) {
+        return;
+    }
+    for (const auto& entry : m_pending) {
+        const auto component = m_component.find(entry.first);
+        if (component == m_component.end() || busy.count(component->second) == 0) {
+            m_flushArmed = true;
+            QMetaObject::invokeMethod(this, &DataflowScheduler::armFlush, Qt::QueuedConnection);
+            break;
+        }
+    }
+}
+
+/**
+ * 函数级注释：将一个节点本轮的全部下发投递到线程池
+ * - 同一节点同时最多一个任务（所在分量忙碌期间不再推进），setInData 不会并发执行
+ * - 任务完成后预约刷新，继续推进该分量
+ */
+void DataflowScheduler::submit(NodeId nodeId, std::vector<Delivery> deliveries, int component) {
+    auto* model = m_graph->delegateModel<QtNodes::NodeDelegateModel>(nodeId);
+    if (!model || deliveries.empty()) {
+        return;
+    }
+    {
+        QMutexLocker locker(&m_inflightMutex);
+        ++m_inflight[nodeId];
+    }
+    m_evaluations.fetch_add(deliveries.size(), std::memory_order_relaxed);
+    m_parallel.fetch_add(1, std::memory_order_relaxed);
+
+    WorkStealingPool::instance().submit([this, model, nodeId, deliveries = std::move(deliveries)]() {
+        for (const Delivery& delivery : deliveries) {
+            m_graph->deliverInData(model, nodeId, delivery.connectionId.inPortIndex, delivery.value);
+        }
+        {
+            QMutexLocker locker(&m_inflightMutex);
+            const auto it = m_inflight.find(nodeId);
+            if (it != m_inflight.end() && --it->second == 0) {
+                m_inflight.erase(it);
+            }
+            m_inflightDone.wakeAll();
+        }
+        requestFlush();
+    }, component);
+}
+
+/**
+ * 函数级注释：有待处理更新时预约一次刷新（任意线程）
+ */
+void DataflowScheduler::requestFlush() {
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        if (m_flushArmed || m_pending.empty()) {
+            return;
+        }
+        m_flushArmed = true;
+    }
+    if (QThread::currentThread() == thread()) {
+        armFlush();
+    } else {
+        QMetaObject::invokeMethod(this, &DataflowScheduler::armFlush, Qt::QueuedConnection);
+    }
+}
+
+/**
+ * 函数级注释：等待线程池中的任务完成
+ * - 删除节点、销毁图模型前调用，保证工作线程不再访问节点对象
+ */
+void DataflowScheduler::waitForIdle(NodeId nodeId) {
+    QMutexLocker locker(&m_inflightMutex);
+    while (nodeId == QtNodes::InvalidNodeId ? !m_inflight.empty() : m_inflight.count(nodeId) > 0) {
+        m_inflightDone.wait(&m_inflightMutex);
+    }
+}
+
+/**
+ * 函数级注释：向一条连接的下游下发一个值
+ * - NodeThread：节点对象不在当前线程时排队投递到其线程，节点或图模型已销毁则丢弃
+ */
+void DataflowScheduler::deliver(const ConnectionId& connectionId,
+                                const std::shared_ptr<NodeData>& value,
+                                Affinity affinity) {
+    auto* model = m_graph->delegateModel<QtNodes::NodeDelegateModel>(connectionId.inNodeId);
+    if (!model) {
+        return;
+    }
+    m_evaluations.fetch_add(1, std::memory_order_relaxed);
+
+    if (affinity == Affinity::NodeThread && model->thread() != QThread::currentThread()) {
+        QPointer<CustomDataFlowGraphModel> graph(m_graph);
+        QPointer<QtNodes::NodeDelegateModel> target(model);
+        const NodeId nodeId = connectionId.inNodeId;
+        const PortIndex portIndex = connectionId.inPortIndex;
+        QMetaObject::invokeMethod(model, [graph, target, nodeId, portIndex, value]() {
+            if (graph && target) {
+                graph->deliverInData(target.data(), nodeId, portIndex, value);
+            }
+        }, Qt::QueuedConnection);
+        return;
+    }
+    m_graph->deliverInData(model, connectionId.inNodeId, connectionId.inPortIndex, value);
+}
+
+/**
+ * 函数级注释：每秒更新一次速率，并在有连接时发出 statsUpdated
+ */
+void DataflowScheduler::updateRates() {
+    const qint64 elapsed = m_rateClock.elapsed();
+    if (elapsed < 1000) {
+        return;
+    }
+    const Stats stats = getStats();
+    const double seconds = elapsed / 1000.0;
+    m_evaluationsPerSecond = (stats.evaluations - m_rateEvaluationsBase) / seconds;
+    m_savedPerSecond = (stats.saved - m_rateSavedBase) / seconds;
+    m_rateEvaluationsBase = stats.evaluations;
+    m_rateSavedBase = stats.saved;
+    m_rateClock.restart();
+
+    static const QMetaMethod statsSignal = QMetaMethod::fromSignal(&DataflowScheduler::statsUpdated);
+    if (isSignalConnected(statsSignal)) {
+        Q_EMIT statsUpdated(getStats());
+    }
+}
+
+DataflowScheduler::Stats DataflowScheduler::getStats() const {
+    Stats stats;
+    stats.updates = m_updates.load(std::memory_order_relaxed);
+    stats.evaluations = m_evaluations.load(std::memory_order_relaxed);
+    const quint64 potential = m_potential.load(std::memory_order_relaxed);
+    stats.saved = potential > stats.evaluations ? potential - stats.evaluations : 0;
+    stats.ticks = m_ticks.load(std::memory_order_relaxed);
+    stats.parallelTasks = m_parallel.load(std::memory_order_relaxed);
+    stats.evaluationsPerSecond = m_evaluationsPerSecond;
+    stats.savedPerSecond = m_savedPerSecond;
+    return stats;
+}
+
+QString DataflowScheduler::affinityToString(Affinity affinity) {
+    switch (affinity) {
+        case Affinity::Direct:
+            return QStringLiteral("direct");
+        case Affinity::NodeThread:
+            return QStringLiteral("node-thread");
+        default:
+            return QStringLiteral("scheduled");
+    }
+}
+
+DataflowScheduler::Affinity DataflowScheduler::affinityFromString(const QString& text) {
+    if (text == QLatin1String("direct")) {
+        return Affinity::Direct;
+    }
+    if (text == QLatin1String("node-thread")) {
+        return Affinity::NodeThread;
+    }
+    return Affinity::Scheduled;
+}
@@ -0,0 +1,198 @@
+//
+// Created by WuBin on 2025/9/3.
+//
+
+#pragma once
+
+#include <QObject>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "QtNodes/Definitions"
+#include "QtNodes/NodeData"
+#include "QtNodes/internal/ConnectionIdHash.hpp"
+#include "Common/BaseClass/AbstractDelegateModel.h"
+
+class CustomDataFlowGraphModel;
+
+/**
+ * @brief 数据流批量调度器（可选，由 Dataflow/SchedulerEnabled 开启）
+ * - 节点输出更新时只记录“端口 → 最新值”并标记下游为脏，不立即调用下游 setInData
+ * - 每个刷新周期（Dataflow/TickRate）在调度器线程（图模型所在线程）按拓扑层级处理脏端口：
+ *   每条连接每周期只下发一次最新值，菱形汇聚节点的输出也只向后传播一次
+ * - 传播过程中下游产生的输出若位于更高层级，在同一周期内继续处理；环路或已处理层级顺延到下一周期
+ * - 节点亲和性：Scheduled（默认，周期内同步下发）、Direct（绕过调度立即下发；来自线程池等其他线程的更新排队到图模型线程下发）、
+ *   NodeThread（周期内以排队调用投递到节点对象所在线程）
+ * - 连接合并策略：默认“最新值优先”；关闭合并的连接按顺序下发周期内的每个值（触发类信号）
+ * - 并行：按连接计算拓扑层级与连通分量，同一层的下游互不依赖；声明 ThreadSafe 的节点
+ *   （AbstractDelegateModel::executionFlags）投递到共享的工作窃取线程池并行执行，其余节点固定在主线程
+ * - 输出更新可来自任意线程；下游 setInData 的调用线程由亲和性与执行特性决定
+ */
+class DataflowScheduler : public QObject {
+    Q_OBJECT
+public:
+    enum class Affinity {
+        Scheduled,
+        Direct,
+        NodeThread
+    };
+
+    /**
+     * @brief 调度统计
+     * - evaluations 为实际的 setInData 次数；saved 为旧的立即下发方式相对多出的次数
+     */
+    struct Stats {
+        quint64 updates = 0;            // 收到的输出更新次数
+        quint64 evaluations = 0;        // 实际下发次数
+        quint64 saved = 0;              // 合并节省的下发次数
+        quint64 ticks = 0;              // 已执行的刷新周期数
+        quint64 parallelTasks = 0;      // 投递到线程池的节点任务数
+        double evaluationsPerSecond = 0.0;
+        double savedPerSecond = 0.0;
+    };
+
+    static constexpr int MaxQueuedValues = 256;   // 关闭合并的连接每周期最多缓存的值
+
+    explicit DataflowScheduler(CustomDataFlowGraphModel* graph);
+    ~DataflowScheduler() override;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 设置最大刷新率（Hz），小于等于 0 表示每次事件循环空闲时刷新
+     */
+    void setTickRate(double hz);
+    double tickRate() const { return m_tickRate; }
+
+    /**
+     * @brief 设置节点亲和性
+     */
+    void setNodeAffinity(QtNodes::NodeId nodeId, Affinity affinity);
+    Affinity nodeAffinity(QtNodes::NodeId nodeId) const;
+
+    /**
+     * @brief 设置节点执行特性（添加节点时由图模型读取 AbstractDelegateModel::executionFlags）
+     */
+    void setNodeExecution(QtNodes::NodeId nodeId, AbstractDelegateModel::ExecutionFlags flags);
+
+    /**
+     * @brief 设置连接是否合并为最新值（默认 true）
+     */
+    void setConnectionCoalescing(const QtNodes::ConnectionId& connectionId, bool latestValueWins);
+    bool connectionCoalescing(const QtNodes::ConnectionId& connectionId) const;
+
+    /**
+     * @brief 拓扑维护（图模型线程调用）
+     */
+    void connectionAdded(const QtNodes::ConnectionId& connectionId);
+    void connectionRemoved(const QtNodes::ConnectionId& connectionId);
+    void nodeRemoved(QtNodes::NodeId nodeId);
+    void clear();
+
+    /**
+     * @brief 节点输出端口数据更新（任意线程）
+     * @param value 发出线程读取的输出值快照
+     */
+    void outputUpdated(QtNodes::NodeId nodeId,
+                       QtNodes::PortIndex portIndex,
+                       const std::shared_ptr<QtNodes::NodeData>& value);
+
+    /**
+     * @brief 等待线程池中的节点任务完成
+     * @param nodeId 指定节点；InvalidNodeId 表示全部
+     */
+    void waitForIdle(QtNodes::NodeId nodeId = QtNodes::InvalidNodeId);
+
+    Stats getStats() const;
+
+    static QString affinityToString(Affinity affinity);
+    static Affinity affinityFromString(const QString& text);
+
+Q_SIGNALS:
+    /**
+     * @brief 统计更新（每秒一次，仅在有连接时发出）
+     */
+    void statsUpdated(const DataflowScheduler::Stats& stats);
+
+private Q_SLOTS:
+    void armFlush();
+    void flush();
+
+private:
+    using PortValues = std::map<QtNodes::PortIndex, std::shared_ptr<QtNodes::NodeData>>;
+    using ExecutionFlags = AbstractDelegateModel::ExecutionFlags;
+
+    struct Delivery {
+        QtNodes::ConnectionId connectionId;
+        std::shared_ptr<QtNodes::NodeData> value;
+    };
+
+    struct Target {
+        Affinity affinity = Affinity::Scheduled;
+        ExecutionFlags execution;
+        std::vector<Delivery> deliveries;
+    };
+
+    void ensureTopology();
+    std::unordered_set<int> busyComponents() const;
+    void submit(QtNodes::NodeId nodeId, std::vector<Delivery> deliveries, int component);
+    void requestFlush();
+    void deliver(const QtNodes::ConnectionId& connectionId,
+                 const std::shared_ptr<QtNodes::NodeData>& value,
+                 Affinity affinity);
+    void updateRates();
+
+    CustomDataFlowGraphModel* m_graph;
+    std::atomic<bool> m_enabled {false};
+    double m_tickRate = 60.0;
+    QTimer m_timer;
+    QElapsedTimer m_sinceFlush;
+
+    // 拓扑（图模型线程写，任意线程读）
+    mutable QReadWriteLock m_topologyLock;
+    std::unordered_map<QtNodes::NodeId, std::vector<QtNodes::ConnectionId>> m_outEdges;
+    std::unordered_map<QtNodes::NodeId, Affinity> m_affinity;
+    std::unordered_map<QtNodes::NodeId, ExecutionFlags> m_execution;
+    std::unordered_set<QtNodes::ConnectionId> m_everyValueEdges;
+    bool m_topologyDirty = true;
+
+    // 拓扑层级与连通分量（调度器线程在 m_topologyLock 写锁下重建）
+    std::unordered_map<QtNodes::NodeId, int> m_level;
+    std::unordered_map<QtNodes::NodeId, int> m_component;
+
+    // 线程池中执行的节点任务数
+    mutable QMutex m_inflightMutex;
+    QWaitCondition m_inflightDone;
+    std::unordered_map<QtNodes::NodeId, int> m_inflight;
+
+    // 待处理更新
+    mutable QMutex m_pendingMutex;
+    std::unordered_map<QtNodes::NodeId, PortValues> m_pending;
+    std::unordered_map<QtNodes::ConnectionId, std::vector<std::shared_ptr<QtNodes::NodeData>>> m_edgeQueues;
+    bool m_flushArmed = false;
+    bool m_flushing = false;                   // 仅调度器线程读写
+
+    // 统计
+    std::atomic<quint64> m_updates {0};
+    std::atomic<quint64> m_potential {0};      // 立即下发方式下应有的下发次数
+    std::atomic<quint64> m_evaluations {0};
+    std::atomic<quint64> m_ticks {0};
+    std::atomic<quint64> m_parallel {0};
+    QElapsedTimer m_rateClock;
+    quint64 m_rateEvaluationsBase = 0;
+    quint64 m_rateSavedBase = 0;
+    double m_evaluationsPerSecond = 0.0;
+    double m_savedPerSecond = 0.0;
+};
+
+Q_DECLARE_METATYPE(DataflowScheduler::Stats)
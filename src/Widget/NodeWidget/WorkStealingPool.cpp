@@ -0,0 +1,136 @@
+//
+// Created by WuBin on 2025/9/4.
+//
+
+#include "WorkStealingPool.h"
+
+#include <QDebug>
+
+namespace {
+    thread_local int t_workerIndex = -1;
+}
+
+WorkStealingPool& WorkStealingPool::instance() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+WorkStealingPool::WorkStealingPool() {
+    const int count = qMax(1, QThread::idealThreadCount() - 1);
+    m_workers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < count; ++i) {
+        QThread* thread = QThread::create([this, i]() { run(i); });
+        thread->setObjectName(QStringLiteral("DataflowWorker-%1").arg(i));
+        m_workers[i]->thread = thread;
+        thread->start();
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    m_stopping.store(true, std::memory_order_release);
+    {
+        QMutexLocker locker(&m_sleepMutex);
+        m_wake.wakeAll();
+    }
+    for (auto& worker : m_workers) {
+        if (worker->thread) {
+            worker->thread->wait();
+            delete worker->thread;
+            worker->thread = nullptr;
+        }
+    }
+}
+
+bool WorkStealingPool::isWorkerThread() {
+    return t_workerIndex >= 0;
+}
+
+/**
+ * 函数级注释：投递任务
+ * - 先入队再计数，计数与唤醒在睡眠锁内完成，工作线程检查计数后才睡眠，不会丢失唤醒
+ */
+void WorkStealingPool::submit(Task task, int homeHint) {
+    int home = t_workerIndex;
+    if (home < 0) {
+        home = homeHint >= 0 ? homeHint % workerCount()
+                             : int(m_nextHome.fetch_add(1, std::memory_order_relaxed) % unsigned(workerCount()));
+    }
+    {
+        QMutexLocker locker(&m_workers[home]->mutex);
+        m_workers[home]->queue.push_back(std::move(task));
+    }
+    QMutexLocker locker(&m_sleepMutex);
+    m_queued.fetch_add(1, std::memory_order_release);
+    m_wake.wakeOne();
+}
+
+bool WorkStealingPool::popLocal(int index, Task& task) {
+    Worker& worker = *m_workers[index];
+    QMutexLocker locker(&worker.mutex);
+    if (worker.queue.empty()) {
+        return false;
+    }
+    task = std::move(worker.queue.back());
+    worker.queue.pop_back();
+    return true;
+}
+
+/**
+ * 函数级注释：从其他工作线程队列头部窃取一个任务，从相邻线程开始依次尝试
+ * - 只尝试加锁，被占用的队列跳过，避免与队列所有者竞争
+ */
+bool WorkStealingPool::steal(int index, Task& task) {
+    const int count = workerCount();
+    for (int offset = 1; offset < count; ++offset) {
+        Worker& victim = *m_workers[(index + offset) % count];
+        if (!victim.mutex.tryLock()) {
+            continue;
+        }
+        if (!victim.queue.empty()) {
+            task = std::move(victim.queue.front());
+            victim.queue.pop_front();
+            victim.mutex.unlock();
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        victim.mutex.unlock();
+    }
+    return false;
+}
+
+void WorkStealingPool::run(int index) {
+    t_workerIndex = index;
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            m_queued.fetch_sub(1, std::memory_order_acq_rel);
+            try {
+                task();
+            } catch (const std::exception& e) {
+                qWarning() << "WorkStealingPool task failed:" << e.what();
+            } catch (...) {
+                qWarning() << "WorkStealingPool task failed";
+            }
+            m_executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        QMutexLocker locker(&m_sleepMutex);
+        if (m_queued.load(std::memory_order_acquire) == 0 && !m_stopping.load(std::memory_order_acquire)) {
+            // 超时兜底：被跳过的加锁队列中可能仍有任务
+            m_wake.wait(&m_sleepMutex, 50);
+        }
+    }
+    t_workerIndex = -1;
+}
+
+WorkStealingPool::Stats WorkStealingPool::getStats() const {
+    Stats stats;
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.stolen = m_stolen.load(std::memory_order_relaxed);
+    stats.workers = int(m_workers.size());
+    return stats;
+}
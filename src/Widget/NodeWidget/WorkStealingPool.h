@@ -0,0 +1,74 @@
+//
+// Created by WuBin on 2025/9/4.
+//
+
+#pragma once
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 工作窃取线程池（数据流图共享）
+ * - 每个工作线程一个本地双端队列：本线程从尾部取（后进先出，缓存友好），空闲线程从其他队列头部窃取
+ * - 工作线程数为核心数减一（为 GUI 线程保留一个核心），至少为 1
+ * - 投递时可指定归属队列（如连通分量编号），同一分支的任务倾向于在同一核心上执行
+ * - 工作线程内再投递的任务进入本线程队列
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    struct Stats {
+        quint64 executed = 0;    // 已执行任务数
+        quint64 stolen = 0;      // 其中被其他线程窃取执行的任务数
+        int workers = 0;
+    };
+
+    static WorkStealingPool& instance();
+
+    /**
+     * @brief 投递任务
+     * @param homeHint 归属队列提示，小于 0 时轮询分配
+     */
+    void submit(Task task, int homeHint = -1);
+
+    int workerCount() const { return int(m_workers.size()); }
+
+    /**
+     * @brief 当前线程是否为本线程池的工作线程
+     */
+    static bool isWorkerThread();
+
+    Stats getStats() const;
+
+private:
+    WorkStealingPool();
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    struct Worker {
+        QMutex mutex;
+        std::deque<Task> queue;
+        QThread* thread = nullptr;
+    };
+
+    void run(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    QMutex m_sleepMutex;
+    QWaitCondition m_wake;
+    std::atomic<int> m_queued {0};
+    std::atomic<unsigned> m_nextHome {0};
+    std::atomic<bool> m_stopping {false};
+    std::atomic<quint64> m_executed {0};
+    std::atomic<quint64> m_stolen {0};
+};
@@ -0,0 +1,91 @@
+#include "LtcChaseEngine.hpp"
+#include <cmath>
+
+void LtcChaseEngine::setSampleRate(int sampleRate)
+{
+    if (sampleRate > 0) {
+        m_sampleRate = sampleRate;
+    }
+}
+
+void LtcChaseEngine::setThresholds(double deadbandMs, double locateThresholdMs)
+{
+    m_deadbandSec = qMax(0.0, deadbandMs) / 1000.0;
+    m_locateThresholdSec = qMax(m_deadbandSec, locateThresholdMs / 1000.0);
+}
+
+void LtcChaseEngine::reset()
+{
+    m_rate = 1.0;
+    m_offset = 0.0;
+    m_consistentFrames = 0;
+    const qint64 relocates = m_status.relocates;
+    m_status = LtcChaseStatus();
+    m_status.relocates = relocates;
+}
+
+void LtcChaseEngine::restartFilter(double ltcTime, double sampleTime)
+{
+    m_position = ltcTime;
+    m_lastSampleTime = sampleTime;
+    m_rate = 1.0;
+    m_offset = 0.0;
+    m_consistentFrames = 1;
+    m_status.state = LtcChaseStatus::Locking;
+}
+
+LtcChaseEngine::Action LtcChaseEngine::update(double ltcTime, qint64 frameStartSample, qint64 currentSample,
+                                              double localTime, bool localRunning)
+{
+    Action action;
+    const double sampleTime = double(frameStartSample) / m_sampleRate;
+
+    if (m_status.state == LtcChaseStatus::Unlocked) {
+        restartFilter(ltcTime, sampleTime);
+        return action;
+    }
+
+    // 预测 → 校正：残差过大（跳变、倒带、重新开始）时重新进入确认阶段
+    const double dt = sampleTime - m_lastSampleTime;
+    const double predicted = m_position + m_rate * dt;
+    const double residual = ltcTime - predicted;
+    if (dt <= 0.0 || std::abs(residual) > m_locateThresholdSec) {
+        restartFilter(ltcTime, sampleTime);
+        return action;
+    }
+    m_position = predicted + Alpha * residual;
+    m_rate = qBound(1.0 - MaxRateDeviation, m_rate + Beta * residual / dt, 1.0 + MaxRateDeviation);
+    m_lastSampleTime = sampleTime;
+    m_status.driftPpm = (m_rate - 1.0) * 1e6;
+
+    if (m_status.state == LtcChaseStatus::Locking) {
+        if (++m_consistentFrames < LockFrames) {
+            return action;
+        }
+        m_status.state = LtcChaseStatus::Locked;
+    }
+
+    // 外推到当前写入位置，与同一时刻读取的本地时钟比较
+    const double elapsed = double(currentSample - frameStartSample) / m_sampleRate;
+    const double ltcNow = m_position + m_rate * elapsed;
+    const double offset = ltcNow - localTime;
+
+    if (!localRunning || std::abs(offset) > m_locateThresholdSec) {
+        action.type = Action::Locate;
+        action.time = ltcNow;
+        action.speed = m_rate;
+        m_offset = 0.0;
+        ++m_status.relocates;
+    } else {
+        m_offset += OffsetGain * (offset - m_offset);
+        action.type = Action::Slew;
+        action.speed = m_rate;
+        if (std::abs(m_offset) > m_deadbandSec) {
+            const double correction = qBound(-MaxSlewRatio, m_offset / SlewWindowSec, MaxSlewRatio);
+            action.speed = m_rate * (1.0 + correction);
+        }
+    }
+    m_status.offsetMs = m_offset * 1000.0;
+    m_status.speed = action.speed;
+    return action;
+}
@@ -0,0 +1,110 @@
+#ifndef LTCCHASEENGINE_HPP
+#define LTCCHASEENGINE_HPP
+
+#include <QMetaType>
+#include <QtGlobal>
+
+/**
+ * LTC 追踪状态
+ */
+struct LtcChaseStatus {
+    enum LockState {
+        Unlocked,   // 无信号
+        Locking,    // 收到连续帧，正在确认
+        Locked      // 已锁定，本地时钟跟随 LTC
+    };
+    LockState state = Unlocked;
+    double offsetMs = 0.0;   // LTC − 本地时钟（滤波后，毫秒），正值表示本地落后
+    double driftPpm = 0.0;   // LTC 相对声卡采样时钟的速率偏差（ppm）
+    double speed = 1.0;      // 当前应用到本地时钟的速度
+    qint64 relocates = 0;    // 硬定位次数
+};
+Q_DECLARE_METATYPE(LtcChaseStatus)
+
+/**
+ * LTC 追踪引擎
+ * - 以解码帧起点的样本序号为时间轴（声卡采样时钟），用 α-β 滤波器（稳态卡尔曼 / 二阶锁相环）
+ *   估计 LTC 位置与速率，平滑解码抖动
+ * - 与本地时钟比较得到偏差：偏差小于死区时只跟随速率；超过死区时微调速度（slew）追赶；
+ *   超过定位阈值或本地时钟未运行时硬定位
+ * - 只做计算，不持有时钟也不阻塞；调用方按返回的动作调整本地时钟
+ */
+class LtcChaseEngine {
+public:
+    /**
+     * 追踪动作
+     */
+    struct Action {
+        enum Type {
+            Hold,     // 不调整本地时钟
+            Slew,     // 只调整速度
+            Locate    // 跳转到 time 并以 speed 运行
+        };
+        Type type = Hold;
+        double time = 0.0;    // 跳转目标（秒），仅 Locate 有效
+        double speed = 1.0;   // 本地时钟速度
+    };
+
+    static constexpr int LockFrames = 4;                 // 连续多少帧后确认锁定
+    static constexpr double Alpha = 0.1;                 // 位置增益
+    static constexpr double Beta = Alpha * Alpha / (2.0 - Alpha);   // 速率增益（临界阻尼）
+    static constexpr double OffsetGain = 0.25;           // 偏差平滑系数
+    static constexpr double MaxRateDeviation = 0.1;      // 速率估计上限 ±10%
+    static constexpr double MaxSlewRatio = 0.02;         // 追赶时最多额外加减速 2%
+    static constexpr double SlewWindowSec = 1.0;         // 期望在约 1 秒内消除偏差
+    static constexpr double DefaultDeadbandMs = 2.0;
+    static constexpr double DefaultLocateThresholdMs = 80.0;
+
+    LtcChaseEngine() = default;
+
+    /**
+     * 设置采样率
+     * @param int sampleRate 声卡采样率
+     */
+    void setSampleRate(int sampleRate);
+
+    /**
+     * 设置死区与硬定位阈值
+     * @param double deadbandMs 偏差小于该值时不追赶
+     * @param double locateThresholdMs 偏差超过该值时硬定位
+     */
+    void setThresholds(double deadbandMs, double locateThresholdMs);
+
+    /**
+     * 丢失信号后复位
+     */
+    void reset();
+
+    /**
+     * 输入一帧 LTC 并给出本地时钟的调整动作
+     * @param double ltcTime 帧对应的时间（秒）
+     * @param qint64 frameStartSample 帧起点的样本序号
+     * @param qint64 currentSample 当前写入位置的样本序号（与 localTime 同一时刻）
+     * @param double localTime 本地时钟当前时间（秒）
+     * @param bool localRunning 本地时钟是否在运行
+     * @return Action 调整动作
+     */
+    Action update(double ltcTime, qint64 frameStartSample, qint64 currentSample, double localTime, bool localRunning);
+
+    /**
+     * 当前状态
+     */
+    const LtcChaseStatus &status() const { return m_status; }
+
+private:
+    void restartFilter(double ltcTime, double sampleTime);
+
+private:
+    double m_sampleRate = 44100.0;
+    double m_deadbandSec = DefaultDeadbandMs / 1000.0;
+    double m_locateThresholdSec = DefaultLocateThresholdMs / 1000.0;
+
+    double m_position = 0.0;        // 滤波后的 LTC 位置（对应 m_lastSampleTime）
+    double m_rate = 1.0;            // 滤波后的速率（LTC 秒 / 采样秒）
+    double m_lastSampleTime = 0.0;  // 上一帧起点的采样时间（秒）
+    double m_offset = 0.0;          // 平滑后的偏差（秒）
+    int m_consistentFrames = 0;
+    LtcChaseStatus m_status;
+};
+
+#endif // LTCCHASEENGINE_HPP
@@ -1,6 +1,16 @@
 #include "Widget/TimeLineWidget/TimeLineClock/TimeLineClock.hpp"
 #include <QThread>
+#include <chrono>
 #include "TimeCodeDefines.h"
+
+namespace {
+    qint64 monotonicMs()
+    {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
 TimeLineClock::TimeLineClock(QObject* parent)
     : QObject(parent)
     , m_currentFrame(0)
@@ -9,12 +19,18 @@ TimeLineClock::TimeLineClock(QObject* parent)
     , m_timecodeType(TimeCodeType::PAL)
     , m_clockSource(ClockSource::Internal)
 {
+    qRegisterMetaType<LtcChaseStatus>("LtcChaseStatus");
+    m_ltcWatchdog = new QTimer(this);
+    m_ltcWatchdog->setInterval(LtcDropoutMs / 2);
+    connect(m_ltcWatchdog, &QTimer::timeout, this, &TimeLineClock::checkLtcDropout);
     //默认初始化内部时钟
   initInternalClock();
 }
 
 TimeLineClock::~TimeLineClock()
 {
+    // 先停止 LTC 接收，音频线程不再回调
+    closeLTCClock();
     // 确保定时器停止
     if (m_timer) {
         m_timer->stop();
@@ -69,13 +85,8 @@ void TimeLineClock::setCurrentFrame(qint64 frame)
 {
     m_currentFrame = frame;  // QAtomicInteger 是线程安全的，不需要互斥锁
     m_currentTimecode = frames_to_timecode_frame(m_currentFrame, m_timecodeType);
-    auto status=m_timer->isPause();
-    m_timer->pause();
-    m_timer->setCurrentTime(timecode_frame_to_time(m_currentTimecode, m_timecodeType));
-    if(!status) {
-        QThread::msleep(50);
-        m_timer->resume();
-    }
+    // 原子地跳转，播放状态不变，不需要暂停/等待/恢复
+    m_timer->seek(timecode_frame_to_time(m_currentTimecode, m_timecodeType));
 
     updateTimecode();
 }
@@ -96,7 +107,8 @@ void TimeLineClock::setCurrentTimecodeFromTime(const double time)
     }
     m_currentFrame = timecode_frame_to_frames(m_currentTimecode, m_timecodeType);
     // 越界保护：根据 isLoop 判断循环或停止
-    if (m_maxFrames > 0 && m_currentFrame > m_maxFrames) {
+    // LTC 模式下位置由 LTC 决定，不在本地循环或停止
+    if (m_clockSource == ClockSource::Internal && m_maxFrames > 0 && m_currentFrame > m_maxFrames) {
         if (m_isLooping) {
             // 同步计时器时间，确保保持当前状态
             setCurrentFrame(0);
@@ -269,11 +281,14 @@ void TimeLineClock::closeCurrentClockSource()
 
 void TimeLineClock::closeLTCClock()
 {
+    m_ltcWatchdog->stop();
     if(m_ltcReceiver) {
         m_ltcReceiver->stop();  // 确保先停止接收
         delete m_ltcReceiver;
         m_ltcReceiver = nullptr;
     }
+    QMutexLocker locker(&m_mutex);
+    m_chase.reset();
 }
 
 void TimeLineClock::initLTCClock(QString device, int channelIndex)
@@ -284,13 +299,90 @@ void TimeLineClock::initLTCClock(QString device, int channelIndex)
     // 创建新的接收器
     m_ltcReceiver = new LTCReceiver();
     if (m_ltcReceiver) {
-        // connect(m_ltcReceiver, &LTCReceiver::newFrame, 
-        //         this, &TimeCodeGenerator::setCurrentTimecode);
+        // 在音频回调线程中直接追踪，帧位置与本地时钟在同一时刻比较
+        connect(m_ltcReceiver, &LTCReceiver::framePosition,
+                this, &TimeLineClock::onLtcFrame, Qt::DirectConnection);
+        {
+            QMutexLocker locker(&m_mutex);
+            m_chase.setSampleRate(m_ltcReceiver->sampleRate());
+            m_chase.reset();
+        }
+        m_lastLtcFrameMs = 0;
         m_ltcReceiver->setChannel(channelIndex);
         m_ltcReceiver->start(device);
+        m_ltcWatchdog->start();
+    }
+}
+
+void TimeLineClock::onLtcFrame(const TimeCodeFrame& frame, qint64 frameStartSample, qint64 currentSample)
+{
+    if (!m_timer) return;
+    m_lastLtcFrameMs = monotonicMs();
+
+    const double ltcTime = timecode_frame_to_time(frame, m_timecodeType);
+    LtcChaseEngine::Action action;
+    LtcChaseStatus status;
+    bool report = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto previousState = m_chase.status().state;
+        action = m_chase.update(ltcTime, frameStartSample, currentSample, m_timer->getTime(), !m_timer->isPause());
+        status = m_chase.status();
+        report = status.state != previousState || ++m_framesSinceStatus >= LtcStatusIntervalFrames;
+        if (report) {
+            m_framesSinceStatus = 0;
+        }
+    }
+
+    switch (action.type) {
+        case LtcChaseEngine::Action::Locate:
+            // 硬定位：跳转并按估计的速率运行
+            m_timer->setSpeed(action.speed);
+            m_timer->seek(action.time);
+            if (m_timer->isPause()) {
+                m_timer->resume();
+                emit timecodePlayingChanged(true);
+            }
+            break;
+        case LtcChaseEngine::Action::Slew:
+            // 小偏差只微调速度，播放不跳帧
+            m_timer->setSpeed(action.speed);
+            break;
+        case LtcChaseEngine::Action::Hold:
+            break;
+    }
+    if (report) {
+        emit ltcChaseStatusChanged(status);
     }
 }
 
+void TimeLineClock::checkLtcDropout()
+{
+    const qint64 last = m_lastLtcFrameMs;
+    if (last == 0 || monotonicMs() - last < LtcDropoutMs) return;
+    m_lastLtcFrameMs = 0;
+
+    // LTC 停止：本地时钟停在当前位置，等待信号恢复后重新锁定
+    LtcChaseStatus status;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_chase.reset();
+        status = m_chase.status();
+    }
+    if (m_timer && !m_timer->isPause()) {
+        m_timer->pause();
+        m_timer->setSpeed(1.0);
+        emit timecodePlayingChanged(false);
+    }
+    emit ltcChaseStatusChanged(status);
+}
+
+LtcChaseStatus TimeLineClock::getLtcChaseStatus() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_chase.status();
+}
+
 ClockSource TimeLineClock::getClockSource() const
 { 
     return m_clockSource;
@@ -347,8 +439,13 @@ void TimeLineClock::load(const QJsonObject& json)
             case ClockSource::Internal:
                 if(m_clockSource != ClockSource::Internal)
                 {
+                    // 内部时钟一直保留（LTC 模式下由它追踪 LTC），只需关闭其它时钟源
                     closeCurrentClockSource();
-                    initInternalClock();
+                    if (!m_timer) {
+                        initInternalClock();
+                    }
+                    m_timer->pause();
+                    m_timer->setSpeed(1.0);
                     m_clockSource = source;
                 }
                 break;
@@ -356,7 +453,14 @@ void TimeLineClock::load(const QJsonObject& json)
             case ClockSource::LTC:
                 if(m_clockSource != ClockSource::LTC)
                 {
-                    closeCurrentClockSource();
+                    if (m_clockSource != ClockSource::Internal) {
+                        closeCurrentClockSource();
+                    }
+                    if (!m_timer) {
+                        initInternalClock();
+                    }
+                    // 由 LTC 驱动播放，锁定后才开始走时
+                    m_timer->pause();
                     if (json.contains("ltcSettings")) {
                         QJsonObject ltcSettings = json["ltcSettings"].toObject();
                         m_clockSource = source;
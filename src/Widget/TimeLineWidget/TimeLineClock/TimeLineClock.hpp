@@ -10,10 +10,14 @@
 #include "../../Common/Devices/LtcReceiver/ltcreceiver.h"
 #include <QJsonObject>
 #include "TimeSyncServer.hpp"
+#include "LtcChaseEngine.hpp"
 using namespace QtTimeline;
 class TimeLineClock : public QObject {
     Q_OBJECT
 public:
+    static constexpr int LtcDropoutMs = 200;   // 超过该时间未收到 LTC 视为信号丢失
+    static constexpr int LtcStatusIntervalFrames = 25;   // 锁定后每隔多少帧汇报一次追踪状态
+
     explicit TimeLineClock(QObject* parent = nullptr);
     ~TimeLineClock() override;
     // 设置当前帧
@@ -62,6 +66,12 @@ public:
 
     void closeLTCClock();
 
+    /**
+     * 获取 LTC 追踪状态（偏差、漂移、锁定状态）
+     * @return LtcChaseStatus 追踪状态
+     */
+    LtcChaseStatus getLtcChaseStatus() const;
+
     QJsonObject save();
 
     void load(const QJsonObject& json);
@@ -98,6 +108,11 @@ signals:
     void stopPlay();
 
     void resumePlay();
+    /**
+     * LTC 追踪状态改变（锁定状态变化时立即发出，锁定期间定期发出）
+     * @param LtcChaseStatus status 追踪状态
+     */
+    void ltcChaseStatusChanged(const LtcChaseStatus& status);
 
 public slots:
     /**
@@ -114,20 +129,32 @@ public slots:
     void onStop();
 
     void onLoop(bool loop);
+private slots:
+    /**
+     * 检查 LTC 是否中断，中断时暂停本地时钟
+     */
+    void checkLtcDropout();
 private:
     /**
      * 更新时间码
      */
     void updateTimecode();
+    /**
+     * 收到 LTC 帧（在音频回调线程中直接调用，不阻塞）
+     * @param TimeCodeFrame frame 时间码帧
+     * @param qint64 frameStartSample 帧起点的样本序号
+     * @param qint64 currentSample 当前写入位置的样本序号
+     */
+    void onLtcFrame(const TimeCodeFrame& frame, qint64 frameStartSample, qint64 currentSample);
 private:
     /**
      * 定时器
      */
     TimeSyncServer* m_timer;
     /**
-     * 互斥锁
+     * 互斥锁（保护 LTC 追踪引擎）
      */
-    QMutex m_mutex;
+    mutable QMutex m_mutex;
     /**
      * 当前帧
      */
@@ -158,6 +185,19 @@ private:
      * LTC接收器
      */
     LTCReceiver* m_ltcReceiver {nullptr};
+    /**
+     * LTC 追踪引擎
+     */
+    LtcChaseEngine m_chase;
+    /**
+     * LTC 中断检测
+     */
+    QTimer* m_ltcWatchdog {nullptr};
+    /**
+     * 最近一次收到 LTC 帧的时间（毫秒，单调时钟）
+     */
+    QAtomicInteger<qint64> m_lastLtcFrameMs {0};
+    int m_framesSinceStatus {0};
 };
 
 #endif // TIMECODEGENERATOR_HPP 
\ No newline at end of file
@@ -27,6 +27,7 @@ TimeSyncServer::~TimeSyncServer() {
 }
 
 void TimeSyncServer::start() {
+    QMutexLocker locker(&mutex);
     startTime = Clock::now();
     currentTime = 0.0;
     isPaused = false;
@@ -34,20 +35,22 @@ void TimeSyncServer::start() {
 }
 
 void TimeSyncServer::stop() {
-    
+    QMutexLocker locker(&mutex);
     currentTime = 0.00;
     isPaused = true;
 }
 
 void TimeSyncServer::pause() {
+    QMutexLocker locker(&mutex);
     if (!isPaused) {
         // 记录暂停时的时间点
-        currentTime = getTime();
+        currentTime = timeLocked();
         isPaused = true;
     }
 }
 
 void TimeSyncServer::resume() {
+    QMutexLocker locker(&mutex);
     if (isPaused) {
         // 恢复时重新设置起始时间点，确保从暂停点继续
         startTime = Clock::now();
@@ -60,6 +63,11 @@ void TimeSyncServer::resume() {
  * @return 当前时间（秒）
  */
 double TimeSyncServer::getTime() const {
+    QMutexLocker locker(&mutex);
+    return timeLocked();
+}
+
+double TimeSyncServer::timeLocked() const {
     if (isPaused) {
 
         return currentTime;  // 暂停状态返回记录的时间点
@@ -86,7 +94,7 @@ void TimeSyncServer::broadcastTime() {
 
         timeToSend = getTime();
 
-        jsonObj["status"] = isPaused ? "pause" : "play";
+        jsonObj["status"] = isPause() ? "pause" : "play";
     }
     
     jsonObj["time"] = timeToSend;
@@ -110,11 +118,30 @@ void TimeSyncServer::broadcastTime() {
 }
 
 void TimeSyncServer::setCurrentTime(double time) {
+    QMutexLocker locker(&mutex);
+    currentTime = time;
+}
 
+void TimeSyncServer::seek(double time) {
+    QMutexLocker locker(&mutex);
     currentTime = time;
+    startTime = Clock::now();
 }
+
 void TimeSyncServer::setSpeed(double newSpeed) {
+    QMutexLocker locker(&mutex);
+    if (speed == newSpeed) return;
+    // 以当前时间为新的起点，改变速度时时间保持连续
+    if (!isPaused) {
+        currentTime = timeLocked();
+        startTime = Clock::now();
+    }
     speed = newSpeed;
 }
 
+double TimeSyncServer::getSpeed() const {
+    QMutexLocker locker(&mutex);
+    return speed;
+}
+
 
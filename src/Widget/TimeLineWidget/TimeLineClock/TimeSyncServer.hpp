@@ -6,6 +6,7 @@
 #include <QTimer>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QMutex>
 #include <chrono>
 
 class TimeSyncServer : public QObject {
@@ -21,14 +22,19 @@ private:
     double currentTime;        // 当前时间
     double speed;             // 播放速度
     bool isPaused;            // 是否暂停
+    mutable QMutex mutex;     // 保护时间状态（LTC 追踪在音频线程中调整速度与位置）
+
+    double timeLocked() const;
 
 public:
     TimeSyncServer(QObject *parent = nullptr);
     ~TimeSyncServer();
     double getTime() const;
     bool isPause() const{
+        QMutexLocker locker(&mutex);
         return isPaused;
     }
+    double getSpeed() const;
     
 signals:
     void timeUpdated(double time);
@@ -39,6 +45,10 @@ public slots:
     void resume();
     void setSpeed(double newSpeed);
     void setCurrentTime(double time);
+    /**
+     * @brief 跳转到指定时间，播放状态保持不变（不暂停、不等待）
+     */
+    void seek(double time);
     
 private slots:
     void broadcastTime();
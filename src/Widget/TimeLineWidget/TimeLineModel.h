@@ -8,6 +8,7 @@
 #include  "TimeCodeDefines.h"
 #include "./TimeLineClock/TimeLineClock.hpp"
 #include "TimeLineDefines.h"
+#include "Common/BaseClass/TimelineClipIndex.h"
 class TimeLineModel : public BaseTimeLineModel {
     Q_OBJECT
 
@@ -49,9 +50,16 @@ public slots:
 
     QList<QVariantMap> onGetClipCurrentData(qint64 currentFrame) const;
 private:
+    /**
+     * 获取剪辑索引，失效时按当前轨道重建
+     */
+    TimelineClipIndex* clipIndex() const;
+
     // 舞台对象
     TimeLineStage* m_stage;
     //时钟对象
     TimeLineClock* m_clock;
+    // 剪辑区间索引与 ClipId 索引
+    TimelineClipIndex* m_clipIndex;
     // mutable qint64 lastFrame = 0;
 };
\ No newline at end of file